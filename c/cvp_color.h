@@ -110,7 +110,8 @@ cvp_color_write_to_file(const struct cvp_color *c, FILE *fp)
  *  Function:                                                                 *
  *      cvp_color_write_to_ppm                                                *
  *  Purpose:                                                                  *
- *      Writes a color to a ppm pointer.                                      *
+ *      Writes a color to a ppm pointer. The color is appended to the PPM's   *
+ *      buffer, which is written to the file in large blocks.                 *
  *  Arguments:                                                                *
  *      c (const struct cvp_color *):                                         *
  *          A pointer to a color.                                             *
@@ -122,7 +123,7 @@ cvp_color_write_to_file(const struct cvp_color *c, FILE *fp)
 CVP_INLINE void
 cvp_color_write_to_ppm(const struct cvp_color *c, struct cvp_ppm *PPM)
 {
-    cvp_color_write_to_file(c, PPM->fp);
+    cvp_ppm_put(PPM, c->red, c->green, c->blue);
 }
 /*  End of cvp_color_write_to_ppm.                                            */
 
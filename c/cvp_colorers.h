@@ -126,6 +126,76 @@ cvp_color_from_angle(double angle)
 }
 /*  End of cvp_color_from_angle.                                              */
 
+/*  The number of colors on the wheel, six segments of 256.                   */
+#define CVP_COLOR_WHEEL_SIZE (1536)
+
+/*  The wheel, filled in by cvp_color_wheel_table the first time it is used.  */
+static struct cvp_color cvp_color_wheel_colors[CVP_COLOR_WHEEL_SIZE];
+static int cvp_color_wheel_is_filled = 0;
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp_color_wheel_table                                                 *
+ *  Purpose:                                                                  *
+ *      Returns the color wheel as a lookup table, computing it if needed.    *
+ *  Arguments:                                                                *
+ *      None (void).                                                          *
+ *  Outputs:                                                                  *
+ *      table (const struct cvp_color *):                                     *
+ *          The 1536 colors of the wheel.                                     *
+ *  Method:                                                                   *
+ *      Entry n is the gradient blue-cyan-green-yellow-red-magenta-blue at    *
+ *      n + 1/2. In each segment of 256 one channel rises as k or falls as    *
+ *      255 - k, where k = n mod 256, and the other two are fixed at 0 or     *
+ *      255. A small table gives the mode of each channel in each segment.    *
+ *  Notes:                                                                    *
+ *      The table is filled lazily, and this is not thread safe. None of the  *
+ *      C routines are run in parallel.                                       *
+ ******************************************************************************/
+CVP_INLINE const struct cvp_color *
+cvp_color_wheel_table(void)
+{
+    /*  Red, green, and blue for each segment. 0 is off, 1 rises, 2 falls,    *
+     *  and 3 is on.                                                          */
+    static const unsigned char segments[6][3] = {
+        {0U, 1U, 3U}, {0U, 3U, 2U}, {1U, 3U, 0U},
+        {3U, 2U, 0U}, {3U, 0U, 1U}, {2U, 0U, 3U}
+    };
+
+    unsigned int n, m;
+
+    if (cvp_color_wheel_is_filled)
+        return cvp_color_wheel_colors;
+
+    for (n = 0U; n < CVP_COLOR_WHEEL_SIZE; ++n)
+    {
+        const unsigned char k = (unsigned char)(n & 0xFFU);
+        unsigned char levels[3];
+
+        for (m = 0U; m < 3U; ++m)
+        {
+            const unsigned char mode = segments[n >> 8][m];
+
+            if (mode == 0U)
+                levels[m] = 0x00U;
+            else if (mode == 1U)
+                levels[m] = k;
+            else if (mode == 2U)
+                levels[m] = (unsigned char)(0xFFU - k);
+            else
+                levels[m] = 0xFFU;
+        }
+
+        cvp_color_wheel_colors[n].red = levels[0];
+        cvp_color_wheel_colors[n].green = levels[1];
+        cvp_color_wheel_colors[n].blue = levels[2];
+    }
+
+    cvp_color_wheel_is_filled = 1;
+    return cvp_color_wheel_colors;
+}
+/*  End of cvp_color_wheel_table.                                             */
+
 /******************************************************************************
  *  Function:                                                                 *
  *      cvp_color_wheel_from_angle                                            *
@@ -139,9 +209,10 @@ cvp_color_from_angle(double angle)
  *          The color corresponding to the angle.                             *
  *  Notes:                                                                    *
  *      The input should be between -pi and pi. Values outside this range     *
- *      return blue.                                                          *
+ *      return blue, as do NaNs.                                              *
  *  Method:                                                                   *
- *      Create a gradient blue-cyan-green-yellow-red-magenta-blue.            *
+ *      Scale the angle to (0, 1535) and use it to index a precomputed        *
+ *      gradient blue-cyan-green-yellow-red-magenta-blue.                     *
  ******************************************************************************/
 CVP_INLINE struct cvp_color
 cvp_color_wheel_from_angle(double angle)
@@ -150,89 +221,16 @@ cvp_color_wheel_from_angle(double angle)
      *  factor helps normalize the angle.                                     */
     const double gradient_factor = 1535.0 / (2.0 * M_PI);
 
-    /*  Scale the angle from (-pi, pi) to (0, 1023).                          */
-    double val = (angle + M_PI) * gradient_factor;
-
-    /*  Lastly, a color for the output.                                       */
-    struct cvp_color out;
-
-    /*  Values outside the legal range (angle < -pi). Return blue.            */
-    if (val < 0.0)
-        return cvp_blue;
-
-    /*  For 0 <= val < 256 transition from blue to cyan.                      */
-    else if (val < 256.0)
-    {
-        out.red = 0x00U;
-        out.green = (unsigned char)val;
-        out.blue = 0xFFU;
-    }
-
-    /*  For 256 <= val < 512 transition from cyan to green.                   */
-    else if (val < 512.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 256.0;
-
-        /*  Transition from cyan to green.                                    */
-        out.red = 0x00U;
-        out.green = 0xFFU;
-        out.blue = (unsigned char)(256.0 - val);
-    }
-
-    /*  For 512 <= val < 768 transition from green to yellow.                 */
-    else if (val < 768.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 512.0;
-
-        /*  Transition from green to yellow.                                  */
-        out.red = (unsigned char)val;
-        out.green = 0xFFU;
-        out.blue = 0x00U;
-    }
+    /*  Scale the angle from (-pi, pi) to (0, 1535).                          */
+    const double val = (angle + M_PI) * gradient_factor;
 
-    /*  For 768 <= val < 1024 transition from yellow to red.                  */
-    else if (val < 1024.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 768.0;
+    /*  Clamp to the table. Both ends of the wheel are blue. The comparison   *
+     *  is false for NaN, which then also gives blue. These are selects, and  *
+     *  compile without branches.                                             */
+    const double low = (val >= 0.0 ? val : 0.0);
+    const double index = (low < 1535.0 ? low : 1535.0);
 
-        /*  Transition from yellow to red.                                    */
-        out.red = 0xFFU;
-        out.green = (unsigned char)(256.0 - val);
-        out.blue = 0x00U;
-    }
-
-    /*  For 1024 <= val < 1280 transition from red to magenta.                */
-    else if (val < 1280.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 1024.0;
-
-        /*  Gradient from red to magenta.                                     */
-        out.red = 0xFFU;
-        out.green = 0x00U;
-        out.blue = (unsigned char)val;
-    }
-
-    /*  Finally transition from magenta back to blue.                         */
-    else if (val < 1536.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 1280.0;
-
-        /*  Transition from magenta to blue.                                  */
-        out.red = (unsigned char)(256.0 - val);
-        out.green = 0x00U;
-        out.blue = 0xFFU;
-    }
-
-    /*  Values outside the legal range (angle > +pi). Return blue.            */
-    else
-        return cvp_blue;
-
-    return out;
+    return cvp_color_wheel_table()[(unsigned int)index];
 }
 /*  End of cvp_color_wheel_from_angle.                                        */
 
@@ -31,17 +31,28 @@
 /*  FILE data type found here.                                                */
 #include <stdio.h>
 
+/*  memcpy found here.                                                        */
+#include <string.h>
+
 /*  CVP_INLINE macro found here.                                              */
 #include "cvp_inline.h"
 
 /*  Basic constants for the setup of the experiments given here.              */
 #include "cvp_setup.h"
 
+/*  Size of the output buffer of a PPM, in bytes. This is a whole number of   *
+ *  pixels so that cvp_ppm_put never splits a pixel across two flushes.       */
+#define CVP_PPM_BUFFER_SIZE (3U * 4096U)
+
 /*  Struct for working with PPM files.                                        */
 struct cvp_ppm {
 
     /*  The "data" of the PPM is just a FILE pointer.                         */
     FILE *fp;
+
+    /*  Packed RGB bytes waiting to be written, and how many there are.       */
+    unsigned char buffer[CVP_PPM_BUFFER_SIZE];
+    size_t size;
 };
 
 /******************************************************************************
@@ -70,6 +81,9 @@ cvp_ppm_create(const char *name)
     /*  Open the file and give it write permissions.                          */
     PPM.fp = fopen(name, "w");
 
+    /*  The buffer starts off empty.                                          */
+    PPM.size = 0U;
+
     /*  Warn the caller if fopen failed.                                      */
     if (!PPM.fp)
         puts("ERROR: fopen failed and returned NULL.");
@@ -132,6 +146,99 @@ cvp_ppm_init(struct cvp_ppm *PPM)
 }
 /*  End of cvp_ppm_init.                                                      */
 
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp_ppm_flush                                                         *
+ *  Purpose:                                                                  *
+ *      Writes the contents of a PPM's buffer to its file.                    *
+ *  Arguments:                                                                *
+ *      PPM (struct cvp_ppm *):                                               *
+ *          A pointer to the PPM struct that is to be flushed.                *
+ *  Outputs:                                                                  *
+ *      None (void).                                                          *
+ ******************************************************************************/
+CVP_INLINE void
+cvp_ppm_flush(struct cvp_ppm *PPM)
+{
+    /*  Nothing to do if the buffer is empty.                                 */
+    if (PPM->size == 0U)
+        return;
+
+    /*  One large fwrite instead of a separate fputc for every byte.          */
+    if (fwrite(PPM->buffer, 1U, PPM->size, PPM->fp) != PPM->size)
+        puts("ERROR: fwrite failed.");
+
+    PPM->size = 0U;
+}
+/*  End of cvp_ppm_flush.                                                     */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp_ppm_put                                                           *
+ *  Purpose:                                                                  *
+ *      Appends a single pixel to a PPM's buffer.                             *
+ *  Arguments:                                                                *
+ *      PPM (struct cvp_ppm *):                                               *
+ *          A pointer to the PPM the pixel is being written to.               *
+ *      r (unsigned char):                                                    *
+ *          The red component of the pixel.                                   *
+ *      g (unsigned char):                                                    *
+ *          The green component of the pixel.                                 *
+ *      b (unsigned char):                                                    *
+ *          The blue component of the pixel.                                  *
+ *  Outputs:                                                                  *
+ *      None (void).                                                          *
+ ******************************************************************************/
+CVP_INLINE void
+cvp_ppm_put(struct cvp_ppm *PPM,
+            unsigned char r, unsigned char g, unsigned char b)
+{
+    /*  The buffer holds a whole number of pixels, so it is either full or    *
+     *  has room for at least one more.                                       */
+    if (PPM->size == CVP_PPM_BUFFER_SIZE)
+        cvp_ppm_flush(PPM);
+
+    PPM->buffer[PPM->size] = r;
+    PPM->buffer[PPM->size + 1U] = g;
+    PPM->buffer[PPM->size + 2U] = b;
+    PPM->size += 3U;
+}
+/*  End of cvp_ppm_put.                                                       */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp_ppm_write                                                         *
+ *  Purpose:                                                                  *
+ *      Appends a block of packed RGB bytes, such as an entire row, to a PPM. *
+ *  Arguments:                                                                *
+ *      PPM (struct cvp_ppm *):                                               *
+ *          A pointer to the PPM the data is being written to.                *
+ *      data (const void *):                                                  *
+ *          The bytes to write.                                               *
+ *      size (size_t):                                                        *
+ *          The number of bytes to write.                                     *
+ *  Outputs:                                                                  *
+ *      None (void).                                                          *
+ ******************************************************************************/
+CVP_INLINE void
+cvp_ppm_write(struct cvp_ppm *PPM, const void *data, size_t size)
+{
+    /*  Small blocks are copied into the buffer.                              */
+    if (PPM->size + size <= CVP_PPM_BUFFER_SIZE)
+    {
+        memcpy(PPM->buffer + PPM->size, data, size);
+        PPM->size += size;
+        return;
+    }
+
+    /*  Larger ones are written directly after emptying the buffer.           */
+    cvp_ppm_flush(PPM);
+
+    if (fwrite(data, 1U, size, PPM->fp) != size)
+        puts("ERROR: fwrite failed.");
+}
+/*  End of cvp_ppm_write.                                                     */
+
 /******************************************************************************
  *  Function:                                                                 *
  *      cvp_ppm_close                                                         *
@@ -150,6 +257,8 @@ cvp_ppm_close(struct cvp_ppm *PPM)
     if (!PPM->fp)
         return;
 
+    /*  Write whatever is left in the buffer before closing.                  */
+    cvp_ppm_flush(PPM);
     fclose(PPM->fp);
 }
 /*  End of cvp_ppm_close.                                                     */
@@ -28,9 +28,6 @@
 #ifndef CVP_HPP
 #define CVP_HPP
 
-/*  malloc and free are given here.                                           */
-#include <cstdlib>
-
 /*  Complex class provided here.                                              */
 #include "cvp_complex.hpp"
 
@@ -43,9 +40,45 @@
 /*  Basic setup parameters for plotting functions provided here.              */
 #include "cvp_setup.hpp"
 
+/*  Viewports for choosing the region of the plane and the resolution.        */
+#include "cvp_viewport.hpp"
+
 /*  Functions for converting complex numbers into colors given here.          */
 #include "cvp_colorers.hpp"
 
+/*  Pixel kernels for the plotting routines.                                  */
+#include "cvp_kernels.hpp"
+
+/*  Options for how the plotting routines schedule their work.                */
+#include "cvp_options.hpp"
+
+/*  Driver for running kernels over the tiles of an image.                    */
+#include "cvp_render.hpp"
+
+/*  Field files, for saving values and recoloring them later.                 */
+#include "cvp_field.hpp"
+
+/*  Deep zooms of the Mandelbrot set using perturbation theory.               */
+#include "cvp_deep.hpp"
+
+/*  Newton maps of functions, differentiated with dual numbers.               */
+#include "cvp_newton.hpp"
+
+/*  Polynomials given by their roots, and Newton's method for them.           */
+#include "cvp_root_polynomial.hpp"
+
+/*  Polynomials and rational functions with compile-time coefficients.        */
+#include "cvp_polynomial.hpp"
+
+/*  Lazy complex arithmetic, evaluating whole expressions in one pass.        */
+#include "cvp_lazy.hpp"
+
+/*  Elementary functions: exp, log, pow, sqrt, sin, cos, and tanh.            */
+#include "cvp_math.hpp"
+
+/*  Fast coloring, with approximations of atan good to a fraction of a step.  */
+#include "cvp_fast_color.hpp"
+
 /*  Namespace for this mini-project. "Complex Visual Plots."                  */
 namespace cvp {
 
@@ -54,17 +87,265 @@ namespace cvp {
     inline void
     complex_plot(Tfunc cfunc, Tcolor color, const char *name);
 
+    /*  Same as complex_plot, with options for how to render the image.       */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    complex_plot(Tfunc cfunc, Tcolor color, const char *name,
+                 const cvp::render_options &opts);
+
+    /*  Same as complex_plot, but for the region of the given viewport.       */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    complex_plot(Tfunc cfunc, Tcolor color, const Tview &view,
+                 const char *name);
+
+    /*  Same as complex_plot, with a viewport and rendering options.          */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    complex_plot(Tfunc cfunc, Tcolor color, const Tview &view,
+                 const char *name, const cvp::render_options &opts);
+
     /*  Template for plotting iterative calls to complex functions.           */
     template <typename Tfunc, typename Tcolor>
     inline void
     iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name);
 
+    /*  Same as iters_plot, with options for how to render the image.         */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name,
+               const cvp::render_options &opts);
+
+    /*  Same as iters_plot, but for the region of the given viewport.         */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+               const Tview &view, const char *name);
+
+    /*  Same as iters_plot, with a viewport and rendering options.            */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+               const Tview &view, const char *name,
+               const cvp::render_options &opts);
+
     /*  Template for plotting Mandelbrot iterations of functions.             */
     template <typename Tfunc, typename Tcolor>
     inline void
     mandelbrot_plot(Tfunc cfunc, unsigned int iters,
                     Tcolor color, const char *name);
 
+    /*  Same as mandelbrot_plot, with options for how to render the image.    */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                    const char *name, const cvp::render_options &opts);
+
+    /*  Same as mandelbrot_plot, but for the region of the given viewport.    */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                    const Tview &view, const char *name);
+
+    /*  Same as mandelbrot_plot, with a viewport and rendering options.       */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                    const Tview &view, const char *name,
+                    const cvp::render_options &opts);
+
+    /*  Template for escape-time plots of Mandelbrot iterations.              */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                Tcolor color, const char *name);
+
+    /*  Same as escape_plot, with options for how to render the image.        */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                Tcolor color, const char *name,
+                const cvp::render_options &opts);
+
+    /*  Same as escape_plot, but for the region of the given viewport.        */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                Tcolor color, const Tview &view, const char *name);
+
+    /*  Same as escape_plot, with a viewport and rendering options.           */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                Tcolor color, const Tview &view, const char *name,
+                const cvp::render_options &opts);
+
+    /*  Template for plotting iterations that converge, like Newton's method. */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                     const cvp::attractors &roots, Tcolor color,
+                     const char *name);
+
+    /*  Same as convergence_plot, with options for how to render the image.   */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                     const cvp::attractors &roots, Tcolor color,
+                     const char *name, const cvp::render_options &opts);
+
+    /*  Same as convergence_plot, but for the region of the given viewport.   */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                     const cvp::attractors &roots, Tcolor color,
+                     const Tview &view, const char *name);
+
+    /*  Same as convergence_plot, with a viewport and rendering options.      */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                     const cvp::attractors &roots, Tcolor color,
+                     const Tview &view, const char *name,
+                     const cvp::render_options &opts);
+
+    /*  Template for plotting Newton's method for f, with f' found by dual    *
+     *  numbers.                                                              */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                const cvp::attractors &roots, Tcolor color, const char *name);
+
+    /*  Same as newton_plot, with options for how to render the image.        */
+    template <typename Tfunc, typename Tcolor>
+    inline void
+    newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                const cvp::attractors &roots, Tcolor color, const char *name,
+                const cvp::render_options &opts);
+
+    /*  Same as newton_plot, but for the region of the given viewport.        */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                const cvp::attractors &roots, Tcolor color,
+                const Tview &view, const char *name);
+
+    /*  Same as newton_plot, with a viewport and rendering options.           */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    inline void
+    newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                const cvp::attractors &roots, Tcolor color,
+                const Tview &view, const char *name,
+                const cvp::render_options &opts);
+
+    /*  Template for plotting Newton's method for a polynomial given by its   *
+     *  roots, with the basins labeled by the nearest root.                   */
+    template <typename Tcolor>
+    inline void
+    root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                     double tolerance, Tcolor color, const char *name);
+
+    /*  Same as root_newton_plot, with options for how to render the image.   */
+    template <typename Tcolor>
+    inline void
+    root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                     double tolerance, Tcolor color, const char *name,
+                     const cvp::render_options &opts);
+
+    /*  Same as root_newton_plot, but for the region of the given viewport.   */
+    template <typename Tcolor, typename Tview>
+    inline void
+    root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                     double tolerance, Tcolor color, const Tview &view,
+                     const char *name);
+
+    /*  Same as root_newton_plot, with a viewport and rendering options.      */
+    template <typename Tcolor, typename Tview>
+    inline void
+    root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                     double tolerance, Tcolor color, const Tview &view,
+                     const char *name, const cvp::render_options &opts);
+
+    /*  Escape-time plot of a deep zoom into the Mandelbrot set.              */
+    template <typename Tcolor>
+    inline void
+    deep_zoom_plot(unsigned int iters, double bailout, Tcolor color,
+                   const cvp::deep_viewport &view, const char *name);
+
+    /*  Same as deep_zoom_plot, with options for how to render the image.     */
+    template <typename Tcolor>
+    inline void
+    deep_zoom_plot(unsigned int iters, double bailout, Tcolor color,
+                   const cvp::deep_viewport &view, const char *name,
+                   const cvp::render_options &opts);
+
+    /*  Saves the values f(z) to a field file, for recoloring later.          */
+    template <typename Tfunc>
+    inline void complex_field(Tfunc cfunc, const char *name);
+
+    /*  Same as complex_field, but for the region of the given viewport.      */
+    template <typename Tfunc, typename Tview>
+    inline void complex_field(Tfunc cfunc, const Tview &view, const char *name);
+
+    /*  Same as complex_field, with a viewport and a choice of compression.   */
+    template <typename Tfunc, typename Tview>
+    inline void
+    complex_field(Tfunc cfunc, const Tview &view, const char *name,
+                  cvp::field_compression compression);
+
+    /*  Saves the iterates f^n(z) to a field file.                            */
+    template <typename Tfunc>
+    inline void
+    iters_field(Tfunc cfunc, unsigned int iters, const char *name);
+
+    /*  Same as iters_field, but for the region of the given viewport.        */
+    template <typename Tfunc, typename Tview>
+    inline void
+    iters_field(Tfunc cfunc, unsigned int iters,
+                const Tview &view, const char *name);
+
+    /*  Same as iters_field, with a viewport and a choice of compression.     */
+    template <typename Tfunc, typename Tview>
+    inline void
+    iters_field(Tfunc cfunc, unsigned int iters, const Tview &view,
+                const char *name, cvp::field_compression compression);
+
+    /*  Saves the Mandelbrot iterates w_n to a field file.                    */
+    template <typename Tfunc>
+    inline void
+    mandelbrot_field(Tfunc cfunc, unsigned int iters, const char *name);
+
+    /*  Same as mandelbrot_field, but for the region of the given viewport.   */
+    template <typename Tfunc, typename Tview>
+    inline void
+    mandelbrot_field(Tfunc cfunc, unsigned int iters,
+                     const Tview &view, const char *name);
+
+    /*  Same as mandelbrot_field, with a viewport and a choice of compression.*/
+    template <typename Tfunc, typename Tview>
+    inline void
+    mandelbrot_field(Tfunc cfunc, unsigned int iters, const Tview &view,
+                     const char *name, cvp::field_compression compression);
+
+    /*  Saves the escape-time orbits of the Mandelbrot iterations of f.       */
+    template <typename Tfunc>
+    inline void
+    escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                 const char *name);
+
+    /*  Same as escape_field, but for the region of the given viewport.       */
+    template <typename Tfunc, typename Tview>
+    inline void
+    escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                 const Tview &view, const char *name);
+
+    /*  Same as escape_field, with a viewport and a choice of compression.    */
+    template <typename Tfunc, typename Tview>
+    inline void
+    escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                 const Tview &view, const char *name,
+                 cvp::field_compression compression);
+
     /*  Template for creating complex plots with parallelization.             */
     template <typename Tfunc, typename Tcolor>
     inline void
@@ -82,65 +363,60 @@ namespace cvp {
  *          A complex-valued function of a complex variable.                  *
  *      color (Tcolor):                                                       *
  *          Coloring function for converting complex numbers into colors.     *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
  *      name (const char *):                                                  *
  *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
  *  Outputs:                                                                  *
  *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      The image is computed by every available thread if OpenMP is          *
+ *      enabled, and serially otherwise. cfunc and color must be safe to      *
+ *      call from several threads at once.                                    *
  ******************************************************************************/
-template <typename Tfunc, typename Tcolor>
-inline void cvp::complex_plot(Tfunc cfunc, Tcolor color, const char *name)
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::complex_plot(Tfunc cfunc, Tcolor color, const Tview &view,
+                  const char *name, const cvp::render_options &opts)
 {
-    /*  Variables for the x and y coordinates of a given pixel.               */
-    unsigned int x, y;
-
-    /*  Variables for the real and imaginary parts of a given complex number. */
-    double z_re, z_im;
-
-    /*  Variable for the complex number z_re + i*z_im.                        */
-    cvp::complex z;
-
-    /*  Color for the pixel corresponding to z.                               */
-    cvp::color c;
-
-    /*  Variable for the ppm file.                                            */
-    cvp::ppm PPM = cvp::ppm(name);
-
-    /*  Check if the constructor failed.                                      */
-    if (!PPM.fp)
-        return;
-
-    /*  Initialize the ppm file to the default values.                        */
-    PPM.init();
-
-    /*  Loop over the y coordinates of the ppm file.                          */
-    for (y = 0U; y < cvp::setup::ysize; y++)
-    {
-        /*  Compute the y coordinate in the plane corresponding to the pixel. */
-        z_im = cvp::setup::ymax - cvp::setup::pyfactor*y;
+    /*  Kernel for computing the color of f(z) for each pixel.                */
+    const cvp::complex_kernel<Tfunc, Tcolor, Tview> kernel =
+        cvp::complex_kernel<Tfunc, Tcolor, Tview>(cfunc, color, view);
 
-        /*  Loop over the x coordinates of the ppm file.                      */
-        for (x = 0U; x < cvp::setup::xsize; x++)
-        {
-            /*  Compute the corresponding x coordinate.                       */
-            z_re = cvp::setup::xmin + cvp::setup::pxfactor*x;
-
-            /*  Treat the ordered pair (z_re, z_im) as a complex number.      */
-            z = cvp::complex(z_re, z_im);
+    /*  Run the kernel over the image and write the result.                   */
+    cvp::render(kernel, view, name, opts);
+}
+/*  End of cvp::complex_plot.                                                 */
 
-            /*  Get the color corresponding to this pixel.                    */
-            c = color(cfunc(z));
+/*  Creates a plot of a complex function over a viewport, default options.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::complex_plot(Tfunc cfunc, Tcolor color, const Tview &view,
+                  const char *name)
+{
+    cvp::complex_plot(cfunc, color, view, name, cvp::render_options());
+}
 
-            /*  Write the color to the ppm file.                              */
-            c.write(PPM);
-        }
-        /*  End of x for-loop.                                                */
-    }
-    /*  End of y for-loop.                                                    */
+/*  Creates a plot of a complex function over the default viewport.           */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::complex_plot(Tfunc cfunc, Tcolor color, const char *name,
+                  const cvp::render_options &opts)
+{
+    cvp::complex_plot(cfunc, color, cvp::default_viewport(), name, opts);
+}
 
-    /*  Close the ppm file.                                                   */
-    PPM.close();
+/*  Creates a plot of a complex function using the default options.           */
+template <typename Tfunc, typename Tcolor>
+inline void cvp::complex_plot(Tfunc cfunc, Tcolor color, const char *name)
+{
+    cvp::complex_plot(
+        cfunc, color, cvp::default_viewport(), name, cvp::render_options()
+    );
 }
-/*  End of cvp::complex_plot.                                                 */
 
 /******************************************************************************
  *  Function:                                                                 *
@@ -154,73 +430,59 @@ inline void cvp::complex_plot(Tfunc cfunc, Tcolor color, const char *name)
  *          The number of times to call the function.                         *
  *      color (Tcolor):                                                       *
  *          Coloring function for converting complex numbers into colors.     *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
  *      name (const char *):                                                  *
  *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
  *  Outputs:                                                                  *
  *      None.                                                                 *
  ******************************************************************************/
-template <typename Tfunc, typename Tcolor>
+template <typename Tfunc, typename Tcolor, typename Tview>
 inline void
-cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name)
+cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                const Tview &view, const char *name,
+                const cvp::render_options &opts)
 {
-    /*  Variables for the x and y coordinates of a given pixel.               */
-    unsigned int x, y;
-
-    /*  Variable for keeping tracks of the number of iterations performed.    */
-    unsigned int ind;
-
-    /*  Variables for the real and imaginary parts of a given complex number. */
-    double z_re, z_im;
-
-    /*  Variable for the complex number z_re + i*z_im.                        */
-    cvp::complex z;
-
-    /*  Color for the pixel corresponding to z.                               */
-    cvp::color c;
-
-    /*  Variable for the ppm file.                                            */
-    cvp::ppm PPM = cvp::ppm(name);
-
-    /*  Check if the constructor failed.                                      */
-    if (!PPM.fp)
-        return;
+    /*  Kernel for computing the color of f^n(z) for each pixel.              */
+    const cvp::iters_kernel<Tfunc, Tcolor, Tview> kernel =
+        cvp::iters_kernel<Tfunc, Tcolor, Tview>(cfunc, iters, color, view);
 
-    /*  Initialize the ppm file to the default values.                        */
-    PPM.init();
-
-    /*  Loop over the y coordinates of the ppm file.                          */
-    for (y = 0U; y < cvp::setup::ysize; y++)
-    {
-        /*  Compute the y coordinate in the plane corresponding to the pixel. */
-        z_im = cvp::setup::ymax - cvp::setup::pyfactor*y;
-
-        /*  Loop over the x coordinates of the ppm file.                      */
-        for (x = 0U; x < cvp::setup::xsize; x++)
-        {
-            /*  Compute the corresponding x coordinate.                       */
-            z_re = cvp::setup::xmin + cvp::setup::pxfactor*x;
-
-            /*  Treat the ordered pair (z_re, z_im) as a complex number.      */
-            z = cvp::complex(z_re, z_im);
-
-            /*  Repeatedly call the function.                                 */
-            for (ind = 0U; ind < iters; ++ind)
-                z = cfunc(z);
+    /*  Run the kernel over the image and write the result.                   */
+    cvp::render(kernel, view, name, opts);
+}
+/*  End of cvp::iters_plot.                                                   */
 
-            /*  Get the color corresponding to this pixel.                    */
-            c = color(z);
+/*  Plots iterates of a complex function over a viewport, default options.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                const Tview &view, const char *name)
+{
+    cvp::iters_plot(cfunc, iters, color, view, name, cvp::render_options());
+}
 
-            /*  Write the color to the ppm file.                              */
-            c.write(PPM);
-        }
-        /*  End of x for-loop.                                                */
-    }
-    /*  End of y for-loop.                                                    */
+/*  Plots iterates of a complex function over the default viewport.           */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name,
+                const cvp::render_options &opts)
+{
+    cvp::iters_plot(cfunc, iters, color, cvp::default_viewport(), name, opts);
+}
 
-    /*  Close the ppm file.                                                   */
-    PPM.close();
+/*  Plots iterates of a complex function using the default options.           */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name)
+{
+    cvp::iters_plot(
+        cfunc, iters, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
 }
-/*  End of cvp::iters_plot.                                                   */
 
 /******************************************************************************
  *  Function:                                                                 *
@@ -234,157 +496,687 @@ cvp::iters_plot(Tfunc cfunc, unsigned int iters, Tcolor color, const char *name)
  *          The number of times to call the function.                         *
  *      color (Tcolor):                                                       *
  *          Coloring function for converting complex numbers into colors.     *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
  *      name (const char *):                                                  *
  *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
  *  Outputs:                                                                  *
  *      None.                                                                 *
  ******************************************************************************/
-template <typename Tfunc, typename Tcolor>
+template <typename Tfunc, typename Tcolor, typename Tview>
 inline void
-cvp::mandelbrot_plot(Tfunc cfunc, unsigned int iters,
-                     Tcolor color, const char *name)
+cvp::mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                     const Tview &view, const char *name,
+                     const cvp::render_options &opts)
 {
-    /*  Variables for the x and y coordinates of a given pixel.               */
-    unsigned int x, y;
+    /*  Kernel for computing the color of w_n, w_{n+1} = f(w_n) + z.          */
+    const cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview> kernel =
+        cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview>(cfunc, iters, color, view);
 
-    /*  Variable for keeping tracks of the number of iterations performed.    */
-    unsigned int ind;
+    /*  Run the kernel over the image and write the result.                   */
+    cvp::render(kernel, view, name, opts);
+}
+/*  End of cvp::mandelbrot_plot.                                              */
 
-    /*  Variables for the real and imaginary parts of a given complex number. */
-    double z_re, z_im;
+/*  Plots Mandelbrot iterations over a viewport using the default options.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                     const Tview &view, const char *name)
+{
+    cvp::mandelbrot_plot(
+        cfunc, iters, color, view, name, cvp::render_options()
+    );
+}
 
-    /*  Variable for the complex number z_re + i*z_im.                        */
-    cvp::complex z;
+/*  Plots Mandelbrot iterations over the default viewport.                    */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::mandelbrot_plot(Tfunc cfunc, unsigned int iters, Tcolor color,
+                     const char *name, const cvp::render_options &opts)
+{
+    cvp::mandelbrot_plot(
+        cfunc, iters, color, cvp::default_viewport(), name, opts
+    );
+}
 
-    /*  Variable for computing the Mandelbrot iterations.                     */
-    cvp::complex w;
+/*  Plots Mandelbrot iterations using the default options.                    */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::mandelbrot_plot(Tfunc cfunc, unsigned int iters,
+                     Tcolor color, const char *name)
+{
+    cvp::mandelbrot_plot(
+        cfunc, iters, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
+}
 
-    /*  Color for the pixel corresponding to z.                               */
-    cvp::color c;
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::escape_plot                                                      *
+ *  Purpose:                                                                  *
+ *      Creates an escape-time plot of the Mandelbrot iterations of f.        *
+ *  Arguments:                                                                *
+ *      cfunc (Tfunc):                                                        *
+ *          A complex-valued function of a complex variable.                  *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of times to call the function.                 *
+ *      bailout (double):                                                     *
+ *          The orbit of a point has escaped once |w| exceeds this.           *
+ *      color (Tcolor):                                                       *
+ *          Coloring function for converting a cvp::orbit into a color, like  *
+ *          cvp::escape_time_color.                                           *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Iterate w_{n+1} = f(w_n) + z, starting at w_0 = z, until |w_n| is     *
+ *      larger than the bailout radius or iters steps have been taken. The    *
+ *      last value, the number of steps, and whether the point escaped are    *
+ *      given to the colorer. Unlike mandelbrot_plot, escaped points stop     *
+ *      iterating, which is far cheaper for large iteration counts.           *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                 Tcolor color, const Tview &view, const char *name,
+                 const cvp::render_options &opts)
+{
+    /*  Kernel for computing the escape time of each pixel.                   */
+    const cvp::escape_kernel<Tfunc, Tcolor, Tview> kernel =
+        cvp::escape_kernel<Tfunc, Tcolor, Tview>(
+            cfunc, iters, bailout, color, view
+        );
+
+    /*  Run the kernel over the image and write the result.                   */
+    cvp::render(kernel, view, name, opts);
+}
+/*  End of cvp::escape_plot.                                                  */
 
-    /*  Variable for the ppm file.                                            */
-    cvp::ppm PPM = cvp::ppm(name);
+/*  Escape-time plot over a viewport using the default options.               */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                 Tcolor color, const Tview &view, const char *name)
+{
+    cvp::escape_plot(
+        cfunc, iters, bailout, color, view, name, cvp::render_options()
+    );
+}
 
-    /*  Check if the constructor failed.                                      */
-    if (!PPM.fp)
-        return;
+/*  Escape-time plot over the default viewport.                               */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                 Tcolor color, const char *name,
+                 const cvp::render_options &opts)
+{
+    cvp::escape_plot(
+        cfunc, iters, bailout, color, cvp::default_viewport(), name, opts
+    );
+}
 
-    /*  Initialize the ppm file to the default values.                        */
-    PPM.init();
+/*  Escape-time plot using the default viewport and options.                  */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::escape_plot(Tfunc cfunc, unsigned int iters, double bailout,
+                 Tcolor color, const char *name)
+{
+    cvp::escape_plot(
+        cfunc, iters, bailout, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
+}
 
-    /*  Loop over the y coordinates of the ppm file.                          */
-    for (y = 0U; y < cvp::setup::ysize; y++)
-    {
-        /*  Compute the y coordinate in the plane corresponding to the pixel. */
-        z_im = cvp::setup::ymax - cvp::setup::pyfactor*y;
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::convergence_plot                                                 *
+ *  Purpose:                                                                  *
+ *      Creates a plot of the iterations of f that stops each point once its  *
+ *      orbit converges, recording how long it took and where it went.        *
+ *  Arguments:                                                                *
+ *      cfunc (Tfunc):                                                        *
+ *          A complex-valued function of a complex variable, like the Newton  *
+ *          map z - p(z) / p'(z) of a polynomial p.                           *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of times to call the function.                 *
+ *      tolerance (double):                                                   *
+ *          The orbit has converged once |w_{n+1} - w_n| is less than this.   *
+ *      roots (const cvp::attractors &):                                      *
+ *          The known attractors, used to label converged points. May be      *
+ *          empty, in which case every point is labeled -1.                   *
+ *      color (Tcolor):                                                       *
+ *          Coloring function for converting a cvp::convergence into a color, *
+ *          like cvp::convergence_color.                                      *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Iterate w_{n+1} = f(w_n), starting at w_0 = z, until consecutive      *
+ *      values are within the tolerance or iters steps have been taken. The   *
+ *      last value, the number of steps, whether the orbit converged, and the *
+ *      index of the attractor it converged to are given to the colorer.      *
+ *      Unlike iters_plot, most points stop after a few steps.                *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                      const cvp::attractors &roots, Tcolor color,
+                      const Tview &view, const char *name,
+                      const cvp::render_options &opts)
+{
+    /*  Kernel for computing the orbit of each pixel.                         */
+    const cvp::convergence_kernel<Tfunc, Tcolor, Tview> kernel =
+        cvp::convergence_kernel<Tfunc, Tcolor, Tview>(
+            cfunc, iters, tolerance, roots, color, view
+        );
+
+    /*  Run the kernel over the image and write the result.                   */
+    cvp::render(kernel, view, name, opts);
+}
+/*  End of cvp::convergence_plot.                                             */
 
-        /*  Loop over the x coordinates of the ppm file.                      */
-        for (x = 0U; x < cvp::setup::xsize; x++)
-        {
-            /*  Compute the corresponding x coordinate.                       */
-            z_re = cvp::setup::xmin + cvp::setup::pxfactor*x;
+/*  Convergence plot over a viewport using the default options.               */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                      const cvp::attractors &roots, Tcolor color,
+                      const Tview &view, const char *name)
+{
+    cvp::convergence_plot(
+        cfunc, iters, tolerance, roots, color, view, name,
+        cvp::render_options()
+    );
+}
 
-            /*  Treat the ordered pair (z_re, z_im) as a complex number.      */
-            z = cvp::complex(z_re, z_im);
+/*  Convergence plot over the default viewport.                               */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                      const cvp::attractors &roots, Tcolor color,
+                      const char *name, const cvp::render_options &opts)
+{
+    cvp::convergence_plot(
+        cfunc, iters, tolerance, roots, color, cvp::default_viewport(), name,
+        opts
+    );
+}
 
-            /*  Set the first iteration to the input.                         */
-            w = z;
+/*  Convergence plot using the default viewport and options.                  */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::convergence_plot(Tfunc cfunc, unsigned int iters, double tolerance,
+                      const cvp::attractors &roots, Tcolor color,
+                      const char *name)
+{
+    cvp::convergence_plot(
+        cfunc, iters, tolerance, roots, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
+}
 
-            /*  Repeatedly call the function.                                 */
-            for (ind = 0U; ind < iters; ++ind)
-                w = cfunc(w) + z;
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::newton_plot                                                      *
+ *  Purpose:                                                                  *
+ *      Creates a plot of Newton's method for finding the roots of f, without *
+ *      having to work out the Newton map by hand.                            *
+ *  Arguments:                                                                *
+ *      f (Tfunc):                                                            *
+ *          A complex-valued function of a complex variable. It must be a     *
+ *          template so that it can be called on a cvp::dual, like the class  *
+ *          in newton_fractal.cpp.                                            *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of Newton steps.                               *
+ *      tolerance (double):                                                   *
+ *          The orbit has converged once a step is smaller than this.         *
+ *      roots (const cvp::attractors &):                                      *
+ *          The known roots of f, used to label the basins. May be empty.     *
+ *      color (Tcolor):                                                       *
+ *          Coloring function for converting a cvp::convergence into a color. *
+ *          cvp::convergence_color colors the basins of the roots, and        *
+ *          cvp::convergence_speed_color shades by the speed of convergence.  *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      cvp::newton_map evaluates f once on a dual number per step, giving    *
+ *      f(z) and f'(z) together, and returns z - f(z) / f'(z). This is passed *
+ *      to cvp::convergence_plot, so the orbits stop as soon as they settle   *
+ *      and batches are used whenever f can be called on them.                *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                 const cvp::attractors &roots, Tcolor color,
+                 const Tview &view, const char *name,
+                 const cvp::render_options &opts)
+{
+    cvp::convergence_plot(
+        cvp::newton_map<Tfunc>(f), iters, tolerance, roots, color, view,
+        name, opts
+    );
+}
+/*  End of cvp::newton_plot.                                                  */
 
-            /*  Get the color corresponding to this pixel.                    */
-            c = color(w);
+/*  Newton plot over a viewport using the default options.                    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+inline void
+cvp::newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                 const cvp::attractors &roots, Tcolor color,
+                 const Tview &view, const char *name)
+{
+    cvp::newton_plot(
+        f, iters, tolerance, roots, color, view, name, cvp::render_options()
+    );
+}
 
-            /*  Write the color to the ppm file.                              */
-            c.write(PPM);
-        }
-        /*  End of x for-loop.                                                */
-    }
-    /*  End of y for-loop.                                                    */
+/*  Newton plot over the default viewport.                                    */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                 const cvp::attractors &roots, Tcolor color, const char *name,
+                 const cvp::render_options &opts)
+{
+    cvp::newton_plot(
+        f, iters, tolerance, roots, color, cvp::default_viewport(), name, opts
+    );
+}
 
-    /*  Close the ppm file.                                                   */
-    PPM.close();
+/*  Newton plot using the default viewport and options.                       */
+template <typename Tfunc, typename Tcolor>
+inline void
+cvp::newton_plot(Tfunc f, unsigned int iters, double tolerance,
+                 const cvp::attractors &roots, Tcolor color, const char *name)
+{
+    cvp::newton_plot(
+        f, iters, tolerance, roots, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
 }
-/*  End of cvp::mandelbrot_plot.                                              */
 
 /******************************************************************************
  *  Function:                                                                 *
- *      cvp::pcomplex_plot                                                    *
+ *      cvp::root_newton_plot                                                 *
  *  Purpose:                                                                  *
- *      Creates a plot of a complex function using parallel computing.        *
+ *      Creates a plot of Newton's method for a polynomial given by its       *
+ *      roots, coloring each point by the root it converges to.               *
  *  Arguments:                                                                *
- *      cfunc (Tfunc):                                                        *
- *          A complex-valued function of a complex variable.                  *
+ *      poly (const cvp::root_polynomial &):                                  *
+ *          The polynomial, given by its roots.                               *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of Newton steps.                               *
+ *      tolerance (double):                                                   *
+ *          The orbit has converged once a step is smaller than this.         *
  *      color (Tcolor):                                                       *
- *          Coloring function for converting complex numbers into colors.     *
+ *          Coloring function for converting a cvp::convergence into a color, *
+ *          like cvp::convergence_color.                                      *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
  *      name (const char *):                                                  *
  *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
  *  Outputs:                                                                  *
  *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Each step is z - 1 / sum 1 / (z - r_k), see cvp::root_newton. This is *
+ *      passed to cvp::convergence_plot, so pixels are iterated a batch at a  *
+ *      time and stop once they converge. A converged point is labeled by the *
+ *      root with the smallest squared distance to it.                        *
  *  Notes:                                                                    *
- *      Unless you're rendering at a very high resolution image, this         *
- *      function is actually slower than the default.                         *
+ *      The cost of a step grows linearly in the degree, with one division    *
+ *      per root. The coefficients of the polynomial are never needed.        *
  ******************************************************************************/
-template <typename Tfunc, typename Tcolor>
-inline void cvp::pcomplex_plot(Tfunc cfunc, Tcolor color, const char *name)
+template <typename Tcolor, typename Tview>
+inline void
+cvp::root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                      double tolerance, Tcolor color, const Tview &view,
+                      const char *name, const cvp::render_options &opts)
 {
-    /*  Total number of pixels in the PPM file.                               */
-    const unsigned int size = cvp::setup::xsize * cvp::setup::ysize;
+    cvp::convergence_plot(
+        cvp::root_newton(poly), iters, tolerance, poly.basins(), color, view,
+        name, opts
+    );
+}
+/*  End of cvp::root_newton_plot.                                             */
 
-    /*  Index for looping over the pixels of the file.                        */
-    unsigned int n;
+/*  Root Newton plot over a viewport using the default options.               */
+template <typename Tcolor, typename Tview>
+inline void
+cvp::root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                      double tolerance, Tcolor color, const Tview &view,
+                      const char *name)
+{
+    cvp::root_newton_plot(
+        poly, iters, tolerance, color, view, name, cvp::render_options()
+    );
+}
 
-    /*  Color array for the color of each pixel in the PPM.                   */
-    cvp::color *c = static_cast<cvp::color *>(std::malloc(sizeof(*c)*size));
+/*  Root Newton plot over the default viewport.                               */
+template <typename Tcolor>
+inline void
+cvp::root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                      double tolerance, Tcolor color, const char *name,
+                      const cvp::render_options &opts)
+{
+    cvp::root_newton_plot(
+        poly, iters, tolerance, color, cvp::default_viewport(), name, opts
+    );
+}
 
-    /*  Variable for the ppm file.                                            */
-    cvp::ppm PPM = cvp::ppm(name);
+/*  Root Newton plot using the default viewport and options.                  */
+template <typename Tcolor>
+inline void
+cvp::root_newton_plot(const cvp::root_polynomial &poly, unsigned int iters,
+                      double tolerance, Tcolor color, const char *name)
+{
+    cvp::root_newton_plot(
+        poly, iters, tolerance, color, cvp::default_viewport(), name,
+        cvp::render_options()
+    );
+}
 
-    /*  Check if the constructor failed.                                      */
-    if (!PPM.fp)
-    {
-        /*  If malloc failed there is nothing to free. Return to caller.      */
-        if (!c)
-            return;
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::deep_zoom_plot                                                   *
+ *  Purpose:                                                                  *
+ *      Creates an escape-time plot of a deep zoom into the Mandelbrot set.   *
+ *  Arguments:                                                                *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of iterations.                                 *
+ *      bailout (double):                                                     *
+ *          The orbit of a point has escaped once |z| exceeds this.           *
+ *      color (Tcolor):                                                       *
+ *          Coloring function for converting a cvp::orbit into a color, like  *
+ *          cvp::escape_time_color.                                           *
+ *      view (const cvp::deep_viewport &):                                    *
+ *          The center, width, and resolution of the image.                   *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The orbit of the center is computed once in high precision, and then  *
+ *      every pixel is iterated in double precision as an offset from it. See *
+ *      cvp::perturbation_kernel. The result is the same as escape_plot with  *
+ *      cvp::quadratic, at zoom depths where doubles can no longer tell the   *
+ *      pixels apart.                                                         *
+ ******************************************************************************/
+template <typename Tcolor>
+inline void
+cvp::deep_zoom_plot(unsigned int iters, double bailout, Tcolor color,
+                    const cvp::deep_viewport &view, const char *name,
+                    const cvp::render_options &opts)
+{
+    /*  The reference orbit, from Z_0 up to Z_{iters+1}.                      */
+    cvp::complex *reference;
+    unsigned int length;
 
-        /*  Otherwise free the data before returning.                         */
-        std::free(c);
+    if (!view.valid)
         return;
-    }
 
-    /*  Similarly check if malloc failed.                                     */
-    if (!c)
+    reference = static_cast<cvp::complex *>(
+        cvp::memory::aligned_malloc(
+            sizeof(cvp::complex) * (static_cast<std::size_t>(iters) + 2U)
+        )
+    );
+
+    if (!reference)
     {
-        /*  If it did close the PPM file and return.                          */
-        PPM.close();
+        std::puts("ERROR: malloc failed and returned NULL.");
         return;
     }
 
-    /*  Initialize the ppm file to the default values.                        */
-    PPM.init();
+    length = cvp::reference_orbit(view, iters, bailout, reference);
 
-    /*  Loop over the y coordinates of the ppm file.                          */
-#ifdef _OPENMP
-#pragma omp parallel for
-#endif
-    for (n = 0U; n < size; ++n)
+    /*  Scope for the kernel, which must not outlive the reference orbit.     */
     {
-        /*  Compute the y coordinate in the plane corresponding to the pixel. */
-        const unsigned int x = n % cvp::setup::xsize;
-        const unsigned int y = n / cvp::setup::ysize;
-        const double z_im = cvp::setup::ymax - cvp::setup::pyfactor*y;
-        const double z_re = cvp::setup::xmin + cvp::setup::pxfactor*x;
-        cvp::complex z = cvp::complex(z_re, z_im);
-        c[n] = color(cfunc(z));
+        /*  Kernel for computing the escape time of each pixel.               */
+        const cvp::perturbation_kernel<Tcolor> kernel =
+            cvp::perturbation_kernel<Tcolor>(
+                reference, length, iters, bailout, color, view
+            );
+
+        /*  Run the kernel over the image and write the result.               */
+        cvp::render(kernel, view, name, opts);
     }
 
-    for (n = 0U; n < size; ++n)
-        c[n].write(PPM);
+    cvp::memory::aligned_free(reference);
+}
+/*  End of cvp::deep_zoom_plot.                                               */
 
-    /*  Close the ppm file.                                                   */
-    PPM.close();
+/*  Deep zoom using the default options.                                      */
+template <typename Tcolor>
+inline void
+cvp::deep_zoom_plot(unsigned int iters, double bailout, Tcolor color,
+                    const cvp::deep_viewport &view, const char *name)
+{
+    cvp::deep_zoom_plot(iters, bailout, color, view, name,
+                        cvp::render_options());
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::complex_field                                                    *
+ *  Purpose:                                                                  *
+ *      Saves the values of a complex function to a field file.               *
+ *  Arguments:                                                                *
+ *      cfunc (Tfunc):                                                        *
+ *          A complex-valued function of a complex variable.                  *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
+ *      name (const char *):                                                  *
+ *          The name of the output field file.                                *
+ *      compression (cvp::field_compression):                                 *
+ *          How to store the field. Optional, defaults to no_compression.     *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      The field can be turned into an image with cvp::recolor, using any    *
+ *      colorer of complex numbers. This gives exactly the image              *
+ *      complex_plot would have, without evaluating cfunc again.              *
+ ******************************************************************************/
+template <typename Tfunc, typename Tview>
+inline void
+cvp::complex_field(Tfunc cfunc, const Tview &view, const char *name,
+                   cvp::field_compression compression)
+{
+    /*  Kernel for computing f(z) for each pixel, keeping the value.          */
+    const cvp::complex_kernel<Tfunc, cvp::keep_value, Tview> kernel =
+        cvp::complex_kernel<Tfunc, cvp::keep_value, Tview>(
+            cfunc, cvp::keep_value(), view
+        );
+
+    cvp::render_field<cvp::complex>(kernel, view, name, 0U, compression);
+}
+/*  End of cvp::complex_field.                                                */
+
+/*  Saves the values of a complex function over a viewport, uncompressed.     */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::complex_field(Tfunc cfunc, const Tview &view, const char *name)
+{
+    cvp::complex_field(cfunc, view, name, cvp::no_compression);
+}
+
+/*  Saves the values of a complex function over the default viewport.         */
+template <typename Tfunc>
+inline void cvp::complex_field(Tfunc cfunc, const char *name)
+{
+    cvp::complex_field(cfunc, cvp::default_viewport(), name);
+}
+
+/*  Saves the iterates f^n(z) over a viewport, see iters_plot.                */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::iters_field(Tfunc cfunc, unsigned int iters, const Tview &view,
+                 const char *name, cvp::field_compression compression)
+{
+    const cvp::iters_kernel<Tfunc, cvp::keep_value, Tview> kernel =
+        cvp::iters_kernel<Tfunc, cvp::keep_value, Tview>(
+            cfunc, iters, cvp::keep_value(), view
+        );
+
+    cvp::render_field<cvp::complex>(kernel, view, name, iters, compression);
+}
+
+/*  Saves the iterates f^n(z) over a viewport, uncompressed.                  */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::iters_field(Tfunc cfunc, unsigned int iters,
+                 const Tview &view, const char *name)
+{
+    cvp::iters_field(cfunc, iters, view, name, cvp::no_compression);
+}
+
+/*  Saves the iterates f^n(z) over the default viewport.                      */
+template <typename Tfunc>
+inline void
+cvp::iters_field(Tfunc cfunc, unsigned int iters, const char *name)
+{
+    cvp::iters_field(cfunc, iters, cvp::default_viewport(), name);
+}
+
+/*  Saves the Mandelbrot iterates over a viewport, see mandelbrot_plot.       */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::mandelbrot_field(Tfunc cfunc, unsigned int iters, const Tview &view,
+                      const char *name, cvp::field_compression compression)
+{
+    const cvp::mandelbrot_kernel<Tfunc, cvp::keep_value, Tview> kernel =
+        cvp::mandelbrot_kernel<Tfunc, cvp::keep_value, Tview>(
+            cfunc, iters, cvp::keep_value(), view
+        );
+
+    cvp::render_field<cvp::complex>(kernel, view, name, iters, compression);
+}
+
+/*  Saves the Mandelbrot iterates over a viewport, uncompressed.              */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::mandelbrot_field(Tfunc cfunc, unsigned int iters,
+                      const Tview &view, const char *name)
+{
+    cvp::mandelbrot_field(cfunc, iters, view, name, cvp::no_compression);
+}
+
+/*  Saves the Mandelbrot iterates over the default viewport.                  */
+template <typename Tfunc>
+inline void
+cvp::mandelbrot_field(Tfunc cfunc, unsigned int iters, const char *name)
+{
+    cvp::mandelbrot_field(cfunc, iters, cvp::default_viewport(), name);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::escape_field                                                     *
+ *  Purpose:                                                                  *
+ *      Saves the escape-time orbits of the Mandelbrot iterations of f.       *
+ *  Arguments:                                                                *
+ *      cfunc (Tfunc):                                                        *
+ *          A complex-valued function of a complex variable.                  *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of times to call the function.                 *
+ *      bailout (double):                                                     *
+ *          The orbit of a point has escaped once |w| exceeds this.           *
+ *      view (const Tview &):                                                 *
+ *          The region of the plane and the resolution. Optional, defaults to *
+ *          cvp::default_viewport, the values in cvp::setup.                  *
+ *      name (const char *):                                                  *
+ *          The name of the output field file.                                *
+ *      compression (cvp::field_compression):                                 *
+ *          How to store the field. Optional, defaults to no_compression.     *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      For every pixel the last value of the orbit, the iteration count,     *
+ *      and whether it escaped are saved. cvp::recolor then takes any         *
+ *      escape-time colorer, and gives the image escape_plot would have.      *
+ ******************************************************************************/
+template <typename Tfunc, typename Tview>
+inline void
+cvp::escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                  const Tview &view, const char *name,
+                  cvp::field_compression compression)
+{
+    /*  Kernel for the escape time of each pixel, keeping the orbit.          */
+    const cvp::escape_kernel<Tfunc, cvp::keep_orbit, Tview> kernel =
+        cvp::escape_kernel<Tfunc, cvp::keep_orbit, Tview>(
+            cfunc, iters, bailout, cvp::keep_orbit(), view
+        );
+
+    cvp::render_field<cvp::orbit>(kernel, view, name, iters, compression);
+}
+/*  End of cvp::escape_field.                                                 */
+
+/*  Saves the escape-time orbits over a viewport, uncompressed.               */
+template <typename Tfunc, typename Tview>
+inline void
+cvp::escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                  const Tview &view, const char *name)
+{
+    cvp::escape_field(cfunc, iters, bailout, view, name, cvp::no_compression);
+}
+
+/*  Saves the escape-time orbits over the default viewport.                   */
+template <typename Tfunc>
+inline void
+cvp::escape_field(Tfunc cfunc, unsigned int iters, double bailout,
+                  const char *name)
+{
+    cvp::escape_field(cfunc, iters, bailout, cvp::default_viewport(), name);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::pcomplex_plot                                                    *
+ *  Purpose:                                                                  *
+ *      Creates a plot of a complex function using parallel computing.        *
+ *  Arguments:                                                                *
+ *      cfunc (Tfunc):                                                        *
+ *          A complex-valued function of a complex variable.                  *
+ *      color (Tcolor):                                                       *
+ *          Coloring function for converting complex numbers into colors.     *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      complex_plot is now parallelized by the tile engine. This is kept     *
+ *      for backwards compatibility and is identical to complex_plot.         *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor>
+inline void cvp::pcomplex_plot(Tfunc cfunc, Tcolor color, const char *name)
+{
+    cvp::complex_plot(cfunc, color, name);
 }
 /*  End of cvp::pcomplex_plot.                                                */
 
@@ -0,0 +1,119 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a list of known attractors, like the roots found by Newton's *
+ *      method, for labeling the points whose orbits converge.                *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_ATTRACTORS_HPP
+#define CVP_ATTRACTORS_HPP
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  A short list of points that orbits may converge to. Stored inline, so *
+     *  kernels can copy it into every thread without allocating.             */
+    class attractors {
+        public:
+            /*  The most attractors that can be stored.                       */
+            static const unsigned int max_count = 64U;
+
+            /*  The attractors and the number of them.                        */
+            cvp::complex points[max_count];
+            unsigned int count;
+
+            /*  Points within this distance of an attractor belong to it.     */
+            double radius;
+
+            /*  Empty constructor, no attractors.                             */
+            attractors(void);
+
+            /*  Constructor from an array of n points and the radius.         */
+            attractors(const cvp::complex *p, unsigned int n, double r);
+
+            /*  Adds a point to the list. Ignored if the list is full.        */
+            inline void add(const cvp::complex &z);
+
+            /*  The index of the attractor nearest to z, or -1 if none of     *
+             *  them are within the radius.                                   */
+            inline int find(const cvp::complex &z) const;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, an empty list.                                         */
+cvp::attractors::attractors(void)
+    : count(0U), radius(1.0E-6)
+{
+    return;
+}
+
+/*  Constructor from an array of points, keeping at most max_count of them.   */
+cvp::attractors::attractors(const cvp::complex *p, unsigned int n, double r)
+    : count(0U), radius(r)
+{
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+        add(p[k]);
+}
+
+/*  Adds a point to the end of the list.                                      */
+inline void cvp::attractors::add(const cvp::complex &z)
+{
+    if (count == max_count)
+        return;
+
+    points[count] = z;
+    ++count;
+}
+
+/*  Linear search over the squared distances. The lists are short, and this   *
+ *  runs once per pixel. With an infinite radius this labels every point by   *
+ *  its nearest attractor.                                                    */
+inline int cvp::attractors::find(const cvp::complex &z) const
+{
+    unsigned int k;
+    int index = -1;
+    double best_sq = radius*radius;
+
+    for (k = 0U; k < count; ++k)
+    {
+        const double dist_sq = (z - points[k]).abssq();
+
+        if (dist_sq < best_sq)
+        {
+            best_sq = dist_sq;
+            index = static_cast<int>(k);
+        }
+    }
+
+    return index;
+}
+
+#endif
+/*  End of include guard.                                                     */
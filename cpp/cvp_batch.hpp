@@ -0,0 +1,631 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a batch of complex numbers stored as a structure of arrays,  *
+ *      so functions written for cvp::complex can evaluate several pixels at  *
+ *      once using the vector registers of the CPU.                           *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_BATCH_HPP
+#define CVP_BATCH_HPP
+
+/*  std::declval, used to detect functions that can be called on batches.     */
+#include <utility>
+
+/*  std::true_type and std::false_type, used for tag dispatch.                */
+#include <type_traits>
+
+/*  sqrt and atan2 found here.                                                */
+#include <cmath>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  The number of lanes in a batch. One AVX-512 register holds 8 doubles. An  *
+ *  AVX register holds 4 and an SSE2 register holds 2, for these a batch of 4 *
+ *  keeps one or two independent vector operations in flight. This may be     *
+ *  overridden by compiling with -DCVP_BATCH_WIDTH=n, for any n > 0. Widths   *
+ *  that are not powers of two work, but leave part of a register unused.     */
+#ifndef CVP_BATCH_WIDTH
+#if defined(__AVX512F__)
+#define CVP_BATCH_WIDTH 8
+#else
+#define CVP_BATCH_WIDTH 4
+#endif
+#endif
+
+/*  Loops over the lanes that mask some of them out use selects on 64-bit     *
+ *  integers. These are only vectorized well with AVX2, so only then do the   *
+ *  kernels ask for them with "omp simd". Otherwise scalar code is faster.    */
+#if defined(_OPENMP) && defined(__AVX2__)
+#define CVP_SIMD_MASKS 1
+#else
+#define CVP_SIMD_MASKS 0
+#endif
+
+/*  Namespace for the project. "complex visual plots."                        */
+namespace cvp {
+
+    /*  The default number of lanes in a batch, chosen at build time.         */
+    static const unsigned int batch_width = CVP_BATCH_WIDTH;
+
+    /*  The smallest power of two that is at least n. alignas only takes      *
+     *  powers of two, so a batch of 3 or 6 lanes is aligned as 4 or 8 are.   */
+    constexpr unsigned int bit_ceil(unsigned int n, unsigned int p = 1U)
+    {
+        return (p >= n ? p : cvp::bit_ceil(n, 2U * p));
+    }
+
+    /*  Class for N complex numbers stored as a structure of arrays. The      *
+     *  arithmetic is written as fixed-length loops over the lanes, which the *
+     *  compiler turns into vector instructions. Each lane is computed with   *
+     *  the same formula as cvp::complex, so the results are identical.       */
+    template <unsigned int N = cvp::batch_width>
+    class complex_batch {
+        public:
+            /*  The real and imaginary parts of each lane.                    */
+            alignas(sizeof(double) * cvp::bit_ceil(N)) double real[N];
+            alignas(sizeof(double) * cvp::bit_ceil(N)) double imag[N];
+
+            /*  Empty constructor.                                            */
+            complex_batch(void);
+
+            /*  Constructor setting every lane to the same complex number.    */
+            explicit complex_batch(const cvp::complex &z);
+
+            /*  Returns the k^th lane as a complex number.                    */
+            inline cvp::complex get(unsigned int k) const;
+
+            /*  Sets the k^th lane to a complex number.                       */
+            inline void set(unsigned int k, const cvp::complex &z);
+
+            /*  Computes the complex conjugate of every lane.                 */
+            inline complex_batch conjugate(void) const;
+
+            /*  Computes the complex conjugate and stores the result in z.    */
+            inline void conjugateself(void);
+
+            /*  Method for computing the inverse of every lane.               */
+            inline complex_batch rcpr(void) const;
+
+            /*  Method for inverting every lane and storing the result.       */
+            inline void invert(void);
+
+            /*  Computes the square of the modulus of every lane.             */
+            inline void abssq(double *out) const;
+
+            /*  Computes the modulus of every lane.                           */
+            inline void abs(double *out) const;
+
+            /*  Computes the argument of every lane.                          */
+            inline void arg(double *out) const;
+    };
+    /*  End of "complex_batch" class.                                         */
+
+    /*  Tells whether a function can be called on a batch and returns one.    *
+     *  Derives from std::true_type if so, and std::false_type otherwise.     */
+    template <typename Tfunc, unsigned int N = cvp::batch_width>
+    class is_batch_callable {
+        private:
+            template <typename T>
+            static std::true_type test(
+                typename std::enable_if<
+                    std::is_convertible<
+                        decltype(std::declval<const T &>()(
+                            std::declval<const cvp::complex_batch<N> &>()
+                        )),
+                        cvp::complex_batch<N>
+                    >::value, int
+                >::type
+            );
+
+            template <typename T>
+            static std::false_type test(...);
+
+        public:
+            typedef decltype(test<Tfunc>(0)) type;
+            static const bool value = type::value;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, simply return.                                         */
+template <unsigned int N>
+cvp::complex_batch<N>::complex_batch(void)
+{
+    return;
+}
+
+/*  Constructor setting every lane to the same complex number.                */
+template <unsigned int N>
+cvp::complex_batch<N>::complex_batch(const cvp::complex &z)
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        real[k] = z.real;
+        imag[k] = z.imag;
+    }
+}
+
+/*  Returns the k^th lane as a complex number.                                */
+template <unsigned int N>
+inline cvp::complex cvp::complex_batch<N>::get(unsigned int k) const
+{
+    return cvp::complex(real[k], imag[k]);
+}
+
+/*  Sets the k^th lane to a complex number.                                   */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::set(unsigned int k, const cvp::complex &z)
+{
+    real[k] = z.real;
+    imag[k] = z.imag;
+}
+/*  Complex addition. This is performed component-wise.                       */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator + (const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] + w.real[k];
+        out.imag[k] = z.imag[k] + w.imag[k];
+    }
+
+    return out;
+}
+
+/*  Addition of a batch and a complex number, component-wise.                 */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator + (const cvp::complex_batch<N> &z, const cvp::complex &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] + w.real;
+        out.imag[k] = z.imag[k] + w.imag;
+    }
+
+    return out;
+}
+
+/*  Addition of a complex number and a batch, component-wise.                 */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator + (const cvp::complex &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real + w.real[k];
+        out.imag[k] = z.imag + w.imag[k];
+    }
+
+    return out;
+}
+
+/*  Addition of a real number and a batch. Add to the real parts.             */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator + (const cvp::complex_batch<N> &z, double a)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] + a;
+        out.imag[k] = z.imag[k];
+    }
+
+    return out;
+}
+
+/*  Addition of a real number and a batch. Add to the real parts.             */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator + (double a, const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = a + z.real[k];
+        out.imag[k] = z.imag[k];
+    }
+
+    return out;
+}
+
+/*  Subtraction of complex numbers. Subtract component-wise.                  */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator - (const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] - w.real[k];
+        out.imag[k] = z.imag[k] - w.imag[k];
+    }
+
+    return out;
+}
+
+/*  Subtraction of a batch and a complex number, component-wise.              */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator - (const cvp::complex_batch<N> &z, const cvp::complex &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] - w.real;
+        out.imag[k] = z.imag[k] - w.imag;
+    }
+
+    return out;
+}
+
+/*  Subtraction of a complex number and a batch, component-wise.              */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator - (const cvp::complex &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real - w.real[k];
+        out.imag[k] = z.imag - w.imag[k];
+    }
+
+    return out;
+}
+
+/*  Subtraction of a batch and a real number. Subtract real parts.            */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator - (const cvp::complex_batch<N> &z, double a)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] - a;
+        out.imag[k] = z.imag[k];
+    }
+
+    return out;
+}
+
+/*  Subtraction of a real number and a batch. Negate the batch.               */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator - (double a, const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = a - z.real[k];
+        out.imag[k] = -z.imag[k];
+    }
+
+    return out;
+}
+
+/*  Multiplication of complex numbers. Compute using i^2 = -1.                */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator * (const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k]*w.real[k] - z.imag[k]*w.imag[k];
+        out.imag[k] = z.real[k]*w.imag[k] + z.imag[k]*w.real[k];
+    }
+
+    return out;
+}
+
+/*  Multiplication of a batch and a complex number.                           */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator * (const cvp::complex_batch<N> &z, const cvp::complex &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k]*w.real - z.imag[k]*w.imag;
+        out.imag[k] = z.real[k]*w.imag + z.imag[k]*w.real;
+    }
+
+    return out;
+}
+
+/*  Multiplication of a complex number and a batch.                           */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator * (const cvp::complex &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real*w.real[k] - z.imag*w.imag[k];
+        out.imag[k] = z.real*w.imag[k] + z.imag*w.real[k];
+    }
+
+    return out;
+}
+
+/*  Multiplication of a real number and a batch. Scale the lanes.             */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator * (double a, const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = a*z.real[k];
+        out.imag[k] = a*z.imag[k];
+    }
+
+    return out;
+}
+
+/*  Multiplication of a batch and a real number. Scale the lanes.             */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator * (const cvp::complex_batch<N> &z, double a)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k]*a;
+        out.imag[k] = z.imag[k]*a;
+    }
+
+    return out;
+}
+
+/*  Division of complex numbers. Use z^{-1} = conj(z) / |z|^2.                */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator / (const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (w.real[k]*w.real[k] + w.imag[k]*w.imag[k]);
+        const double real = z.real[k]*w.real[k] + z.imag[k]*w.imag[k];
+        const double imag = z.imag[k]*w.real[k] - z.real[k]*w.imag[k];
+        out.real[k] = real*denom;
+        out.imag[k] = imag*denom;
+    }
+
+    return out;
+}
+
+/*  Division of a batch by a complex number.                                  */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator / (const cvp::complex_batch<N> &z, const cvp::complex &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (w.real*w.real + w.imag*w.imag);
+        const double real = z.real[k]*w.real + z.imag[k]*w.imag;
+        const double imag = z.imag[k]*w.real - z.real[k]*w.imag;
+        out.real[k] = real*denom;
+        out.imag[k] = imag*denom;
+    }
+
+    return out;
+}
+
+/*  Division of a complex number by a batch.                                  */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator / (const cvp::complex &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (w.real[k]*w.real[k] + w.imag[k]*w.imag[k]);
+        const double real = z.real*w.real[k] + z.imag*w.imag[k];
+        const double imag = z.imag*w.real[k] - z.real*w.imag[k];
+        out.real[k] = real*denom;
+        out.imag[k] = imag*denom;
+    }
+
+    return out;
+}
+
+/*  Division of a batch and a real number. Divide component-wise.             */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator / (const cvp::complex_batch<N> &z, double a)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    /*  Compute the reciprocal and scale the real and imaginary parts.        */
+    const double rcpr = 1.0 / a;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = z.real[k] * rcpr;
+        out.imag[k] = z.imag[k] * rcpr;
+    }
+
+    return out;
+}
+
+/*  Division of a real number by a batch. Compute z^{-1} and scale.           */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+operator / (double a, const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (z.real[k]*z.real[k] + z.imag[k]*z.imag[k]);
+        out.real[k] = a*z.real[k]*denom;
+        out.imag[k] = -a*z.imag[k]*denom;
+    }
+
+    return out;
+}
+
+/*  Computes the complex conjugate of every lane.                             */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::complex_batch<N>::conjugate(void) const
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    /*  The complex conjugate negates the imaginary part.                     */
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = real[k];
+        out.imag[k] = -imag[k];
+    }
+
+    return out;
+}
+
+/*  Conjugates every lane and stores the result in itself.                    */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::conjugateself(void)
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        imag[k] = -imag[k];
+}
+
+/*  Computes the reciprocal, or inverse, of every lane.                       */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::complex_batch<N>::rcpr(void) const
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    /*  The inverse can be computed via conj(z) / |z|^2.                      */
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (real[k]*real[k] + imag[k]*imag[k]);
+        out.real[k] = real[k]*denom;
+        out.imag[k] = -imag[k]*denom;
+    }
+
+    return out;
+}
+
+/*  Inverts every lane and stores the result in itself.                       */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::invert(void)
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double denom = 1.0 / (real[k]*real[k] + imag[k]*imag[k]);
+        real[k] *= denom;
+        imag[k] *= -denom;
+    }
+}
+
+/*  Computes the square of the modulus of every lane.                         */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::abssq(double *out) const
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out[k] = real[k]*real[k] + imag[k]*imag[k];
+}
+
+/*  Computes the modulus of every lane.                                       */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::abs(double *out) const
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out[k] = std::sqrt(real[k]*real[k] + imag[k]*imag[k]);
+}
+
+/*  Computes the argument of every lane. atan2 does not vectorize, this is    *
+ *  provided for completeness and runs one lane at a time.                    */
+template <unsigned int N>
+inline void cvp::complex_batch<N>::arg(double *out) const
+{
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out[k] = std::atan2(imag[k], real[k]);
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,320 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a fixed-point real number with hundreds of bits of precision *
+ *      for computing the reference orbits of deep zooms.                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_BIGFLOAT_HPP
+#define CVP_BIGFLOAT_HPP
+
+/*  ldexp and floor found here.                                               */
+#include <cmath>
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Real numbers with |x| < 2^32 and a fixed number of bits after the     *
+     *  point. The magnitude is stored in base 2^32 with the integer part in  *
+     *  limbs[0] and the fraction in limbs[1], ..., limbs[size - 1], most     *
+     *  significant first. Products must also be below 2^32, so factors are   *
+     *  below 2^16. cvp::reference_orbit stops well before that.              */
+    class bigfloat {
+        public:
+            /*  The largest number of limbs. 64 limbs is 2016 bits after the  *
+             *  point, far below the smallest double.                         */
+            static const unsigned int max_limbs = 64U;
+
+            /*  The digits of the magnitude in base 2^32.                     */
+            unsigned int limbs[max_limbs];
+
+            /*  The number of limbs in use, and the sign.                     */
+            unsigned int size;
+            bool negative;
+
+            /*  Empty constructor, zero with a single limb.                   */
+            bigfloat(void);
+
+            /*  Constructor from a double and the number of limbs. Exact if   *
+             *  there are enough limbs for every bit of the double.           */
+            bigfloat(double x, unsigned int n);
+
+            /*  Reads a decimal number like "-0.7436438870371587". Returns    *
+             *  false if the string is not a decimal number.                  */
+            inline bool parse(const char *str, unsigned int n);
+
+            /*  Rounds to the nearest double (truncates, in fact).            */
+            inline double to_double(void) const;
+
+            /*  Compares the magnitudes of two numbers of the same size.      */
+            inline int compare_abs(const bigfloat &x) const;
+    };
+
+    /*  Number of limbs for computing at the scale of a given pixel size.     *
+     *  This is the bits of the pixel size, plus 64 for the iteration.        */
+    inline unsigned int bigfloat_limbs(double pixel);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, the number zero.                                       */
+cvp::bigfloat::bigfloat(void)
+    : size(1U), negative(false)
+{
+    limbs[0] = 0U;
+}
+
+/*  Constructor from a double. The limbs are peeled off 32 bits at a time,    *
+ *  which is exact since scaling by 2^32 and removing the floor are exact.    */
+cvp::bigfloat::bigfloat(double x, unsigned int n)
+    : size(n < 1U ? 1U : (n > max_limbs ? max_limbs : n)), negative(x < 0.0)
+{
+    unsigned int k;
+    double y = (negative ? -x : x);
+
+    for (k = 0U; k < size; ++k)
+    {
+        const double digit = std::floor(y);
+        limbs[k] = static_cast<unsigned int>(digit);
+        y = std::ldexp(y - digit, 32);
+    }
+}
+
+/*  Parses a decimal number. The fraction is built from its last digit to its *
+ *  first with f = (f + d) / 10, using long division by 10 on the limbs.      */
+inline bool cvp::bigfloat::parse(const char *str, unsigned int n)
+{
+    /*  Variables for the integer part, the digits, and the limbs.            */
+    unsigned long long integer = 0ULL;
+    const char *point, *end;
+    unsigned int k;
+
+    size = (n < 1U ? 1U : (n > max_limbs ? max_limbs : n));
+    negative = false;
+
+    for (k = 0U; k < size; ++k)
+        limbs[k] = 0U;
+
+    if (*str == '-' || *str == '+')
+    {
+        negative = (*str == '-');
+        ++str;
+    }
+
+    /*  There must be at least one digit before or after the point.           */
+    if (!(*str >= '0' && *str <= '9') &&
+        !(*str == '.' && str[1] >= '0' && str[1] <= '9'))
+        return false;
+
+    /*  The integer part, which must fit in one limb.                         */
+    for (point = str; *point >= '0' && *point <= '9'; ++point)
+    {
+        integer = 10ULL*integer + static_cast<unsigned long long>(*point - '0');
+
+        if (integer > 0xFFFFFFFFULL)
+            return false;
+    }
+
+    /*  The fraction, if there is one.                                        */
+    end = point;
+
+    if (*point == '.')
+        for (end = point + 1; *end >= '0' && *end <= '9'; ++end);
+
+    /*  Anything left over is not part of a decimal number.                   */
+    if (*end != '\0')
+        return false;
+
+    /*  Build the fraction from the last digit back to the point.             */
+    while (end > point + 1)
+    {
+        unsigned long long remainder = 0ULL;
+        --end;
+
+        limbs[0] = static_cast<unsigned int>(*end - '0');
+
+        for (k = 0U; k < size; ++k)
+        {
+            const unsigned long long current = (remainder << 32) | limbs[k];
+            limbs[k] = static_cast<unsigned int>(current / 10ULL);
+            remainder = current % 10ULL;
+        }
+    }
+
+    limbs[0] = static_cast<unsigned int>(integer);
+    return true;
+}
+
+/*  Converts to a double using the first three non-zero limbs.                */
+inline double cvp::bigfloat::to_double(void) const
+{
+    unsigned int k, first = 0U;
+    double out = 0.0;
+
+    while (first < size && limbs[first] == 0U)
+        ++first;
+
+    for (k = first; k < size && k < first + 3U; ++k)
+        out += std::ldexp(static_cast<double>(limbs[k]),
+                          -32 * static_cast<int>(k));
+
+    return (negative ? -out : out);
+}
+
+/*  Compares |this| with |x|. Returns -1, 0, or 1.                            */
+inline int cvp::bigfloat::compare_abs(const cvp::bigfloat &x) const
+{
+    unsigned int k;
+
+    for (k = 0U; k < size; ++k)
+    {
+        if (limbs[k] != x.limbs[k])
+            return (limbs[k] < x.limbs[k] ? -1 : 1);
+    }
+
+    return 0;
+}
+
+/*  Bits of the pixel size plus 64 guard bits, 32 bits per limb, plus the     *
+ *  limb for the integer part.                                                */
+inline unsigned int cvp::bigfloat_limbs(double pixel)
+{
+    int exponent;
+    unsigned int n;
+
+    std::frexp(pixel, &exponent);
+
+    if (exponent > 0)
+        exponent = 0;
+
+    n = 2U + (static_cast<unsigned int>(-exponent) + 64U) / 32U;
+    return (n > cvp::bigfloat::max_limbs ? cvp::bigfloat::max_limbs : n);
+}
+
+/*  Adds two numbers with the same number of limbs. Signs are handled by      *
+ *  adding or subtracting the magnitudes.                                     */
+inline cvp::bigfloat operator + (const cvp::bigfloat &x,
+                                 const cvp::bigfloat &y)
+{
+    cvp::bigfloat out;
+    unsigned int k;
+    out.size = x.size;
+
+    /*  Same sign, add the magnitudes from the least significant limb up.     */
+    if (x.negative == y.negative)
+    {
+        unsigned long long carry = 0ULL;
+
+        for (k = x.size; k > 0U; --k)
+        {
+            const unsigned long long sum =
+                static_cast<unsigned long long>(x.limbs[k - 1U]) +
+                y.limbs[k - 1U] + carry;
+
+            out.limbs[k - 1U] = static_cast<unsigned int>(sum);
+            carry = sum >> 32;
+        }
+
+        out.negative = x.negative;
+    }
+
+    /*  Opposite signs, subtract the smaller magnitude from the larger one.   */
+    else
+    {
+        const bool x_larger = (x.compare_abs(y) >= 0);
+        const cvp::bigfloat &big = (x_larger ? x : y);
+        const cvp::bigfloat &small = (x_larger ? y : x);
+        long long borrow = 0LL;
+
+        for (k = x.size; k > 0U; --k)
+        {
+            long long diff =
+                static_cast<long long>(big.limbs[k - 1U]) -
+                static_cast<long long>(small.limbs[k - 1U]) - borrow;
+
+            borrow = (diff < 0LL ? 1LL : 0LL);
+            diff += (borrow ? 0x100000000LL : 0LL);
+            out.limbs[k - 1U] = static_cast<unsigned int>(diff);
+        }
+
+        out.negative = big.negative;
+    }
+
+    return out;
+}
+
+/*  Subtraction is addition with the sign of y flipped.                       */
+inline cvp::bigfloat operator - (const cvp::bigfloat &x,
+                                 const cvp::bigfloat &y)
+{
+    cvp::bigfloat minus_y = y;
+    minus_y.negative = !y.negative;
+    return x + minus_y;
+}
+
+/*  Multiplies two numbers with the same number of limbs. The magnitudes are  *
+ *  multiplied as integers with the schoolbook method, least significant limb *
+ *  first, and the product is truncated back to the same number of limbs.     */
+inline cvp::bigfloat operator * (const cvp::bigfloat &x,
+                                 const cvp::bigfloat &y)
+{
+    /*  The full product, least significant limb first.                       */
+    unsigned int product[2U * cvp::bigfloat::max_limbs];
+    cvp::bigfloat out;
+    unsigned int i, j;
+    const unsigned int n = x.size;
+
+    for (i = 0U; i < 2U*n; ++i)
+        product[i] = 0U;
+
+    /*  Limb i of x, counting from the least significant, is x.limbs[n-1-i].  */
+    for (i = 0U; i < n; ++i)
+    {
+        unsigned long long carry = 0ULL;
+        const unsigned long long xi = x.limbs[n - 1U - i];
+
+        for (j = 0U; j < n; ++j)
+        {
+            const unsigned long long current =
+                xi * y.limbs[n - 1U - j] + product[i + j] + carry;
+
+            product[i + j] = static_cast<unsigned int>(current);
+            carry = current >> 32;
+        }
+
+        product[i + n] = static_cast<unsigned int>(carry);
+    }
+
+    /*  Both inputs have n - 1 fractional limbs, so the product has 2n - 2.   *
+     *  Keep the integer limb and the top n - 1 fractional limbs.             */
+    out.size = n;
+    out.negative = (x.negative != y.negative);
+
+    for (i = 0U; i < n; ++i)
+        out.limbs[i] = product[2U*n - 2U - i];
+
+    return out;
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -52,7 +52,7 @@ namespace cvp {
             /*  Write function, writes the color to a PPM file.               */
             inline void write(FILE *fp) const;
 
-            /*  Write function, writes directly to a PPM struct.              */
+            /*  Write function, appends the color to a PPM's buffer.          */
             inline void write(cvp::ppm &PPM) const;
 
             /*  Scale a color by a positive real number. Used for darkening.  */
@@ -66,8 +66,15 @@ namespace cvp {
 
             /*  Operator for adding colors.                                   */
             inline void operator += (const cvp::color &c);
+
+            /*  Operator for comparing colors. Equal if every channel is.     */
+            inline bool operator == (const cvp::color &c) const;
     };
 
+    /*  Arrays of colors are written to files as packed RGB bytes. Make sure  *
+     *  the compiler did not pad the class.                                   */
+    static_assert(sizeof(color) == 3U, "cvp::color must be 3 packed bytes");
+
     /*  Constant colors that are worth having.                                */
     namespace colors {
         inline color white(double t);
@@ -103,10 +110,11 @@ inline void cvp::color::write(FILE *fp) const
     std::fputc(int(blue), fp);
 }
 
-/*  Function for writing directly to a PPM struct.                            */
+/*  Function for writing to a PPM struct. Appends to the PPM's buffer, which  *
+ *  is written to the file in large blocks instead of byte by byte.           */
 inline void cvp::color::write(cvp::ppm &PPM) const
 {
-    write(PPM.fp);
+    PPM.put(red, green, blue);
 }
 
 /*  Scale a color by a positive real number. Used for darkening.              */
@@ -165,6 +173,12 @@ inline void cvp::color::operator += (const cvp::color &c)
     blue = static_cast<unsigned char>(z);
 }
 
+/*  Two colors are equal if their red, green, and blue values are.            */
+inline bool cvp::color::operator == (const cvp::color &c) const
+{
+    return (red == c.red) && (green == c.green) && (blue == c.blue);
+}
+
 /*  Function for creating a black-to-white gradient.                          */
 inline cvp::color cvp::colors::white(double t)
 {
@@ -28,19 +28,29 @@
 #ifndef CVP_COLORERS_HPP
 #define CVP_COLORERS_HPP
 
-/*  atan function provided here.                                              */
+/*  log, log2, fmod, and exp provided here.                                   */
 #include <cmath>
 
 /*  Complex class defined here.                                               */
 #include "cvp_complex.hpp"
 
+/*  Class for the result of iterating a point, used by escape-time plots.     */
+#include "cvp_orbit.hpp"
+
 /*  Class for working with colors in RGB format.                              */
 #include "cvp_color.hpp"
 
+/*  Gradients stored as lookup tables, and the rainbow wheel.                 */
+#include "cvp_palette.hpp"
+
 /*  Namespace for this mini-project. "Complex Visual Plots."                  */
 namespace cvp {
     inline cvp::color color_from_complex(cvp::complex z);
     inline cvp::color color_wheel_from_complex(cvp::complex z);
+    inline cvp::color color_wheel_gradient(double val);
+    inline cvp::color escape_time_color(const cvp::orbit &o);
+    inline cvp::color convergence_color(const cvp::convergence &c);
+    inline cvp::color convergence_speed_color(const cvp::convergence &c);
 }
 
 /******************************************************************************
@@ -58,73 +68,15 @@ namespace cvp {
  *  Method:                                                                   *
  *      Create a rainbow gradient red-to-blue from the argument of the input  *
  *      and then scale this by the magnitude.                                 *
+ *  Notes:                                                                    *
+ *      The gradient and the scale factor are looked up from tables, see      *
+ *      cvp_palette.hpp. The argument spans the whole gradient. It used to be *
+ *      scaled by 1023 / (2 / pi), which ran far past the end of it.          *
  ******************************************************************************/
 inline cvp::color cvp::color_from_complex(cvp::complex z)
 {
-    /*  There are 1024 possible colors given by the gradient. This scale      *
-     *  factor helps normalize the argument.                                  */
-    const double gradient_factor = 1023.0 / M_2_PI;
-
-    /*  Compute the argument and modulus of the input complex number.         */
-    const double arg_z = z.arg();
-    const double abs_z = z.abs();
-
-    /*  Scale the argument from (-pi, pi) to (0, 1023).                       */
-    double val = (arg_z + M_PI) * gradient_factor;
-
-    /*  The atan function compresses the intensity to prohibit arbitrarily    *
-     *  bright points. This allows the drawing to fit into an actual PPM.     */
-    const double t = std::atan(5.0*abs_z) / M_PI_2;
-
-    /*  Lastly, a color for the output.                                       */
-    cvp::color out;
-
-    /*  For 0 <= val < 256 transition from blue to cyan.                      */
-    if (val < 256.0)
-    {
-        out.red = 0x00U;
-        out.green = static_cast<unsigned char>(val);
-        out.blue = 0xFFU;
-    }
-
-    /*  For 256 <= val < 512 transition from cyan to green.                   */
-    else if (val < 512.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 256.0;
-
-        /*  Transition from cyan to green.                                    */
-        out.red = 0x00U;
-        out.green = 0xFFU;
-        out.blue = static_cast<unsigned char>(256.0 - val);
-    }
-
-    /*  For 512 <= val < 768 transition from green to yellow.                 */
-    else if (val < 768.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 512.0;
-
-        /*  Transition from green to yellow.                                  */
-        out.red = static_cast<unsigned char>(val);
-        out.green = 0xFFU;
-        out.blue = 0x00U;
-    }
-
-    /*  For 768 <= val < 1024 transition from yellow to red.                  */
-    else
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 768.0;
-
-        /*  Transition from yellow to red.                                    */
-        out.red = 0xFFU;
-        out.green = static_cast<unsigned char>(256.0 - val);
-        out.blue = 0x00U;
-    }
-
-    /*  Scale the color by the atan factor and return.                        */
-    return out * t;
+    /*  The rainbow palette does the scaling and both table lookups.          */
+    return cvp::palettes::rainbow()(z);
 }
 /*  End of color_from_complex.                                                */
 
@@ -143,99 +95,184 @@ inline cvp::color cvp::color_from_complex(cvp::complex z)
  *  Method:                                                                   *
  *      Create a rainbow gradient red-to-blue from the argument of the input  *
  *      and then scale this by the magnitude.                                 *
+ *  Notes:                                                                    *
+ *      Both the gradient and the atan(5|z|) scale factor are looked up from  *
+ *      tables, see cvp_palette.hpp.                                          *
  ******************************************************************************/
 inline cvp::color cvp::color_wheel_from_complex(cvp::complex z)
 {
-    /*  There are 1535 possible colors given by the gradient. This scale      *
-     *  factor helps normalize the argument.                                  */
-    const double gradient_factor = 1535.0 / (2.0 * M_PI);
+    /*  The wheel palette does the scaling and both table lookups.            */
+    return cvp::palettes::wheel()(z);
+}
+/*  End of color_wheel_from_complex.                                          */
 
-    /*  Compute the argument and modulus of the input complex number.         */
-    const double arg_z = z.arg();
-    const double abs_z = z.abs();
+/******************************************************************************
+ *  Function:                                                                 *
+ *      color_wheel_gradient                                                  *
+ *  Purpose:                                                                  *
+ *      Creates an RGB color from a point on a rainbow color wheel.           *
+ *  Arguments:                                                                *
+ *      val (double):                                                         *
+ *          A real number between 0 and 1536.                                 *
+ *  Outputs:                                                                  *
+ *      c (cvp::color):                                                       *
+ *          The color at val on the wheel, at full intensity.                 *
+ *  Method:                                                                   *
+ *      The wheel is split into six segments of length 256, each moving one   *
+ *      of the channels up or down: blue, cyan, green, yellow, red, magenta,  *
+ *      and back to blue. It is precomputed once, and val is truncated and    *
+ *      used as an index into the table.                                      *
+ ******************************************************************************/
+inline cvp::color cvp::color_wheel_gradient(double val)
+{
+    return cvp::palettes::wheel().at(val);
+}
+/*  End of color_wheel_gradient.                                              */
 
-    /*  Scale the argument from (-pi, pi) to (0, 1535).                       */
-    double val = (arg_z + M_PI) * gradient_factor;
+/******************************************************************************
+ *  Function:                                                                 *
+ *      escape_time_color                                                     *
+ *  Purpose:                                                                  *
+ *      Creates an RGB color from the orbit of a point in escape-time plots.  *
+ *  Arguments:                                                                *
+ *      o (const cvp::orbit &):                                               *
+ *          The end of the orbit of a point.                                  *
+ *  Outputs:                                                                  *
+ *      c (cvp::color):                                                       *
+ *          Black for points that never escaped, and otherwise a color from   *
+ *          the number of iterations it took to escape.                       *
+ *  Method:                                                                   *
+ *      The smooth iteration count n + 1 - log2(log|z|) removes the bands     *
+ *      between consecutive integer counts for quadratic maps. This is then   *
+ *      wrapped around the color wheel.                                       *
+ *  Notes:                                                                    *
+ *      The smoothing needs |z| > e when the orbit escapes. For smaller       *
+ *      bailout radii the integer count is used instead.                      *
+ ******************************************************************************/
+inline cvp::color cvp::escape_time_color(const cvp::orbit &o)
+{
+    /*  The number of steps of the color wheel per iteration.                 */
+    const double steps_per_iter = 32.0;
 
-    /*  The atan function compresses the intensity to prohibit arbitrarily    *
-     *  bright points. This allows the drawing to fit into an actual PPM.     */
-    const double t = std::atan(5.0*abs_z) / (0.5 * M_PI);
+    /*  The iteration count, smoothed if possible.                            */
+    double mu = static_cast<double>(o.iters);
 
-    /*  Lastly, a color for the output.                                       */
-    cvp::color out;
+    /*  log|z| = log(|z|^2) / 2, avoiding the square root.                    */
+    double log_abs;
 
-    /*  For 0 <= val < 256 transition from blue to cyan.                      */
-    if (val < 256.0)
-    {
-        out.red = 0x00U;
-        out.green = static_cast<unsigned char>(val);
-        out.blue = 0xFFU;
-    }
+    /*  Points in the set are colored black.                                  */
+    if (!o.escaped)
+        return cvp::colors::black();
 
-    /*  For 256 <= val < 512 transition from cyan to green.                   */
-    else if (val < 512.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 256.0;
+    log_abs = 0.5 * std::log(o.z.abssq());
 
-        /*  Transition from cyan to green.                                    */
-        out.red = 0x00U;
-        out.green = 0xFFU;
-        out.blue = static_cast<unsigned char>(256.0 - val);
-    }
+    /*  log(log|z|) is only defined, and positive, for |z| > e.               */
+    if (log_abs > 1.0)
+        mu += 1.0 - std::log2(std::log(log_abs));
 
-    /*  For 512 <= val < 768 transition from green to yellow.                 */
-    else if (val < 768.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 512.0;
+    /*  Wrap the count around the color wheel.                                */
+    mu = std::fmod(mu * steps_per_iter, 1536.0);
 
-        /*  Transition from green to yellow.                                  */
-        out.red = static_cast<unsigned char>(val);
-        out.green = 0xFFU;
-        out.blue = 0x00U;
-    }
+    if (mu < 0.0)
+        mu += 1536.0;
 
-    /*  For 768 <= val < 1024 transition from yellow to red.                  */
-    else if (val < 1024.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 768.0;
+    return cvp::color_wheel_gradient(mu);
+}
+/*  End of escape_time_color.                                                 */
 
-        /*  Transition from yellow to red.                                    */
-        out.red = 0xFFU;
-        out.green = static_cast<unsigned char>(256.0 - val);
-        out.blue = 0x00U;
-    }
+/******************************************************************************
+ *  Function:                                                                 *
+ *      convergence_color                                                     *
+ *  Purpose:                                                                  *
+ *      Creates an RGB color from the orbit of a point in convergence plots.  *
+ *  Arguments:                                                                *
+ *      c (const cvp::convergence &):                                         *
+ *          The end of the orbit of a point.                                  *
+ *  Outputs:                                                                  *
+ *      color (cvp::color):                                                   *
+ *          Black for points that never converged. Otherwise the hue is given *
+ *          by the attractor and the brightness by the number of iterations.  *
+ *  Method:                                                                   *
+ *      Attractor k gets the hue k times the golden ratio around the color    *
+ *      wheel, which keeps the hues of any number of attractors apart.        *
+ *      Points converging to an unknown attractor use the argument of the     *
+ *      limit instead. The color is then dimmed by 16 / (16 + n), so slow     *
+ *      points near the boundaries of the basins are darker.                  *
+ ******************************************************************************/
+inline cvp::color cvp::convergence_color(const cvp::convergence &c)
+{
+    /*  The golden ratio, and the number of colors on the wheel.              */
+    const double golden_ratio = 1.6180339887498949;
+    const double wheel_size = 1536.0;
 
-    /*  For 1024 <= val < 1280 transition from red to magenta.                */
-    else if (val < 1280.0)
-    {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 1024.0;
+    /*  The position on the color wheel and the brightness.                   */
+    double val;
+    double shade;
 
-        /*  Gradient from red to magenta.                                     */
-        out.red = 0xFFU;
-        out.green = 0x00U;
-        out.blue = static_cast<unsigned char>(val);
-    }
+    if (!c.converged)
+        return cvp::colors::black();
 
-    /*  Finally transition from magenta back to blue.                         */
+    if (c.attractor >= 0)
+        val = wheel_size * std::fmod(golden_ratio * c.attractor, 1.0);
     else
+        val = (c.z.arg() + M_PI) * (wheel_size - 1.0) / (2.0 * M_PI);
+
+    shade = 16.0 / (16.0 + static_cast<double>(c.iters));
+    return cvp::color_wheel_gradient(val) * shade;
+}
+/*  End of convergence_color.                                                 */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      convergence_speed_color                                               *
+ *  Purpose:                                                                  *
+ *      Shades the orbit of a point in convergence plots by how quickly it    *
+ *      converged, ignoring which attractor it went to.                       *
+ *  Arguments:                                                                *
+ *      c (const cvp::convergence &):                                         *
+ *          The end of the orbit of a point.                                  *
+ *  Outputs:                                                                  *
+ *      color (cvp::color):                                                   *
+ *          Black for points that never converged. Otherwise a shade of gray, *
+ *          white for the fastest points and darker for slower ones.          *
+ *  Method:                                                                   *
+ *      The orbit crossed the tolerance somewhere between its last two steps, *
+ *      d_{n-1} >= tol > d_n. Newton's method converges quadratically, so the *
+ *      log of d_n is about twice the log of d_{n-1}. Interpolating the log   *
+ *      of the step size gives the smooth count                               *
+ *      mu = n - 2 + log(tol) / log(d_{n-1}), which lies between n - 1 and n. *
+ *      This removes the bands between integer counts. The shade is then      *
+ *      exp(-mu / 8).                                                         *
+ *  Notes:                                                                    *
+ *      d_n itself is not used, since it is usually below the rounding error. *
+ *      For a tolerance of 1 or more, or an orbit that converged on its first *
+ *      step, the integer count is used instead.                              *
+ ******************************************************************************/
+inline cvp::color cvp::convergence_speed_color(const cvp::convergence &c)
+{
+    /*  The number of iterations over which the shade falls by a factor e.    */
+    const double decay = 8.0;
+
+    /*  The iteration count, smoothed if possible.                            */
+    double mu = static_cast<double>(c.iters);
+
+    if (!c.converged)
+        return cvp::colors::black();
+
+    /*  Both logs are negative, and the ratio of logs of squares is the same  *
+     *  as the ratio of the logs of the distances.                            */
+    if (c.tolerance_sq < 1.0 && c.step_sq > 0.0)
     {
-        /*  Shift val back to the range (0, 256).                             */
-        val -= 1280.0;
+        double t = std::log(c.tolerance_sq) / std::log(c.step_sq);
 
-        /*  Transition from magenta to blue.                                  */
-        out.red = static_cast<unsigned char>(256.0 - val);
-        out.green = 0x00U;
-        out.blue = 0xFFU;
+        /*  t is between 1 and 2 when convergence is exactly quadratic.       */
+        t = (t < 1.0 ? 1.0 : (t > 2.0 ? 2.0 : t));
+        mu += t - 2.0;
     }
 
-    /*  Scale the color by the atan factor and return.                        */
-    return out * t;
+    return cvp::colors::white(std::exp(-mu / decay));
 }
-/*  End of color_wheel_from_complex.                                          */
+/*  End of convergence_speed_color.                                           */
 
 #endif
 /*  End of include guard.                                                     */
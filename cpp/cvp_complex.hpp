@@ -34,206 +34,288 @@
 /*  sqrt function and more found here.                                        */
 #include <cmath>
 
+/*  Extended precision types for the real and imaginary parts. These are      *
+ *  included first so that their operators are declared before any template   *
+ *  that uses them.                                                           */
+#include "cvp_dd_real.hpp"
+#include "cvp_qd_real.hpp"
+
 /*  Namespace for the project. "complex visual plots."                        */
 namespace cvp {
 
-    /*  Class for working with complex numbers (doesn't use std::complex).    */
-    class complex {
+    /*  Class for working with complex numbers (doesn't use std::complex).    *
+     *  T is the type of the real and imaginary parts. It may be double, or   *
+     *  an extended precision type like cvp::dd_real or cvp::qd_real.         */
+    template <typename T>
+    class basic_complex {
         public:
+            /*  The type of the real and imaginary parts.                     */
+            typedef T real_type;
+
             /*  The data is the real and imaginary parts of the number.       */
-            double real, imag;
+            T real, imag;
 
             /*  Empty constructor.                                            */
-            complex(void);
+            basic_complex(void);
 
             /*  Constructor from the real and imaginary parts.                */
-            complex(double x, double y);
+            basic_complex(const T &x, const T &y);
+
+            /*  Conversion between precisions, rounding if needed.            */
+            template <typename U>
+            explicit basic_complex(const basic_complex<U> &z);
 
             /*  Returns the real part of the class.                           */
-            inline double re(void);
+            inline T re(void) const;
 
             /*  Returns the imaginary part of the class.                      */
-            inline double im(void);
+            inline T im(void) const;
 
             /*  Computes the complex conjugate of z.                          */
-            inline complex conjugate(void);
+            inline basic_complex conjugate(void) const;
 
             /*  Computes the complex conjugate and stores the result in z.    */
             inline void conjugateself(void);
 
             /*  Method for computing the inverse of z.                        */
-            inline complex rcpr(void);
+            inline basic_complex rcpr(void) const;
 
             /*  Method for inverting z and storing the result in z.           */
             inline void invert(void);
 
             /*  Method for computing the square of the modulus.               */
-            inline double abssq(void);
+            inline T abssq(void) const;
 
             /*  Method for computing the modulus of a complex number.         */
-            inline double abs(void);
+            inline T abs(void) const;
 
             /*  Method for computing the argument of a complex number.        */
-            inline double arg(void);
+            inline T arg(void) const;
     };
-    /*  End of "complex" class.                                               */
+    /*  End of "basic_complex" class.                                         */
+
+    /*  Complex numbers in double precision, used by most of the project.     */
+    typedef basic_complex<double> complex;
 }
 /*  End of namespace "cvp".                                                   */
 
 /*  Empty constructor, simply return.                                         */
-cvp::complex::complex(void)
+template <typename T>
+cvp::basic_complex<T>::basic_complex(void)
 {
     return;
 }
 
 /*  Constructor from the real and imaginary parts.                            */
-cvp::complex::complex(double x, double y)
+template <typename T>
+cvp::basic_complex<T>::basic_complex(const T &x, const T &y)
 {
     real = x;
     imag = y;
 }
 
+/*  Conversion from another precision. The components are converted with a    *
+ *  static_cast, so the scalar types must be explicitly convertible.          */
+template <typename T>
+template <typename U>
+cvp::basic_complex<T>::basic_complex(const cvp::basic_complex<U> &z)
+{
+    real = static_cast<T>(z.real);
+    imag = static_cast<T>(z.imag);
+}
+
 /*  Returns the real part of the class.                                       */
-inline double cvp::complex::re(void)
+template <typename T>
+inline T cvp::basic_complex<T>::re(void) const
 {
     return real;
 }
 
 /*  Returns the imaginary part of the class.                                  */
-inline double cvp::complex::im(void)
+template <typename T>
+inline T cvp::basic_complex<T>::im(void) const
 {
     return imag;
 }
 
+/*  The real arguments of the mixed operators below are written as            *
+ *  basic_complex<T>::real_type so that T is deduced from the complex         *
+ *  argument alone. 2.0 * z then works for every precision, and an int like   *
+ *  2 * z is converted as it would be for a double.                           */
+
 /*  Complex addition. This is performed component-wise.                       */
-inline cvp::complex operator + (cvp::complex z, cvp::complex w)
+template <typename T>
+inline cvp::basic_complex<T>
+operator + (cvp::basic_complex<T> z, cvp::basic_complex<T> w)
 {
-    return cvp::complex(z.real + w.real, z.imag + w.imag);
+    return cvp::basic_complex<T>(z.real + w.real, z.imag + w.imag);
 }
 
 /*  Addition of a real and complex number. Add to the real part of z.         */
-inline cvp::complex operator + (cvp::complex z, double a)
+template <typename T>
+inline cvp::basic_complex<T>
+operator + (cvp::basic_complex<T> z,
+            typename cvp::basic_complex<T>::real_type a)
 {
-    return cvp::complex(z.real + a, z.imag);
+    return cvp::basic_complex<T>(z.real + a, z.imag);
 }
 
 /*  Addition of a real and complex number. Add to the real part of z.         */
-inline cvp::complex operator + (double a, cvp::complex z)
+template <typename T>
+inline cvp::basic_complex<T>
+operator + (typename cvp::basic_complex<T>::real_type a,
+            cvp::basic_complex<T> z)
 {
-    return cvp::complex(a + z.real, z.imag);
+    return cvp::basic_complex<T>(a + z.real, z.imag);
 }
 
 /*  Subtraction of complex numbers. Subtract component-wise.                  */
-inline cvp::complex operator - (cvp::complex z, cvp::complex w)
+template <typename T>
+inline cvp::basic_complex<T>
+operator - (cvp::basic_complex<T> z, cvp::basic_complex<T> w)
 {
-    return cvp::complex(z.real - w.real, z.imag - w.imag);
+    return cvp::basic_complex<T>(z.real - w.real, z.imag - w.imag);
 }
 
 /*  Subtraction of a complex number and a real one. Subtract real part.       */
-inline cvp::complex operator - (cvp::complex z, double a)
+template <typename T>
+inline cvp::basic_complex<T>
+operator - (cvp::basic_complex<T> z,
+            typename cvp::basic_complex<T>::real_type a)
 {
-    return cvp::complex(z.real - a, z.imag);
+    return cvp::basic_complex<T>(z.real - a, z.imag);
 }
 
 /*  Subtraction of a real number and complex one. Negate complex number.      */
-inline cvp::complex operator - (double a, cvp::complex z)
+template <typename T>
+inline cvp::basic_complex<T>
+operator - (typename cvp::basic_complex<T>::real_type a,
+            cvp::basic_complex<T> z)
 {
-    return cvp::complex(a - z.real, -z.imag);
+    return cvp::basic_complex<T>(a - z.real, -z.imag);
 }
 
 /*  Multiplication of two complex number. Compute using i^2 = -1.             */
-inline cvp::complex operator * (cvp::complex z, cvp::complex w)
+template <typename T>
+inline cvp::basic_complex<T>
+operator * (cvp::basic_complex<T> z, cvp::basic_complex<T> w)
 {
-    const double real = z.real*w.real - z.imag*w.imag;
-    const double imag = z.real*w.imag + z.imag*w.real;
-    return cvp::complex(real, imag);
+    const T real = z.real*w.real - z.imag*w.imag;
+    const T imag = z.real*w.imag + z.imag*w.real;
+    return cvp::basic_complex<T>(real, imag);
 }
 
 /*  Multiplication of a real and complex number. Scale the components.        */
-inline cvp::complex operator * (double a, cvp::complex z)
+template <typename T>
+inline cvp::basic_complex<T>
+operator * (typename cvp::basic_complex<T>::real_type a,
+            cvp::basic_complex<T> z)
 {
-    return cvp::complex(a*z.real, a*z.imag);
+    return cvp::basic_complex<T>(a*z.real, a*z.imag);
 }
 
 /*  Multiplication of a real and complex number. Scale the components.        */
-inline cvp::complex operator * (cvp::complex z, double a)
+template <typename T>
+inline cvp::basic_complex<T>
+operator * (cvp::basic_complex<T> z,
+            typename cvp::basic_complex<T>::real_type a)
 {
-    return cvp::complex(z.real*a, z.imag*a);
+    return cvp::basic_complex<T>(z.real*a, z.imag*a);
 }
 
 /*  Division of complex numbers. Use z^{-1} = conj(z) / |z|^2.                */
-inline cvp::complex operator / (cvp::complex z, cvp::complex w)
+template <typename T>
+inline cvp::basic_complex<T>
+operator / (cvp::basic_complex<T> z, cvp::basic_complex<T> w)
 {
-    const double denom = 1.0 / (w.real*w.real + w.imag*w.imag);
-    const double real = z.real*w.real + z.imag*w.imag;
-    const double imag = z.imag*w.real - z.real*w.imag;
-    return cvp::complex(real*denom, imag*denom);
+    const T denom = 1.0 / (w.real*w.real + w.imag*w.imag);
+    const T real = z.real*w.real + z.imag*w.imag;
+    const T imag = z.imag*w.real - z.real*w.imag;
+    return cvp::basic_complex<T>(real*denom, imag*denom);
 }
 
 /*  Division of complex and real numbers. Divide component-wise.              */
-inline cvp::complex operator / (cvp::complex z, double a)
+template <typename T>
+inline cvp::basic_complex<T>
+operator / (cvp::basic_complex<T> z,
+            typename cvp::basic_complex<T>::real_type a)
 {
     /*  Compute the reciprocal and scale the real and imaginary parts.        */
-    const double rcpr = 1.0 / a;
-    return cvp::complex(z.real * rcpr, z.imag * rcpr);
+    const T rcpr = 1.0 / a;
+    return cvp::basic_complex<T>(z.real * rcpr, z.imag * rcpr);
 }
 
 /*  Division of a complex number and real number. Compute z^{-1} and scale.   */
-inline cvp::complex operator / (double a, cvp::complex z)
+template <typename T>
+inline cvp::basic_complex<T>
+operator / (typename cvp::basic_complex<T>::real_type a,
+            cvp::basic_complex<T> z)
 {
-    const double denom = 1.0 / (z.real*z.real + z.imag*z.imag);
-    return cvp::complex(a*z.real*denom, -a*z.imag*denom);
+    const T denom = 1.0 / (z.real*z.real + z.imag*z.imag);
+    return cvp::basic_complex<T>(a*z.real*denom, -a*z.imag*denom);
 }
 
 /*  Computes the complex conjugate of the class.                              */
-inline cvp::complex cvp::complex::conjugate(void)
+template <typename T>
+inline cvp::basic_complex<T> cvp::basic_complex<T>::conjugate(void) const
 {
     /*  The complex conjugate negates the imaginary part.                     */
-    return cvp::complex(real, -imag);
+    return cvp::basic_complex<T>(real, -imag);
 }
 
 /*  Conjugates the class and stores the result in itself.                     */
-inline void cvp::complex::conjugateself(void)
+template <typename T>
+inline void cvp::basic_complex<T>::conjugateself(void)
 {
     /*  We only need to negate the imaginary part.                            */
     imag = -imag;
 }
 
 /*  Computes the reciprocal, or inverse, of a complex number.                 */
-inline cvp::complex cvp::complex::rcpr(void)
+template <typename T>
+inline cvp::basic_complex<T> cvp::basic_complex<T>::rcpr(void) const
 {
     /*  The inverse can be computed via conj(z) / |z|^2.                      */
-    const double denom = 1.0 / (real*real + imag*imag);
-    return cvp::complex(real*denom, -imag*denom);
+    const T denom = 1.0 / (real*real + imag*imag);
+    return cvp::basic_complex<T>(real*denom, -imag*denom);
 }
 
 /*  Computes the reciprocal, or inverse, of a complex number.                 */
-inline void cvp::complex::invert(void)
+template <typename T>
+inline void cvp::basic_complex<T>::invert(void)
 {
     /*  The inverse can be computed via conj(z) / |z|^2.                      */
-    const double denom = 1.0 / (real*real + imag*imag);
-    real *= denom;
-    imag *= -denom;
+    const T denom = 1.0 / (real*real + imag*imag);
+    real = real*denom;
+    imag = -imag*denom;
 }
 
 /*  Computes the square of the modulus of a complex number.                   */
-inline double cvp::complex::abssq(void)
+template <typename T>
+inline T cvp::basic_complex<T>::abssq(void) const
 {
     return real*real + imag*imag;
 }
 
-/*  Computes the modulus of a complex number.                                 */
-inline double cvp::complex::abs(void)
+/*  Computes the modulus of a complex number. sqrt is found by argument       *
+ *  dependent lookup for the extended precision types.                        */
+template <typename T>
+inline T cvp::basic_complex<T>::abs(void) const
 {
+    using std::sqrt;
+
     /*  Use the Pythagoras formula on the vector (real, imag).                */
-    return std::sqrt(real*real + imag*imag);
+    return sqrt(real*real + imag*imag);
 }
 
 /*  Computes the argument, or azimuthal angle, of the complex number.         */
-inline double cvp::complex::arg(void)
+template <typename T>
+inline T cvp::basic_complex<T>::arg(void) const
 {
+    using std::atan2;
+
     /*  Treat z as a vector (real, imag) and compute the azimuthal angle.     */
-    return std::atan2(imag, real);
+    return atan2(imag, real);
 }
 
 #endif
@@ -0,0 +1,355 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides double-double numbers, the unevaluated sum of two doubles,   *
+ *      with about 106 bits of precision, and the error-free transformations  *
+ *      they are built on.                                                    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_DD_REAL_HPP
+#define CVP_DD_REAL_HPP
+
+/*  puts found here.                                                          */
+#include <cstdio>
+
+/*  sqrt, atan2, and fma found here.                                          */
+#include <cmath>
+
+/*  Decimal strings are read with a cvp::bigfloat.                            */
+#include "cvp_bigfloat.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Error-free transformations. Each returns the rounded result of an     *
+     *  operation and stores the exact rounding error in err, so that result  *
+     *  plus err is exactly the true value. These need IEEE-754 arithmetic,   *
+     *  so do not compile with -ffast-math.                                   */
+    namespace eft {
+
+        /*  a + b for any a and b.                                            */
+        inline double two_sum(double a, double b, double &err);
+
+        /*  a + b, assuming |a| >= |b|. Cheaper than two_sum.                 */
+        inline double quick_two_sum(double a, double b, double &err);
+
+        /*  a * b. Uses a fused multiply-add if the hardware has one.         */
+        inline double two_prod(double a, double b, double &err);
+    }
+
+    /*  A double-double number, the unevaluated sum hi + lo of two doubles    *
+     *  with |lo| at most half an ulp of hi.                                  */
+    class dd_real {
+        public:
+            double hi, lo;
+
+            /*  Empty constructor.                                            */
+            dd_real(void);
+
+            /*  Constructor from a double. Not explicit, so doubles may be    *
+             *  used wherever a dd_real is expected.                          */
+            dd_real(double x);
+
+            /*  Constructor from the two parts. They must not overlap.        */
+            dd_real(double h, double l);
+
+            /*  Constructor from a decimal string like "-0.743643887037151".  */
+            explicit dd_real(const char *str);
+
+            /*  Rounds to a double.                                           */
+            explicit operator double(void) const;
+    };
+
+    /*  Square root, accurate to the full precision.                          */
+    inline cvp::dd_real sqrt(const cvp::dd_real &x);
+
+    /*  The angle of (x, y). Only computed in double precision, as it is only *
+     *  ever used for colors.                                                 */
+    inline cvp::dd_real atan2(const cvp::dd_real &y, const cvp::dd_real &x);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Knuth's two-sum. No assumption on the sizes of a and b.                   */
+inline double cvp::eft::two_sum(double a, double b, double &err)
+{
+    const double s = a + b;
+    const double bb = s - a;
+    err = (a - (s - bb)) + (b - bb);
+    return s;
+}
+
+/*  Dekker's fast two-sum. Requires |a| >= |b|, or a = 0.                     */
+inline double cvp::eft::quick_two_sum(double a, double b, double &err)
+{
+    const double s = a + b;
+    err = b - (s - a);
+    return s;
+}
+
+/*  With a fused multiply-add the error of a * b is one instruction. Without  *
+ *  one, a and b are split into halves of 26 bits whose products are exact.   */
+inline double cvp::eft::two_prod(double a, double b, double &err)
+{
+    const double p = a * b;
+
+#ifdef FP_FAST_FMA
+    err = std::fma(a, b, -p);
+#else
+    /*  2^27 + 1, for splitting a double into two halves.                     */
+    const double splitter = 134217729.0;
+
+    const double ta = splitter * a;
+    const double a_hi = ta - (ta - a);
+    const double a_lo = a - a_hi;
+
+    const double tb = splitter * b;
+    const double b_hi = tb - (tb - b);
+    const double b_lo = b - b_hi;
+
+    err = ((a_hi*b_hi - p) + a_hi*b_lo + a_lo*b_hi) + a_lo*b_lo;
+#endif
+
+    return p;
+}
+
+/*  Empty constructor, simply return.                                         */
+cvp::dd_real::dd_real(void)
+{
+    return;
+}
+
+/*  Constructor from a double, which is exact.                                */
+cvp::dd_real::dd_real(double x)
+    : hi(x), lo(0.0)
+{
+    return;
+}
+
+/*  Constructor from the two parts.                                           */
+cvp::dd_real::dd_real(double h, double l)
+    : hi(h), lo(l)
+{
+    return;
+}
+
+/*  Reads the string with more bits than a dd_real holds, then peels off the  *
+ *  two parts, subtracting each from the exact value.                         */
+cvp::dd_real::dd_real(const char *str)
+    : hi(0.0), lo(0.0)
+{
+    const unsigned int limbs = 8U;
+    cvp::bigfloat x;
+
+    if (!x.parse(str, limbs))
+    {
+        std::puts("ERROR: dd_real could not parse the string.");
+        return;
+    }
+
+    hi = x.to_double();
+    x = x - cvp::bigfloat(hi, limbs);
+    lo = x.to_double();
+    hi = cvp::eft::quick_two_sum(hi, lo, lo);
+}
+
+/*  The high part is the value rounded to a double.                           */
+cvp::dd_real::operator double(void) const
+{
+    return hi;
+}
+
+/*  Negation is exact.                                                        */
+inline cvp::dd_real operator - (const cvp::dd_real &x)
+{
+    return cvp::dd_real(-x.hi, -x.lo);
+}
+
+/*  Addition of double-doubles. Both parts are added with two_sum so that     *
+ *  the result is accurate even when x and y nearly cancel.                   */
+inline cvp::dd_real operator + (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    double s_err, t_err;
+    double s = cvp::eft::two_sum(x.hi, y.hi, s_err);
+    const double t = cvp::eft::two_sum(x.lo, y.lo, t_err);
+
+    s_err += t;
+    s = cvp::eft::quick_two_sum(s, s_err, s_err);
+    s_err += t_err;
+    s = cvp::eft::quick_two_sum(s, s_err, s_err);
+    return cvp::dd_real(s, s_err);
+}
+
+/*  Addition of a double-double and a double.                                 */
+inline cvp::dd_real operator + (const cvp::dd_real &x, double y)
+{
+    double err;
+    double s = cvp::eft::two_sum(x.hi, y, err);
+
+    err += x.lo;
+    s = cvp::eft::quick_two_sum(s, err, err);
+    return cvp::dd_real(s, err);
+}
+
+/*  Addition of a double and a double-double.                                 */
+inline cvp::dd_real operator + (double x, const cvp::dd_real &y)
+{
+    return y + x;
+}
+
+/*  Subtraction is addition of the negative.                                  */
+inline cvp::dd_real operator - (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return x + (-y);
+}
+
+/*  Subtraction of a double from a double-double.                             */
+inline cvp::dd_real operator - (const cvp::dd_real &x, double y)
+{
+    return x + (-y);
+}
+
+/*  Subtraction of a double-double from a double.                             */
+inline cvp::dd_real operator - (double x, const cvp::dd_real &y)
+{
+    return (-y) + x;
+}
+
+/*  Multiplication of double-doubles. The product of the high parts is exact  *
+ *  with two_prod. The cross terms only need double precision, and the        *
+ *  product of the low parts is below the precision and dropped.              */
+inline cvp::dd_real operator * (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    double err;
+    double p = cvp::eft::two_prod(x.hi, y.hi, err);
+
+    err += x.hi*y.lo + x.lo*y.hi;
+    p = cvp::eft::quick_two_sum(p, err, err);
+    return cvp::dd_real(p, err);
+}
+
+/*  Multiplication of a double-double and a double.                           */
+inline cvp::dd_real operator * (const cvp::dd_real &x, double y)
+{
+    double err;
+    double p = cvp::eft::two_prod(x.hi, y, err);
+
+    err += x.lo*y;
+    p = cvp::eft::quick_two_sum(p, err, err);
+    return cvp::dd_real(p, err);
+}
+
+/*  Multiplication of a double and a double-double.                           */
+inline cvp::dd_real operator * (double x, const cvp::dd_real &y)
+{
+    return y * x;
+}
+
+/*  Long division, one double of the quotient at a time. Each step divides    *
+ *  the remainder by the high part of y, and the third step corrects the      *
+ *  rounding of the first two.                                                */
+inline cvp::dd_real operator / (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    double q1, q2, q3;
+    cvp::dd_real r;
+
+    q1 = x.hi / y.hi;
+    r = x - y*q1;
+
+    q2 = r.hi / y.hi;
+    r = r - y*q2;
+
+    q3 = r.hi / y.hi;
+
+    q1 = cvp::eft::quick_two_sum(q1, q2, q2);
+    return cvp::dd_real(q1, q2) + q3;
+}
+
+/*  Division of a double-double by a double.                                  */
+inline cvp::dd_real operator / (const cvp::dd_real &x, double y)
+{
+    return x / cvp::dd_real(y);
+}
+
+/*  Division of a double by a double-double.                                  */
+inline cvp::dd_real operator / (double x, const cvp::dd_real &y)
+{
+    return cvp::dd_real(x) / y;
+}
+
+/*  Comparisons. The parts are normalized, so compare the high parts first.   */
+inline bool operator < (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return x.hi < y.hi || (x.hi == y.hi && x.lo < y.lo);
+}
+
+inline bool operator > (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return y < x;
+}
+
+inline bool operator <= (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return !(y < x);
+}
+
+inline bool operator >= (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return !(x < y);
+}
+
+inline bool operator == (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return x.hi == y.hi && x.lo == y.lo;
+}
+
+inline bool operator != (const cvp::dd_real &x, const cvp::dd_real &y)
+{
+    return !(x == y);
+}
+
+/*  One step of Newton's method for 1/sqrt(x), starting from the double       *
+ *  precision value, doubles the number of correct bits (Karp's method).      */
+inline cvp::dd_real cvp::sqrt(const cvp::dd_real &x)
+{
+    /*  Variables for the double precision root and the correction to it.     */
+    double rsqrt, root, correction, err;
+
+    if (x.hi <= 0.0)
+        return cvp::dd_real(0.0);
+
+    rsqrt = 1.0 / std::sqrt(x.hi);
+    root = x.hi * rsqrt;
+    correction = (x - cvp::dd_real(root)*root).hi * (0.5 * rsqrt);
+    root = cvp::eft::two_sum(root, correction, err);
+    return cvp::dd_real(root, err);
+}
+
+/*  The angle is only needed for coloring, so double precision suffices.      */
+inline cvp::dd_real cvp::atan2(const cvp::dd_real &y, const cvp::dd_real &x)
+{
+    return cvp::dd_real(std::atan2(y.hi, x.hi));
+}
+
+#endif
+/*  End of include guard.                                                     */
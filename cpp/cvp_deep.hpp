@@ -0,0 +1,312 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides deep zooms of the Mandelbrot set using perturbation theory.  *
+ *      One reference orbit is computed with a cvp::bigfloat, and every pixel *
+ *      is iterated in double precision as a small offset from it.            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_DEEP_HPP
+#define CVP_DEEP_HPP
+
+/*  puts found here.                                                          */
+#include <cstdio>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  The end of an orbit, given to the colorers, provided here.                */
+#include "cvp_orbit.hpp"
+
+/*  Fixed-point numbers for the center and the reference orbit.               */
+#include "cvp_bigfloat.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  A viewport for deep zooms. The center is given as decimal strings and *
+     *  kept in a cvp::bigfloat, but only offsets from the center are ever    *
+     *  needed for the pixels, and these are small enough for a double.       */
+    class deep_viewport {
+        public:
+            /*  The center of the image, to as many digits as needed.         */
+            cvp::bigfloat center_re, center_im;
+
+            /*  The width of the region and the width of a single pixel.      */
+            double width, pixel;
+
+            /*  The number of pixels in the x and y axes.                     */
+            unsigned int xsize, ysize;
+
+            /*  False if the center could not be parsed.                      */
+            bool valid;
+
+            /*  Constructor from the center, the width of the region, and the *
+             *  resolution. Pixels are square. The precision of the center is *
+             *  chosen from the size of a pixel.                              */
+            deep_viewport(const char *re, const char *im, double w,
+                          unsigned int width_px, unsigned int height_px);
+
+            /*  Offset from the center of the points in column x.             */
+            inline double delta_real(unsigned int x) const;
+
+            /*  Offset from the center of the points in row y.                */
+            inline double delta_imag(unsigned int y) const;
+    };
+
+    /*  The largest radius of a reference orbit. Its values are squared in    *
+     *  high precision, which has a single limb, below 2^32, for the integer  *
+     *  part, so they must stay below 2^16. Use 2^15 to leave room for c.     */
+    static const double reference_radius = 32768.0;
+
+    /*  Computes the orbit of the center of a deep viewport under z^2 + c,    *
+     *  rounded to doubles, starting from zero. The orbit is stored in ref,   *
+     *  which must have room for iters + 2 values, and stops early if it      *
+     *  leaves the bailout radius, or reference_radius if that is smaller.    *
+     *  Returns the number of values stored.                                  */
+    inline unsigned int
+    reference_orbit(const cvp::deep_viewport &view, unsigned int iters,
+                    double bailout, cvp::complex *ref);
+
+    /*  Escape-time kernel for z^2 + c using perturbation theory.             */
+    template <typename Tcolor>
+    class perturbation_kernel {
+        public:
+            /*  The reference orbit and the number of values in it.           */
+            const cvp::complex *reference;
+            unsigned int length;
+
+            unsigned int iters;
+            double bailout_sq;
+            Tcolor color;
+            cvp::deep_viewport view;
+
+            /*  Constructor from the reference orbit, maximum number of       *
+             *  iterations, bailout radius, colorer, and viewport.            */
+            perturbation_kernel(const cvp::complex *ref, unsigned int len,
+                                unsigned int n, double bailout,
+                                Tcolor c, const cvp::deep_viewport &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, cvp::color *out) const;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the center, width, and resolution.                       */
+cvp::deep_viewport::deep_viewport(const char *re, const char *im, double w,
+                                  unsigned int width_px,
+                                  unsigned int height_px)
+    : width(w), pixel(w / static_cast<double>(width_px)),
+      xsize(width_px), ysize(height_px), valid(true)
+{
+    /*  Enough limbs to resolve a pixel, with bits to spare for the orbit.    */
+    const unsigned int limbs = cvp::bigfloat_limbs(pixel);
+
+    if (!center_re.parse(re, limbs) || !center_im.parse(im, limbs))
+    {
+        std::puts("ERROR: deep_viewport could not parse the center.");
+        valid = false;
+    }
+}
+
+/*  Pixels are mapped left-to-right, with the center in the middle.           */
+inline double cvp::deep_viewport::delta_real(unsigned int x) const
+{
+    return pixel * (static_cast<double>(x) - 0.5*static_cast<double>(xsize));
+}
+
+/*  Pixels are mapped top-to-bottom, with the center in the middle.           */
+inline double cvp::deep_viewport::delta_imag(unsigned int y) const
+{
+    return pixel * (0.5*static_cast<double>(ysize) - static_cast<double>(y));
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::reference_orbit                                                  *
+ *  Purpose:                                                                  *
+ *      Computes the reference orbit Z_n of the center of a deep zoom.        *
+ *  Arguments:                                                                *
+ *      view (const cvp::deep_viewport &):                                    *
+ *          The viewport. The orbit is for its center.                        *
+ *      iters (unsigned int):                                                 *
+ *          The maximum number of iterations.                                 *
+ *      bailout (double):                                                     *
+ *          The orbit stops once |Z_n| exceeds this, or reference_radius.     *
+ *      ref (cvp::complex *):                                                 *
+ *          Array of at least iters + 2 values, Z_0 = 0 through Z_{iters+1}.  *
+ *  Outputs:                                                                  *
+ *      length (unsigned int):                                                *
+ *          The number of values stored in ref.                               *
+ *  Method:                                                                   *
+ *      Iterate Z_{n+1} = Z_n^2 + C with the precision of the center of the   *
+ *      viewport, rounding each value to a double once it is computed. Only   *
+ *      the real and imaginary parts are needed in high precision, as         *
+ *      Z^2 = (X^2 - Y^2) + 2XYi, so each step costs three multiplications.   *
+ *  Notes:                                                                    *
+ *      Larger bailouts are common for smooth coloring, but the squares of    *
+ *      values past 2^16 would wrap around in high precision. The orbit is    *
+ *      cut off at reference_radius instead. Pixels that outlive it are       *
+ *      rebased by the perturbation kernel and carry on in double precision,  *
+ *      where their own bailout is used, so the image does not change.        *
+ ******************************************************************************/
+inline unsigned int
+cvp::reference_orbit(const cvp::deep_viewport &view, unsigned int iters,
+                     double bailout, cvp::complex *ref)
+{
+    /*  The current value of the orbit and the center, in high precision.     */
+    const unsigned int limbs = view.center_re.size;
+    cvp::bigfloat x = cvp::bigfloat(0.0, limbs);
+    cvp::bigfloat y = cvp::bigfloat(0.0, limbs);
+
+    /*  Index for the orbit.                                                  */
+    unsigned int n;
+    const double radius =
+        (bailout < cvp::reference_radius ? bailout : cvp::reference_radius);
+    const double bailout_sq = radius*radius;
+
+    ref[0] = cvp::complex(0.0, 0.0);
+
+    for (n = 1U; n < iters + 2U; ++n)
+    {
+        const cvp::bigfloat xx = x*x;
+        const cvp::bigfloat yy = y*y;
+        const cvp::bigfloat xy = x*y;
+
+        x = xx - yy + view.center_re;
+        y = xy + xy + view.center_im;
+        ref[n] = cvp::complex(x.to_double(), y.to_double());
+
+        /*  Once the reference escapes, the rest of its orbit is useless.     */
+        if (ref[n].abssq() > bailout_sq)
+            return n + 1U;
+    }
+
+    return n;
+}
+/*  End of cvp::reference_orbit.                                              */
+
+/*  Constructor from the reference orbit, iterations, bailout, colorer, and   *
+ *  the viewport.                                                             */
+template <typename Tcolor>
+cvp::perturbation_kernel<Tcolor>::perturbation_kernel(
+    const cvp::complex *ref, unsigned int len, unsigned int n,
+    double bailout, Tcolor c, const cvp::deep_viewport &v
+) : reference(ref), length(len), iters(n), bailout_sq(bailout*bailout),
+    color(c), view(v)
+{
+    return;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::perturbation_kernel::operator ()                                 *
+ *  Purpose:                                                                  *
+ *      Computes the escape-time colors of n pixels using perturbation.       *
+ *  Arguments:                                                                *
+ *      x (unsigned int):                                                     *
+ *          The column of the first pixel.                                    *
+ *      y (unsigned int):                                                     *
+ *          The row of the pixels.                                            *
+ *      n (unsigned int):                                                     *
+ *          The number of pixels.                                             *
+ *      out (cvp::color *):                                                   *
+ *          The colors of the pixels are stored here.                         *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Write the orbit of a pixel as z_n = Z_n + d_n, where Z_n is the       *
+ *      reference orbit and dc = c - C is the offset of the pixel. Then       *
+ *                                                                            *
+ *          d_{n+1} = 2 Z_n d_n + d_n^2 + dc = (2 Z_n + d_n) d_n + dc         *
+ *                                                                            *
+ *      Since d_n is small, this is accurate in double precision even when dc *
+ *      is far below the precision of c itself. The approximation breaks down *
+ *      (a "glitch") when z_n passes close to zero, where it is smaller than  *
+ *      d_n and all of its digits come from the cancellation of Z_n and d_n.  *
+ *      When |z_n| < |d_n| the pixel is rebased: d_n is replaced by z_n, and  *
+ *      the reference restarts from Z_0 = 0, so that z_n = Z_0 + d_n still    *
+ *      holds. The same is done if the reference orbit runs out, which        *
+ *      happens when the center escapes before the pixel does.                *
+ *  Notes:                                                                    *
+ *      The iteration count matches cvp::escape_plot with cvp::quadratic,     *
+ *      starting from z_1 = c, so the same colorers may be used. Rebasing     *
+ *      means a single reference orbit suffices for the whole image.          *
+ *                                                                            *
+ *      Offsets are doubles, so widths below about 1e-300 are not supported.  *
+ ******************************************************************************/
+template <typename Tcolor>
+inline void
+cvp::perturbation_kernel<Tcolor>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, cvp::color *out
+) const
+{
+    /*  Indices for the pixels in the run, the iterations, and the reference. *
+     *  The last index of the reference orbit forces a rebase.                */
+    unsigned int k, ind, m;
+    const unsigned int last = length - 1U;
+
+    /*  The imaginary part of the offset is the same for the entire run.      */
+    const double dc_im = view.delta_imag(y);
+
+    for (k = 0U; k < n; ++k)
+    {
+        /*  The offset of this pixel from the center.                         */
+        const cvp::complex dc = cvp::complex(view.delta_real(x + k), dc_im);
+
+        /*  Start at z_1 = c, which is Z_1 + dc, and count from there.        */
+        cvp::complex d = dc;
+        cvp::complex z = reference[1] + d;
+        bool escaped = false;
+        m = 1U;
+
+        for (ind = 0U; ind < iters && !escaped; ++ind)
+        {
+            /*  Rebase if the pixel is closer to zero than to the reference,  *
+             *  or if the reference orbit has run out.                        */
+            if (z.abssq() < d.abssq() || m == last)
+            {
+                d = z;
+                m = 0U;
+            }
+
+            d = (2.0*reference[m] + d)*d + dc;
+            ++m;
+
+            z = reference[m] + d;
+            escaped = (z.abssq() > bailout_sq);
+        }
+
+        out[k] = color(cvp::orbit(z, ind, iters, escaped));
+    }
+}
+/*  End of cvp::perturbation_kernel::operator ().                             */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,1406 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a deflate compressor (RFC 1951) and the Adler-32 checksum of *
+ *      zlib streams, with no dependencies. Data is compressed in pieces that *
+ *      may be primed with the bytes before them, so the pieces of one stream *
+ *      can be compressed by different threads and simply concatenated.       *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_DEFLATE_HPP
+#define CVP_DEFLATE_HPP
+
+/*  size_t and memcpy found here.                                             */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, for the checksums and the bit buffer.            */
+#include <cstdint>
+
+/*  std::sort, for ordering symbols by frequency.                             */
+#include <algorithm>
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Namespace for the compressor, to avoid name conflicts.                */
+    namespace deflate {
+
+        /*  Level 0 stores the data as it is, and level 1 only codes runs of  *
+         *  a repeated byte. Levels 2 to 9 search for matches, harder and     *
+         *  more slowly as the level goes up, like zlib.                      */
+        static const unsigned int stored_level = 0U;
+        static const unsigned int rle_level = 1U;
+        static const unsigned int default_level = 6U;
+        static const unsigned int max_level = 9U;
+
+        /*  How far back a match may reach, and so the most history worth     *
+         *  priming the compressor with.                                      */
+        static const std::size_t window_size = 32768U;
+
+        /*  The shortest and longest matches deflate can code.                */
+        static const unsigned int min_match = 3U;
+        static const unsigned int max_match = 258U;
+
+        /*  The number of symbols collected before a block is written. Each   *
+         *  block gets its own Huffman codes.                                 */
+        static const unsigned int block_symbols = 16384U;
+
+        /*  The number of bits of the hash of three bytes.                    */
+        static const unsigned int hash_bits = 15U;
+
+        /*  The base values and extra bits of the length and distance codes.  */
+        static const std::uint16_t length_base[29] = {
+            3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 13U, 15U, 17U, 19U, 23U,
+            27U, 31U, 35U, 43U, 51U, 59U, 67U, 83U, 99U, 115U, 131U, 163U,
+            195U, 227U, 258U
+        };
+
+        static const unsigned char length_extra[29] = {
+            0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 1U, 1U, 2U, 2U, 2U, 2U,
+            3U, 3U, 3U, 3U, 4U, 4U, 4U, 4U, 5U, 5U, 5U, 5U, 0U
+        };
+
+        static const std::uint16_t distance_base[30] = {
+            1U, 2U, 3U, 4U, 5U, 7U, 9U, 13U, 17U, 25U, 33U, 49U, 65U, 97U,
+            129U, 193U, 257U, 385U, 513U, 769U, 1025U, 1537U, 2049U, 3073U,
+            4097U, 6145U, 8193U, 12289U, 16385U, 24577U
+        };
+
+        static const unsigned char distance_extra[30] = {
+            0U, 0U, 0U, 0U, 1U, 1U, 2U, 2U, 3U, 3U, 4U, 4U, 5U, 5U, 6U, 6U,
+            7U, 7U, 8U, 8U, 9U, 9U, 10U, 10U, 11U, 11U, 12U, 12U, 13U, 13U
+        };
+
+        /*  The order the lengths of the code length code are stored in.      */
+        static const unsigned char code_length_order[19] = {
+            16U, 17U, 18U, 0U, 8U, 7U, 9U, 6U, 10U, 5U, 11U, 4U, 12U, 3U, 13U,
+            2U, 14U, 1U, 15U
+        };
+
+        /*  A literal byte, with distance zero, or a match of the given       *
+         *  length and distance.                                              */
+        class symbol {
+            public:
+                std::uint16_t value, distance;
+        };
+
+        /*  How hard levels 2 to 9 search for matches. Searching stops at a   *
+         *  match of nice_length, follows at most max_chain earlier places,   *
+         *  and a quarter of that once a match of good_length is in hand. A   *
+         *  match shorter than max_lazy is kept only if the next byte does    *
+         *  not start a longer one. Zero means matches are taken greedily.    */
+        class search_params {
+            public:
+                unsigned int good_length, max_lazy, nice_length, max_chain;
+        };
+
+        /*  Orders symbols by frequency, and by symbol among equal ones.      */
+        class by_frequency {
+            public:
+                const std::uint32_t *freq;
+
+                inline bool operator () (unsigned int a, unsigned int b) const
+                {
+                    return (freq[a] != freq[b] ? freq[a] < freq[b] : a < b);
+                }
+        };
+
+        /*  Lookup tables for the codes of lengths and distances, and the     *
+         *  fixed Huffman codes.                                              */
+        class code_tables {
+            public:
+                /*  The length code (0 to 28) of each match length.           */
+                unsigned char length_code[max_match + 1U];
+
+                /*  The distance code of d is entry d - 1 for d <= 256, and   *
+                 *  entry 256 + (d - 1) / 128 otherwise.                      */
+                unsigned char distance_code[512];
+
+                /*  The fixed codes, already bit reversed, and their lengths. *
+                 *  Every fixed distance code is 5 bits long.                 */
+                std::uint16_t fixed_code[288];
+                unsigned char fixed_length[288];
+                std::uint16_t fixed_distance_code[30];
+                unsigned char fixed_distance_length[30];
+
+                /*  Constructor, fills in the tables.                         */
+                code_tables(void);
+        };
+
+        /*  The tables, built once on first use.                              */
+        inline const cvp::deflate::code_tables &tables(void);
+
+        /*  Writes bits least significant first, as deflate wants.            */
+        class bit_writer {
+            public:
+                /*  The output, and the number of bytes written to it.        */
+                unsigned char *out;
+                std::size_t size;
+
+                /*  Bits not yet written, and how many there are.             */
+                std::uint64_t bits;
+                unsigned int count;
+
+                /*  Constructor from the output buffer.                       */
+                bit_writer(unsigned char *o);
+
+                /*  Writes the low length bits of value, at most 16 of them.  */
+                inline void put(std::uint32_t value, unsigned int length);
+
+                /*  Pads with zero bits to the next byte and writes it out.   */
+                inline void align(void);
+
+                /*  Copies bytes to the output, which must be aligned.        */
+                inline void copy(const unsigned char *data, std::size_t n);
+        };
+
+        /*  Finds matches by hashing every three bytes and chaining together  *
+         *  the places with the same hash.                                    */
+        class matcher {
+            public:
+                /*  The data, and the end of the part being compressed.       */
+                const unsigned char *in;
+                std::size_t end;
+
+                /*  The latest place with each hash, and the place before     *
+                 *  each place with the same hash, both plus one so that      *
+                 *  zero means none.                                          */
+                std::uint32_t *head, *prev;
+
+                /*  The first place not hashed yet.                           */
+                std::size_t next;
+
+                /*  How hard to search.                                       */
+                cvp::deflate::search_params params;
+
+                /*  Constructor from the data, where the part being           *
+                 *  compressed starts and ends, and the level.                */
+                matcher(const unsigned char *data, std::size_t start,
+                        std::size_t stop, unsigned int level);
+
+                /*  Finds the longest match for the bytes at p that is longer *
+                 *  than best, returning its length or zero if there is none. */
+                inline unsigned int find(std::size_t p, unsigned int best,
+                                         std::size_t *distance);
+
+                /*  Frees the hash tables.                                    */
+                inline void destroy(void);
+
+                /*  The hash of the three bytes at p.                         */
+                static inline std::uint32_t hash(const unsigned char *p);
+
+                /*  The number of bytes, at most limit, that a and b share.   */
+                static inline unsigned int
+                common_length(const unsigned char *a, const unsigned char *b,
+                              unsigned int limit);
+        };
+
+        /*  Updates an Adler-32 checksum with n more bytes. Start from 1.     */
+        inline std::uint32_t
+        adler32(std::uint32_t adler, const unsigned char *data, std::size_t n);
+
+        /*  The Adler-32 checksum of two pieces of data one after the other,  *
+         *  from the checksums of the pieces and the size of the second.      */
+        inline std::uint32_t
+        adler32_combine(std::uint32_t first, std::uint32_t second,
+                        std::size_t n);
+
+        /*  The largest number of bytes compress can write for n bytes.       */
+        inline std::size_t bound(std::size_t n);
+
+        /*  The second byte of a zlib header, after 0x78, for a level.        */
+        inline unsigned char zlib_flags(unsigned int level);
+
+        /*  Compresses in[start] to in[end - 1], which may refer back to the  *
+         *  bytes before start, and returns the number of bytes written to    *
+         *  out, or zero if malloc failed. The last piece of a stream ends    *
+         *  with a final block. Every other piece ends with an empty stored   *
+         *  block so that it stops on a byte, and the next piece can follow.  */
+        inline std::size_t
+        compress(const unsigned char *in, std::size_t start, std::size_t end,
+                 unsigned int level, bool last, unsigned char *out);
+
+        /*  Computes the lengths of a Huffman code for n symbols with the     *
+         *  given frequencies, none longer than limit. Unused symbols get 0.  */
+        inline void code_lengths(const std::uint32_t *freq, unsigned int n,
+                                 unsigned int limit, unsigned char *lengths);
+
+        /*  Computes the canonical codes for the given lengths, bit reversed. */
+        inline void canonical_codes(const unsigned char *lengths,
+                                    unsigned int n, std::uint16_t *codes);
+
+        /*  The code of a match distance.                                     */
+        inline unsigned int distance_code(unsigned int distance);
+
+        /*  Writes n bytes as stored blocks. With n zero this writes a single *
+         *  empty block, which ends a piece on a byte.                        */
+        inline void write_stored(cvp::deflate::bit_writer &bits,
+                                 const unsigned char *data, std::size_t n,
+                                 bool last);
+
+        /*  Writes symbols with the given codes, and the end of the block.    */
+        inline void write_symbols(cvp::deflate::bit_writer &bits,
+                                  const cvp::deflate::symbol *symbols,
+                                  unsigned int count,
+                                  const std::uint16_t *codes,
+                                  const unsigned char *lengths,
+                                  const std::uint16_t *distance_codes,
+                                  const unsigned char *distance_lengths);
+
+        /*  Writes a block of symbols, standing for the n bytes of data, in   *
+         *  whichever of the three kinds of block is smallest.                */
+        inline void write_block(cvp::deflate::bit_writer &bits,
+                                const cvp::deflate::symbol *symbols,
+                                unsigned int count,
+                                const unsigned char *data, std::size_t n,
+                                bool last);
+    }
+    /*  End of namespace "deflate".                                           */
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor, fills in the tables of codes.                                */
+cvp::deflate::code_tables::code_tables(void)
+{
+    /*  Indices for the codes and the values each one covers.                 */
+    unsigned int code, k;
+
+    for (code = 0U; code < 29U; ++code)
+    {
+        for (k = 0U; k < (1U << cvp::deflate::length_extra[code]); ++k)
+        {
+            const unsigned int n = cvp::deflate::length_base[code] + k;
+
+            if (n <= cvp::deflate::max_match)
+                length_code[n] = static_cast<unsigned char>(code);
+        }
+    }
+
+    /*  258 could be coded either way, deflate uses the last code for it.     */
+    length_code[cvp::deflate::max_match] = 28U;
+
+    for (code = 0U; code < 30U; ++code)
+    {
+        for (k = 0U; k < (1U << cvp::deflate::distance_extra[code]); ++k)
+        {
+            const unsigned int d = cvp::deflate::distance_base[code] + k;
+
+            if (d <= 256U)
+                distance_code[d - 1U] = static_cast<unsigned char>(code);
+            else
+                distance_code[256U + ((d - 1U) >> 7)] =
+                    static_cast<unsigned char>(code);
+        }
+    }
+
+    /*  The fixed code from section 3.2.6 of RFC 1951.                        */
+    for (k = 0U; k < 288U; ++k)
+    {
+        if (k < 144U)
+            fixed_length[k] = 8U;
+        else if (k < 256U)
+            fixed_length[k] = 9U;
+        else if (k < 280U)
+            fixed_length[k] = 7U;
+        else
+            fixed_length[k] = 8U;
+    }
+
+    for (k = 0U; k < 30U; ++k)
+        fixed_distance_length[k] = 5U;
+
+    cvp::deflate::canonical_codes(fixed_length, 288U, fixed_code);
+    cvp::deflate::canonical_codes(
+        fixed_distance_length, 30U, fixed_distance_code
+    );
+}
+
+/*  The tables are a function-local static, which C++11 initializes once in a *
+ *  thread-safe way, so pieces may be compressed from OpenMP loops.           */
+inline const cvp::deflate::code_tables &cvp::deflate::tables(void)
+{
+    static const cvp::deflate::code_tables code_table;
+    return code_table;
+}
+
+/*  Constructor from the output buffer, which starts empty.                   */
+cvp::deflate::bit_writer::bit_writer(unsigned char *o)
+{
+    out = o;
+    size = 0U;
+    bits = 0U;
+    count = 0U;
+}
+
+/*  Adds the bits to the buffer, writing four bytes once there are 32 bits.   *
+ *  With at most 16 bits at a time the buffer never holds more than 47.       */
+inline void
+cvp::deflate::bit_writer::put(std::uint32_t value, unsigned int length)
+{
+    bits |= static_cast<std::uint64_t>(value) << count;
+    count += length;
+
+    if (count >= 32U)
+    {
+        out[size] = static_cast<unsigned char>(bits);
+        out[size + 1U] = static_cast<unsigned char>(bits >> 8);
+        out[size + 2U] = static_cast<unsigned char>(bits >> 16);
+        out[size + 3U] = static_cast<unsigned char>(bits >> 24);
+        size += 4U;
+        bits >>= 32;
+        count -= 32U;
+    }
+}
+
+/*  Writes out every bit in the buffer, padding the last byte with zeros.     */
+inline void cvp::deflate::bit_writer::align(void)
+{
+    while (count > 0U)
+    {
+        out[size] = static_cast<unsigned char>(bits);
+        ++size;
+        bits >>= 8;
+        count = (count > 8U ? count - 8U : 0U);
+    }
+}
+
+/*  Copies bytes straight to the output, which align must have been called on.*/
+inline void
+cvp::deflate::bit_writer::copy(const unsigned char *data, std::size_t n)
+{
+    std::memcpy(out + size, data, n);
+    size += n;
+}
+
+/*  Constructor from the data, the part to compress, and the level. The hash  *
+ *  tables are NULL if malloc failed.                                         */
+cvp::deflate::matcher::matcher(const unsigned char *data, std::size_t start,
+                               std::size_t stop, unsigned int level)
+{
+    /*  The search parameters of zlib for levels 2 to 9.                      */
+    static const cvp::deflate::search_params table[8] = {
+        {4U, 0U, 16U, 8U}, {4U, 0U, 32U, 32U}, {4U, 4U, 16U, 16U},
+        {8U, 16U, 32U, 32U}, {8U, 16U, 128U, 128U}, {8U, 32U, 128U, 256U},
+        {32U, 128U, 258U, 1024U}, {32U, 258U, 258U, 4096U}
+    };
+
+    const std::size_t table_size = sizeof(std::uint32_t) << hash_bits;
+
+    in = data;
+    end = stop;
+    params = table[(level < 2U ? 2U : level) - 2U];
+
+    /*  The bytes before the start can be matched, hash them first.           */
+    next = (start > window_size ? start - window_size : 0U);
+
+    head = static_cast<std::uint32_t *>(
+        cvp::memory::aligned_malloc(table_size)
+    );
+
+    prev = static_cast<std::uint32_t *>(
+        cvp::memory::aligned_malloc(sizeof(std::uint32_t) * window_size)
+    );
+
+    /*  Only the heads need clearing. An entry of prev is read only for a     *
+     *  place that has been hashed, which set that entry.                     */
+    if (head)
+        std::memset(head, 0, table_size);
+}
+
+/*  A multiplicative hash of three bytes, keeping the top hash_bits bits.     */
+inline std::uint32_t cvp::deflate::matcher::hash(const unsigned char *p)
+{
+    const std::uint32_t word = (static_cast<std::uint32_t>(p[0]) << 16) |
+                               (static_cast<std::uint32_t>(p[1]) << 8) |
+                               static_cast<std::uint32_t>(p[2]);
+
+    return (word * 2654435761U) >> (32U - hash_bits);
+}
+
+/*  Compares eight bytes at a time until they differ, then byte by byte.      */
+inline unsigned int
+cvp::deflate::matcher::common_length(const unsigned char *a,
+                                     const unsigned char *b,
+                                     unsigned int limit)
+{
+    unsigned int n = 0U;
+
+    while (n + 8U <= limit)
+    {
+        std::uint64_t x, y;
+        std::memcpy(&x, a + n, sizeof(x));
+        std::memcpy(&y, b + n, sizeof(y));
+
+        if (x != y)
+            break;
+
+        n += 8U;
+    }
+
+    while (n < limit && a[n] == b[n])
+        ++n;
+
+    return n;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::deflate::matcher::find                                           *
+ *  Purpose:                                                                  *
+ *      Finds the longest earlier copy of the bytes at p.                     *
+ *  Arguments:                                                                *
+ *      p (std::size_t):                                                      *
+ *          Where the match starts. Must not be less than on the last call.   *
+ *      best (unsigned int):                                                  *
+ *          The length of a match already found, which must be beaten.        *
+ *      distance (std::size_t *):                                             *
+ *          Set to how far back the match is, if one is found.                *
+ *  Outputs:                                                                  *
+ *      length (unsigned int):                                                *
+ *          The length of the match, or zero if none is longer than best.     *
+ *  Method:                                                                   *
+ *      Hash every place before p that has not been hashed yet, then walk     *
+ *      the chain of earlier places with the same hash as p, newest first,    *
+ *      comparing bytes. Stop at the edge of the window, at the end of the    *
+ *      chain, after max_chain places, or once a match of nice_length turns   *
+ *      up. The chains are never cleared, so a place may also have been       *
+ *      overwritten by one a whole window later. Such a link points forward,  *
+ *      which ends the walk.                                                  *
+ ******************************************************************************/
+inline unsigned int
+cvp::deflate::matcher::find(std::size_t p, unsigned int best,
+                            std::size_t *distance)
+{
+    const std::size_t mask = window_size - 1U;
+    const std::size_t lowest = (p > window_size ? p - window_size : 0U);
+
+    /*  The longest match possible, and the one worth stopping at.            */
+    const unsigned int limit = static_cast<unsigned int>(
+        end - p < max_match ? end - p : max_match
+    );
+
+    const unsigned int nice =
+        (params.nice_length < limit ? params.nice_length : limit);
+
+    /*  Number of places left to try, the current place, and the length.      */
+    unsigned int chain = params.max_chain;
+    std::uint32_t current;
+    unsigned int length = best;
+
+    /*  Hash every earlier place that has three bytes after it.               */
+    while (next < p && next + min_match <= end)
+    {
+        const std::uint32_t h = hash(in + next);
+        prev[next & mask] = head[h];
+        head[h] = static_cast<std::uint32_t>(next + 1U);
+        ++next;
+    }
+
+    if (p + min_match > end || best >= limit)
+        return 0U;
+
+    if (best >= params.good_length)
+        chain >>= 2;
+
+    current = head[hash(in + p)];
+
+    while (current != 0U && chain > 0U)
+    {
+        const std::size_t c = current - 1U;
+        std::uint32_t link;
+        --chain;
+
+        if (c < lowest)
+            break;
+
+        /*  Check the byte that would make this match the longest first.      */
+        if (in[c + length] == in[p + length] && in[c] == in[p])
+        {
+            const unsigned int n = common_length(in + c, in + p, limit);
+
+            if (n > length)
+            {
+                length = n;
+                *distance = p - c;
+
+                if (n >= nice)
+                    break;
+            }
+        }
+
+        link = prev[c & mask];
+
+        if (link >= current)
+            break;
+
+        current = link;
+    }
+
+    return (length > best ? length : 0U);
+}
+/*  End of cvp::deflate::matcher::find.                                       */
+
+/*  Frees the hash tables.                                                    */
+inline void cvp::deflate::matcher::destroy(void)
+{
+    cvp::memory::aligned_free(head);
+    cvp::memory::aligned_free(prev);
+    head = prev = NULL;
+}
+
+/*  The sums are reduced mod 65521 every 5552 bytes, the most that can be     *
+ *  added before the second sum could overflow 32 bits.                       */
+inline std::uint32_t
+cvp::deflate::adler32(std::uint32_t adler, const unsigned char *data,
+                      std::size_t n)
+{
+    std::uint32_t a = adler & 0xFFFFU;
+    std::uint32_t b = adler >> 16;
+
+    while (n > 0U)
+    {
+        std::size_t k = (n < 5552U ? n : 5552U);
+        n -= k;
+
+        /*  Sixteen bytes at a time, which the compiler unrolls.              */
+        while (k >= 16U)
+        {
+            unsigned int m;
+
+            for (m = 0U; m < 16U; ++m)
+            {
+                a += data[m];
+                b += a;
+            }
+
+            data += 16U;
+            k -= 16U;
+        }
+
+        while (k > 0U)
+        {
+            a += *data;
+            b += a;
+            ++data;
+            --k;
+        }
+
+        a %= 65521U;
+        b %= 65521U;
+    }
+
+    return (b << 16) | a;
+}
+
+/*  Appending n bytes with sum a2 to data with sums a1 and b1 gives the sums  *
+ *  a1 + a2 - 1 and b1 + b2 + n (a1 - 1), all mod 65521. This is the same     *
+ *  combination zlib uses.                                                    */
+inline std::uint32_t
+cvp::deflate::adler32_combine(std::uint32_t first, std::uint32_t second,
+                              std::size_t n)
+{
+    const std::uint32_t base = 65521U;
+    const std::uint32_t remainder = static_cast<std::uint32_t>(n % base);
+    std::uint32_t a = first & 0xFFFFU;
+    std::uint32_t b = (remainder * a) % base;
+
+    a += (second & 0xFFFFU) + base - 1U;
+    b += (first >> 16) + (second >> 16) + base - remainder;
+
+    if (a >= base)
+        a -= base;
+
+    if (a >= base)
+        a -= base;
+
+    if (b >= 2U * base)
+        b -= 2U * base;
+
+    if (b >= base)
+        b -= base;
+
+    return (b << 16) | a;
+}
+
+/*  A block is never larger than storing its bytes, five bytes for each       *
+ *  stored block and one to reach a byte. Blocks hold 16384 symbols, so there *
+ *  are at most n / 16384 + 1 of them, plus one every 65535 stored bytes, and *
+ *  the empty block at the end of a piece.                                    */
+inline std::size_t cvp::deflate::bound(std::size_t n)
+{
+    return n + n / 1024U + 64U;
+}
+
+/*  The header tells how hard the stream was compressed, in four steps, and   *
+ *  is a multiple of 31. There is no dictionary.                              */
+inline unsigned char cvp::deflate::zlib_flags(unsigned int level)
+{
+    if (level < 2U)
+        return 0x01U;
+
+    if (level < 6U)
+        return 0x5EU;
+
+    return (level == 6U ? 0x9CU : 0xDAU);
+}
+
+/*  The codes of distances above 256 depend only on the distance over 128.    */
+inline unsigned int cvp::deflate::distance_code(unsigned int distance)
+{
+    const cvp::deflate::code_tables &t = cvp::deflate::tables();
+
+    if (distance <= 256U)
+        return t.distance_code[distance - 1U];
+
+    return t.distance_code[256U + ((distance - 1U) >> 7)];
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::deflate::code_lengths                                            *
+ *  Purpose:                                                                  *
+ *      Computes the lengths of a length-limited Huffman code.                *
+ *  Arguments:                                                                *
+ *      freq (const std::uint32_t *):                                         *
+ *          The frequency of each symbol.                                     *
+ *      n (unsigned int):                                                     *
+ *          The number of symbols, at most 288.                               *
+ *      limit (unsigned int):                                                 *
+ *          The longest allowed code, 15 or 7 for deflate.                    *
+ *      lengths (unsigned char *):                                            *
+ *          Set to the length of the code of each symbol, 0 if unused.        *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Sort the used symbols by frequency and find the optimal lengths with  *
+ *      the in-place algorithm of Moffat and Katajainen. If any is over the   *
+ *      limit, cap them at the limit and then lengthen the longest codes      *
+ *      below the limit until the code is complete again, as miniz does.      *
+ *      The most frequent symbols get the shortest lengths.                   *
+ *  Notes:                                                                    *
+ *      A single used symbol gets a 1 bit code. Inflate accepts this.         *
+ ******************************************************************************/
+inline void cvp::deflate::code_lengths(const std::uint32_t *freq,
+                                       unsigned int n, unsigned int limit,
+                                       unsigned char *lengths)
+{
+    /*  The used symbols in order of frequency, their weights (then their     *
+     *  lengths), and the number of codes of each length.                     */
+    unsigned int order[288];
+    long weight[288];
+    unsigned int count[33];
+
+    /*  Indices for the algorithm of Moffat and Katajainen.                   */
+    long root, leaf, next, available, used, depth;
+
+    /*  The number of used symbols, an index, and the Kraft sum.              */
+    unsigned int symbols = 0U, k, length;
+    std::uint32_t total = 0U;
+    cvp::deflate::by_frequency compare;
+
+    for (k = 0U; k < n; ++k)
+    {
+        lengths[k] = 0U;
+
+        if (freq[k] != 0U)
+        {
+            order[symbols] = k;
+            ++symbols;
+        }
+    }
+
+    if (symbols == 0U)
+        return;
+
+    if (symbols == 1U)
+    {
+        lengths[order[0]] = 1U;
+        return;
+    }
+
+    compare.freq = freq;
+    std::sort(order, order + symbols, compare);
+
+    for (k = 0U; k < symbols; ++k)
+        weight[k] = static_cast<long>(freq[order[k]]);
+
+    /*  First pass, build the tree in place, leaves and internal nodes in     *
+     *  increasing order of weight.                                           */
+    weight[0] += weight[1];
+    root = 0;
+    leaf = 2;
+
+    for (next = 1; next < static_cast<long>(symbols) - 1; ++next)
+    {
+        if (leaf >= static_cast<long>(symbols) || weight[root] < weight[leaf])
+        {
+            weight[next] = weight[root];
+            weight[root] = next;
+            ++root;
+        }
+        else
+        {
+            weight[next] = weight[leaf];
+            ++leaf;
+        }
+
+        if (leaf >= static_cast<long>(symbols) ||
+            (root < next && weight[root] < weight[leaf]))
+        {
+            weight[next] += weight[root];
+            weight[root] = next;
+            ++root;
+        }
+        else
+        {
+            weight[next] += weight[leaf];
+            ++leaf;
+        }
+    }
+
+    /*  Second pass, the depths of the internal nodes.                        */
+    weight[symbols - 2U] = 0;
+
+    for (next = static_cast<long>(symbols) - 3; next >= 0; --next)
+        weight[next] = weight[weight[next]] + 1;
+
+    /*  Third pass, the depths of the leaves.                                 */
+    available = 1;
+    used = depth = 0;
+    root = static_cast<long>(symbols) - 2;
+    next = static_cast<long>(symbols) - 1;
+
+    while (available > 0)
+    {
+        while (root >= 0 && weight[root] == depth)
+        {
+            ++used;
+            --root;
+        }
+
+        while (available > used)
+        {
+            weight[next] = depth;
+            --next;
+            --available;
+        }
+
+        available = 2 * used;
+        ++depth;
+        used = 0;
+    }
+
+    /*  Count the codes of each length, capping them at the limit.            */
+    for (k = 0U; k <= limit; ++k)
+        count[k] = 0U;
+
+    for (k = 0U; k < symbols; ++k)
+    {
+        length = static_cast<unsigned int>(weight[k]);
+        ++count[length < limit ? length : limit];
+    }
+
+    for (k = 1U; k <= limit; ++k)
+        total += count[k] << (limit - k);
+
+    /*  Too many short codes. Trade a code at the limit for splitting a       *
+     *  shorter one in two, which lowers the Kraft sum by one each time.      */
+    while (total > (1U << limit))
+    {
+        --count[limit];
+
+        for (k = limit - 1U; k > 0U; --k)
+        {
+            if (count[k] != 0U)
+            {
+                --count[k];
+                count[k + 1U] += 2U;
+                break;
+            }
+        }
+
+        --total;
+    }
+
+    /*  The most frequent symbols, at the end of the order, get the shortest. */
+    k = symbols;
+
+    for (length = 1U; length <= limit; ++length)
+    {
+        unsigned int m;
+
+        for (m = 0U; m < count[length]; ++m)
+        {
+            --k;
+            lengths[order[k]] = static_cast<unsigned char>(length);
+        }
+    }
+}
+/*  End of cvp::deflate::code_lengths.                                        */
+
+/*  Canonical codes, section 3.2.2 of RFC 1951, reversed since deflate writes *
+ *  Huffman codes starting from their most significant bit.                   */
+inline void cvp::deflate::canonical_codes(const unsigned char *lengths,
+                                          unsigned int n,
+                                          std::uint16_t *codes)
+{
+    /*  The number of codes of each length, and the next code of each length. */
+    unsigned int count[16], next[16];
+    unsigned int k, bits, code = 0U;
+
+    for (k = 0U; k < 16U; ++k)
+        count[k] = 0U;
+
+    for (k = 0U; k < n; ++k)
+        ++count[lengths[k]];
+
+    count[0] = 0U;
+
+    for (bits = 1U; bits < 16U; ++bits)
+    {
+        code = (code + count[bits - 1U]) << 1;
+        next[bits] = code;
+    }
+
+    for (k = 0U; k < n; ++k)
+    {
+        const unsigned int length = lengths[k];
+        unsigned int reversed = 0U;
+
+        codes[k] = 0U;
+
+        if (length == 0U)
+            continue;
+
+        code = next[length];
+        ++next[length];
+
+        for (bits = 0U; bits < length; ++bits)
+            reversed |= ((code >> bits) & 1U) << (length - 1U - bits);
+
+        codes[k] = static_cast<std::uint16_t>(reversed);
+    }
+}
+
+/*  Stored blocks hold at most 65535 bytes, after the header bits, padding to *
+ *  a byte, and the length and its complement.                                */
+inline void cvp::deflate::write_stored(cvp::deflate::bit_writer &bits,
+                                       const unsigned char *data,
+                                       std::size_t n, bool last)
+{
+    do {
+        const std::size_t piece = (n < 65535U ? n : 65535U);
+        const bool final_block = (last && piece == n);
+
+        bits.put(final_block ? 1U : 0U, 1U);
+        bits.put(0U, 2U);
+        bits.align();
+        bits.put(static_cast<std::uint32_t>(piece), 16U);
+        bits.put(static_cast<std::uint32_t>(~piece & 0xFFFFU), 16U);
+        bits.align();
+
+        if (piece != 0U)
+            bits.copy(data, piece);
+
+        data += piece;
+        n -= piece;
+    } while (n > 0U);
+}
+
+/*  Literals are written with their code. Matches are written as a length     *
+ *  code and its extra bits, then a distance code and its extra bits.         */
+inline void
+cvp::deflate::write_symbols(cvp::deflate::bit_writer &bits,
+                            const cvp::deflate::symbol *symbols,
+                            unsigned int count, const std::uint16_t *codes,
+                            const unsigned char *lengths,
+                            const std::uint16_t *distance_codes,
+                            const unsigned char *distance_lengths)
+{
+    const cvp::deflate::code_tables &t = cvp::deflate::tables();
+    unsigned int k;
+
+    for (k = 0U; k < count; ++k)
+    {
+        const unsigned int value = symbols[k].value;
+        const unsigned int distance = symbols[k].distance;
+        unsigned int code;
+
+        if (distance == 0U)
+        {
+            bits.put(codes[value], lengths[value]);
+            continue;
+        }
+
+        code = t.length_code[value];
+        bits.put(codes[257U + code], lengths[257U + code]);
+
+        if (cvp::deflate::length_extra[code] != 0U)
+            bits.put(value - cvp::deflate::length_base[code],
+                     cvp::deflate::length_extra[code]);
+
+        code = cvp::deflate::distance_code(distance);
+        bits.put(distance_codes[code], distance_lengths[code]);
+
+        if (cvp::deflate::distance_extra[code] != 0U)
+            bits.put(distance - cvp::deflate::distance_base[code],
+                     cvp::deflate::distance_extra[code]);
+    }
+
+    /*  The end of the block.                                                 */
+    bits.put(codes[256], lengths[256]);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::deflate::write_block                                             *
+ *  Purpose:                                                                  *
+ *      Writes a block of symbols in the smallest of the three block types.   *
+ *  Arguments:                                                                *
+ *      bits (cvp::deflate::bit_writer &):                                    *
+ *          The output.                                                       *
+ *      symbols (const cvp::deflate::symbol *):                               *
+ *          The literals and matches of the block.                            *
+ *      count (unsigned int):                                                 *
+ *          The number of symbols.                                            *
+ *      data (const unsigned char *):                                         *
+ *          The bytes the symbols stand for, in case storing them is smaller. *
+ *      n (std::size_t):                                                      *
+ *          The number of bytes.                                              *
+ *      last (bool):                                                          *
+ *          Whether this is the final block of the stream.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Count the symbols, build Huffman codes for the literals and lengths   *
+ *      and for the distances, and run-length code their lengths with the     *
+ *      symbols 16, 17, and 18 of the code length alphabet. Work out the size *
+ *      in bits of the block with these codes, with the fixed codes, and      *
+ *      stored, and write the smallest.                                       *
+ ******************************************************************************/
+inline void cvp::deflate::write_block(cvp::deflate::bit_writer &bits,
+                                      const cvp::deflate::symbol *symbols,
+                                      unsigned int count,
+                                      const unsigned char *data,
+                                      std::size_t n, bool last)
+{
+    const cvp::deflate::code_tables &t = cvp::deflate::tables();
+
+    /*  Frequencies, lengths, and codes of the three alphabets.               */
+    std::uint32_t freq[286], distance_freq[30], length_freq[19];
+    unsigned char lengths[286], distance_lengths[30], length_lengths[19];
+    std::uint16_t codes[286], distance_codes[30], length_codes[19];
+
+    /*  The lengths of both codes in a row, and their run-length coding.      */
+    unsigned char all[286 + 30], runs[286 + 30], run_extra[286 + 30];
+    unsigned int literals = 286U, distances = 30U, orders = 19U, run_count = 0U;
+
+    /*  The sizes of the three kinds of block in bits, and extra bits.        */
+    std::uint64_t dynamic_bits, fixed_bits, stored_bits, extra = 0U;
+
+    /*  Indices for the symbols and the lengths.                              */
+    unsigned int k, m;
+
+    for (k = 0U; k < 286U; ++k)
+        freq[k] = 0U;
+
+    for (k = 0U; k < 30U; ++k)
+        distance_freq[k] = 0U;
+
+    for (k = 0U; k < 19U; ++k)
+        length_freq[k] = 0U;
+
+    for (k = 0U; k < count; ++k)
+    {
+        unsigned int code;
+
+        if (symbols[k].distance == 0U)
+        {
+            ++freq[symbols[k].value];
+            continue;
+        }
+
+        code = t.length_code[symbols[k].value];
+        ++freq[257U + code];
+        extra += cvp::deflate::length_extra[code];
+
+        code = cvp::deflate::distance_code(symbols[k].distance);
+        ++distance_freq[code];
+        extra += cvp::deflate::distance_extra[code];
+    }
+
+    freq[256] = 1U;
+
+    cvp::deflate::code_lengths(freq, 286U, 15U, lengths);
+    cvp::deflate::code_lengths(distance_freq, 30U, 15U, distance_lengths);
+
+    /*  There must be at least one distance code, even if it is never used.   */
+    for (k = 0U; k < 30U; ++k)
+    {
+        if (distance_lengths[k] != 0U)
+            break;
+    }
+
+    if (k == 30U)
+        distance_lengths[0] = 1U;
+
+    while (literals > 257U && lengths[literals - 1U] == 0U)
+        --literals;
+
+    while (distances > 1U && distance_lengths[distances - 1U] == 0U)
+        --distances;
+
+    std::memcpy(all, lengths, literals);
+    std::memcpy(all + literals, distance_lengths, distances);
+
+    /*  Run-length code the lengths. 16 repeats the last length 3 to 6 times, *
+     *  17 gives 3 to 10 zeros and 18 gives 11 to 138 zeros.                  */
+    k = 0U;
+
+    while (k < literals + distances)
+    {
+        const unsigned char length = all[k];
+        unsigned int run = 1U;
+
+        while (k + run < literals + distances && all[k + run] == length)
+            ++run;
+
+        k += run;
+
+        if (length == 0U)
+        {
+            while (run >= 11U)
+            {
+                const unsigned int piece = (run < 138U ? run : 138U);
+                runs[run_count] = 18U;
+                run_extra[run_count] = static_cast<unsigned char>(piece - 11U);
+                ++run_count;
+                run -= piece;
+            }
+
+            if (run >= 3U)
+            {
+                runs[run_count] = 17U;
+                run_extra[run_count] = static_cast<unsigned char>(run - 3U);
+                ++run_count;
+                run = 0U;
+            }
+        }
+        else
+        {
+            runs[run_count] = length;
+            ++run_count;
+            --run;
+
+            while (run >= 3U)
+            {
+                const unsigned int piece = (run < 6U ? run : 6U);
+                runs[run_count] = 16U;
+                run_extra[run_count] = static_cast<unsigned char>(piece - 3U);
+                ++run_count;
+                run -= piece;
+            }
+        }
+
+        /*  Whatever is left is too short for a repeat.                       */
+        for (m = 0U; m < run; ++m)
+        {
+            runs[run_count] = length;
+            ++run_count;
+        }
+    }
+
+    for (k = 0U; k < run_count; ++k)
+        ++length_freq[runs[k]];
+
+    cvp::deflate::code_lengths(length_freq, 19U, 7U, length_lengths);
+
+    while (orders > 4U &&
+           length_lengths[cvp::deflate::code_length_order[orders - 1U]] == 0U)
+        --orders;
+
+    /*  The header of a dynamic block, then the code lengths.                 */
+    dynamic_bits = 3U + 5U + 5U + 4U + 3U * orders;
+
+    for (k = 0U; k < 19U; ++k)
+        dynamic_bits += static_cast<std::uint64_t>(length_freq[k]) *
+                        length_lengths[k];
+
+    dynamic_bits += 2U * length_freq[16] + 3U * length_freq[17] +
+                    7U * length_freq[18];
+
+    fixed_bits = 3U;
+
+    for (k = 0U; k < 286U; ++k)
+    {
+        dynamic_bits += static_cast<std::uint64_t>(freq[k]) * lengths[k];
+        fixed_bits += static_cast<std::uint64_t>(freq[k]) * t.fixed_length[k];
+    }
+
+    for (k = 0U; k < 30U; ++k)
+    {
+        dynamic_bits +=
+            static_cast<std::uint64_t>(distance_freq[k]) * distance_lengths[k];
+        fixed_bits += 5U * static_cast<std::uint64_t>(distance_freq[k]);
+    }
+
+    dynamic_bits += extra;
+    fixed_bits += extra;
+
+    /*  At most 10 bits to reach a byte, and 32 for each length and its       *
+     *  complement, for every 65535 bytes.                                    */
+    stored_bits = 8U * static_cast<std::uint64_t>(n) +
+                  42U * (n / 65535U + 1U);
+
+    if (stored_bits < dynamic_bits && stored_bits < fixed_bits)
+    {
+        cvp::deflate::write_stored(bits, data, n, last);
+        return;
+    }
+
+    bits.put(last ? 1U : 0U, 1U);
+
+    if (fixed_bits <= dynamic_bits)
+    {
+        bits.put(1U, 2U);
+        cvp::deflate::write_symbols(
+            bits, symbols, count, t.fixed_code, t.fixed_length,
+            t.fixed_distance_code, t.fixed_distance_length
+        );
+
+        return;
+    }
+
+    cvp::deflate::canonical_codes(lengths, 286U, codes);
+    cvp::deflate::canonical_codes(distance_lengths, 30U, distance_codes);
+    cvp::deflate::canonical_codes(length_lengths, 19U, length_codes);
+
+    bits.put(2U, 2U);
+    bits.put(literals - 257U, 5U);
+    bits.put(distances - 1U, 5U);
+    bits.put(orders - 4U, 4U);
+
+    for (k = 0U; k < orders; ++k)
+        bits.put(length_lengths[cvp::deflate::code_length_order[k]], 3U);
+
+    for (k = 0U; k < run_count; ++k)
+    {
+        const unsigned int code = runs[k];
+        bits.put(length_codes[code], length_lengths[code]);
+
+        if (code == 16U)
+            bits.put(run_extra[k], 2U);
+        else if (code == 17U)
+            bits.put(run_extra[k], 3U);
+        else if (code == 18U)
+            bits.put(run_extra[k], 7U);
+    }
+
+    cvp::deflate::write_symbols(
+        bits, symbols, count, codes, lengths, distance_codes, distance_lengths
+    );
+}
+/*  End of cvp::deflate::write_block.                                         */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::deflate::compress                                                *
+ *  Purpose:                                                                  *
+ *      Compresses a piece of a deflate stream.                               *
+ *  Arguments:                                                                *
+ *      in (const unsigned char *):                                           *
+ *          The data. Bytes before start are history that matches may refer   *
+ *          back to, and only the last window_size of them are used.          *
+ *      start (std::size_t):                                                  *
+ *          The first byte to compress.                                       *
+ *      end (std::size_t):                                                    *
+ *          One past the last byte to compress.                               *
+ *      level (unsigned int):                                                 *
+ *          0 to store, 1 for runs only, and 2 to 9 for harder searches.      *
+ *      last (bool):                                                          *
+ *          Whether this is the last piece of the stream.                     *
+ *      out (unsigned char *):                                                *
+ *          Room for bound(end - start) bytes.                                *
+ *  Outputs:                                                                  *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes written to out, zero if malloc failed.        *
+ *  Method:                                                                   *
+ *      Parse the data into literals and matches, lazily for levels 4 and up  *
+ *      as zlib does, where a match is put off by a byte if a longer one      *
+ *      starts there. Level 1 only looks one byte back, which finds runs of   *
+ *      a repeated byte. Every 16384 symbols are written as one block.        *
+ *  Notes:                                                                    *
+ *      This is how pigz compresses a stream on many threads. The pieces are  *
+ *      independent, but each is primed with the 32 kB before it, so little   *
+ *      is lost by splitting. Since each ends on a byte, the compressed       *
+ *      pieces are concatenated to give one valid stream.                     *
+ ******************************************************************************/
+inline std::size_t
+cvp::deflate::compress(const unsigned char *in, std::size_t start,
+                       std::size_t end, unsigned int level, bool last,
+                       unsigned char *out)
+{
+    cvp::deflate::bit_writer bits = cvp::deflate::bit_writer(out);
+
+    /*  The symbols of the current block, and how many there are.             */
+    cvp::deflate::symbol *symbols;
+    unsigned int count = 0U;
+
+    /*  The current place, and where the current block started.               */
+    std::size_t p = start, block = start;
+
+    /*  Level 0 needs no parsing at all.                                      */
+    if (level == cvp::deflate::stored_level)
+    {
+        cvp::deflate::write_stored(bits, in + start, end - start, last);
+        return bits.size;
+    }
+
+    symbols = static_cast<cvp::deflate::symbol *>(
+        cvp::memory::aligned_malloc(
+            sizeof(cvp::deflate::symbol) * block_symbols
+        )
+    );
+
+    if (!symbols)
+        return 0U;
+
+    cvp::deflate::matcher match = cvp::deflate::matcher(in, start, end, level);
+
+    if (!match.head || !match.prev)
+    {
+        match.destroy();
+        cvp::memory::aligned_free(symbols);
+        return 0U;
+    }
+
+    while (p < end)
+    {
+        std::size_t distance = 0U, later = 0U;
+        unsigned int length = 0U;
+
+        /*  Runs are matches one byte back.                                   */
+        if (level == cvp::deflate::rle_level)
+        {
+            const std::size_t left = end - p;
+            const unsigned int limit = static_cast<unsigned int>(
+                left < max_match ? left : max_match
+            );
+
+            if (p > 0U)
+            {
+                while (length < limit && in[p + length] == in[p - 1U])
+                    ++length;
+            }
+
+            distance = 1U;
+        }
+        else
+        {
+            length = match.find(p, min_match - 1U, &distance);
+
+            /*  A short match far away costs more than the literals.          */
+            if (length == min_match && distance > 4096U)
+                length = 0U;
+
+            /*  Lazy matching. While the next byte starts a longer match,     *
+             *  write this byte as a literal and take that one instead.       */
+            while (length >= min_match && length < match.params.max_lazy &&
+                   p + 1U < end)
+            {
+                const unsigned int next_length =
+                    match.find(p + 1U, length, &later);
+
+                if (next_length == 0U)
+                    break;
+
+                symbols[count].value = in[p];
+                symbols[count].distance = 0U;
+                ++count;
+                ++p;
+
+                length = next_length;
+                distance = later;
+
+                if (count == block_symbols)
+                {
+                    cvp::deflate::write_block(
+                        bits, symbols, count, in + block, p - block, false
+                    );
+
+                    block = p;
+                    count = 0U;
+                }
+            }
+        }
+
+        if (length >= min_match)
+        {
+            symbols[count].value = static_cast<std::uint16_t>(length);
+            symbols[count].distance = static_cast<std::uint16_t>(distance);
+            p += length;
+        }
+        else
+        {
+            symbols[count].value = in[p];
+            symbols[count].distance = 0U;
+            ++p;
+        }
+
+        ++count;
+
+        if (count == block_symbols && p < end)
+        {
+            cvp::deflate::write_block(
+                bits, symbols, count, in + block, p - block, false
+            );
+
+            block = p;
+            count = 0U;
+        }
+    }
+
+    /*  The last block, final if this is the last piece.                      */
+    cvp::deflate::write_block(
+        bits, symbols, count, in + block, p - block, last
+    );
+
+    /*  Otherwise end on a byte with an empty stored block, a sync flush.     */
+    if (last)
+        bits.align();
+    else
+        cvp::deflate::write_stored(bits, NULL, 0U, false);
+
+    match.destroy();
+    cvp::memory::aligned_free(symbols);
+    return bits.size;
+}
+/*  End of cvp::deflate::compress.                                            */
+
+#endif
+/*  End of include guard.                                                     */
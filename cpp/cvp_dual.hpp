@@ -0,0 +1,212 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides dual numbers over the complex types, which carry the value   *
+ *      of a function together with its derivative (forward differentiation). *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_DUAL_HPP
+#define CVP_DUAL_HPP
+
+/*  std::declval, used to detect functions that can be called on duals.       */
+#include <utility>
+
+/*  std::enable_if and std::is_convertible found here.                        */
+#include <type_traits>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, which may also be differentiated.             */
+#include "cvp_batch.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Class for a value and its derivative, a + b eps with eps^2 = 0. T is  *
+     *  a complex type, like cvp::basic_complex or cvp::complex_batch.        */
+    template <typename T>
+    class dual {
+        public:
+            /*  The value of the function and its derivative.                 */
+            T value, deriv;
+
+            /*  Empty constructor.                                            */
+            dual(void);
+
+            /*  Constructor from the value and the derivative.                */
+            dual(const T &v, const T &d);
+    };
+    /*  End of "dual" class.                                                  */
+
+    /*  Creates the independent variable z, the dual with derivative one.     */
+    template <typename T>
+    inline cvp::dual<T> dual_variable(const T &z);
+
+    /*  Tells whether a function can be called on cvp::dual<T> and returns    *
+     *  one. Derives from std::true_type if so, and std::false_type if not.   */
+    template <typename Tfunc, typename T>
+    class is_dual_callable {
+        private:
+            template <typename U>
+            static std::true_type test(
+                typename std::enable_if<
+                    std::is_convertible<
+                        decltype(std::declval<const U &>()(
+                            std::declval<const cvp::dual<T> &>()
+                        )),
+                        cvp::dual<T>
+                    >::value, int
+                >::type
+            );
+
+            template <typename U>
+            static std::false_type test(...);
+
+        public:
+            typedef decltype(test<Tfunc>(0)) type;
+            static const bool value = type::value;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, simply return.                                         */
+template <typename T>
+cvp::dual<T>::dual(void)
+{
+    return;
+}
+
+/*  Constructor from the value and the derivative.                            */
+template <typename T>
+cvp::dual<T>::dual(const T &v, const T &d) : value(v), deriv(d)
+{
+    return;
+}
+
+/*  The variable z has derivative one. T(1) is written as a conversion from   *
+ *  cvp::complex, which works for every precision and for batches.            */
+template <typename T>
+inline cvp::dual<T> cvp::dual_variable(const T &z)
+{
+    return cvp::dual<T>(z, T(cvp::complex(1.0, 0.0)));
+}
+
+/*  The operators mixing a dual with a constant take the constant as any type *
+ *  U that the value can be combined with. This allows doubles, ints, and     *
+ *  cvp::complex coefficients with duals of every complex type, batches too.  *
+ *  The constant has derivative zero, so it only touches the value, or scales *
+ *  the derivative.                                                           */
+
+/*  Addition of duals. The derivative of a sum is the sum of derivatives.     */
+template <typename T>
+inline cvp::dual<T> operator + (const cvp::dual<T> &z, const cvp::dual<T> &w)
+{
+    return cvp::dual<T>(z.value + w.value, z.deriv + w.deriv);
+}
+
+/*  Addition of a dual and a constant. The derivative is unchanged.           */
+template <typename T, typename U>
+inline cvp::dual<T> operator + (const cvp::dual<T> &z, const U &a)
+{
+    return cvp::dual<T>(z.value + a, z.deriv);
+}
+
+/*  Addition of a constant and a dual. The derivative is unchanged.           */
+template <typename T, typename U>
+inline cvp::dual<T> operator + (const U &a, const cvp::dual<T> &z)
+{
+    return cvp::dual<T>(a + z.value, z.deriv);
+}
+
+/*  Subtraction of duals, performed on the values and derivatives.            */
+template <typename T>
+inline cvp::dual<T> operator - (const cvp::dual<T> &z, const cvp::dual<T> &w)
+{
+    return cvp::dual<T>(z.value - w.value, z.deriv - w.deriv);
+}
+
+/*  Subtraction of a constant from a dual. The derivative is unchanged.       */
+template <typename T, typename U>
+inline cvp::dual<T> operator - (const cvp::dual<T> &z, const U &a)
+{
+    return cvp::dual<T>(z.value - a, z.deriv);
+}
+
+/*  Subtraction of a dual from a constant. The derivative is negated.         */
+template <typename T, typename U>
+inline cvp::dual<T> operator - (const U &a, const cvp::dual<T> &z)
+{
+    return cvp::dual<T>(a - z.value, 0.0 - z.deriv);
+}
+
+/*  Product of duals, using the product rule (uv)' = u'v + uv'.               */
+template <typename T>
+inline cvp::dual<T> operator * (const cvp::dual<T> &z, const cvp::dual<T> &w)
+{
+    return cvp::dual<T>(
+        z.value * w.value, z.deriv * w.value + z.value * w.deriv
+    );
+}
+
+/*  Product of a dual and a constant. Both parts are scaled.                  */
+template <typename T, typename U>
+inline cvp::dual<T> operator * (const cvp::dual<T> &z, const U &a)
+{
+    return cvp::dual<T>(z.value * a, z.deriv * a);
+}
+
+/*  Product of a constant and a dual. Both parts are scaled.                  */
+template <typename T, typename U>
+inline cvp::dual<T> operator * (const U &a, const cvp::dual<T> &z)
+{
+    return cvp::dual<T>(a * z.value, a * z.deriv);
+}
+
+/*  Quotient of duals. With q = u / v, the quotient rule is written as        *
+ *  (u / v)' = (u' - q v') / v, which reuses q and saves a product.           */
+template <typename T>
+inline cvp::dual<T> operator / (const cvp::dual<T> &z, const cvp::dual<T> &w)
+{
+    const T q = z.value / w.value;
+    return cvp::dual<T>(q, (z.deriv - q * w.deriv) / w.value);
+}
+
+/*  Quotient of a dual and a constant. Both parts are divided.                */
+template <typename T, typename U>
+inline cvp::dual<T> operator / (const cvp::dual<T> &z, const U &a)
+{
+    return cvp::dual<T>(z.value / a, z.deriv / a);
+}
+
+/*  Quotient of a constant and a dual. (a / v)' = -(a / v) v' / v.            */
+template <typename T, typename U>
+inline cvp::dual<T> operator / (const U &a, const cvp::dual<T> &z)
+{
+    const T q = a / z.value;
+    return cvp::dual<T>(q, 0.0 - q * z.deriv / z.value);
+}
+
+#endif
+/*  End of include guard.                                                     */
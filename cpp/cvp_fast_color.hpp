@@ -0,0 +1,348 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a fast coloring mode. The argument and the intensity of a    *
+ *      complex number are found with low degree approximations of atan,      *
+ *      which only need to be good to a fraction of an 8-bit step.            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_FAST_COLOR_HPP
+#define CVP_FAST_COLOR_HPP
+
+/*  sqrt and copysign provided here.                                          */
+#include <cmath>
+
+/*  Complex class defined here.                                               */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, colored a whole batch at a time.              */
+#include "cvp_batch.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  The rainbow wheel is looked up from its palette.                          */
+#include "cvp_palette.hpp"
+
+/*  CVP_MATH_INLINE macro found here.                                         */
+#include "cvp_math.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Approximations for coloring, where the results are rounded to 8 bits. *
+     *  The template parameter "terms" is the accuracy knob, the number of    *
+     *  terms of the odd polynomial used for atan on [0, 1].                  */
+    namespace fast {
+
+        /*  Minimax polynomials P with x P(x^2) ~ atan(x) for 0 <= x <= 1.    *
+         *  The maximum errors, in radians, are:                              *
+         *      terms = 3: 6.1E-04                                            *
+         *      terms = 4: 8.2E-05                                            *
+         *      terms = 5: 1.2E-05                                            *
+         *      terms = 6: 1.7E-06                                            *
+         *      terms = 7: 2.5E-07                                            *
+         *  Other numbers of terms are not defined.                           */
+        template <unsigned int terms>
+        class atan_poly;
+
+        template <>
+        class atan_poly<3U> {
+            public:
+                static CVP_MATH_INLINE double eval(double x2)
+                {
+                    return 0.99535795475045585 + x2*(
+                        -0.28869023801217869 + x2*0.079339041418980114
+                    );
+                }
+        };
+
+        template <>
+        class atan_poly<4U> {
+            public:
+                static CVP_MATH_INLINE double eval(double x2)
+                {
+                    return 0.99921381257023445 + x2*(
+                        -0.32117496930513478 + x2*(
+                            0.14626446358551529 + x2*-0.038986514158480694
+                        )
+                    );
+                }
+        };
+
+        template <>
+        class atan_poly<5U> {
+            public:
+                static CVP_MATH_INLINE double eval(double x2)
+                {
+                    return 0.99986632946731757 + x2*(
+                        -0.33030478552470849 + x2*(
+                            0.180159294697227 + x2*(
+                                -0.08515635089522737 + x2*0.020845114194423729
+                            )
+                        )
+                    );
+                }
+        };
+
+        template <>
+        class atan_poly<6U> {
+            public:
+                static CVP_MATH_INLINE double eval(double x2)
+                {
+                    return 0.99997721908225323 + x2*(
+                        -0.3326228278902576 + x2*(
+                            0.19354037608393043 + x2*(
+                                -0.11642648196997651 + x2*(
+                                    0.052647351465896407 +
+                                    x2*-0.011719135734256725
+                                )
+                            )
+                        )
+                    );
+                }
+        };
+
+        template <>
+        class atan_poly<7U> {
+            public:
+                static CVP_MATH_INLINE double eval(double x2)
+                {
+                    return 0.99999611154957091 + x2*(
+                        -0.3331736805474933 + x2*(
+                            0.19807815564989179 + x2*(
+                                -0.13233342095574629 + x2*(
+                                    0.079623672365616585 + x2*(
+                                        -0.033604220565024996 +
+                                        x2*0.0068117932908732517
+                                    )
+                                )
+                            )
+                        )
+                    );
+                }
+        };
+
+        /*  The fewest terms that keep the color wheel within half an 8-bit   *
+         *  step of the exact one, see color_wheel_from_complex below.        */
+        static const unsigned int default_terms = 3U;
+
+        /*  Arctangent of a non-negative number, or NaN.                      */
+        template <unsigned int terms>
+        CVP_MATH_INLINE double atan(double x);
+
+        /*  Two-argument arctangent, atan2(0, 0) is 0.                        */
+        template <unsigned int terms>
+        CVP_MATH_INLINE double atan2(double y, double x);
+
+        /*  color_wheel_from_complex with the approximations.                 */
+        template <unsigned int terms>
+        CVP_MATH_INLINE cvp::color color_wheel_from_complex(cvp::complex z);
+
+        /*  The same, for the n points re[k] + i im[k], writing packed RGB    *
+         *  to out. The math is vectorized.                                   */
+        template <unsigned int terms>
+        inline void color_wheel_row(const double *re, const double *im,
+                                    unsigned int n, cvp::color *out);
+
+        /*  The same, for every lane of a batch. out must have room for N     *
+         *  colors.                                                           */
+        template <unsigned int terms, unsigned int N>
+        inline void
+        color_wheel_from_complex(const cvp::complex_batch<N> &z,
+                                 cvp::color *out);
+    }
+    /*  End of namespace "fast".                                              */
+
+    /*  The fast color wheel at the default accuracy, for passing to the      *
+     *  plotting routines in place of color_wheel_from_complex.               */
+    inline cvp::color fast_color_wheel_from_complex(cvp::complex z);
+
+    /*  Row version of fast_color_wheel_from_complex.                         */
+    inline void fast_color_wheel_from_complex_row(const double *re,
+                                                  const double *im,
+                                                  unsigned int n,
+                                                  cvp::color *out);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  For x > 1 use atan(x) = pi/2 - atan(1/x). Both sides are computed, with   *
+ *  a single division, and the result selected. x = inf gives pi/2.           */
+template <unsigned int terms>
+CVP_MATH_INLINE double cvp::fast::atan(double x)
+{
+    const bool is_large = (x > 1.0);
+    const double num = (is_large ? 1.0 : x);
+    const double den = (is_large ? x : 1.0);
+    const double a = num / den;
+    const double p = a * cvp::fast::atan_poly<terms>::eval(a*a);
+    return (is_large ? 0.5 * M_PI - p : p);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fast::atan2                                                      *
+ *  Purpose:                                                                  *
+ *      Computes the angle of the point (x, y), between -pi and pi.           *
+ *  Arguments:                                                                *
+ *      y (double):                                                           *
+ *          The y coordinate of the point.                                    *
+ *      x (double):                                                           *
+ *          The x coordinate of the point.                                    *
+ *  Outputs:                                                                  *
+ *      theta (double):                                                       *
+ *          The angle of the point.                                           *
+ *  Method:                                                                   *
+ *      With a = min(|x|, |y|) / max(|x|, |y|) in [0, 1], the angle in the    *
+ *      first octant is a P(a^2). This is reflected across y = x if |y| > |x| *
+ *      and across the y axis if x < 0, and takes the sign of y. Every step   *
+ *      is a select, so there are no branches.                                *
+ *  Notes:                                                                    *
+ *      The error is that of atan_poly<terms>. The reflections are exact up   *
+ *      to the rounding of pi/2 - p and pi - p. x and y both infinite give    *
+ *      NaN, as does a NaN input.                                             *
+ ******************************************************************************/
+template <unsigned int terms>
+CVP_MATH_INLINE double cvp::fast::atan2(double y, double x)
+{
+    const double ax = (x < 0.0 ? -x : x);
+    const double ay = (y < 0.0 ? -y : y);
+    const bool is_steep = (ay > ax);
+    const double num = (is_steep ? ax : ay);
+    const double big = (is_steep ? ay : ax);
+
+    /*  Avoid 0 / 0 at the origin, which is given the angle 0.                */
+    const double den = (big > 0.0 ? big : 1.0);
+    const double a = num / den;
+
+    /*  The angle in the first octant, then reflected into place.             */
+    const double p = a * cvp::fast::atan_poly<terms>::eval(a*a);
+    const double q = (is_steep ? 0.5 * M_PI - p : p);
+    const double r = (x < 0.0 ? M_PI - q : q);
+    return std::copysign(r, y);
+}
+/*  End of cvp::fast::atan2.                                                  */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fast::color_wheel_from_complex                                   *
+ *  Purpose:                                                                  *
+ *      Creates an RGB color from a complex number, as in                     *
+ *      cvp::color_wheel_from_complex, with approximations of atan.           *
+ *  Arguments:                                                                *
+ *      z (cvp::complex):                                                     *
+ *          A complex number.                                                 *
+ *  Outputs:                                                                  *
+ *      c (cvp::color):                                                       *
+ *          The color given by the modulus and argument of the input.         *
+ *  Method:                                                                   *
+ *      The argument is scaled to the index (arg(z) + pi) * 1535 / (2 pi) of  *
+ *      the wheel, and the color is scaled by atan(5|z|) / (pi / 2). The      *
+ *      modulus uses the hardware square root.                                *
+ *  Notes:                                                                    *
+ *      An error E in atan moves the index by E * 1535 / (2 pi), and each     *
+ *      channel by at most E * 255 / (pi / 2). For three terms these are 0.15 *
+ *      and 0.10 steps, under half a step as required. More terms make the    *
+ *      results agree with the exact colorer more often, since a channel only *
+ *      changes when the error crosses an integer. fast_color_accuracy.cpp    *
+ *      checks these bounds against the C library.                            *
+ ******************************************************************************/
+template <unsigned int terms>
+CVP_MATH_INLINE cvp::color cvp::fast::color_wheel_from_complex(cvp::complex z)
+{
+    /*  Factors for the index of the wheel and for the intensity.             */
+    const double gradient_factor = 1535.0 / (2.0 * M_PI);
+    const double intensity_factor = 1.0 / (0.5 * M_PI);
+
+    const double arg_z = cvp::fast::atan2<terms>(z.imag, z.real);
+    const double abs_z = std::sqrt(z.real*z.real + z.imag*z.imag);
+    const double val = (arg_z + M_PI) * gradient_factor;
+    const double t = cvp::fast::atan<terms>(5.0*abs_z) * intensity_factor;
+
+    return cvp::palettes::wheel().at(val) * t;
+}
+/*  End of cvp::fast::color_wheel_from_complex.                               */
+
+/*  The index and intensity of every point in a block are computed first, in  *
+ *  a loop with no branches or calls that is vectorized. The table lookups    *
+ *  are then done one point at a time. The formulas are the same as the       *
+ *  scalar version's, and so are the colors.                                  */
+template <unsigned int terms>
+inline void cvp::fast::color_wheel_row(const double *re, const double *im,
+                                       unsigned int n, cvp::color *out)
+{
+    const double gradient_factor = 1535.0 / (2.0 * M_PI);
+    const double intensity_factor = 1.0 / (0.5 * M_PI);
+    const cvp::palette &wheel = cvp::palettes::wheel();
+
+    /*  The indices and intensities of a block are kept on the stack.         */
+    const unsigned int block = 256U;
+    double val[block], t[block];
+    unsigned int start, k;
+
+    for (start = 0U; start < n; start += block)
+    {
+        const unsigned int m = (n - start < block ? n - start : block);
+
+        for (k = 0U; k < m; ++k)
+        {
+            const double x = re[start + k];
+            const double y = im[start + k];
+            const double arg_z = cvp::fast::atan2<terms>(y, x);
+            const double abs_z = std::sqrt(x*x + y*y);
+            val[k] = (arg_z + M_PI) * gradient_factor;
+            t[k] = cvp::fast::atan<terms>(5.0*abs_z) * intensity_factor;
+        }
+
+        for (k = 0U; k < m; ++k)
+            out[start + k] = wheel.at(val[k]) * t[k];
+    }
+}
+
+/*  A batch is a short row.                                                   */
+template <unsigned int terms, unsigned int N>
+inline void
+cvp::fast::color_wheel_from_complex(const cvp::complex_batch<N> &z,
+                                    cvp::color *out)
+{
+    cvp::fast::color_wheel_row<terms>(z.real, z.imag, N, out);
+}
+
+/*  The fast color wheel with the default number of terms.                    */
+inline cvp::color cvp::fast_color_wheel_from_complex(cvp::complex z)
+{
+    return cvp::fast::color_wheel_from_complex<cvp::fast::default_terms>(z);
+}
+
+/*  The fast color wheel for a row, with the default number of terms.         */
+inline void cvp::fast_color_wheel_from_complex_row(const double *re,
+                                                   const double *im,
+                                                   unsigned int n,
+                                                   cvp::color *out)
+{
+    cvp::fast::color_wheel_row<cvp::fast::default_terms>(re, im, n, out);
+}
+
+#endif
+/*  End of include guard.                                                     */
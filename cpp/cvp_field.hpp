@@ -0,0 +1,1453 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides field files, which store the complex value (and for          *
+ *      escape-time plots the iteration count and status) of every pixel      *
+ *      instead of its color. A field is computed once and can then be        *
+ *      recolored with any colorer without evaluating the function again.     *
+ *      Fields may be compressed without loss in bands of rows, each of which *
+ *      can be decoded on its own.                                            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_FIELD_HPP
+#define CVP_FIELD_HPP
+
+/*  FILE, fopen, fread, and puts found here.                                  */
+#include <cstdio>
+
+/*  size_t and memcpy found here.                                             */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, for the header of the file.                      */
+#include <cstdint>
+
+/*  std::true_type, std::false_type, and std::declval found here.             */
+#include <type_traits>
+#include <utility>
+
+/*  std::atomic found here, for counting chunks that failed to decode.        */
+#include <atomic>
+
+/*  Complex class, and the class for the end of an orbit.                     */
+#include "cvp_complex.hpp"
+#include "cvp_orbit.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Viewports for mapping pixels to points in the plane.                      */
+#include "cvp_viewport.hpp"
+
+/*  Aligned memory and low-level file I/O found here.                         */
+#include "cvp_memory.hpp"
+#include "cvp_io.hpp"
+
+/*  Tile engine, and the renderer used for recoloring.                        */
+#include "cvp_tiles.hpp"
+#include "cvp_render.hpp"
+
+/*  Row colorers, used to color a row of the field in place.                  */
+#include "cvp_row_colorers.hpp"
+
+/*  Lossless compression of doubles, for compressed fields.                   */
+#include "cvp_fpc.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The first eight bytes of every field file, and the current version.   */
+    static const char field_magic[8] = {'C', 'V', 'P', 'F', 'I', 'E', 'L', 'D'};
+    static const std::uint32_t field_version = 2U;
+
+    /*  The number of rows in a chunk of a compressed field.                  */
+    static const std::uint32_t field_chunk_rows = 16U;
+
+    /*  What a field file stores for each pixel.                              */
+    enum field_kind {
+
+        /*  The final complex value, for colorers of complex numbers.         */
+        value_field,
+
+        /*  The end of an escape-time orbit, for colorers of cvp::orbit.      */
+        orbit_field
+    };
+
+    /*  How the planes of a field file are stored.                            */
+    enum field_compression {
+
+        /*  As they are, so the file can be mapped and used directly.         */
+        no_compression,
+
+        /*  In chunks of rows compressed with cvp::fpc, with an index of      *
+         *  where each chunk is and how long it is.                           */
+        fpc_compression
+    };
+
+    /*  The header at the start of a field file. Every member has a fixed     *
+     *  size and the doubles fall on multiples of eight, so there is no       *
+     *  padding and the header is exactly 72 bytes.                           */
+    class field_header {
+        public:
+            /*  The bytes of cvp::field_magic, with no terminating zero.      */
+            char magic[8];
+
+            /*  The version of the format, and the field_kind of the data.    */
+            std::uint32_t version, kind;
+
+            /*  The number of pixels in the x and y axes.                     */
+            std::uint32_t xsize, ysize;
+
+            /*  The number of iterations used, zero if there were none.       */
+            std::uint32_t max_iters;
+
+            /*  The number 0x01020304, as written by the machine that made    *
+             *  the file. Everything is stored in native byte order, and this *
+             *  catches files from a machine with a different one.            */
+            std::uint32_t byte_order;
+
+            /*  The field_compression of the planes, and the number of rows   *
+             *  in a chunk if they are compressed.                            */
+            std::uint32_t compression, chunk_rows;
+
+            /*  The region of the plane, [xmin, xmax] x [ymin, ymax].         */
+            double xmin, xmax, ymin, ymax;
+    };
+
+    /*  Tells which kind of field stores values of type T.                    */
+    template <typename T>
+    class field_traits;
+
+    template <>
+    class field_traits<cvp::complex> {
+        public:
+            static const cvp::field_kind kind = cvp::value_field;
+    };
+
+    template <>
+    class field_traits<cvp::orbit> {
+        public:
+            static const cvp::field_kind kind = cvp::orbit_field;
+    };
+
+    /*  "Colorer" for the kernels that keeps the value instead of coloring.   */
+    class keep_value {
+        public:
+            inline cvp::complex operator () (const cvp::complex &z) const;
+    };
+
+    /*  Same as keep_value, for the orbits of escape-time kernels.            */
+    class keep_orbit {
+        public:
+            inline cvp::orbit operator () (const cvp::orbit &w) const;
+    };
+
+    /*  Class for reading and writing field files. The file is a header       *
+     *  followed by planes of length xsize * ysize, in scanline order: the    *
+     *  real parts, the imaginary parts, and for orbit fields the iteration   *
+     *  counts and a byte that is 1 for escaped points and 0 otherwise.       *
+     *  Compressed files have an index after the header: the offsets of the   *
+     *  chunk_count() chunks from the start of the file, then their sizes in  *
+     *  bytes, 64 bits each. The chunks follow the index in the order they    *
+     *  were finished, and each holds the planes of its rows coded with       *
+     *  cvp::fpc, the counts and flags of orbits as 2 * iters + escaped.      */
+    class field {
+        public:
+            /*  The file, and its header.                                     */
+            FILE *fp;
+            cvp::field_header header;
+
+            /*  The whole file, mapped or read into memory, and its size.     */
+            unsigned char *data;
+            std::size_t size;
+
+            /*  Whether data is a mapping, and whether the file is being      *
+             *  created rather than read.                                     */
+            bool mapped, writing;
+
+            /*  The planes of the field, pointers into data. iters and        *
+             *  escaped are NULL for value fields.                            */
+            double *real, *imag;
+            std::uint32_t *iters;
+            unsigned char *escaped;
+
+            /*  Empty constructor, the field is not attached to any file.     */
+            field(void);
+
+            /*  Creates a field file for the given viewport.                  */
+            template <typename Tview>
+            inline bool create(const char *name, const Tview &view,
+                               cvp::field_kind kind, unsigned int max_iters);
+
+            /*  Opens an existing field file for reading. Compressed fields   *
+             *  are decoded into memory, a chunk per thread.                  */
+            inline bool open(const char *name);
+
+            /*  Fills in the header for a viewport.                           */
+            template <typename Tview>
+            inline void set_header(const Tview &view, cvp::field_kind kind,
+                                   unsigned int max_iters,
+                                   cvp::field_compression compression);
+
+            /*  Holds the planes of the header's viewport in memory, without  *
+             *  a file.                                                       */
+            inline bool allocate(void);
+
+            /*  The number of chunks of a compressed field, and the number of *
+             *  rows in the n^th one.                                         */
+            inline unsigned int chunk_count(void) const;
+            inline unsigned int chunk_height(unsigned int n) const;
+
+            /*  Compresses all of the planes as a single chunk, returning the *
+             *  number of bytes written to out, or zero on failure.           */
+            inline std::size_t encode_chunk(unsigned char *out) const;
+
+            /*  Decodes the n^th chunk of a compressed field into the planes. */
+            inline bool decode_chunk(unsigned int n, const unsigned char *in,
+                                     std::size_t bytes) const;
+
+            /*  Creates a compressed field file and writes the header. The    *
+             *  index and the chunks are written later with io::write_at.     */
+            template <typename Tview>
+            inline bool create_compressed(const char *name, const Tview &view,
+                                          cvp::field_kind kind,
+                                          unsigned int max_iters);
+
+            /*  The size in bytes of the index of a compressed field.         */
+            inline std::size_t index_size(void) const;
+
+            /*  The index of the pixel (x, y) in the planes.                  */
+            inline std::size_t index(unsigned int x, unsigned int y) const;
+
+            /*  The viewport the field was computed over.                     */
+            inline cvp::viewport viewport(void) const;
+
+            /*  Stores n values, or n orbits, starting at the pixel (x, y).   */
+            inline void store(unsigned int x, unsigned int y, unsigned int n,
+                              const cvp::complex *values) const;
+
+            inline void store(unsigned int x, unsigned int y, unsigned int n,
+                              const cvp::orbit *orbits) const;
+
+            /*  Writes out anything not yet in the file and closes it.        */
+            inline void close(void);
+
+            /*  The size in bytes of the header and the uncompressed planes.  */
+            static inline std::size_t file_size(const cvp::field_header &h);
+
+            /*  The largest size of a compressed chunk with the given header. */
+            static inline std::size_t chunk_bound(const cvp::field_header &h);
+
+        private:
+            /*  Points the planes at their places in data.                    */
+            inline void find_planes(void);
+
+            /*  Reads the index and the chunks of a compressed field.         */
+            inline bool open_compressed(void);
+    };
+
+    /*  Job for the tile engine, runs a kernel over a tile of a field.        */
+    template <typename Tvalue, typename Tkernel>
+    class field_tile_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::tile_grid &grid;
+            const cvp::field &F;
+
+            /*  Constructor from the kernel, the tiling, and the field.       */
+            field_tile_job(const Tkernel &k, const cvp::tile_grid &g,
+                           const cvp::field &f);
+
+            /*  Computes the values of the n^th tile and stores them.         */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Job for the tile engine, computes a chunk of rows, compresses it,     *
+     *  and writes it to the file.                                            */
+    template <typename Tvalue, typename Tkernel>
+    class field_chunk_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::field &F;
+
+            /*  The offsets and the sizes of the chunks, for the index.       */
+            std::uint64_t *offsets, *sizes;
+
+            /*  The end of the file, and whether any chunk failed.            */
+            std::uint64_t end;
+            bool failed;
+
+            /*  Constructor from the kernel, the field being created, and     *
+             *  room for its index.                                           */
+            field_chunk_job(const Tkernel &k, const cvp::field &f,
+                            std::uint64_t *index);
+
+            /*  Computes the n^th chunk, compresses it, and writes it.        */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Job for the tile engine, decodes a chunk of a compressed field.       */
+    class field_decode_job {
+        public:
+            const cvp::field &F;
+            const unsigned char *file;
+            const std::uint64_t *offsets, *sizes;
+            std::atomic<unsigned int> failures;
+
+            /*  Constructor from the field, the compressed file, and the      *
+             *  index of the chunks.                                          */
+            field_decode_job(const cvp::field &f, const unsigned char *in,
+                             const std::uint64_t *index);
+
+            /*  Decodes the n^th chunk into the planes of the field.          */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Runs a kernel that keeps values of type Tvalue over a viewport and    *
+     *  saves them to a field file.                                           */
+    template <typename Tvalue, typename Tkernel, typename Tview>
+    inline void render_field(const Tkernel &kernel, const Tview &view,
+                             const char *name, unsigned int max_iters,
+                             cvp::field_compression compression);
+
+    /*  Same as render_field, compressing the field a chunk at a time.        */
+    template <typename Tvalue, typename Tkernel, typename Tview>
+    inline void
+    render_compressed_field(const Tkernel &kernel, const Tview &view,
+                            const char *name, unsigned int max_iters);
+
+    /*  Tells whether a colorer can be called on a cvp::orbit. Derives from   *
+     *  std::true_type if so, and std::false_type otherwise.                  */
+    template <typename Tcolor>
+    class colors_orbits {
+        private:
+            template <typename T>
+            static std::true_type test(
+                decltype(std::declval<const T &>()(
+                    std::declval<const cvp::orbit &>()
+                )) *
+            );
+
+            template <typename T>
+            static std::false_type test(...);
+
+        public:
+            typedef decltype(test<Tcolor>(0)) type;
+            static const bool value = type::value;
+    };
+
+    /*  Kernel for coloring the values of a field.                            */
+    template <typename Tcolor>
+    class recolor_kernel {
+        public:
+            const cvp::field &F;
+            Tcolor color;
+
+            /*  Constructor from the field and the colorer.                   */
+            recolor_kernel(const cvp::field &f, Tcolor c);
+
+            /*  Colors the n pixels starting at (x, y).                       */
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, cvp::color *out) const;
+    };
+
+    /*  Kernel for coloring the orbits of a field with an escape colorer.     */
+    template <typename Tcolor>
+    class recolor_orbit_kernel {
+        public:
+            const cvp::field &F;
+            Tcolor color;
+
+            /*  Constructor from the field and the colorer.                   */
+            recolor_orbit_kernel(const cvp::field &f, Tcolor c);
+
+            /*  Colors the n pixels starting at (x, y).                       */
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, cvp::color *out) const;
+    };
+
+    /*  Colors a field file and writes the image to a PPM file.               */
+    template <typename Tcolor>
+    inline void recolor(const char *field_name, Tcolor color,
+                        const char *name);
+
+    /*  Same as recolor, with options for how to render the image.            */
+    template <typename Tcolor>
+    inline void recolor(const char *field_name, Tcolor color,
+                        const char *name, const cvp::render_options &opts);
+
+    /*  Same as recolor, for a field that is already open. Useful for trying  *
+     *  several colorers on one field.                                        */
+    template <typename Tcolor>
+    inline void recolor(const cvp::field &F, Tcolor color,
+                        const char *name, const cvp::render_options &opts);
+
+    /*  The two cases of recolor, for escape colorers and for the rest.       */
+    template <typename Tcolor>
+    inline void recolor(const cvp::field &F, Tcolor color,
+                        const char *name, const cvp::render_options &opts,
+                        std::true_type);
+
+    template <typename Tcolor>
+    inline void recolor(const cvp::field &F, Tcolor color,
+                        const char *name, const cvp::render_options &opts,
+                        std::false_type);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Keeps the value of the point.                                             */
+inline cvp::complex cvp::keep_value::operator () (const cvp::complex &z) const
+{
+    return z;
+}
+
+/*  Keeps the end of the orbit.                                               */
+inline cvp::orbit cvp::keep_orbit::operator () (const cvp::orbit &w) const
+{
+    return w;
+}
+
+/*  Empty constructor, the field is not attached to any file.                 */
+cvp::field::field(void)
+{
+    fp = NULL;
+    data = NULL;
+    size = 0U;
+    mapped = writing = false;
+    real = imag = NULL;
+    iters = NULL;
+    escaped = NULL;
+    std::memset(&header, 0, sizeof(header));
+    return;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::field::create                                                    *
+ *  Purpose:                                                                  *
+ *      Creates a field file for a viewport, ready to be filled with store.   *
+ *  Arguments:                                                                *
+ *      name (const char *):                                                  *
+ *          The name of the field file.                                       *
+ *      view (const Tview &):                                                 *
+ *          The viewport the field is computed over.                          *
+ *      kind (cvp::field_kind):                                               *
+ *          Whether the field holds values or orbits.                         *
+ *      max_iters (unsigned int):                                             *
+ *          The number of iterations, saved in the header.                    *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if the file was created.                                     *
+ *  Method:                                                                   *
+ *      Map the file at its final size so that every thread can store its     *
+ *      values straight into it. If mmap is not available, fill a buffer      *
+ *      instead and write it out when the field is closed.                    *
+ ******************************************************************************/
+template <typename Tview>
+inline bool cvp::field::create(const char *name, const Tview &view,
+                               cvp::field_kind kind, unsigned int max_iters)
+{
+    set_header(view, kind, max_iters, cvp::no_compression);
+
+    /*  Open for reading as well so that the file can be mapped.              */
+    fp = std::fopen(name, "w+b");
+
+    if (!fp)
+    {
+        std::puts("ERROR: fopen failed and returned NULL.");
+        return false;
+    }
+
+    writing = true;
+    size = cvp::field::file_size(header);
+    data = cvp::io::map_file(fp, size);
+    mapped = (data != NULL);
+
+    /*  No mmap, collect the field in memory and write it when closing.       */
+    if (!mapped)
+    {
+        if (!allocate())
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    std::memcpy(data, &header, sizeof(header));
+    find_planes();
+    return true;
+}
+/*  End of cvp::field::create.                                                */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::field::open                                                      *
+ *  Purpose:                                                                  *
+ *      Opens an existing field file for reading.                             *
+ *  Arguments:                                                                *
+ *      name (const char *):                                                  *
+ *          The name of the field file.                                       *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if the file is a valid field and was loaded.                 *
+ *  Method:                                                                   *
+ *      Check the header, then map the whole file. Nothing is copied, the     *
+ *      planes are read straight out of the page cache. Without mmap, read    *
+ *      the file into memory instead. Compressed fields are decoded into      *
+ *      memory with open_compressed.                                          *
+ ******************************************************************************/
+inline bool cvp::field::open(const char *name)
+{
+    /*  Number of bytes after the header.                                     */
+    std::size_t body;
+
+    fp = std::fopen(name, "rb");
+
+    if (!fp)
+    {
+        std::puts("ERROR: fopen failed and returned NULL.");
+        return false;
+    }
+
+    if (std::fread(&header, sizeof(header), 1U, fp) != 1U ||
+        std::memcmp(header.magic, cvp::field_magic, sizeof(header.magic)))
+    {
+        std::puts("ERROR: Not a field file.");
+        close();
+        return false;
+    }
+
+    if (header.byte_order != 0x01020304U)
+    {
+        std::puts("ERROR: Field file was written with another byte order.");
+        close();
+        return false;
+    }
+
+    if (header.version != cvp::field_version ||
+        header.kind > static_cast<std::uint32_t>(cvp::orbit_field) ||
+        header.compression > static_cast<std::uint32_t>(cvp::fpc_compression))
+    {
+        std::puts("ERROR: Unsupported version of the field format.");
+        close();
+        return false;
+    }
+
+    if (header.compression != static_cast<std::uint32_t>(cvp::no_compression))
+    {
+        if (header.chunk_rows == 0U)
+        {
+            std::puts("ERROR: Compressed field has no rows in a chunk.");
+            close();
+            return false;
+        }
+
+        if (!open_compressed())
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    size = cvp::field::file_size(header);
+    data = cvp::io::map_read(fp, size);
+    mapped = (data != NULL);
+
+    /*  No mmap, or the file is short. Read it the slow way, which also       *
+     *  tells the two cases apart.                                            */
+    if (!mapped)
+    {
+        if (!allocate())
+        {
+            close();
+            return false;
+        }
+
+        body = size - sizeof(header);
+
+        if (std::fread(data + sizeof(header), 1U, body, fp) != body)
+        {
+            std::puts("ERROR: Field file is truncated.");
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    find_planes();
+    return true;
+}
+/*  End of cvp::field::open.                                                  */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::field::open_compressed                                           *
+ *  Purpose:                                                                  *
+ *      Reads the rest of a compressed field whose header has been read.      *
+ *  Arguments:                                                                *
+ *      None.                                                                 *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if every chunk was decoded.                                  *
+ *  Method:                                                                   *
+ *      Read the index, map the chunks (or read them if mmap is missing),     *
+ *      and have the tile engine decode the chunks into the planes in         *
+ *      parallel. The chunks share no state, so any one of them can also be   *
+ *      decoded on its own with decode_chunk.                                 *
+ ******************************************************************************/
+inline bool cvp::field::open_compressed(void)
+{
+    /*  The number of chunks, and where the chunks start.                     */
+    const unsigned int chunks = chunk_count();
+    const std::size_t start = sizeof(header) + index_size();
+
+    /*  The index, the offsets and sizes in it, the size of the file, and an  *
+     *  index for the chunks.                                                 */
+    std::uint64_t *offsets, *sizes;
+    std::size_t total;
+    unsigned int n;
+
+    /*  The compressed file, and whether it was mapped.                       */
+    unsigned char *file;
+    bool file_mapped;
+
+    offsets = static_cast<std::uint64_t *>(
+        cvp::memory::aligned_malloc(index_size())
+    );
+
+    if (!offsets)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        return false;
+    }
+
+    sizes = offsets + chunks;
+
+    if (std::fread(offsets, index_size(), 1U, fp) != 1U)
+    {
+        std::puts("ERROR: Field file has a damaged index.");
+        cvp::memory::aligned_free(offsets);
+        return false;
+    }
+
+    /*  The chunks must lie after the index. The file ends with the last.     */
+    total = start;
+
+    for (n = 0U; n < chunks; ++n)
+    {
+        if (offsets[n] < start || offsets[n] + sizes[n] < offsets[n])
+        {
+            std::puts("ERROR: Field file has a damaged index.");
+            cvp::memory::aligned_free(offsets);
+            return false;
+        }
+
+        if (offsets[n] + sizes[n] > total)
+            total = static_cast<std::size_t>(offsets[n] + sizes[n]);
+    }
+
+    file = cvp::io::map_read(fp, total);
+    file_mapped = (file != NULL);
+
+    /*  No mmap, or the file is short. Read the chunks into memory.           */
+    if (!file_mapped)
+    {
+        file = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(total)
+        );
+
+        if (!file ||
+            std::fread(file + start, 1U, total - start, fp) != total - start)
+        {
+            std::puts("ERROR: Field file is truncated.");
+            cvp::memory::aligned_free(file);
+            cvp::memory::aligned_free(offsets);
+            return false;
+        }
+    }
+
+    if (allocate())
+    {
+        cvp::field_decode_job job(*this, file, offsets);
+        cvp::run_tiles(chunks, job);
+
+        if (job.failures.load() != 0U)
+        {
+            std::puts("ERROR: Field file has damaged chunks.");
+            cvp::memory::aligned_free(data);
+            data = NULL;
+        }
+    }
+
+    if (file_mapped)
+        cvp::io::unmap_file(file, total);
+    else
+        cvp::memory::aligned_free(file);
+
+    cvp::memory::aligned_free(offsets);
+    return (data != NULL);
+}
+/*  End of cvp::field::open_compressed.                                       */
+
+/*  Fills in the header for a viewport, with the bounds rounded to double.    */
+template <typename Tview>
+inline void cvp::field::set_header(const Tview &view, cvp::field_kind kind,
+                                   unsigned int max_iters,
+                                   cvp::field_compression compression)
+{
+    std::memcpy(header.magic, cvp::field_magic, sizeof(header.magic));
+    header.version = cvp::field_version;
+    header.kind = static_cast<std::uint32_t>(kind);
+    header.xsize = view.xsize;
+    header.ysize = view.ysize;
+    header.max_iters = max_iters;
+    header.byte_order = 0x01020304U;
+    header.compression = static_cast<std::uint32_t>(compression);
+    header.chunk_rows =
+        (compression == cvp::no_compression ? 0U : cvp::field_chunk_rows);
+
+    header.xmin = static_cast<double>(view.xmin);
+    header.xmax = static_cast<double>(view.xmax);
+    header.ymin = static_cast<double>(view.ymin);
+    header.ymax = static_cast<double>(view.ymax);
+}
+
+/*  Allocates the header and the uncompressed planes. Closing the field frees *
+ *  them, and also writes them to the file if it was created and not mapped.  */
+inline bool cvp::field::allocate(void)
+{
+    size = cvp::field::file_size(header);
+    mapped = false;
+    data = static_cast<unsigned char *>(cvp::memory::aligned_malloc(size));
+
+    if (!data)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        return false;
+    }
+
+    std::memcpy(data, &header, sizeof(header));
+    find_planes();
+    return true;
+}
+
+/*  Chunks are bands of chunk_rows rows, the last one possibly shorter.       */
+inline unsigned int cvp::field::chunk_count(void) const
+{
+    const std::uint64_t rows = header.chunk_rows;
+    return static_cast<unsigned int>((header.ysize + rows - 1U) / rows);
+}
+
+/*  The number of rows in the n^th chunk.                                     */
+inline unsigned int cvp::field::chunk_height(unsigned int n) const
+{
+    const unsigned int y = n * header.chunk_rows;
+    const unsigned int rows = header.ysize - y;
+    return (rows < header.chunk_rows ? rows : header.chunk_rows);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::field::encode_chunk                                              *
+ *  Purpose:                                                                  *
+ *      Compresses the planes of a field held in memory as a single chunk.    *
+ *  Arguments:                                                                *
+ *      out (unsigned char *):                                                *
+ *          Room for chunk_bound(header) bytes.                               *
+ *  Outputs:                                                                  *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes written, zero if malloc failed.               *
+ *  Notes:                                                                    *
+ *      The field is usually a band of rows of a larger one, made by setting  *
+ *      ysize to the height of the chunk before calling allocate.             *
+ ******************************************************************************/
+inline std::size_t cvp::field::encode_chunk(unsigned char *out) const
+{
+    const unsigned int width = header.xsize, rows = header.ysize;
+    const std::size_t count = static_cast<std::size_t>(width) * rows;
+
+    /*  The orbits, packed as 2 * iters + escaped, and an index for them.     */
+    std::uint32_t *words;
+    std::size_t n;
+
+    std::size_t bytes = cvp::fpc::encode(real, width, rows, out);
+    bytes += cvp::fpc::encode(imag, width, rows, out + bytes);
+
+    if (header.kind != static_cast<std::uint32_t>(cvp::orbit_field))
+        return bytes;
+
+    words = static_cast<std::uint32_t *>(
+        cvp::memory::aligned_malloc(count * sizeof(std::uint32_t))
+    );
+
+    if (!words)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        return 0U;
+    }
+
+    for (n = 0U; n < count; ++n)
+        words[n] = (iters[n] << 1U) | escaped[n];
+
+    bytes += cvp::fpc::encode(words, width, rows, out + bytes);
+    cvp::memory::aligned_free(words);
+    return bytes;
+}
+/*  End of cvp::field::encode_chunk.                                          */
+
+/*  Decodes the planes of the n^th chunk in order. The orbits are decoded     *
+ *  into the iteration counts and then split into counts and flags.           */
+inline bool cvp::field::decode_chunk(unsigned int n, const unsigned char *in,
+                                     std::size_t bytes) const
+{
+    const unsigned int width = header.xsize, rows = chunk_height(n);
+    const std::size_t start = index(0U, n * header.chunk_rows);
+    const std::size_t count = static_cast<std::size_t>(width) * rows;
+
+    /*  The number of bytes used by each plane, and an index for the pixels.  */
+    std::size_t used, k;
+
+    used = cvp::fpc::decode(in, bytes, width, rows, real + start);
+
+    if (used == 0U)
+        return false;
+
+    in += used;
+    bytes -= used;
+    used = cvp::fpc::decode(in, bytes, width, rows, imag + start);
+
+    if (used == 0U)
+        return false;
+
+    if (header.kind != static_cast<std::uint32_t>(cvp::orbit_field))
+        return (used == bytes);
+
+    in += used;
+    bytes -= used;
+    used = cvp::fpc::decode(in, bytes, width, rows, iters + start);
+
+    if (used != bytes)
+        return false;
+
+    for (k = start; k < start + count; ++k)
+    {
+        escaped[k] = static_cast<unsigned char>(iters[k] & 1U);
+        iters[k] >>= 1U;
+    }
+
+    return true;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::field::create_compressed                                         *
+ *  Purpose:                                                                  *
+ *      Creates a compressed field file for a viewport.                       *
+ *  Arguments:                                                                *
+ *      name (const char *):                                                  *
+ *          The name of the field file.                                       *
+ *      view (const Tview &):                                                 *
+ *          The viewport the field is computed over.                          *
+ *      kind (cvp::field_kind):                                               *
+ *          Whether the field holds values or orbits.                         *
+ *      max_iters (unsigned int):                                             *
+ *          The number of iterations, saved in the header.                    *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if the file was created and the header written.              *
+ *  Method:                                                                   *
+ *      Open the file and write the header. Nothing is held in memory. The    *
+ *      chunks go after the room for the index, and the index goes last,      *
+ *      both with cvp::io::write_at.                                          *
+ ******************************************************************************/
+template <typename Tview>
+inline bool
+cvp::field::create_compressed(const char *name, const Tview &view,
+                              cvp::field_kind kind, unsigned int max_iters)
+{
+    set_header(view, kind, max_iters, cvp::fpc_compression);
+    fp = std::fopen(name, "wb");
+
+    if (!fp)
+    {
+        std::puts("ERROR: fopen failed and returned NULL.");
+        return false;
+    }
+
+    if (!cvp::io::write_all(fp, &header, sizeof(header)))
+    {
+        std::puts("ERROR: Could not write the field file.");
+        close();
+        return false;
+    }
+
+    return true;
+}
+/*  End of cvp::field::create_compressed.                                     */
+
+/*  An offset and a size for every chunk, 64 bits each.                       */
+inline std::size_t cvp::field::index_size(void) const
+{
+    return 2U * static_cast<std::size_t>(chunk_count()) * sizeof(std::uint64_t);
+}
+
+/*  The planes are stored in scanline order.                                  */
+inline std::size_t cvp::field::index(unsigned int x, unsigned int y) const
+{
+    return static_cast<std::size_t>(y) * header.xsize + x;
+}
+
+/*  The viewport from the header. The resolution is exact, the bounds are     *
+ *  only as precise as a double.                                              */
+inline cvp::viewport cvp::field::viewport(void) const
+{
+    return cvp::viewport(
+        header.xmin, header.xmax, header.ymin, header.ymax,
+        header.xsize, header.ysize
+    );
+}
+
+/*  Stores n complex values starting at the pixel (x, y).                     */
+inline void cvp::field::store(unsigned int x, unsigned int y, unsigned int n,
+                              const cvp::complex *values) const
+{
+    const std::size_t start = index(x, y);
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+    {
+        real[start + k] = values[k].real;
+        imag[start + k] = values[k].imag;
+    }
+}
+
+/*  Stores n orbits starting at the pixel (x, y).                             */
+inline void cvp::field::store(unsigned int x, unsigned int y, unsigned int n,
+                              const cvp::orbit *orbits) const
+{
+    const std::size_t start = index(x, y);
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+    {
+        real[start + k] = orbits[k].z.real;
+        imag[start + k] = orbits[k].z.imag;
+        iters[start + k] = orbits[k].iters;
+        escaped[start + k] = (orbits[k].escaped ? 1U : 0U);
+    }
+}
+
+/*  Writes out the buffer of an unmapped field being created, then frees      *
+ *  everything and closes the file.                                           */
+inline void cvp::field::close(void)
+{
+    if (data)
+    {
+        if (mapped)
+            cvp::io::unmap_file(data, size);
+
+        else
+        {
+            if (writing && !cvp::io::write_all(fp, data, size))
+                std::puts("ERROR: Could not write the field file.");
+
+            cvp::memory::aligned_free(data);
+        }
+    }
+
+    if (fp)
+        std::fclose(fp);
+
+    fp = NULL;
+    data = NULL;
+    size = 0U;
+    mapped = writing = false;
+    real = imag = NULL;
+    iters = NULL;
+    escaped = NULL;
+}
+
+/*  The header, two planes of doubles, and for orbits the counts and flags.   */
+inline std::size_t cvp::field::file_size(const cvp::field_header &h)
+{
+    const std::size_t count = static_cast<std::size_t>(h.xsize) * h.ysize;
+    std::size_t bytes = sizeof(cvp::field_header) + 2U*sizeof(double)*count;
+
+    if (h.kind == static_cast<std::uint32_t>(cvp::orbit_field))
+        bytes += (sizeof(std::uint32_t) + 1U) * count;
+
+    return bytes;
+}
+
+/*  Both planes of doubles, and the packed orbits, at their largest.          */
+inline std::size_t cvp::field::chunk_bound(const cvp::field_header &h)
+{
+    const std::size_t count = static_cast<std::size_t>(h.xsize) * h.ysize;
+    std::size_t bytes = 2U * cvp::fpc::bound<double>(count);
+
+    if (h.kind == static_cast<std::uint32_t>(cvp::orbit_field))
+        bytes += cvp::fpc::bound<std::uint32_t>(count);
+
+    return bytes;
+}
+
+/*  The planes follow the header in order. The header is 72 bytes, a multiple *
+ *  of eight, so every plane of doubles or integers is suitably aligned.      */
+inline void cvp::field::find_planes(void)
+{
+    const std::size_t count =
+        static_cast<std::size_t>(header.xsize) * header.ysize;
+
+    unsigned char * const body = data + sizeof(cvp::field_header);
+
+    real = reinterpret_cast<double *>(body);
+    imag = real + count;
+
+    if (header.kind == static_cast<std::uint32_t>(cvp::orbit_field))
+    {
+        iters = reinterpret_cast<std::uint32_t *>(imag + count);
+        escaped = reinterpret_cast<unsigned char *>(iters + count);
+    }
+}
+
+/*  Constructor from the kernel, the tiling, and the field.                   */
+template <typename Tvalue, typename Tkernel>
+cvp::field_tile_job<Tvalue, Tkernel>::field_tile_job(const Tkernel &k,
+                                                     const cvp::tile_grid &g,
+                                                     const cvp::field &f)
+    : kernel(k), grid(g), F(f)
+{
+    return;
+}
+
+/*  Computes the n^th tile a row at a time, storing each row in the field.    */
+template <typename Tvalue, typename Tkernel>
+inline void cvp::field_tile_job<Tvalue, Tkernel>::operator () (unsigned int n)
+{
+    /*  Index for the rows of the tile.                                       */
+    unsigned int row;
+
+    /*  The values of a row of the tile. Tiles are at most tiles::width wide. */
+    Tvalue values[cvp::tiles::width];
+
+    /*  The location of the tile in the image.                                */
+    const cvp::tile t = grid.get(n);
+
+    for (row = 0U; row < t.height; ++row)
+    {
+        kernel(t.x, t.y + row, t.width, values);
+        F.store(t.x, t.y + row, t.width, values);
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_field                                                     *
+ *  Purpose:                                                                  *
+ *      Runs a kernel over a viewport and saves the values to a field file.   *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) storing the values of type     *
+ *          Tvalue of the n pixels starting at (x, y) in out. A kernel from   *
+ *          cvp_kernels.hpp with cvp::keep_value or cvp::keep_orbit as its    *
+ *          colorer, say.                                                     *
+ *      view (const Tview &):                                                 *
+ *          The viewport, saved in the header of the field.                   *
+ *      name (const char *):                                                  *
+ *          The name of the field file.                                       *
+ *      max_iters (unsigned int):                                             *
+ *          The number of iterations, saved in the header of the field.       *
+ *      compression (cvp::field_compression):                                 *
+ *          How to store the planes.                                          *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Same as cvp::render_mapped. Split the image into tiles and have the   *
+ *      tile engine store every row of a tile straight into the mapped file.  *
+ *      Compressed fields are left to render_compressed_field.                *
+ ******************************************************************************/
+template <typename Tvalue, typename Tkernel, typename Tview>
+inline void cvp::render_field(const Tkernel &kernel, const Tview &view,
+                              const char *name, unsigned int max_iters,
+                              cvp::field_compression compression)
+{
+    /*  Split the image into cache-sized tiles.                               */
+    const cvp::tile_grid grid = cvp::tile_grid(
+        view.xsize, view.ysize, cvp::tiles::width, cvp::tiles::height
+    );
+
+    /*  The output file.                                                      */
+    cvp::field F;
+
+    /*  Job for the tile engine, fills the field.                             */
+    cvp::field_tile_job<Tvalue, Tkernel> job =
+        cvp::field_tile_job<Tvalue, Tkernel>(kernel, grid, F);
+
+    if (compression == cvp::fpc_compression)
+    {
+        cvp::render_compressed_field<Tvalue>(kernel, view, name, max_iters);
+        return;
+    }
+
+    if (!F.create(name, view, cvp::field_traits<Tvalue>::kind, max_iters))
+        return;
+
+    cvp::run_tiles(grid.count, job);
+    F.close();
+}
+/*  End of cvp::render_field.                                                 */
+
+/*  Constructor from the kernel, the field, and room for the index. The       *
+ *  chunks go right after the index.                                          */
+template <typename Tvalue, typename Tkernel>
+cvp::field_chunk_job<Tvalue, Tkernel>::field_chunk_job(const Tkernel &k,
+                                                       const cvp::field &f,
+                                                       std::uint64_t *index)
+    : kernel(k), F(f), offsets(index), sizes(index + f.chunk_count()),
+      end(sizeof(f.header) + f.index_size()), failed(false)
+{
+    return;
+}
+
+/*  Computes the rows of the n^th chunk into a band held in memory,           *
+ *  compresses the band, takes space for it from the end of the file with an  *
+ *  atomic add, and writes it there.                                          */
+template <typename Tvalue, typename Tkernel>
+inline void cvp::field_chunk_job<Tvalue, Tkernel>::operator () (unsigned int n)
+{
+    /*  Indices for the rows of the chunk and the columns of a row.           */
+    unsigned int row, x;
+
+    /*  The values of part of a row, at most tiles::width of them.            */
+    Tvalue values[cvp::tiles::width];
+
+    /*  The first row of the chunk, and the band of rows in memory.           */
+    const unsigned int y = n * F.header.chunk_rows;
+    cvp::field band;
+
+    /*  The compressed chunk, its size, and where it goes in the file.        */
+    unsigned char *out;
+    std::size_t out_size;
+    std::uint64_t offset;
+
+    if (failed)
+        return;
+
+    band.header = F.header;
+    band.header.ysize = F.chunk_height(n);
+
+    if (!band.allocate())
+    {
+        failed = true;
+        return;
+    }
+
+    for (row = 0U; row < band.header.ysize; ++row)
+    {
+        for (x = 0U; x < band.header.xsize; x += cvp::tiles::width)
+        {
+            const unsigned int m = (band.header.xsize - x < cvp::tiles::width ?
+                                    band.header.xsize - x : cvp::tiles::width);
+
+            kernel(x, y + row, m, values);
+            band.store(x, row, m, values);
+        }
+    }
+
+    out = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(cvp::field::chunk_bound(band.header))
+    );
+
+    out_size = (out ? band.encode_chunk(out) : 0U);
+    band.close();
+
+    if (out_size == 0U)
+    {
+        std::puts("ERROR: Could not compress the field.");
+        cvp::memory::aligned_free(out);
+        failed = true;
+        return;
+    }
+
+    /*  Take the space for the chunk from the end of the file.                */
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    {
+        offset = end;
+        end += out_size;
+    }
+
+    if (!cvp::io::write_at(F.fp, offset, out, out_size))
+    {
+        std::puts("ERROR: Could not write the field file.");
+        failed = true;
+    }
+
+    offsets[n] = offset;
+    sizes[n] = out_size;
+    cvp::memory::aligned_free(out);
+}
+
+/*  Constructor from the field, the compressed file, and its index.           */
+cvp::field_decode_job::field_decode_job(const cvp::field &f,
+                                        const unsigned char *in,
+                                        const std::uint64_t *index)
+    : F(f), file(in), offsets(index), sizes(index + f.chunk_count()),
+      failures(0U)
+{
+    return;
+}
+
+/*  Decodes the n^th chunk, counting it if it is damaged.                     */
+inline void cvp::field_decode_job::operator () (unsigned int n)
+{
+    const std::size_t bytes = static_cast<std::size_t>(sizes[n]);
+
+    if (!F.decode_chunk(n, file + offsets[n], bytes))
+        ++failures;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_compressed_field                                          *
+ *  Purpose:                                                                  *
+ *      Runs a kernel over a viewport and saves a compressed field file.      *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out), as for render_field.          *
+ *      view (const Tview &):                                                 *
+ *          The viewport, saved in the header of the field.                   *
+ *      name (const char *):                                                  *
+ *          The name of the field file.                                       *
+ *      max_iters (unsigned int):                                             *
+ *          The number of iterations, saved in the header of the field.       *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Create the file first, so a bad name fails before any work is done.   *
+ *      The tile engine hands out chunks of field_chunk_rows rows. Each       *
+ *      thread computes its chunk into a buffer, compresses it, and writes    *
+ *      it to the end of the file right away, noting where it went in the     *
+ *      index. The index is written last, in the room left after the header.  *
+ *      Only the index and one band per thread are ever held in memory.       *
+ *  Notes:                                                                    *
+ *      Orbits are packed as 2 * iters + escaped in 32 bits, so iteration     *
+ *      counts must be below 2^31. Larger ones are saved uncompressed.        *
+ ******************************************************************************/
+template <typename Tvalue, typename Tkernel, typename Tview>
+inline void
+cvp::render_compressed_field(const Tkernel &kernel, const Tview &view,
+                             const char *name, unsigned int max_iters)
+{
+    /*  The field, holding nothing but its header and the file.               */
+    cvp::field F;
+
+    /*  The index of the file, the offsets and then the sizes of the chunks.  */
+    std::uint64_t *index;
+
+    if (max_iters >= 0x80000000U)
+    {
+        std::puts("WARNING: Too many iterations to compress, saving as is.");
+        cvp::render_field<Tvalue>(
+            kernel, view, name, max_iters, cvp::no_compression
+        );
+
+        return;
+    }
+
+    if (!F.create_compressed(name, view, cvp::field_traits<Tvalue>::kind,
+                             max_iters))
+        return;
+
+    index = static_cast<std::uint64_t *>(
+        cvp::memory::aligned_malloc(F.index_size())
+    );
+
+    if (!index)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        F.close();
+        return;
+    }
+
+    {
+        cvp::field_chunk_job<Tvalue, Tkernel> job =
+            cvp::field_chunk_job<Tvalue, Tkernel>(kernel, F, index);
+
+        cvp::run_tiles(F.chunk_count(), job);
+
+        if (!job.failed &&
+            !cvp::io::write_at(F.fp, sizeof(F.header), index, F.index_size()))
+            std::puts("ERROR: Could not write the field file.");
+    }
+
+    cvp::memory::aligned_free(index);
+    F.close();
+}
+/*  End of cvp::render_compressed_field.                                      */
+
+/*  Constructor from the field and the colorer.                               */
+template <typename Tcolor>
+cvp::recolor_kernel<Tcolor>::recolor_kernel(const cvp::field &f, Tcolor c)
+    : F(f), color(c)
+{
+    return;
+}
+
+/*  The values of a row are contiguous in the file, so they are colored as a  *
+ *  row in place, with nothing copied.                                        */
+template <typename Tcolor>
+inline void
+cvp::recolor_kernel<Tcolor>::operator () (unsigned int x, unsigned int y,
+                                          unsigned int n,
+                                          cvp::color *out) const
+{
+    const std::size_t start = F.index(x, y);
+    cvp::color_row(color, F.real + start, F.imag + start, n, out);
+}
+
+/*  Constructor from the field and the colorer.                               */
+template <typename Tcolor>
+cvp::recolor_orbit_kernel<Tcolor>::recolor_orbit_kernel(const cvp::field &f,
+                                                        Tcolor c)
+    : F(f), color(c)
+{
+    return;
+}
+
+/*  Rebuilds the orbit of each pixel from the planes and colors it.           */
+template <typename Tcolor>
+inline void
+cvp::recolor_orbit_kernel<Tcolor>::operator () (unsigned int x,
+                                                unsigned int y,
+                                                unsigned int n,
+                                                cvp::color *out) const
+{
+    const std::size_t start = F.index(x, y);
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+    {
+        const std::size_t m = start + k;
+        const cvp::complex z = cvp::complex(F.real[m], F.imag[m]);
+
+        out[k] = color(
+            cvp::orbit(z, F.iters[m], F.header.max_iters, F.escaped[m] != 0U)
+        );
+    }
+}
+
+/*  Recolors a field file using the default options.                          */
+template <typename Tcolor>
+inline void cvp::recolor(const char *field_name, Tcolor color,
+                         const char *name)
+{
+    cvp::recolor(field_name, color, name, cvp::render_options());
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::recolor                                                          *
+ *  Purpose:                                                                  *
+ *      Colors a field file and writes the image to a PPM file.               *
+ *  Arguments:                                                                *
+ *      field_name (const char *):                                            *
+ *          The name of a field file, made by complex_field, escape_field,    *
+ *          or any of the others.                                             *
+ *      color (Tcolor):                                                       *
+ *          A colorer of complex numbers, or of cvp::orbit for fields made    *
+ *          by escape_field.                                                  *
+ *      name (const char *):                                                  *
+ *          The name of the output PPM file.                                  *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how to render the image. Optional.                    *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      Colorers of complex numbers can be used on orbit fields too, they     *
+ *      see the last value of the orbit. The image is the same, byte for      *
+ *      byte, as plotting with the colorer in the first place.                *
+ ******************************************************************************/
+template <typename Tcolor>
+inline void cvp::recolor(const char *field_name, Tcolor color,
+                         const char *name, const cvp::render_options &opts)
+{
+    cvp::field F;
+
+    if (!F.open(field_name))
+        return;
+
+    cvp::recolor(F, color, name, opts);
+    F.close();
+}
+/*  End of cvp::recolor.                                                      */
+
+/*  Escape colorers need orbits, everything else uses the values.             */
+template <typename Tcolor>
+inline void cvp::recolor(const cvp::field &F, Tcolor color,
+                         const char *name, const cvp::render_options &opts)
+{
+    cvp::recolor(
+        F, color, name, opts, typename cvp::colors_orbits<Tcolor>::type()
+    );
+}
+
+/*  Colors the orbits of the field with an escape colorer.                    */
+template <typename Tcolor>
+inline void cvp::recolor(const cvp::field &F, Tcolor color,
+                         const char *name, const cvp::render_options &opts,
+                         std::true_type)
+{
+    const cvp::recolor_orbit_kernel<Tcolor> kernel =
+        cvp::recolor_orbit_kernel<Tcolor>(F, color);
+
+    if (F.header.kind != static_cast<std::uint32_t>(cvp::orbit_field))
+    {
+        std::puts("ERROR: Escape colorers need a field from escape_field.");
+        return;
+    }
+
+    cvp::render(kernel, F.viewport(), name, opts);
+}
+
+/*  Colors the values of the field with a colorer of complex numbers.         */
+template <typename Tcolor>
+inline void cvp::recolor(const cvp::field &F, Tcolor color,
+                         const char *name, const cvp::render_options &opts,
+                         std::false_type)
+{
+    const cvp::recolor_kernel<Tcolor> kernel =
+        cvp::recolor_kernel<Tcolor>(F, color);
+
+    cvp::render(kernel, F.viewport(), name, opts);
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,441 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a lossless compressor for blocks of doubles and 32-bit       *
+ *      integers laid out as images, in the style of FPC. Every value is      *
+ *      predicted from its neighbors, and only the bytes of the XOR of the    *
+ *      value and its prediction that are not zero are stored.                *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_FPC_HPP
+#define CVP_FPC_HPP
+
+/*  size_t and memcpy found here.                                             */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, the words the values are coded as.               */
+#include <cstdint>
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Namespace for the compressor, to avoid name conflicts.                */
+    namespace fpc {
+
+        /*  The unsigned integer with the same bits as a value of type T.     */
+        template <typename T>
+        class word;
+
+        template <>
+        class word<double> {
+            public:
+                typedef std::uint64_t type;
+        };
+
+        template <>
+        class word<std::uint32_t> {
+            public:
+                typedef std::uint32_t type;
+        };
+
+        /*  The largest number of bytes encode can write for n values.        */
+        template <typename T>
+        inline std::size_t bound(std::size_t n);
+
+        /*  Compresses a block of width x rows values stored in scanline      *
+         *  order, returning the number of bytes written to out.              */
+        template <typename T>
+        inline std::size_t encode(const T *in, unsigned int width,
+                                  unsigned int rows, unsigned char *out);
+
+        /*  Decompresses a block written by encode, returning the number of   *
+         *  bytes read, or zero if the data runs out or is corrupt.           */
+        template <typename T>
+        inline std::size_t decode(const unsigned char *in, std::size_t size,
+                                  unsigned int width, unsigned int rows,
+                                  T *out);
+
+        /*  The two predictions for the value at (x, y) in a block, from      *
+         *  values that are already known.                                    */
+        template <typename T>
+        inline void predict(const T *v, unsigned int width,
+                            unsigned int x, unsigned int y,
+                            typename word<T>::type *along,
+                            typename word<T>::type *across);
+
+        /*  Extrapolates along a row from the values left of index n.         */
+        template <typename T>
+        inline typename word<T>::type
+        extrapolate(const T *v, std::size_t n, unsigned int x);
+
+        /*  The bits of the value at index n of a block.                      */
+        template <typename T>
+        inline typename word<T>::type load(const T *v, std::size_t n);
+
+        /*  The number of bytes of a word that are not leading zeros.         */
+        template <typename Tword>
+        inline unsigned int significant_bytes(Tword w);
+
+        /*  Three bits code the number of leading zero bytes of a word of the *
+         *  given size. For 64-bit words there are nine possibilities, and    *
+         *  four zero bytes is stored as three, as in FPC.                    */
+        inline unsigned int zeros_to_code(unsigned int zeros,
+                                          std::size_t word_size);
+
+        inline unsigned int code_to_zeros(unsigned int code,
+                                          std::size_t word_size);
+    }
+    /*  End of namespace "fpc".                                               */
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Every pair of values shares a header byte, and at most all of the bytes   *
+ *  of each value are stored.                                                 */
+template <typename T>
+inline std::size_t cvp::fpc::bound(std::size_t n)
+{
+    return n*sizeof(T) + (n + 1U) / 2U;
+}
+
+/*  Copy the bits with memcpy, which is free and keeps aliasing rules happy.  */
+template <typename T>
+inline typename cvp::fpc::word<T>::type
+cvp::fpc::load(const T *v, std::size_t n)
+{
+    typename cvp::fpc::word<T>::type w;
+    std::memcpy(&w, v + n, sizeof(w));
+    return w;
+}
+
+/*  Extrapolates along a row from the values to the left of index n, which    *
+ *  is in column x > 0. Quadratic when there are three values, linear when    *
+ *  there are two, and constant with only one.                                */
+template <typename T>
+inline typename cvp::fpc::word<T>::type
+cvp::fpc::extrapolate(const T *v, std::size_t n, unsigned int x)
+{
+    const typename cvp::fpc::word<T>::type left = cvp::fpc::load(v, n - 1U);
+
+    if (x == 1U)
+        return left;
+
+    if (x == 2U)
+        return 2U*left - cvp::fpc::load(v, n - 2U);
+
+    return 3U*(left - cvp::fpc::load(v, n - 2U)) + cvp::fpc::load(v, n - 3U);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fpc::predict                                                     *
+ *  Purpose:                                                                  *
+ *      Predicts the value at (x, y) in a block from its neighbors.           *
+ *  Arguments:                                                                *
+ *      v (const T *):                                                        *
+ *          The block, in scanline order. Only the values before (x, y) are   *
+ *          read.                                                             *
+ *      width (unsigned int):                                                 *
+ *          The number of values in a row of the block.                       *
+ *      x (unsigned int):                                                     *
+ *          The column of the value.                                          *
+ *      y (unsigned int):                                                     *
+ *          The row of the value.                                             *
+ *      along (word<T>::type *):                                              *
+ *          The prediction from the values to the left.                       *
+ *      across (word<T>::type *):                                             *
+ *          The prediction from the values to the left and the row above.     *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Work on the bits as unsigned integers, so that decoding repeats the   *
+ *      exact same arithmetic. For values of the same sign and exponent this  *
+ *      is arithmetic on the mantissas. With L1, L2, and L3 the values one,   *
+ *      two, and three to the left, and U the value above,                    *
+ *          along  = 3 L1 - 3 L2 + L3                                         *
+ *          across = along + U - (the same extrapolation for U)               *
+ *      along is exact for quadratics. across corrects it by the error it     *
+ *      made one row up, which is nearly the same for smooth functions. Near  *
+ *      the edges of the block, missing neighbors are left out.               *
+ ******************************************************************************/
+template <typename T>
+inline void
+cvp::fpc::predict(const T *v, unsigned int width,
+                  unsigned int x, unsigned int y,
+                  typename cvp::fpc::word<T>::type *along,
+                  typename cvp::fpc::word<T>::type *across)
+{
+    /*  The index of the value in the block.                                  */
+    const std::size_t n = static_cast<std::size_t>(y) * width + x;
+
+    /*  The first value of the block has no neighbors at all.                 */
+    if (x == 0U && y == 0U)
+    {
+        *along = *across = 0U;
+        return;
+    }
+
+    /*  The start of a row continues from the value above it.                 */
+    if (x == 0U)
+    {
+        *along = *across = cvp::fpc::load(v, n - width);
+        return;
+    }
+
+    *along = cvp::fpc::extrapolate(v, n, x);
+
+    /*  The first row has nothing above, offer the value to the left.         */
+    if (y == 0U)
+        *across = cvp::fpc::load(v, n - 1U);
+    else
+        *across = *along + cvp::fpc::load(v, n - width)
+                         - cvp::fpc::extrapolate(v, n - width, x);
+}
+/*  End of cvp::fpc::predict.                                                 */
+
+/*  Count the bytes below the highest one that is not zero.                   */
+template <typename Tword>
+inline unsigned int cvp::fpc::significant_bytes(Tword w)
+{
+    unsigned int count = 0U;
+
+    while (w)
+    {
+        w >>= 8U;
+        ++count;
+    }
+
+    return count;
+}
+
+/*  For 64-bit words 0, 1, 2, and 3 zero bytes are stored as is, 4 becomes 3, *
+ *  and 5 through 8 are stored as 4 through 7. 32-bit words fit as they are.  */
+inline unsigned int
+cvp::fpc::zeros_to_code(unsigned int zeros, std::size_t word_size)
+{
+    if (word_size < 8U || zeros < 4U)
+        return zeros;
+
+    if (zeros == 4U)
+        return 3U;
+
+    return zeros - 1U;
+}
+
+/*  Inverse of zeros_to_code, with 4 mapping back to 5 for 64-bit words.      */
+inline unsigned int
+cvp::fpc::code_to_zeros(unsigned int code, std::size_t word_size)
+{
+    return (word_size < 8U || code < 4U ? code : code + 1U);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fpc::encode                                                      *
+ *  Purpose:                                                                  *
+ *      Compresses a block of doubles or 32-bit integers without loss.        *
+ *  Arguments:                                                                *
+ *      in (const T *):                                                       *
+ *          The block, width x rows values in scanline order.                 *
+ *      width (unsigned int):                                                 *
+ *          The number of values in a row.                                    *
+ *      rows (unsigned int):                                                  *
+ *          The number of rows.                                               *
+ *      out (unsigned char *):                                                *
+ *          Room for at least bound<T>(width * rows) bytes.                   *
+ *  Outputs:                                                                  *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes written to out.                               *
+ *  Method:                                                                   *
+ *      For each value, XOR its bits with both predictions and keep the one   *
+ *      with more leading zero bytes. A nibble holds which prediction it was  *
+ *      (the top bit) and how many zero bytes there are (the other three).    *
+ *      Values are taken in pairs: a byte with the two nibbles, then the      *
+ *      bytes of the first XOR that are not leading zeros, then those of the  *
+ *      second, low byte first. A good prediction leaves only a byte or two.  *
+ *  Notes:                                                                    *
+ *      FPC predicts from hash tables of the recent history of a stream. The  *
+ *      values here come from a grid, so the neighbors in the plane are used  *
+ *      instead. Blocks share no state, so each can be decoded on its own.    *
+ ******************************************************************************/
+template <typename T>
+inline std::size_t
+cvp::fpc::encode(const T *in, unsigned int width,
+                 unsigned int rows, unsigned char *out)
+{
+    typedef typename cvp::fpc::word<T>::type word_type;
+
+    /*  The number of values in the block, and an index for them.             */
+    const std::size_t count = static_cast<std::size_t>(width) * rows;
+    std::size_t n;
+
+    /*  The number of bytes written so far.                                   */
+    std::size_t size = 0U;
+
+    /*  Where the header byte of the current pair goes.                       */
+    std::size_t header = 0U;
+
+    for (n = 0U; n < count; ++n)
+    {
+        const unsigned int x = static_cast<unsigned int>(n % width);
+        const unsigned int y = static_cast<unsigned int>(n / width);
+        const word_type value = cvp::fpc::load(in, n);
+
+        word_type along, across, residual;
+        unsigned int bytes, nibble, k;
+
+        cvp::fpc::predict(in, width, x, y, &along, &across);
+
+        /*  Keep the prediction with more leading zeros, across on a tie.     */
+        if ((value ^ along) < (value ^ across))
+        {
+            residual = value ^ along;
+            nibble = 0U;
+        }
+        else
+        {
+            residual = value ^ across;
+            nibble = 8U;
+        }
+
+        /*  Four zero bytes of a 64-bit word are stored as three, and the     *
+         *  extra zero byte is written out.                                   */
+        bytes = cvp::fpc::significant_bytes(residual);
+        nibble |= cvp::fpc::zeros_to_code(
+            sizeof(word_type) - bytes, sizeof(word_type)
+        );
+
+        bytes = sizeof(word_type) -
+                cvp::fpc::code_to_zeros(nibble & 7U, sizeof(word_type));
+
+        /*  The first value of a pair reserves the header byte.               */
+        if ((n & 1U) == 0U)
+        {
+            header = size;
+            out[size] = static_cast<unsigned char>(nibble << 4U);
+            ++size;
+        }
+        else
+            out[header] |= static_cast<unsigned char>(nibble);
+
+        for (k = 0U; k < bytes; ++k)
+        {
+            out[size] = static_cast<unsigned char>(residual & 0xFFU);
+            residual >>= 8U;
+            ++size;
+        }
+    }
+
+    return size;
+}
+/*  End of cvp::fpc::encode.                                                  */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fpc::decode                                                      *
+ *  Purpose:                                                                  *
+ *      Decompresses a block written by cvp::fpc::encode.                     *
+ *  Arguments:                                                                *
+ *      in (const unsigned char *):                                           *
+ *          The compressed block.                                             *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes available in in.                              *
+ *      width (unsigned int):                                                 *
+ *          The number of values in a row.                                    *
+ *      rows (unsigned int):                                                  *
+ *          The number of rows.                                               *
+ *      out (T *):                                                            *
+ *          Room for width x rows values.                                     *
+ *  Outputs:                                                                  *
+ *      used (std::size_t):                                                   *
+ *          The number of bytes read from in, zero if in was too short.       *
+ *  Method:                                                                   *
+ *      Values are decoded in the order they were encoded, so the neighbors   *
+ *      a prediction needs are always in out already.                         *
+ ******************************************************************************/
+template <typename T>
+inline std::size_t
+cvp::fpc::decode(const unsigned char *in, std::size_t size,
+                 unsigned int width, unsigned int rows, T *out)
+{
+    typedef typename cvp::fpc::word<T>::type word_type;
+
+    /*  The number of values in the block, and an index for them.             */
+    const std::size_t count = static_cast<std::size_t>(width) * rows;
+    std::size_t n;
+
+    /*  The number of bytes read so far, and the current header byte.         */
+    std::size_t used = 0U;
+    unsigned int header = 0U;
+
+    for (n = 0U; n < count; ++n)
+    {
+        const unsigned int x = static_cast<unsigned int>(n % width);
+        const unsigned int y = static_cast<unsigned int>(n / width);
+
+        word_type along, across, residual, value;
+        unsigned int nibble, zeros, bytes, k;
+
+        if ((n & 1U) == 0U)
+        {
+            if (used >= size)
+                return 0U;
+
+            header = in[used];
+            ++used;
+            nibble = header >> 4U;
+        }
+        else
+            nibble = header & 0x0FU;
+
+        zeros = cvp::fpc::code_to_zeros(nibble & 7U, sizeof(word_type));
+
+        /*  Codes above four are not valid for 32-bit words, and the bytes of *
+         *  the residual must all be there.                                   */
+        if (zeros > sizeof(word_type))
+            return 0U;
+
+        bytes = sizeof(word_type) - zeros;
+
+        if (size - used < bytes)
+            return 0U;
+
+        residual = 0U;
+
+        for (k = 0U; k < bytes; ++k)
+            residual |= static_cast<word_type>(in[used + k]) << (8U*k);
+
+        used += bytes;
+
+        cvp::fpc::predict(out, width, x, y, &along, &across);
+        value = residual ^ ((nibble & 8U) ? across : along);
+        std::memcpy(out + n, &value, sizeof(value));
+    }
+
+    return used;
+}
+/*  End of cvp::fpc::decode.                                                  */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,352 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides low-level file output. POSIX I/O (write, mmap, pwrite) is    *
+ *      used where available, with C standard library fallbacks elsewhere.    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_IO_HPP
+#define CVP_IO_HPP
+
+/*  Unix-like systems, including Linux, the BSDs, and macOS, have POSIX I/O.  *
+ *  Compile with -DCVP_NO_POSIX to force the standard library fallbacks.      */
+#if (defined(__unix__) || defined(__APPLE__)) && !defined(CVP_NO_POSIX)
+
+/*  Macro used throughout the project to check for POSIX support.             */
+#define CVP_HAS_POSIX 1
+
+/*  write, close, ftruncate, and pwrite found here.                           */
+#include <unistd.h>
+
+/*  open and its flags found here.                                            */
+#include <fcntl.h>
+
+/*  errno and EINTR found here, used to retry interrupted writes.             */
+#include <cerrno>
+
+/*  mmap and munmap found here.                                               */
+#include <sys/mman.h>
+
+/*  fstat found here, used to check the size of files before mapping them.    */
+#include <sys/stat.h>
+
+#else
+/*  Else for #if defined(__unix__) || defined(__APPLE__).                     */
+
+/*  No POSIX, use the C standard library instead.                             */
+#define CVP_HAS_POSIX 0
+
+#endif
+/*  End of #if defined(__unix__) || defined(__APPLE__).                       */
+
+/*  FILE, fwrite, and fflush found here.                                      */
+#include <cstdio>
+
+/*  size_t found here.                                                        */
+#include <cstddef>
+
+/*  LONG_MAX found here, the largest offset fseek can take.                   */
+#include <climits>
+
+/*  Integers of exact width, for offsets into files larger than 4 GB.         */
+#include <cstdint>
+
+/*  Namespace for the mini-project. "Complex Visual Plots."                   */
+namespace cvp {
+
+    /*  Another namespace for the low-level I/O routines.                     */
+    namespace io {
+
+        /*  Writes an entire block of bytes to a file, bypassing stdio.       */
+        inline bool write_all(FILE *fp, const void *data, std::size_t size);
+
+        /*  Writes a block of bytes at an offset, safe to call from threads.  */
+        inline bool write_at(FILE *fp, std::uint64_t offset,
+                             const void *data, std::size_t size);
+
+        /*  Grows a file to the given size and maps all of it into memory.    */
+        inline unsigned char *map_file(FILE *fp, std::size_t size);
+
+        /*  Maps the first size bytes of an existing file for reading.        */
+        inline unsigned char *map_read(FILE *fp, std::size_t size);
+
+        /*  Unmaps a file mapped with map_file or map_read.                   */
+        inline void unmap_file(unsigned char *data, std::size_t size);
+    }
+    /*  End of namespace "io".                                                */
+}
+/*  End of namespace "cvp".                                                   */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::io::write_all                                                    *
+ *  Purpose:                                                                  *
+ *      Writes an entire block of bytes to a file.                            *
+ *  Arguments:                                                                *
+ *      fp (FILE *):                                                          *
+ *          The file being written to. Its stdio buffer is flushed first so   *
+ *          that earlier fprintf calls land before the block.                 *
+ *      data (const void *):                                                  *
+ *          The bytes to write.                                               *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes to write.                                     *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if every byte was written.                                   *
+ *  Method:                                                                   *
+ *      On POSIX systems call write(2) on the underlying descriptor until     *
+ *      the whole block is out, retrying on EINTR and short writes. This      *
+ *      skips the locking and copying that stdio does. Elsewhere use fwrite.  *
+ ******************************************************************************/
+inline bool cvp::io::write_all(FILE *fp, const void *data, std::size_t size)
+{
+#if CVP_HAS_POSIX
+    /*  Pointer to the bytes still to be written.                             */
+    const char *ptr = static_cast<const char *>(data);
+
+    /*  The file descriptor for the FILE pointer.                             */
+    const int fd = fileno(fp);
+
+    /*  Anything buffered by stdio (the header, say) must go out first.       */
+    if (std::fflush(fp) != 0)
+        return false;
+
+    while (size > 0U)
+    {
+        const ssize_t written = ::write(fd, ptr, size);
+
+        /*  Interrupted by a signal before anything was written. Try again.   */
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        /*  Short writes are legal, keep going from where it stopped.         */
+        ptr += written;
+        size -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+#else
+    return std::fwrite(data, 1U, size, fp) == size;
+#endif
+}
+/*  End of cvp::io::write_all.                                                */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::io::write_at                                                     *
+ *  Purpose:                                                                  *
+ *      Writes an entire block of bytes at a given offset in a file.          *
+ *  Arguments:                                                                *
+ *      fp (FILE *):                                                          *
+ *          The file being written to. Nothing may be left in its stdio       *
+ *          buffer, write_all leaves nothing there.                           *
+ *      offset (std::uint64_t):                                               *
+ *          Where the block goes, in bytes from the start of the file. The    *
+ *          file grows if this is past its end.                               *
+ *      data (const void *):                                                  *
+ *          The bytes to write.                                               *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes to write.                                     *
+ *  Outputs:                                                                  *
+ *      success (bool):                                                       *
+ *          True if every byte was written.                                   *
+ *  Method:                                                                   *
+ *      On POSIX systems call pwrite(2) until the whole block is out. It      *
+ *      does not move the file position, so any number of threads may write   *
+ *      different parts of the file at once. Elsewhere seek and fwrite, one   *
+ *      thread at a time.                                                     *
+ *  Notes:                                                                    *
+ *      Without POSIX the offset is limited to LONG_MAX, which may be 2 GB.   *
+ ******************************************************************************/
+inline bool cvp::io::write_at(FILE *fp, std::uint64_t offset,
+                              const void *data, std::size_t size)
+{
+#if CVP_HAS_POSIX
+    /*  Pointer to the bytes still to be written.                             */
+    const char *ptr = static_cast<const char *>(data);
+
+    /*  The file descriptor for the FILE pointer.                             */
+    const int fd = fileno(fp);
+
+    while (size > 0U)
+    {
+        const ssize_t written =
+            ::pwrite(fd, ptr, size, static_cast<off_t>(offset));
+
+        /*  Interrupted by a signal before anything was written. Try again.   */
+        if (written < 0)
+        {
+            if (errno == EINTR)
+                continue;
+
+            return false;
+        }
+
+        /*  Short writes are legal, keep going from where it stopped.         */
+        ptr += written;
+        offset += static_cast<std::uint64_t>(written);
+        size -= static_cast<std::size_t>(written);
+    }
+
+    return true;
+#else
+    bool success = false;
+
+    if (offset > static_cast<std::uint64_t>(LONG_MAX))
+        return false;
+
+#ifdef _OPENMP
+#pragma omp critical(cvp_io_write_at)
+#endif
+    {
+        if (std::fseek(fp, static_cast<long>(offset), SEEK_SET) == 0)
+            success = (std::fwrite(data, 1U, size, fp) == size);
+    }
+
+    return success;
+#endif
+}
+/*  End of cvp::io::write_at.                                                 */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::io::map_file                                                     *
+ *  Purpose:                                                                  *
+ *      Grows a file to the given size and maps all of it into memory.        *
+ *  Arguments:                                                                *
+ *      fp (FILE *):                                                          *
+ *          A file opened for both reading and writing.                       *
+ *      size (std::size_t):                                                   *
+ *          The final size of the file, in bytes.                             *
+ *  Outputs:                                                                  *
+ *      data (unsigned char *):                                               *
+ *          Pointer to the start of the file, or NULL if mapping failed or    *
+ *          is not supported on this system.                                  *
+ *  Notes:                                                                    *
+ *      The mapping is shared, so stores through the pointer end up in the    *
+ *      file. The file is extended with ftruncate, which leaves a sparse file *
+ *      on most file systems, so the size costs nothing until it is written.  *
+ ******************************************************************************/
+inline unsigned char *cvp::io::map_file(FILE *fp, std::size_t size)
+{
+#if CVP_HAS_POSIX
+    /*  The file descriptor for the FILE pointer.                             */
+    const int fd = fileno(fp);
+
+    /*  The address of the mapping.                                           */
+    void *data;
+
+    /*  Anything buffered by stdio needs to be in the file before we map it.  */
+    if (std::fflush(fp) != 0)
+        return NULL;
+
+    /*  mmap cannot grow a file, so give it its final size first.             */
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+        return NULL;
+
+    data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+    if (data == MAP_FAILED)
+        return NULL;
+
+    return static_cast<unsigned char *>(data);
+#else
+    /*  No mmap without POSIX. Callers should fall back to streaming.         */
+    static_cast<void>(fp);
+    static_cast<void>(size);
+    return NULL;
+#endif
+}
+/*  End of cvp::io::map_file.                                                 */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::io::map_read                                                     *
+ *  Purpose:                                                                  *
+ *      Maps the start of an existing file into memory for reading.           *
+ *  Arguments:                                                                *
+ *      fp (FILE *):                                                          *
+ *          A file opened for reading.                                        *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes to map, starting from the beginning.          *
+ *  Outputs:                                                                  *
+ *      data (unsigned char *):                                               *
+ *          Pointer to the start of the file, or NULL if the file is shorter  *
+ *          than size, mapping failed, or it is not supported on this system. *
+ *  Notes:                                                                    *
+ *      The mapping is private. Stores through the pointer go to a copy of    *
+ *      the page and never reach the file, which may be opened read-only.     *
+ *      Touching a mapped page past the end of a file raises SIGBUS, so the   *
+ *      size is checked against the file first. Free with unmap_file.         *
+ ******************************************************************************/
+inline unsigned char *cvp::io::map_read(FILE *fp, std::size_t size)
+{
+#if CVP_HAS_POSIX
+    /*  The file descriptor for the FILE pointer.                             */
+    const int fd = fileno(fp);
+
+    /*  The status of the file, for its size, and the address of the mapping. */
+    struct stat status;
+    void *data;
+
+    if (fstat(fd, &status) != 0)
+        return NULL;
+
+    if (static_cast<std::size_t>(status.st_size) < size)
+        return NULL;
+
+    data = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+
+    if (data == MAP_FAILED)
+        return NULL;
+
+    return static_cast<unsigned char *>(data);
+#else
+    /*  No mmap without POSIX. Callers should fall back to reading the file.  */
+    static_cast<void>(fp);
+    static_cast<void>(size);
+    return NULL;
+#endif
+}
+/*  End of cvp::io::map_read.                                                 */
+
+/*  Unmaps a file mapped with map_file or map_read.                           */
+inline void cvp::io::unmap_file(unsigned char *data, std::size_t size)
+{
+#if CVP_HAS_POSIX
+    if (data)
+        munmap(data, size);
+#else
+    static_cast<void>(data);
+    static_cast<void>(size);
+#endif
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,1193 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides pixel kernels for the plotting routines. A kernel computes   *
+ *      the colors of a horizontal run of pixels in the image.                *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_KERNELS_HPP
+#define CVP_KERNELS_HPP
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Viewports for mapping pixels to points in the plane.                      */
+#include "cvp_viewport.hpp"
+
+/*  Batches of complex numbers for evaluating several pixels at once.         */
+#include "cvp_batch.hpp"
+
+/*  Class for the result of iterating a point, given to escape-time colorers. */
+#include "cvp_orbit.hpp"
+
+/*  The quadratic map and the interior shortcuts for the Mandelbrot set.      */
+#include "cvp_quadratic.hpp"
+
+/*  Lists of known attractors, for labeling converged points.                 */
+#include "cvp_attractors.hpp"
+
+/*  Row colorers, which color the values of a whole run at once.              */
+#include "cvp_row_colorers.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The kernels below store whatever their colorer returns. This is a     *
+     *  cvp::color for images, but the output type is a template parameter so *
+     *  that the same kernels can save raw values instead, see cvp_field.hpp. */
+
+    /*  Batches hold doubles, so functions are only evaluated a batch at a    *
+     *  time if they can be and the viewport is in double precision.          */
+    template <typename Tfunc, typename Tview>
+    class use_batches
+        : public std::integral_constant<
+            bool,
+            cvp::is_batch_callable<Tfunc>::value &&
+            std::is_same<typename Tview::real_type, double>::value
+        > {};
+
+    /*  Loads the points of up to N pixels starting at (x, y) into a batch.   */
+    template <unsigned int N, typename Tview>
+    inline unsigned int
+    load_batch(cvp::complex_batch<N> &z, const Tview &view,
+               unsigned int x, unsigned int y, unsigned int n);
+
+    /*  Kernel for plotting f(z).                                             */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    class complex_kernel {
+        public:
+            Tfunc cfunc;
+            Tcolor color;
+            Tview view;
+
+            /*  Constructor from the function, colorer, and viewport.         */
+            complex_kernel(Tfunc f, Tcolor c, const Tview &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            template <typename Tout>
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, Tout *out) const;
+
+            /*  Computes the pixels one at a time, in the precision of the    *
+             *  viewport.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::false_type) const;
+
+            /*  Computes the pixels a batch at a time with cvp::complex_batch.*/
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::true_type) const;
+    };
+
+    /*  Kernel for plotting f(f(...f(z)...)), f applied iters times.          */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    class iters_kernel {
+        public:
+            Tfunc cfunc;
+            unsigned int iters;
+            Tcolor color;
+            Tview view;
+
+            /*  Constructor from the function, iterations, colorer, and view. */
+            iters_kernel(Tfunc f, unsigned int n, Tcolor c, const Tview &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            template <typename Tout>
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, Tout *out) const;
+
+            /*  Computes the pixels one at a time, in the precision of the    *
+             *  viewport.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::false_type) const;
+
+            /*  Computes the pixels a batch at a time with cvp::complex_batch.*/
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::true_type) const;
+    };
+
+    /*  Kernel for plotting the Mandelbrot iteration w_{n+1} = f(w_n) + z.    */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    class mandelbrot_kernel {
+        public:
+            Tfunc cfunc;
+            unsigned int iters;
+            Tcolor color;
+            Tview view;
+
+            /*  Constructor from the function, iterations, colorer, and view. */
+            mandelbrot_kernel(Tfunc f, unsigned int n,
+                              Tcolor c, const Tview &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            template <typename Tout>
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, Tout *out) const;
+
+            /*  Computes the pixels one at a time, in the precision of the    *
+             *  viewport.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::false_type) const;
+
+            /*  Computes the pixels a batch at a time with cvp::complex_batch.*/
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::true_type) const;
+    };
+
+    /*  Kernel for escape-time plots of w_{n+1} = f(w_n) + z.                 */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    class escape_kernel {
+        public:
+            Tfunc cfunc;
+            unsigned int iters;
+            double bailout_sq;
+            Tcolor color;
+            Tview view;
+
+            /*  Constructor from the function, maximum number of iterations,  *
+             *  bailout radius, colorer, and viewport.                        */
+            escape_kernel(Tfunc f, unsigned int n, double bailout,
+                          Tcolor c, const Tview &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            template <typename Tout>
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, Tout *out) const;
+
+            /*  Computes the pixels one at a time, in the precision of the    *
+             *  viewport.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::false_type) const;
+
+            /*  Computes the pixels a batch at a time, masking out lanes as   *
+             *  they escape.                                                  */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::true_type) const;
+    };
+
+    /*  Kernel for iterating w_{n+1} = f(w_n) from w_0 = z until consecutive  *
+     *  values are within a tolerance, like Newton's method converging.       */
+    template <typename Tfunc, typename Tcolor, typename Tview>
+    class convergence_kernel {
+        public:
+            Tfunc cfunc;
+            unsigned int iters;
+            double tolerance_sq;
+            cvp::attractors roots;
+            Tcolor color;
+            Tview view;
+
+            /*  Constructor from the function, maximum number of iterations,  *
+             *  tolerance, known attractors, colorer, and viewport.           */
+            convergence_kernel(Tfunc f, unsigned int n, double tolerance,
+                               const cvp::attractors &a, Tcolor c,
+                               const Tview &v);
+
+            /*  Computes the colors of n pixels starting at (x, y).           */
+            template <typename Tout>
+            inline void operator () (unsigned int x, unsigned int y,
+                                     unsigned int n, Tout *out) const;
+
+            /*  Computes the pixels one at a time, in the precision of the    *
+             *  viewport.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::false_type) const;
+
+            /*  Computes the pixels a batch at a time, retiring lanes as they *
+             *  converge.                                                     */
+            template <typename Tout>
+            inline void run(unsigned int x, unsigned int y, unsigned int n,
+                            Tout *out, std::true_type) const;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Loads min(n, N) pixels of row y into z, returning the number of lanes     *
+ *  used. The unused lanes repeat the last point so that f is evaluated at    *
+ *  valid points even at the end of a row. Their results are ignored.         */
+template <unsigned int N, typename Tview>
+inline unsigned int
+cvp::load_batch(cvp::complex_batch<N> &z, const Tview &view,
+                unsigned int x, unsigned int y, unsigned int n)
+{
+    /*  Index for the lanes of the batch.                                     */
+    unsigned int k;
+
+    /*  The number of lanes with a pixel in them.                             */
+    const unsigned int lanes = (n < N ? n : N);
+
+    /*  The y coordinate in the plane is the same for the entire batch.       */
+    const double z_im = view.imag(y);
+
+    for (k = 0U; k < N; ++k)
+    {
+        z.real[k] = view.real(x + (k < lanes ? k : lanes - 1U));
+        z.imag[k] = z_im;
+    }
+
+    return lanes;
+}
+
+/*  Constructor from the function, colorer, and viewport.                     */
+template <typename Tfunc, typename Tcolor, typename Tview>
+cvp::complex_kernel<Tfunc, Tcolor, Tview>::complex_kernel(Tfunc f, Tcolor c,
+                                                          const Tview &v)
+    : cfunc(f), color(c), view(v)
+{
+    return;
+}
+
+/*  Computes the colors of n pixels starting at (x, y). Functions that can be *
+ *  called on a cvp::complex_batch are evaluated a batch at a time.           */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::complex_kernel<Tfunc, Tcolor, Tview>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, Tout *out
+) const
+{
+    run(x, y, n, out, typename cvp::use_batches<Tfunc, Tview>::type());
+}
+
+/*  Computes the colors of n pixels starting at (x, y), one at a time.        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::complex_kernel<Tfunc, Tcolor, Tview>::run(unsigned int x, unsigned int y,
+                                               unsigned int n, Tout *out,
+                                               std::false_type) const
+{
+    /*  Points are computed in the precision of the viewport.                 */
+    typedef typename Tview::real_type real_type;
+    typedef cvp::basic_complex<real_type> complex_type;
+
+    /*  Indices for the blocks of the run and the pixels of a block.          */
+    unsigned int k, j;
+
+    /*  The values f(z) of a block, colored together as a row.                */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const real_type z_im = view.imag(y);
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; ++j)
+        {
+            /*  Compute the corresponding x coordinate.                       */
+            const real_type z_re = view.real(x + k + j);
+
+            /*  Evaluate f at the point, rounded to double for coloring.      */
+            const cvp::complex w(cfunc(complex_type(z_re, z_im)));
+            re[j] = w.real;
+            im[j] = w.imag;
+        }
+
+        /*  Color the points f(z).                                            */
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Computes the colors of n pixels starting at (x, y), a batch at a time.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::complex_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::true_type
+) const
+{
+    /*  Indices for the blocks of the run, the batches of a block, and the    *
+     *  lanes of a batch.                                                     */
+    unsigned int k, j, lane;
+
+    /*  The values of a block, colored together as a row.                     */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The points in the plane, loaded a batch at a time.                    */
+    cvp::complex_batch<> z;
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; j += cvp::batch_width)
+        {
+            const unsigned int lanes =
+                cvp::load_batch(z, view, x + k + j, y, m - j);
+
+            /*  Evaluate f on every lane at once.                             */
+            const cvp::complex_batch<> w = cfunc(z);
+
+            for (lane = 0U; lane < lanes; ++lane)
+            {
+                re[j + lane] = w.real[lane];
+                im[j + lane] = w.imag[lane];
+            }
+        }
+
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Constructor from the function, iterations, colorer, and viewport.         */
+template <typename Tfunc, typename Tcolor, typename Tview>
+cvp::iters_kernel<Tfunc, Tcolor, Tview>::iters_kernel(Tfunc f,
+                                                      unsigned int n,
+                                                      Tcolor c,
+                                                      const Tview &v)
+    : cfunc(f), iters(n), color(c), view(v)
+{
+    return;
+}
+
+/*  Computes the colors of n pixels starting at (x, y). Functions that can be *
+ *  called on a cvp::complex_batch are evaluated a batch at a time.           */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::iters_kernel<Tfunc, Tcolor, Tview>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, Tout *out
+) const
+{
+    run(x, y, n, out, typename cvp::use_batches<Tfunc, Tview>::type());
+}
+
+/*  Computes the colors of n pixels starting at (x, y), one at a time.        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::iters_kernel<Tfunc, Tcolor, Tview>::run(unsigned int x, unsigned int y,
+                                             unsigned int n, Tout *out,
+                                             std::false_type) const
+{
+    /*  Points are computed in the precision of the viewport.                 */
+    typedef typename Tview::real_type real_type;
+    typedef cvp::basic_complex<real_type> complex_type;
+
+    /*  Indices for the blocks of the run, the pixels of a block, and the     *
+     *  iterations.                                                           */
+    unsigned int k, j, ind;
+
+    /*  The final iterates of a block, colored together as a row.             */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const real_type z_im = view.imag(y);
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; ++j)
+        {
+            /*  Compute the corresponding x coordinate.                       */
+            const real_type z_re = view.real(x + k + j);
+
+            /*  Treat the ordered pair (z_re, z_im) as a complex number.      */
+            complex_type z = complex_type(z_re, z_im);
+
+            /*  Repeatedly call the function.                                 */
+            for (ind = 0U; ind < iters; ++ind)
+                z = cfunc(z);
+
+            const cvp::complex w(z);
+            re[j] = w.real;
+            im[j] = w.imag;
+        }
+
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Computes the colors of n pixels starting at (x, y), a batch at a time.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::iters_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::true_type
+) const
+{
+    /*  Indices for the blocks of the run, the batches of a block, and the    *
+     *  lanes of a batch.                                                     */
+    unsigned int k, j, lane, ind;
+
+    /*  The values of a block, colored together as a row.                     */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The points in the plane, loaded a batch at a time.                    */
+    cvp::complex_batch<> z;
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; j += cvp::batch_width)
+        {
+            const unsigned int lanes =
+                cvp::load_batch(z, view, x + k + j, y, m - j);
+
+            /*  Repeatedly call the function on every lane at once.           */
+            for (ind = 0U; ind < iters; ++ind)
+                z = cfunc(z);
+
+            for (lane = 0U; lane < lanes; ++lane)
+            {
+                re[j + lane] = z.real[lane];
+                im[j + lane] = z.imag[lane];
+            }
+        }
+
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Constructor from the function, iterations, colorer, and viewport.         */
+template <typename Tfunc, typename Tcolor, typename Tview>
+cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview>::mandelbrot_kernel(Tfunc f,
+                                                                unsigned int n,
+                                                                Tcolor c,
+                                                                const Tview &v)
+    : cfunc(f), iters(n), color(c), view(v)
+{
+    return;
+}
+
+/*  Computes the colors of n pixels starting at (x, y). Functions that can be *
+ *  called on a cvp::complex_batch are evaluated a batch at a time.           */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, Tout *out
+) const
+{
+    run(x, y, n, out, typename cvp::use_batches<Tfunc, Tview>::type());
+}
+
+/*  Computes the colors of n pixels starting at (x, y), one at a time.        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::false_type
+) const
+{
+    /*  Points are computed in the precision of the viewport.                 */
+    typedef typename Tview::real_type real_type;
+    typedef cvp::basic_complex<real_type> complex_type;
+
+    /*  Indices for the blocks of the run, the pixels of a block, and the     *
+     *  iterations.                                                           */
+    unsigned int k, j, ind;
+
+    /*  The final iterates of a block, colored together as a row.             */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const real_type z_im = view.imag(y);
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; ++j)
+        {
+            /*  Compute the corresponding x coordinate.                       */
+            const real_type z_re = view.real(x + k + j);
+
+            /*  Treat the ordered pair (z_re, z_im) as a complex number.      */
+            const complex_type z = complex_type(z_re, z_im);
+
+            /*  Set the first iteration to the input.                         */
+            complex_type w = z;
+
+            /*  Repeatedly call the function.                                 */
+            for (ind = 0U; ind < iters; ++ind)
+                w = cfunc(w) + z;
+
+            const cvp::complex final_w(w);
+            re[j] = final_w.real;
+            im[j] = final_w.imag;
+        }
+
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Computes the colors of n pixels starting at (x, y), a batch at a time.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::mandelbrot_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::true_type
+) const
+{
+    /*  Indices for the blocks of the run, the batches of a block, and the    *
+     *  lanes of a batch.                                                     */
+    unsigned int k, j, lane, ind;
+
+    /*  The values of a block, colored together as a row.                     */
+    double re[cvp::row_block], im[cvp::row_block];
+
+    /*  The points in the plane, loaded a batch at a time.                    */
+    cvp::complex_batch<> z, w;
+
+    for (k = 0U; k < n; k += cvp::row_block)
+    {
+        const unsigned int m =
+            (n - k < cvp::row_block ? n - k : cvp::row_block);
+
+        for (j = 0U; j < m; j += cvp::batch_width)
+        {
+            const unsigned int lanes =
+                cvp::load_batch(z, view, x + k + j, y, m - j);
+
+            /*  Set the first iteration to the input.                         */
+            w = z;
+
+            /*  Repeatedly call the function on every lane at once.           */
+            for (ind = 0U; ind < iters; ++ind)
+                w = cfunc(w) + z;
+
+            for (lane = 0U; lane < lanes; ++lane)
+            {
+                re[j + lane] = w.real[lane];
+                im[j + lane] = w.imag[lane];
+            }
+        }
+
+        cvp::color_row(color, re, im, m, out + k);
+    }
+}
+
+/*  Constructor from the function, iterations, bailout, colorer, and view.    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+cvp::escape_kernel<Tfunc, Tcolor, Tview>::escape_kernel(Tfunc f,
+                                                        unsigned int n,
+                                                        double bailout,
+                                                        Tcolor c,
+                                                        const Tview &v)
+    : cfunc(f), iters(n), bailout_sq(bailout*bailout), color(c), view(v)
+{
+    return;
+}
+
+/*  Computes the colors of n pixels starting at (x, y). Functions that can be *
+ *  called on a cvp::complex_batch are evaluated a batch at a time, provided  *
+ *  the masked loops over the lanes can be vectorized. Otherwise the batches  *
+ *  do the same work as the scalar loop, with more bookkeeping.               */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::escape_kernel<Tfunc, Tcolor, Tview>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, Tout *out
+) const
+{
+    typedef std::integral_constant<
+        bool, cvp::use_batches<Tfunc, Tview>::value && CVP_SIMD_MASKS
+    > batched;
+
+    run(x, y, n, out, typename batched::type());
+}
+
+/*  Computes the colors of n pixels starting at (x, y), one at a time.        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::escape_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::false_type
+) const
+{
+    /*  Points are computed in the precision of the viewport.                 */
+    typedef typename Tview::real_type real_type;
+    typedef cvp::basic_complex<real_type> complex_type;
+
+    /*  Indices for the pixels in the run and the iterations.                 */
+    unsigned int k, ind;
+
+    /*  The quadratic map gets the interior shortcuts.                        */
+    const bool shortcuts = cvp::is_quadratic<Tfunc>::value;
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const real_type z_im = view.imag(y);
+
+    for (k = 0U; k < n; ++k)
+    {
+        /*  Compute the corresponding x coordinate.                           */
+        const real_type z_re = view.real(x + k);
+
+        /*  Treat the ordered pair (z_re, z_im) as a complex number.          */
+        const complex_type z = complex_type(z_re, z_im);
+
+        /*  Set the first iteration to the input.                             */
+        complex_type w = z;
+
+        /*  An earlier value of the orbit, for detecting cycles.              */
+        complex_type saved = z;
+
+        /*  Whether the orbit has left the bailout radius, or entered a cycle.*/
+        bool escaped = false;
+        bool cycled = false;
+
+        /*  Points in the cardioid or the bulb never escape. Skip them.       */
+        if (shortcuts && cvp::quadratic::in_cardioid_or_bulb(z_re, z_im))
+        {
+            out[k] = color(cvp::orbit(cvp::complex(z), iters, iters, false));
+            continue;
+        }
+
+        /*  Iterate until the orbit escapes or we run out of iterations.      */
+        for (ind = 0U; ind < iters && !escaped && !cycled; ++ind)
+        {
+            w = cfunc(w) + z;
+            escaped = (w.abssq() > bailout_sq);
+
+            if (!shortcuts || escaped)
+                continue;
+
+            /*  Brent's method: compare with the value saved at the last      *
+             *  power of two, then save a new one at the next power of two.   */
+            cycled = ((w - saved).abssq() < cvp::periodicity_tolerance);
+
+            if (((ind + 1U) & ind) == 0U)
+                saved = w;
+        }
+
+        /*  Orbits caught in a cycle are reported as running to the end.      */
+        if (cycled)
+            ind = iters;
+
+        out[k] = color(cvp::orbit(cvp::complex(w), ind, iters, escaped));
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::escape_kernel::run                                               *
+ *  Purpose:                                                                  *
+ *      Computes the escape-time colors of n pixels, a batch at a time.       *
+ *  Arguments:                                                                *
+ *      x (unsigned int):                                                     *
+ *          The column of the first pixel.                                    *
+ *      y (unsigned int):                                                     *
+ *          The row of the pixels.                                            *
+ *      n (unsigned int):                                                     *
+ *          The number of pixels.                                             *
+ *      out (Tout *):                                                         *
+ *          The colors of the pixels are stored here. Usually cvp::color, but *
+ *          anything the colorer's output can be assigned to will do.         *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Every lane of the batch holds a different pixel of the run, and all   *
+ *      of them are iterated together. A lane that finishes is masked out:    *
+ *      its value and iteration count are frozen with a select, not a branch, *
+ *      so the loops over the lanes stay vectorized. As soon as any lane      *
+ *      finishes its pixel is colored and the lane is refilled with the next  *
+ *      pixel of the run, so no lane sits idle while its neighbors run to the *
+ *      maximum iteration count. Lanes are only left empty at the end of the  *
+ *      run.                                                                  *
+ *  Notes:                                                                    *
+ *      The result of each pixel is identical to the scalar version, unless   *
+ *      the compiler contracts the arithmetic into fused multiply-adds        *
+ *      differently in the two (use -ffp-contract=off to prevent this).       *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::escape_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::true_type
+) const
+{
+    /*  Index for the lanes of the batch.                                     */
+    unsigned int lane;
+
+    /*  The next pixel of the run to be given to a lane.                      */
+    unsigned int next_pixel = 0U;
+
+    /*  The quadratic map gets the interior shortcuts.                        */
+    const bool shortcuts = cvp::is_quadratic<Tfunc>::value;
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const double z_im = view.imag(y);
+
+    /*  The points in the plane, their iterates, and the next iterates.       */
+    cvp::complex_batch<> z, w, next;
+
+    /*  Earlier values of the orbits, for detecting cycles.                   */
+    cvp::complex_batch<> saved;
+
+    /*  The iteration count of each lane, whether it is still active, and     *
+     *  whether it stopped by escaping (instead of by entering a cycle). The  *
+     *  flags are 0 or 1. These are 64 bits wide, like a double, so that the  *
+     *  compiler can vectorize the selects in the loops over the lanes.       */
+    long long count[cvp::batch_width], live[cvp::batch_width];
+    long long escaped[cvp::batch_width];
+
+    /*  The pixel held by each lane. n means the lane is empty.               */
+    unsigned int pixel[cvp::batch_width];
+
+    /*  The maximum number of iterations, as a lane count.                    */
+    const long long max_count = static_cast<long long>(iters);
+
+    /*  Bitwise or of the active flags, zero once every lane is done.         */
+    long long remaining;
+
+    /*  Start with every lane empty.                                          */
+    for (lane = 0U; lane < cvp::batch_width; ++lane)
+    {
+        pixel[lane] = n;
+        live[lane] = 0;
+        z.set(lane, cvp::complex(0.0, 0.0));
+        w.set(lane, cvp::complex(0.0, 0.0));
+        saved.set(lane, cvp::complex(0.0, 0.0));
+        count[lane] = 0;
+        escaped[lane] = 0;
+    }
+
+    for (;;)
+    {
+        /*  Color the pixels of finished lanes and refill them.               */
+        remaining = 0;
+
+        for (lane = 0U; lane < cvp::batch_width; ++lane)
+        {
+            if (!live[lane] && pixel[lane] != n)
+            {
+                out[pixel[lane]] = color(
+                    cvp::orbit(
+                        w.get(lane), static_cast<unsigned int>(count[lane]),
+                        iters, escaped[lane] != 0
+                    )
+                );
+
+                pixel[lane] = n;
+            }
+
+            while (!live[lane] && next_pixel < n)
+            {
+                const cvp::complex c =
+                    cvp::complex(view.real(x + next_pixel), z_im);
+
+                /*  Points in the cardioid or the bulb never escape.          */
+                if (shortcuts && cvp::quadratic::in_cardioid_or_bulb(c.real,
+                                                                     c.imag))
+                {
+                    out[next_pixel] = color(cvp::orbit(c, iters, iters, false));
+                    ++next_pixel;
+                    continue;
+                }
+
+                /*  Start the orbit of this pixel in the lane.                */
+                z.set(lane, c);
+                w.set(lane, c);
+                saved.set(lane, c);
+                count[lane] = 0;
+                escaped[lane] = 0;
+                live[lane] = (max_count > 0 ? 1 : 0);
+                pixel[lane] = next_pixel;
+                ++next_pixel;
+
+                /*  With zero iterations the pixel is done immediately.       */
+                if (!live[lane])
+                {
+                    out[pixel[lane]] = color(cvp::orbit(c, 0U, iters, false));
+                    pixel[lane] = n;
+                }
+            }
+
+            remaining |= live[lane];
+        }
+
+        /*  Every pixel of the run is done.                                   */
+        if (!remaining)
+            break;
+
+        /*  Iterate every lane until at least one of them finishes.           */
+        for (;;)
+        {
+            /*  Bitwise or of the lanes that finished on this step.           */
+            long long finished = 0;
+
+            next = cfunc(w) + z;
+
+            /*  The lane loops are short and fixed-length, the compiler would *
+             *  rather unroll them and branch on the flags than vectorize.    *
+             *  Where vector selects are fast, ask for them explicitly.       */
+#if CVP_SIMD_MASKS
+#pragma omp simd reduction(|:finished)
+#endif
+            for (lane = 0U; lane < cvp::batch_width; ++lane)
+            {
+                const double re = next.real[lane];
+                const double im = next.imag[lane];
+                const double abssq = re*re + im*im;
+
+                /*  Written as a > b, not !(a <= b), so NaN matches scalar.   */
+                const long long out_of_bounds =
+                    static_cast<long long>(abssq > bailout_sq);
+
+                long long stop;
+
+                /*  Only active lanes take the new value and count the step.  */
+                w.real[lane] = (live[lane] ? re : w.real[lane]);
+                w.imag[lane] = (live[lane] ? im : w.imag[lane]);
+                count[lane] += live[lane];
+                escaped[lane] |= live[lane] & out_of_bounds;
+
+                /*  Lanes stop by escaping or by running out of iterations.   */
+                stop = out_of_bounds |
+                       static_cast<long long>(count[lane] == max_count);
+
+                finished |= live[lane] & stop;
+                live[lane] &= (stop ^ 1);
+            }
+
+            /*  Brent's method, as in the scalar version. Each lane compares  *
+             *  with the value saved when its own count was a power of two.   */
+            if (shortcuts)
+            {
+#if CVP_SIMD_MASKS
+#pragma omp simd reduction(|:finished)
+#endif
+                for (lane = 0U; lane < cvp::batch_width; ++lane)
+                {
+                    const double dx = w.real[lane] - saved.real[lane];
+                    const double dy = w.imag[lane] - saved.imag[lane];
+                    const long long cycled = static_cast<long long>(
+                        dx*dx + dy*dy < cvp::periodicity_tolerance
+                    );
+
+                    const long long save = static_cast<long long>(
+                        (count[lane] & (count[lane] - 1)) == 0
+                    );
+
+                    /*  Cycles run to the end, like in the scalar version.    */
+                    count[lane] =
+                        ((live[lane] & cycled) ? max_count : count[lane]);
+
+                    finished |= live[lane] & cycled;
+                    live[lane] &= (cycled ^ 1);
+
+                    saved.real[lane] = (save ? w.real[lane] : saved.real[lane]);
+                    saved.imag[lane] = (save ? w.imag[lane] : saved.imag[lane]);
+                }
+            }
+
+            if (finished)
+                break;
+        }
+    }
+}
+/*  End of cvp::escape_kernel::run.                                           */
+
+/*  Constructor from the function, iterations, tolerance, attractors,         *
+ *  colorer, and viewport.                                                    */
+template <typename Tfunc, typename Tcolor, typename Tview>
+cvp::convergence_kernel<Tfunc, Tcolor, Tview>::convergence_kernel(
+    Tfunc f, unsigned int n, double tolerance, const cvp::attractors &a,
+    Tcolor c, const Tview &v
+) : cfunc(f), iters(n), tolerance_sq(tolerance*tolerance), roots(a),
+    color(c), view(v)
+{
+    return;
+}
+
+/*  Computes the colors of n pixels starting at (x, y). Functions that can be *
+ *  called on a cvp::complex_batch are evaluated a batch at a time, provided  *
+ *  the masked loops over the lanes can be vectorized.                        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::convergence_kernel<Tfunc, Tcolor, Tview>::operator () (
+    unsigned int x, unsigned int y, unsigned int n, Tout *out
+) const
+{
+    typedef std::integral_constant<
+        bool, cvp::use_batches<Tfunc, Tview>::value && CVP_SIMD_MASKS
+    > batched;
+
+    run(x, y, n, out, typename batched::type());
+}
+
+/*  Computes the colors of n pixels starting at (x, y), one at a time.        */
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::convergence_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::false_type
+) const
+{
+    /*  Points are computed in the precision of the viewport.                 */
+    typedef typename Tview::real_type real_type;
+    typedef cvp::basic_complex<real_type> complex_type;
+
+    /*  Indices for the pixels in the run and the iterations.                 */
+    unsigned int k, ind;
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const real_type z_im = view.imag(y);
+
+    for (k = 0U; k < n; ++k)
+    {
+        /*  Compute the corresponding x coordinate.                           */
+        const real_type z_re = view.real(x + k);
+
+        /*  The orbit starts at the point itself.                             */
+        complex_type w = complex_type(z_re, z_im);
+
+        /*  Whether consecutive values have come within the tolerance.        */
+        bool converged = false;
+
+        /*  The square of the last step that was not within the tolerance.    */
+        double step_sq = 0.0;
+
+        /*  The last value of the orbit, rounded for the colorer.             */
+        cvp::complex last;
+
+        /*  Iterate until the orbit settles or we run out of iterations.      */
+        for (ind = 0U; ind < iters && !converged; ++ind)
+        {
+            const complex_type next = cfunc(w);
+            const double dz_sq = static_cast<double>((next - w).abssq());
+            converged = (dz_sq < tolerance_sq);
+            step_sq = (converged ? step_sq : dz_sq);
+            w = next;
+        }
+
+        last = cvp::complex(w);
+
+        out[k] = color(
+            cvp::convergence(
+                last, ind, iters, converged,
+                (converged ? roots.find(last) : -1), step_sq, tolerance_sq
+            )
+        );
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::convergence_kernel::run                                          *
+ *  Purpose:                                                                  *
+ *      Computes the convergence colors of n pixels, a batch at a time.       *
+ *  Arguments:                                                                *
+ *      x (unsigned int):                                                     *
+ *          The column of the first pixel.                                    *
+ *      y (unsigned int):                                                     *
+ *          The row of the pixels.                                            *
+ *      n (unsigned int):                                                     *
+ *          The number of pixels.                                             *
+ *      out (Tout *):                                                         *
+ *          The colors of the pixels are stored here. Usually cvp::color, but *
+ *          anything the colorer's output can be assigned to will do.         *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The same scheme as cvp::escape_kernel. Every lane holds a pixel, and  *
+ *      a lane that converges is masked out with selects. As soon as any lane *
+ *      is done its pixel is colored and the lane is given the next pixel of  *
+ *      the run. Newton's method converges in a handful of steps for most     *
+ *      points, so this keeps the lanes busy while the few points near the    *
+ *      boundaries of the basins take longer.                                 *
+ ******************************************************************************/
+template <typename Tfunc, typename Tcolor, typename Tview>
+template <typename Tout>
+inline void
+cvp::convergence_kernel<Tfunc, Tcolor, Tview>::run(
+    unsigned int x, unsigned int y, unsigned int n, Tout *out,
+    std::true_type
+) const
+{
+    /*  Index for the lanes of the batch.                                     */
+    unsigned int lane;
+
+    /*  The next pixel of the run to be given to a lane.                      */
+    unsigned int next_pixel = 0U;
+
+    /*  The y coordinate in the plane is the same for the entire run.         */
+    const double z_im = view.imag(y);
+
+    /*  The iterates, and the next iterates.                                  */
+    cvp::complex_batch<> w, next;
+
+    /*  The iteration count of each lane, whether it is still active, and     *
+     *  whether it converged. As in cvp::escape_kernel these are 64 bits wide *
+     *  so that the selects in the loops over the lanes vectorize.            */
+    long long count[cvp::batch_width], live[cvp::batch_width];
+    long long converged[cvp::batch_width];
+
+    /*  The square of the last step of each lane not within the tolerance.    */
+    double step_sq[cvp::batch_width];
+
+    /*  The pixel held by each lane. n means the lane is empty.               */
+    unsigned int pixel[cvp::batch_width];
+
+    /*  The maximum number of iterations, as a lane count.                    */
+    const long long max_count = static_cast<long long>(iters);
+
+    /*  Bitwise or of the active flags, zero once every lane is done.         */
+    long long remaining;
+
+    /*  Start with every lane empty. Empty lanes still hold a valid point.    */
+    for (lane = 0U; lane < cvp::batch_width; ++lane)
+    {
+        pixel[lane] = n;
+        live[lane] = 0;
+        w.set(lane, cvp::complex(1.0, 0.0));
+        count[lane] = 0;
+        converged[lane] = 0;
+        step_sq[lane] = 0.0;
+    }
+
+    for (;;)
+    {
+        /*  Color the pixels of finished lanes and refill them.               */
+        remaining = 0;
+
+        for (lane = 0U; lane < cvp::batch_width; ++lane)
+        {
+            if (!live[lane] && pixel[lane] != n)
+            {
+                const cvp::complex last = w.get(lane);
+                const bool status = (converged[lane] != 0);
+
+                out[pixel[lane]] = color(
+                    cvp::convergence(
+                        last, static_cast<unsigned int>(count[lane]), iters,
+                        status, (status ? roots.find(last) : -1),
+                        step_sq[lane], tolerance_sq
+                    )
+                );
+
+                pixel[lane] = n;
+            }
+
+            while (!live[lane] && next_pixel < n)
+            {
+                const cvp::complex z =
+                    cvp::complex(view.real(x + next_pixel), z_im);
+
+                /*  With zero iterations the pixel is done immediately.       */
+                if (max_count == 0)
+                {
+                    out[next_pixel] = color(
+                        cvp::convergence(
+                            z, 0U, iters, false, -1, 0.0, tolerance_sq
+                        )
+                    );
+
+                    ++next_pixel;
+                    continue;
+                }
+
+                /*  Start the orbit of this pixel in the lane.                */
+                w.set(lane, z);
+                count[lane] = 0;
+                converged[lane] = 0;
+                live[lane] = 1;
+                pixel[lane] = next_pixel;
+                ++next_pixel;
+            }
+
+            remaining |= live[lane];
+        }
+
+        /*  Every pixel of the run is done.                                   */
+        if (!remaining)
+            break;
+
+        /*  Iterate every lane until at least one of them finishes.           */
+        for (;;)
+        {
+            /*  Bitwise or of the lanes that finished on this step.           */
+            long long finished = 0;
+
+            next = cfunc(w);
+
+#if CVP_SIMD_MASKS
+#pragma omp simd reduction(|:finished)
+#endif
+            for (lane = 0U; lane < cvp::batch_width; ++lane)
+            {
+                const double dx = next.real[lane] - w.real[lane];
+                const double dy = next.imag[lane] - w.imag[lane];
+
+                const double dz_sq = dx*dx + dy*dy;
+
+                const long long settled =
+                    static_cast<long long>(dz_sq < tolerance_sq);
+
+                long long stop;
+
+                /*  Only active lanes take the new value and count the step.  */
+                w.real[lane] = (live[lane] ? next.real[lane] : w.real[lane]);
+                w.imag[lane] = (live[lane] ? next.imag[lane] : w.imag[lane]);
+                step_sq[lane] = ((live[lane] & (settled ^ 1)) ?
+                                  dz_sq : step_sq[lane]);
+                count[lane] += live[lane];
+                converged[lane] |= live[lane] & settled;
+
+                /*  Lanes stop by converging or by running out of iterations. */
+                stop = settled |
+                       static_cast<long long>(count[lane] == max_count);
+
+                finished |= live[lane] & stop;
+                live[lane] &= (stop ^ 1);
+            }
+
+            if (finished)
+                break;
+        }
+    }
+}
+/*  End of cvp::convergence_kernel::run.                                      */
+
+#endif
+/*  End of include guard.                                                     */
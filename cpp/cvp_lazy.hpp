@@ -0,0 +1,1231 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides lazy complex arithmetic. An expression in one variable is    *
+ *      built up as a type and evaluated in a single pass, with the powers of *
+ *      the variable shared, products fused with the sums that follow them,   *
+ *      and real factors folded into the reciprocal of a division.            *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_LAZY_HPP
+#define CVP_LAZY_HPP
+
+/*  std::declval, used for the types of rewritten products.                   */
+#include <utility>
+
+/*  fma found here, and the FP_FAST_FMA macro.                                */
+#include <cmath>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, which may also be evaluated lazily.           */
+#include "cvp_batch.hpp"
+
+/*  Chains of repeated squares, and the fused Horner steps.                   */
+#include "cvp_polynomial.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The position of the lowest non-zero binary digit of n > 0.            */
+    constexpr unsigned int lowest_bit(unsigned int n)
+    {
+        return (n % 2U == 1U ? 0U : 1U + cvp::lowest_bit(n / 2U));
+    }
+
+    /*  Computes a b + c, with fused multiply-adds when the hardware has      *
+     *  them. Otherwise this is the same arithmetic as the operators.         */
+    template <typename T>
+    inline T fused_mul_add(const T &a, const T &b, const T &c);
+
+    template <typename T>
+    inline T fused_mul_add(const T &a, const T &b, double c);
+
+    inline cvp::complex
+    fused_mul_add(const cvp::complex &a,
+                  const cvp::complex &b, const cvp::complex &c);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    fused_mul_add(const cvp::complex_batch<N> &a,
+                  const cvp::complex_batch<N> &b,
+                  const cvp::complex_batch<N> &c);
+
+    /*  Computes a b + c for real a.                                          */
+    template <typename T>
+    inline T fused_scale_add(double a, const T &b, const T &c);
+
+    template <typename T>
+    inline T fused_scale_add(double a, const T &b, double c);
+
+    inline cvp::complex
+    fused_scale_add(double a, const cvp::complex &b, const cvp::complex &c);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    fused_scale_add(double a, const cvp::complex_batch<N> &b,
+                    const cvp::complex_batch<N> &c);
+
+    /*  Computes n / (s d) for real s, with one reciprocal.                   */
+    template <typename T>
+    inline T fused_divide(const T &n, const T &d, double s);
+
+    inline cvp::complex
+    fused_divide(const cvp::complex &n, const cvp::complex &d, double s);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    fused_divide(const cvp::complex_batch<N> &n,
+                 const cvp::complex_batch<N> &d, double s);
+
+    /*  Computes a / (s d) for real a and s, with one reciprocal.             */
+    template <typename T>
+    inline T fused_rdivide(double a, const T &d, double s);
+
+    inline cvp::complex
+    fused_rdivide(double a, const cvp::complex &d, double s);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    fused_rdivide(double a, const cvp::complex_batch<N> &d, double s);
+
+    /*  Converts a constant of an expression to the type it is added to.      *
+     *  Real constants stay real, which only touches the real part.           */
+    template <typename T>
+    inline double lazy_cast(double c);
+
+    template <typename T>
+    inline T lazy_cast(const cvp::complex &c);
+
+    /*  Base class for the nodes of a lazy expression. E is the node and T    *
+     *  the type it evaluates to, cvp::basic_complex or cvp::complex_batch.   *
+     *  Every node E provides:                                                *
+     *      max_power:   The highest power of the variable in the node.       *
+     *      is_product:  Whether the last operation is a product, which may   *
+     *                   be fused with an addition.                           *
+     *      variable():  The variable the expression is in.                   *
+     *      eval(z):     The value, given the squares z of the variable.      *
+     *      eval_plus(z, c):                                                  *
+     *                   The value plus c, which is T or double.              */
+    template <typename E, typename T>
+    class lazy_expression {
+        public:
+            /*  The type the expression evaluates to.                         */
+            typedef T value_type;
+
+            /*  The node this is the base of.                                 */
+            inline const E &node(void) const;
+
+            /*  Evaluates the expression in one pass.                         */
+            inline operator T (void) const;
+    };
+
+    /*  The power z^N of the variable. z itself is N = 1.                     */
+    template <typename T, unsigned int N>
+    class lazy_power : public cvp::lazy_expression<lazy_power<T, N>, T> {
+        public:
+            static const unsigned int max_power = N;
+            static const bool is_product = ((N & (N - 1U)) != 0U);
+
+            /*  The variable, which must outlive the expression.              */
+            const T &z;
+
+            /*  Constructor from the variable.                                */
+            explicit lazy_power(const T &w);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The power z^N plus c. If N is not a power of two, z^N is the product  *
+     *  of two squares and the addition is fused with it.                     */
+    template <unsigned int N, bool Split = ((N & (N - 1U)) != 0U)>
+    class lazy_power_sum;
+
+    template <unsigned int N>
+    class lazy_power_sum<N, true> {
+        public:
+            template <typename T, unsigned int K, typename C>
+            static inline T eval(const cvp::power_chain<T, K> &chain,
+                                 const C &c)
+            {
+                const unsigned int J = cvp::lowest_bit(N);
+                const T &low = chain.squares[J];
+                const T high =
+                    cvp::chain_product<(N >> (J + 1U)), J + 1U>::eval(
+                        chain.squares
+                    );
+
+                return cvp::fused_mul_add(low, high, c);
+            }
+    };
+
+    template <unsigned int N>
+    class lazy_power_sum<N, false> {
+        public:
+            template <typename T, unsigned int K, typename C>
+            static inline T eval(const cvp::power_chain<T, K> &chain,
+                                 const C &c)
+            {
+                return chain.template power<N>() + c;
+            }
+    };
+
+    /*  The real multiple a e of an expression.                               */
+    template <typename E>
+    class lazy_scale :
+        public cvp::lazy_expression<lazy_scale<E>, typename E::value_type> {
+        public:
+            typedef typename E::value_type T;
+            static const unsigned int max_power = E::max_power;
+            static const bool is_product = true;
+
+            double a;
+            E e;
+
+            lazy_scale(double s, const E &expr);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The complex multiple c e of an expression.                            */
+    template <typename E>
+    class lazy_cscale :
+        public cvp::lazy_expression<lazy_cscale<E>, typename E::value_type> {
+        public:
+            typedef typename E::value_type T;
+            static const unsigned int max_power = E::max_power;
+            static const bool is_product = true;
+
+            cvp::complex c;
+            E e;
+
+            lazy_cscale(const cvp::complex &w, const E &expr);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &d) const;
+    };
+
+    /*  An expression plus a constant C, which is double or cvp::complex.     */
+    template <typename E, typename C>
+    class lazy_shift :
+        public cvp::lazy_expression<lazy_shift<E, C>, typename E::value_type> {
+        public:
+            typedef typename E::value_type T;
+            static const unsigned int max_power = E::max_power;
+            static const bool is_product = false;
+
+            E e;
+            C c;
+
+            lazy_shift(const E &expr, const C &w);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename D>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const D &d) const;
+    };
+
+    /*  The sum of two expressions.                                           */
+    template <typename L, typename R>
+    class lazy_add :
+        public cvp::lazy_expression<lazy_add<L, R>, typename L::value_type> {
+        public:
+            typedef typename L::value_type T;
+            static const unsigned int max_power =
+                (L::max_power > R::max_power ? L::max_power : R::max_power);
+            static const bool is_product = false;
+
+            L l;
+            R r;
+
+            lazy_add(const L &left, const R &right);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The difference of two expressions.                                    */
+    template <typename L, typename R>
+    class lazy_sub :
+        public cvp::lazy_expression<lazy_sub<L, R>, typename L::value_type> {
+        public:
+            typedef typename L::value_type T;
+            static const unsigned int max_power =
+                (L::max_power > R::max_power ? L::max_power : R::max_power);
+            static const bool is_product = false;
+
+            L l;
+            R r;
+
+            lazy_sub(const L &left, const R &right);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The product of two expressions.                                       */
+    template <typename L, typename R>
+    class lazy_mul :
+        public cvp::lazy_expression<lazy_mul<L, R>, typename L::value_type> {
+        public:
+            typedef typename L::value_type T;
+            static const unsigned int max_power =
+                (L::max_power > R::max_power ? L::max_power : R::max_power);
+            static const bool is_product = true;
+
+            L l;
+            R r;
+
+            lazy_mul(const L &left, const R &right);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The quotient of two expressions.                                      */
+    template <typename L, typename R>
+    class lazy_div :
+        public cvp::lazy_expression<lazy_div<L, R>, typename L::value_type> {
+        public:
+            typedef typename L::value_type T;
+            static const unsigned int max_power =
+                (L::max_power > R::max_power ? L::max_power : R::max_power);
+            static const bool is_product = false;
+
+            L l;
+            R r;
+
+            lazy_div(const L &left, const R &right);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  The quotient a / e of a real number by an expression.                 */
+    template <typename E>
+    class lazy_rdiv :
+        public cvp::lazy_expression<lazy_rdiv<E>, typename E::value_type> {
+        public:
+            typedef typename E::value_type T;
+            static const unsigned int max_power = E::max_power;
+            static const bool is_product = false;
+
+            double a;
+            E e;
+
+            lazy_rdiv(double s, const E &expr);
+
+            inline const T &variable(void) const;
+
+            template <unsigned int K>
+            inline T eval(const cvp::power_chain<T, K> &chain) const;
+
+            template <unsigned int K, typename C>
+            inline T
+            eval_plus(const cvp::power_chain<T, K> &chain, const C &c) const;
+    };
+
+    /*  Splits a divisor into a real factor s and the rest. Real multiples    *
+     *  give their factor, everything else has s = 1.                         */
+    template <typename E, unsigned int K>
+    inline typename E::value_type
+    lazy_divisor(const E &e,
+                 const cvp::power_chain<typename E::value_type, K> &chain,
+                 double &s);
+
+    template <typename E, unsigned int K>
+    inline typename E::value_type
+    lazy_divisor(const cvp::lazy_scale<E> &e,
+                 const cvp::power_chain<typename E::value_type, K> &chain,
+                 double &s);
+
+    /*  Starts a lazy expression in the variable z. z must outlive it.        */
+    template <typename T>
+    inline cvp::lazy_power<T, 1U> lazy(const T &z);
+
+    /*  Evaluates a lazy expression. This is the same as converting it to T.  */
+    template <typename E, typename T>
+    inline T evaluate(const cvp::lazy_expression<E, T> &expr);
+}
+/*  End of namespace "cvp".                                                   */
+
+/******************************************************************************
+ *                              Fused Operations                              *
+ ******************************************************************************/
+
+/*  Product and sum for any complex type, using its operators.                */
+template <typename T>
+inline T cvp::fused_mul_add(const T &a, const T &b, const T &c)
+{
+    return a * b + c;
+}
+
+/*  Adding a real number is a Horner step.                                    */
+template <typename T>
+inline T cvp::fused_mul_add(const T &a, const T &b, double c)
+{
+    return cvp::horner_step(a, b, c);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fused_mul_add                                                    *
+ *  Purpose:                                                                  *
+ *      Computes a b + c for complex numbers.                                 *
+ *  Arguments:                                                                *
+ *      a (const cvp::complex &):                                             *
+ *          The first factor.                                                 *
+ *      b (const cvp::complex &):                                             *
+ *          The second factor.                                                *
+ *      c (const cvp::complex &):                                             *
+ *          The number added to the product.                                  *
+ *  Outputs:                                                                  *
+ *      w (cvp::complex):                                                     *
+ *          The value a b + c.                                                *
+ *  Method:                                                                   *
+ *      Each part of the product is two real products and a sum, and c is     *
+ *      added to it. With a fused multiply-add these are two instructions     *
+ *      per part with one rounding each, instead of four operations with a    *
+ *      rounding each.                                                        *
+ ******************************************************************************/
+inline cvp::complex
+cvp::fused_mul_add(const cvp::complex &a,
+                   const cvp::complex &b, const cvp::complex &c)
+{
+#ifdef FP_FAST_FMA
+    const double re = std::fma(-a.imag, b.imag, c.real);
+    const double im = std::fma(a.imag, b.real, c.imag);
+    return cvp::complex(std::fma(a.real, b.real, re),
+                        std::fma(a.real, b.imag, im));
+#else
+    return a * b + c;
+#endif
+}
+/*  End of cvp::fused_mul_add.                                                */
+
+/*  Product and sum of batches, lane by lane as for complex numbers.          */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::fused_mul_add(const cvp::complex_batch<N> &a,
+                   const cvp::complex_batch<N> &b,
+                   const cvp::complex_batch<N> &c)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::fused_mul_add(a.get(k), b.get(k), c.get(k)));
+
+    return out;
+}
+
+/*  Real multiple and sum for any complex type, using its operators.          */
+template <typename T>
+inline T cvp::fused_scale_add(double a, const T &b, const T &c)
+{
+    return a * b + c;
+}
+
+/*  Adding a real number is the first step of Horner's method.                */
+template <typename T>
+inline T cvp::fused_scale_add(double a, const T &b, double c)
+{
+    return cvp::horner_lead_step(b, a, c);
+}
+
+/*  Real multiple and sum of complex numbers, one fused multiply-add a part.  */
+inline cvp::complex
+cvp::fused_scale_add(double a, const cvp::complex &b, const cvp::complex &c)
+{
+#ifdef FP_FAST_FMA
+    const double re = std::fma(a, b.real, c.real);
+    const double im = std::fma(a, b.imag, c.imag);
+    return cvp::complex(re, im);
+#else
+    return a * b + c;
+#endif
+}
+
+/*  Real multiple and sum of batches, lane by lane.                           */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::fused_scale_add(double a, const cvp::complex_batch<N> &b,
+                     const cvp::complex_batch<N> &c)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::fused_scale_add(a, b.get(k), c.get(k)));
+
+    return out;
+}
+
+/*  Quotient for any complex type, using its operators.                       */
+template <typename T>
+inline T cvp::fused_divide(const T &n, const T &d, double s)
+{
+    return n / (d * s);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::fused_divide                                                     *
+ *  Purpose:                                                                  *
+ *      Computes n / (s d) for complex n and d and real s.                    *
+ *  Arguments:                                                                *
+ *      n (const cvp::complex &):                                             *
+ *          The numerator.                                                    *
+ *      d (const cvp::complex &):                                             *
+ *          The complex part of the denominator.                              *
+ *      s (double):                                                           *
+ *          The real factor of the denominator.                               *
+ *  Outputs:                                                                  *
+ *      q (cvp::complex):                                                     *
+ *          The quotient n / (s d).                                           *
+ *  Method:                                                                   *
+ *      n / (s d) = n conj(d) / (s |d|^2). The one reciprocal                 *
+ *      1 / (s |d|^2) scales both parts, and s never multiplies d itself,     *
+ *      saving two products. With s = 1 and no fused multiply-add this is     *
+ *      exactly the division operator.                                        *
+ ******************************************************************************/
+inline cvp::complex
+cvp::fused_divide(const cvp::complex &n, const cvp::complex &d, double s)
+{
+#ifdef FP_FAST_FMA
+    const double denom = 1.0 / (s * std::fma(d.real, d.real, d.imag*d.imag));
+    const double real = std::fma(n.real, d.real, n.imag*d.imag);
+    const double imag = std::fma(n.imag, d.real, -(n.real*d.imag));
+#else
+    const double denom = 1.0 / (s * (d.real*d.real + d.imag*d.imag));
+    const double real = n.real*d.real + n.imag*d.imag;
+    const double imag = n.imag*d.real - n.real*d.imag;
+#endif
+    return cvp::complex(real*denom, imag*denom);
+}
+/*  End of cvp::fused_divide.                                                 */
+
+/*  Quotient of batches, lane by lane.                                        */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::fused_divide(const cvp::complex_batch<N> &n,
+                  const cvp::complex_batch<N> &d, double s)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::fused_divide(n.get(k), d.get(k), s));
+
+    return out;
+}
+
+/*  Real quotient for any complex type, using its operators.                  */
+template <typename T>
+inline T cvp::fused_rdivide(double a, const T &d, double s)
+{
+    return a / (d * s);
+}
+
+/*  Real quotient of complex numbers, a conj(d) / (s |d|^2).                  */
+inline cvp::complex
+cvp::fused_rdivide(double a, const cvp::complex &d, double s)
+{
+#ifdef FP_FAST_FMA
+    const double denom = 1.0 / (s * std::fma(d.real, d.real, d.imag*d.imag));
+#else
+    const double denom = 1.0 / (s * (d.real*d.real + d.imag*d.imag));
+#endif
+    return cvp::complex(a*d.real*denom, -a*d.imag*denom);
+}
+
+/*  Real quotient of batches, lane by lane.                                   */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::fused_rdivide(double a, const cvp::complex_batch<N> &d, double s)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::fused_rdivide(a, d.get(k), s));
+
+    return out;
+}
+
+/*  Real constants are left as they are.                                      */
+template <typename T>
+inline double cvp::lazy_cast(double c)
+{
+    return c;
+}
+
+/*  Complex constants are converted to the type of the expression.            */
+template <typename T>
+inline T cvp::lazy_cast(const cvp::complex &c)
+{
+    return T(c);
+}
+
+/******************************************************************************
+ *                                   Nodes                                    *
+ ******************************************************************************/
+
+/*  The node this is the base of.                                             */
+template <typename E, typename T>
+inline const E &cvp::lazy_expression<E, T>::node(void) const
+{
+    return static_cast<const E &>(*this);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::lazy_expression::operator T                                      *
+ *  Purpose:                                                                  *
+ *      Evaluates a lazy expression.                                          *
+ *  Outputs:                                                                  *
+ *      w (T):                                                                *
+ *          The value of the expression.                                      *
+ *  Method:                                                                   *
+ *      The squares z, z^2, z^4, ... of the variable are computed once, up to *
+ *      the highest power in the expression, and every power of z is a        *
+ *      product of these. The tree of the expression is then evaluated from   *
+ *      the top. A sum whose left or right side ends in a product passes the  *
+ *      other side down into that product, which adds it with fused           *
+ *      multiply-adds. A quotient whose denominator is a real multiple s e    *
+ *      folds s into the one reciprocal 1 / (s |e|^2).                        *
+ *  Notes:                                                                    *
+ *      The result differs from the operators only in rounding. Powers come   *
+ *      from squares, so z^4 is (z^2)^2 and not ((z z) z) z, a real factor    *
+ *      is moved past the products after it, so (3 z) z is 3 (z z), and a     *
+ *      fused multiply-add rounds once where a product and a sum round twice. *
+ *      Each of these changes one operation by about 2 ulp of the size of     *
+ *      its operands at most. So an expression with n operations agrees with  *
+ *      the operators to within 2n ulp of its size, the value it would have   *
+ *      if every term were replaced by its modulus. For (z^3 - 1) / (3 z^2)   *
+ *      this size is (|z|^3 + 1) / (3 |z|^2). Relative to the result the      *
+ *      bound only holds where the terms do not cancel. Near a root both      *
+ *      ways lose the same number of digits. Expressions with no rewrites,    *
+ *      like z^3 - 1 or 2 / (z^2 + z), agree with the operators bit for bit   *
+ *      when there are no fused multiply-adds.                                *
+ ******************************************************************************/
+template <typename E, typename T>
+inline cvp::lazy_expression<E, T>::operator T (void) const
+{
+    const E &expr = node();
+    const cvp::power_chain<T, cvp::bit_width(E::max_power | 1U)>
+        chain(expr.variable());
+
+    return expr.eval(chain);
+}
+/*  End of cvp::lazy_expression::operator T.                                  */
+
+/*  Constructor from the variable.                                            */
+template <typename T, unsigned int N>
+cvp::lazy_power<T, N>::lazy_power(const T &w) : z(w)
+{
+    return;
+}
+
+template <typename T, unsigned int N>
+inline const T &cvp::lazy_power<T, N>::variable(void) const
+{
+    return z;
+}
+
+/*  Powers are products of the squares of the variable.                       */
+template <typename T, unsigned int N>
+template <unsigned int K>
+inline T
+cvp::lazy_power<T, N>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    return chain.template power<N>();
+}
+
+/*  The last product of the power is fused with the sum.                      */
+template <typename T, unsigned int N>
+template <unsigned int K, typename C>
+inline T
+cvp::lazy_power<T, N>::eval_plus(const cvp::power_chain<T, K> &chain,
+                                 const C &c) const
+{
+    return cvp::lazy_power_sum<N>::eval(chain, c);
+}
+
+/*  Constructor from the factor and the expression.                           */
+template <typename E>
+cvp::lazy_scale<E>::lazy_scale(double s, const E &expr) : a(s), e(expr)
+{
+    return;
+}
+
+template <typename E>
+inline const typename E::value_type &cvp::lazy_scale<E>::variable(void) const
+{
+    return e.variable();
+}
+
+template <typename E>
+template <unsigned int K>
+inline typename E::value_type
+cvp::lazy_scale<E>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    return a * e.eval(chain);
+}
+
+template <typename E>
+template <unsigned int K, typename C>
+inline typename E::value_type
+cvp::lazy_scale<E>::eval_plus(const cvp::power_chain<T, K> &chain,
+                              const C &c) const
+{
+    return cvp::fused_scale_add(a, e.eval(chain), c);
+}
+
+/*  Constructor from the factor and the expression.                           */
+template <typename E>
+cvp::lazy_cscale<E>::lazy_cscale(const cvp::complex &w, const E &expr)
+    : c(w), e(expr)
+{
+    return;
+}
+
+template <typename E>
+inline const typename E::value_type &cvp::lazy_cscale<E>::variable(void) const
+{
+    return e.variable();
+}
+
+template <typename E>
+template <unsigned int K>
+inline typename E::value_type
+cvp::lazy_cscale<E>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    return T(c) * e.eval(chain);
+}
+
+template <typename E>
+template <unsigned int K, typename C>
+inline typename E::value_type
+cvp::lazy_cscale<E>::eval_plus(const cvp::power_chain<T, K> &chain,
+                               const C &d) const
+{
+    return cvp::fused_mul_add(T(c), e.eval(chain), d);
+}
+
+/*  Constructor from the expression and the constant.                         */
+template <typename E, typename C>
+cvp::lazy_shift<E, C>::lazy_shift(const E &expr, const C &w) : e(expr), c(w)
+{
+    return;
+}
+
+template <typename E, typename C>
+inline const typename E::value_type &
+cvp::lazy_shift<E, C>::variable(void) const
+{
+    return e.variable();
+}
+
+/*  The constant is passed down, fusing it with a product if there is one.    */
+template <typename E, typename C>
+template <unsigned int K>
+inline typename E::value_type
+cvp::lazy_shift<E, C>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    return e.eval_plus(chain, cvp::lazy_cast<T>(c));
+}
+
+template <typename E, typename C>
+template <unsigned int K, typename D>
+inline typename E::value_type
+cvp::lazy_shift<E, C>::eval_plus(const cvp::power_chain<T, K> &chain,
+                                 const D &d) const
+{
+    return eval(chain) + d;
+}
+
+/*  Constructor from the two sides.                                           */
+template <typename L, typename R>
+cvp::lazy_add<L, R>::lazy_add(const L &left, const R &right)
+    : l(left), r(right)
+{
+    return;
+}
+
+template <typename L, typename R>
+inline const typename L::value_type &
+cvp::lazy_add<L, R>::variable(void) const
+{
+    return l.variable();
+}
+
+/*  A side ending in a product absorbs the other side. Addition commutes, so  *
+ *  this is the same as l + r when neither side is fused.                     */
+template <typename L, typename R>
+template <unsigned int K>
+inline typename L::value_type
+cvp::lazy_add<L, R>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    if (L::is_product)
+        return l.eval_plus(chain, r.eval(chain));
+
+    if (R::is_product)
+        return r.eval_plus(chain, l.eval(chain));
+
+    return l.eval(chain) + r.eval(chain);
+}
+
+template <typename L, typename R>
+template <unsigned int K, typename C>
+inline typename L::value_type
+cvp::lazy_add<L, R>::eval_plus(const cvp::power_chain<T, K> &chain,
+                               const C &c) const
+{
+    return eval(chain) + c;
+}
+
+/*  Constructor from the two sides.                                           */
+template <typename L, typename R>
+cvp::lazy_sub<L, R>::lazy_sub(const L &left, const R &right)
+    : l(left), r(right)
+{
+    return;
+}
+
+template <typename L, typename R>
+inline const typename L::value_type &
+cvp::lazy_sub<L, R>::variable(void) const
+{
+    return l.variable();
+}
+
+/*  A left side ending in a product absorbs -r. Negation is exact, so this is *
+ *  the same as l - r when the product is not fused.                          */
+template <typename L, typename R>
+template <unsigned int K>
+inline typename L::value_type
+cvp::lazy_sub<L, R>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    if (L::is_product)
+        return l.eval_plus(chain, -1.0 * r.eval(chain));
+
+    return l.eval(chain) - r.eval(chain);
+}
+
+template <typename L, typename R>
+template <unsigned int K, typename C>
+inline typename L::value_type
+cvp::lazy_sub<L, R>::eval_plus(const cvp::power_chain<T, K> &chain,
+                               const C &c) const
+{
+    return eval(chain) + c;
+}
+
+/*  Constructor from the two factors.                                         */
+template <typename L, typename R>
+cvp::lazy_mul<L, R>::lazy_mul(const L &left, const R &right)
+    : l(left), r(right)
+{
+    return;
+}
+
+template <typename L, typename R>
+inline const typename L::value_type &
+cvp::lazy_mul<L, R>::variable(void) const
+{
+    return l.variable();
+}
+
+template <typename L, typename R>
+template <unsigned int K>
+inline typename L::value_type
+cvp::lazy_mul<L, R>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    return l.eval(chain) * r.eval(chain);
+}
+
+template <typename L, typename R>
+template <unsigned int K, typename C>
+inline typename L::value_type
+cvp::lazy_mul<L, R>::eval_plus(const cvp::power_chain<T, K> &chain,
+                               const C &c) const
+{
+    return cvp::fused_mul_add(l.eval(chain), r.eval(chain), c);
+}
+
+/*  Constructor from the numerator and denominator.                           */
+template <typename L, typename R>
+cvp::lazy_div<L, R>::lazy_div(const L &left, const R &right)
+    : l(left), r(right)
+{
+    return;
+}
+
+template <typename L, typename R>
+inline const typename L::value_type &
+cvp::lazy_div<L, R>::variable(void) const
+{
+    return l.variable();
+}
+
+/*  A real factor of the denominator is folded into the reciprocal.           */
+template <typename L, typename R>
+template <unsigned int K>
+inline typename L::value_type
+cvp::lazy_div<L, R>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    double s;
+    const T d = cvp::lazy_divisor(r, chain, s);
+    return cvp::fused_divide(l.eval(chain), d, s);
+}
+
+template <typename L, typename R>
+template <unsigned int K, typename C>
+inline typename L::value_type
+cvp::lazy_div<L, R>::eval_plus(const cvp::power_chain<T, K> &chain,
+                               const C &c) const
+{
+    return eval(chain) + c;
+}
+
+/*  Constructor from the numerator and the denominator.                       */
+template <typename E>
+cvp::lazy_rdiv<E>::lazy_rdiv(double s, const E &expr) : a(s), e(expr)
+{
+    return;
+}
+
+template <typename E>
+inline const typename E::value_type &cvp::lazy_rdiv<E>::variable(void) const
+{
+    return e.variable();
+}
+
+/*  A real factor of the denominator is folded into the reciprocal.           */
+template <typename E>
+template <unsigned int K>
+inline typename E::value_type
+cvp::lazy_rdiv<E>::eval(const cvp::power_chain<T, K> &chain) const
+{
+    double s;
+    const T d = cvp::lazy_divisor(e, chain, s);
+    return cvp::fused_rdivide(a, d, s);
+}
+
+template <typename E>
+template <unsigned int K, typename C>
+inline typename E::value_type
+cvp::lazy_rdiv<E>::eval_plus(const cvp::power_chain<T, K> &chain,
+                             const C &c) const
+{
+    return eval(chain) + c;
+}
+
+/*  A divisor with no real factor.                                            */
+template <typename E, unsigned int K>
+inline typename E::value_type
+cvp::lazy_divisor(const E &e,
+                  const cvp::power_chain<typename E::value_type, K> &chain,
+                  double &s)
+{
+    s = 1.0;
+    return e.eval(chain);
+}
+
+/*  A real multiple s e gives its factor and e.                               */
+template <typename E, unsigned int K>
+inline typename E::value_type
+cvp::lazy_divisor(const cvp::lazy_scale<E> &e,
+                  const cvp::power_chain<typename E::value_type, K> &chain,
+                  double &s)
+{
+    s = e.a;
+    return e.e.eval(chain);
+}
+
+/*  Starts a lazy expression in the variable z.                               */
+template <typename T>
+inline cvp::lazy_power<T, 1U> cvp::lazy(const T &z)
+{
+    return cvp::lazy_power<T, 1U>(z);
+}
+
+/*  Evaluates a lazy expression.                                              */
+template <typename E, typename T>
+inline T cvp::evaluate(const cvp::lazy_expression<E, T> &expr)
+{
+    return static_cast<T>(expr);
+}
+
+/******************************************************************************
+ *                                 Operators                                  *
+ ******************************************************************************
+ *  The operators build nodes. Two rewrites happen as the expression is       *
+ *  built: products of powers of the variable become one power, and real      *
+ *  factors are moved to the front of a product, so that a quotient by a      *
+ *  real multiple can fold the factor into its reciprocal.                    *
+ ******************************************************************************/
+
+/*  Sum of two expressions.                                                   */
+template <typename L, typename R, typename T>
+inline cvp::lazy_add<L, R>
+operator + (const cvp::lazy_expression<L, T> &l,
+            const cvp::lazy_expression<R, T> &r)
+{
+    return cvp::lazy_add<L, R>(l.node(), r.node());
+}
+
+/*  Sum of an expression and a real constant.                                 */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, double>
+operator + (const cvp::lazy_expression<E, T> &e, double c)
+{
+    return cvp::lazy_shift<E, double>(e.node(), c);
+}
+
+/*  Sum of a real constant and an expression.                                 */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, double>
+operator + (double c, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_shift<E, double>(e.node(), c);
+}
+
+/*  Sum of an expression and a complex constant.                              */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, cvp::complex>
+operator + (const cvp::lazy_expression<E, T> &e, const cvp::complex &c)
+{
+    return cvp::lazy_shift<E, cvp::complex>(e.node(), c);
+}
+
+/*  Sum of a complex constant and an expression.                              */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, cvp::complex>
+operator + (const cvp::complex &c, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_shift<E, cvp::complex>(e.node(), c);
+}
+
+/*  Difference of two expressions.                                            */
+template <typename L, typename R, typename T>
+inline cvp::lazy_sub<L, R>
+operator - (const cvp::lazy_expression<L, T> &l,
+            const cvp::lazy_expression<R, T> &r)
+{
+    return cvp::lazy_sub<L, R>(l.node(), r.node());
+}
+
+/*  Difference of an expression and a real constant, adding -c.               */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, double>
+operator - (const cvp::lazy_expression<E, T> &e, double c)
+{
+    return cvp::lazy_shift<E, double>(e.node(), -c);
+}
+
+/*  Difference of a real constant and an expression, c + (-1) e.              */
+template <typename E, typename T>
+inline cvp::lazy_shift<cvp::lazy_scale<E>, double>
+operator - (double c, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_shift<cvp::lazy_scale<E>, double>(
+        cvp::lazy_scale<E>(-1.0, e.node()), c
+    );
+}
+
+/*  Difference of an expression and a complex constant, adding -c.            */
+template <typename E, typename T>
+inline cvp::lazy_shift<E, cvp::complex>
+operator - (const cvp::lazy_expression<E, T> &e, const cvp::complex &c)
+{
+    return cvp::lazy_shift<E, cvp::complex>(
+        e.node(), cvp::complex(-c.real, -c.imag)
+    );
+}
+
+/*  Difference of a complex constant and an expression, c + (-1) e.           */
+template <typename E, typename T>
+inline cvp::lazy_shift<cvp::lazy_scale<E>, cvp::complex>
+operator - (const cvp::complex &c, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_shift<cvp::lazy_scale<E>, cvp::complex>(
+        cvp::lazy_scale<E>(-1.0, e.node()), c
+    );
+}
+
+/*  Product of two expressions.                                               */
+template <typename L, typename R, typename T>
+inline cvp::lazy_mul<L, R>
+operator * (const cvp::lazy_expression<L, T> &l,
+            const cvp::lazy_expression<R, T> &r)
+{
+    return cvp::lazy_mul<L, R>(l.node(), r.node());
+}
+
+/*  Product of two powers of the variable, z^M z^N = z^(M + N).               */
+template <typename T, unsigned int M, unsigned int N>
+inline cvp::lazy_power<T, M + N>
+operator * (const cvp::lazy_power<T, M> &l, const cvp::lazy_power<T, N> &r)
+{
+    static_cast<void>(r);
+    return cvp::lazy_power<T, M + N>(l.z);
+}
+
+/*  Product of a real multiple and an expression, (a l) r = a (l r).          */
+template <typename L, typename R, typename T>
+inline cvp::lazy_scale<decltype(std::declval<L>() * std::declval<R>())>
+operator * (const cvp::lazy_scale<L> &l, const cvp::lazy_expression<R, T> &r)
+{
+    typedef decltype(std::declval<L>() * std::declval<R>()) E;
+    return cvp::lazy_scale<E>(l.a, l.e * r.node());
+}
+
+/*  Product of an expression and a real multiple, l (a r) = a (l r).          */
+template <typename L, typename R, typename T>
+inline cvp::lazy_scale<decltype(std::declval<L>() * std::declval<R>())>
+operator * (const cvp::lazy_expression<L, T> &l, const cvp::lazy_scale<R> &r)
+{
+    typedef decltype(std::declval<L>() * std::declval<R>()) E;
+    return cvp::lazy_scale<E>(r.a, l.node() * r.e);
+}
+
+/*  Product of two real multiples, (a l) (b r) = (a b) (l r).                 */
+template <typename L, typename R>
+inline cvp::lazy_scale<decltype(std::declval<L>() * std::declval<R>())>
+operator * (const cvp::lazy_scale<L> &l, const cvp::lazy_scale<R> &r)
+{
+    typedef decltype(std::declval<L>() * std::declval<R>()) E;
+    return cvp::lazy_scale<E>(l.a * r.a, l.e * r.e);
+}
+
+/*  Product of a real constant and an expression.                             */
+template <typename E, typename T>
+inline cvp::lazy_scale<E>
+operator * (double a, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_scale<E>(a, e.node());
+}
+
+/*  Product of an expression and a real constant.                             */
+template <typename E, typename T>
+inline cvp::lazy_scale<E>
+operator * (const cvp::lazy_expression<E, T> &e, double a)
+{
+    return cvp::lazy_scale<E>(a, e.node());
+}
+
+/*  Product of a complex constant and an expression.                          */
+template <typename E, typename T>
+inline cvp::lazy_cscale<E>
+operator * (const cvp::complex &c, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_cscale<E>(c, e.node());
+}
+
+/*  Product of an expression and a complex constant.                          */
+template <typename E, typename T>
+inline cvp::lazy_cscale<E>
+operator * (const cvp::lazy_expression<E, T> &e, const cvp::complex &c)
+{
+    return cvp::lazy_cscale<E>(c, e.node());
+}
+
+/*  Quotient of two expressions.                                              */
+template <typename L, typename R, typename T>
+inline cvp::lazy_div<L, R>
+operator / (const cvp::lazy_expression<L, T> &l,
+            const cvp::lazy_expression<R, T> &r)
+{
+    return cvp::lazy_div<L, R>(l.node(), r.node());
+}
+
+/*  Quotient of an expression and a real constant, a multiple by 1 / a.       */
+template <typename E, typename T>
+inline cvp::lazy_scale<E>
+operator / (const cvp::lazy_expression<E, T> &e, double a)
+{
+    return cvp::lazy_scale<E>(1.0 / a, e.node());
+}
+
+/*  Quotient of a real constant and an expression.                            */
+template <typename E, typename T>
+inline cvp::lazy_rdiv<E>
+operator / (double a, const cvp::lazy_expression<E, T> &e)
+{
+    return cvp::lazy_rdiv<E>(a, e.node());
+}
+
+#endif
+/*  End of include guard.                                                     */
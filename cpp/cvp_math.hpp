@@ -0,0 +1,1082 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides the elementary functions of a complex variable: exp, log,    *
+ *      pow, sqrt, sin, cos, and tanh, for complex numbers and for batches.   *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_MATH_HPP
+#define CVP_MATH_HPP
+
+/*  std::memcpy, used to read and write the bits of a double.                 */
+#include <cstring>
+
+/*  sqrt and HUGE_VAL found here.                                             */
+#include <cmath>
+
+/*  numeric_limits, for the NaN returned by log.                              */
+#include <limits>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, which the functions also take.                */
+#include "cvp_batch.hpp"
+
+/*  The functions are larger than the compiler's inlining limits, and a call  *
+ *  left in a loop over the lanes of a batch stops it from being vectorized.  *
+ *  GCC and clang are asked to inline them regardless.                        */
+#if defined(__GNUC__)
+#define CVP_MATH_INLINE inline __attribute__((always_inline))
+#else
+#define CVP_MATH_INLINE inline
+#endif
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Real functions the complex ones are built from. These have no         *
+     *  branches or calls to the C library (other than sqrt, which is one     *
+     *  instruction), so loops over them are vectorized. Special cases are    *
+     *  handled with selects. Errors are for round-to-nearest, and are in     *
+     *  units of the last place (ulp) of the result.                          */
+    namespace math {
+
+        /*  The bits of 2 / pi, 64 at a time, after 64 zero bits. These are   *
+         *  enough to reduce any double by pi / 2.                            */
+        static const unsigned long long two_by_pi_bits[20] = {
+            0x0000000000000000ULL, 0xA2F9836E4E441529ULL, 0xFC2757D1F534DDC0ULL,
+            0xDB6295993C439041ULL, 0xFE5163ABDEBBC561ULL, 0xB7246E3A424DD2E0ULL,
+            0x06492EEA09D1921CULL, 0xFE1DEB1CB129A73EULL, 0xE88235F52EBB4484ULL,
+            0xE99C7026B45F7E41ULL, 0x3991D639835339F4ULL, 0x9C845F8BBDF9283BULL,
+            0x1FF897FFDE05980FULL, 0xEF2F118B5A0A6D1FULL, 0x6D367ECF27CB09B7ULL,
+            0x4F463F669E5FEA2DULL, 0x7527BAC7EBE5F17BULL, 0x3D0739F78A5292EAULL,
+            0x6BFB5FB11F8D5D08ULL, 0x56033046FC7B6BABULL
+        };
+
+        /*  The nearest integer to x, as a double. |x| must be below 2^51.    */
+        CVP_MATH_INLINE double round_to_int(double x);
+
+        /*  The integer nearest to x reduced mod 4, for |x| below 2^51.       */
+        CVP_MATH_INLINE unsigned long long quadrant(double x);
+
+        /*  2^k for an integer k between -1022 and 1023, made from its bits.  */
+        CVP_MATH_INLINE double pow2(double k);
+
+        /*  The exponential function. Error below 1 ulp.                      */
+        CVP_MATH_INLINE double exp(double x);
+
+        /*  The natural log. Error below 1 ulp. log(0) is -infinity and the   *
+         *  log of a negative number is NaN.                                  */
+        CVP_MATH_INLINE double log(double x);
+
+        /*  Writes x = k pi / 2 + r + lo with |r| <= pi / 4, returning k mod  *
+         *  4, for finite |x| >= 2^19. Every digit of r + lo is correct.      */
+        CVP_MATH_INLINE unsigned long long
+        rem_pio2_large(double x, double *r, double *lo);
+
+        /*  Sine and cosine together. Error below 1.5 ulp for every finite x. *
+         *  Infinity and NaN give NaN. With large false, only |x| < 2^19 is   *
+         *  reduced correctly, and the long reduction is skipped.             */
+        CVP_MATH_INLINE void
+        sincos(double x, double *s, double *c, bool large = true);
+
+        /*  Whether any of n values needs the long reduction in sincos.       */
+        CVP_MATH_INLINE bool any_large(const double *x, unsigned int n);
+
+        /*  Hyperbolic sine and cosine together. Error below 2 ulp.           */
+        CVP_MATH_INLINE void sinhcosh(double x, double *sh, double *ch);
+
+        /*  The angle of the point (x, y), between -pi and pi. Error below    *
+         *  3.5 ulp. atan2(0, 0) is 0.                                        */
+        CVP_MATH_INLINE double atan2(double y, double x);
+    }
+    /*  End of namespace "math".                                              */
+
+    /*  The complex functions. Each is accurate to a few ulp of the modulus   *
+     *  of the result, see the notes on each. The batch versions compute      *
+     *  every lane with the same formulas, and give identical results.        */
+    CVP_MATH_INLINE cvp::complex exp(const cvp::complex &z, bool large = true);
+    CVP_MATH_INLINE cvp::complex log(const cvp::complex &z);
+    CVP_MATH_INLINE cvp::complex sqrt(const cvp::complex &z);
+    CVP_MATH_INLINE cvp::complex
+    pow(const cvp::complex &z, double p, bool large = true);
+    CVP_MATH_INLINE cvp::complex
+    pow(const cvp::complex &z, const cvp::complex &w, bool large = true);
+    CVP_MATH_INLINE cvp::complex sin(const cvp::complex &z, bool large = true);
+    CVP_MATH_INLINE cvp::complex cos(const cvp::complex &z, bool large = true);
+    CVP_MATH_INLINE cvp::complex
+    tanh(const cvp::complex &z, bool large = true);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> exp(const cvp::complex_batch<N> &z);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> log(const cvp::complex_batch<N> &z);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> sqrt(const cvp::complex_batch<N> &z);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    pow(const cvp::complex_batch<N> &z, double p);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    pow(const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> sin(const cvp::complex_batch<N> &z);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> cos(const cvp::complex_batch<N> &z);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N> tanh(const cvp::complex_batch<N> &z);
+}
+/*  End of namespace "cvp".                                                   */
+
+/******************************************************************************
+ *                               Real Functions                               *
+ ******************************************************************************/
+
+/*  Adding 1.5 * 2^52 pushes the fractional bits of x out of the mantissa,    *
+ *  rounding x to the nearest integer, and subtracting it again is exact.     */
+CVP_MATH_INLINE double cvp::math::round_to_int(double x)
+{
+    const double magic = 6755399441055744.0;
+    return (x + magic) - magic;
+}
+
+/*  After adding 1.5 * 2^52 the low bits of the mantissa are the integer in   *
+ *  two's complement. 2^51 is a multiple of 4, so the last two bits are the   *
+ *  integer mod 4, for negative integers too.                                 */
+CVP_MATH_INLINE unsigned long long cvp::math::quadrant(double x)
+{
+    const double shifted = x + 6755399441055744.0;
+    unsigned long long bits;
+
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    return bits & 3ULL;
+}
+
+/*  The biased exponent k + 1023 is placed in the low bits of a double by     *
+ *  adding 1.5 * 2^52, and then shifted into the exponent field.              */
+CVP_MATH_INLINE double cvp::math::pow2(double k)
+{
+    const double shifted = k + (1023.0 + 6755399441055744.0);
+    unsigned long long bits;
+    double out;
+
+    std::memcpy(&bits, &shifted, sizeof(bits));
+    bits <<= 52;
+    std::memcpy(&out, &bits, sizeof(out));
+    return out;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::math::exp                                                        *
+ *  Purpose:                                                                  *
+ *      Computes the exponential of a real number.                            *
+ *  Arguments:                                                                *
+ *      x (double):                                                           *
+ *          A real number.                                                    *
+ *  Outputs:                                                                  *
+ *      exp_x (double):                                                       *
+ *          The value e^x.                                                    *
+ *  Method:                                                                   *
+ *      Write x = k log(2) + r with k an integer and |r| <= log(2) / 2. Then  *
+ *      e^x = 2^k e^r. log(2) is split into a high part with trailing zeros,  *
+ *      so k log(2)_hi is exact, and a low part. The rounding error c of r is *
+ *      kept, and e^(r + c) = e^r (1 + c). e^r is the Taylor polynomial of    *
+ *      degree 13, whose error is below 1e-17 for |r| <= log(2) / 2, summed   *
+ *      so that the 1 is added last. 2^k is made from its bits in             *
+ *      two halves, so subnormal results and overflow to infinity come out    *
+ *      of the final products without any special cases.                      *
+ ******************************************************************************/
+CVP_MATH_INLINE double cvp::math::exp(double x)
+{
+    /*  Beyond these bounds the result is 0 or infinity. Clamping keeps k in  *
+     *  range for pow2. NaN fails both comparisons and is passed through.     *
+     *  Both tests are on x, since a select on the result of another is       *
+     *  turned back into a branch by GCC, and the lane loops are not          *
+     *  vectorized.                                                           */
+    const double xl = (x < -746.0 ? -746.0 : x);
+    const double xc = (x > 710.0 ? 710.0 : xl);
+
+    /*  1 / log(2), and log(2) split into two parts.                          */
+    const double log2_e = 1.44269504088896338700E+00;
+    const double ln2_hi = 6.93147180369123816490E-01;
+    const double ln2_lo = 1.90821492927058770002E-10;
+
+    /*  Reduce x to r + c, |r| <= log(2) / 2. x - k log(2)_hi is exact, and   *
+     *  c is the rounding error of r.                                         */
+    const double k = cvp::math::round_to_int(xc * log2_e);
+    double c;
+    const double r = cvp::eft::quick_two_sum(xc - k*ln2_hi, -k*ln2_lo, c);
+
+    /*  Taylor polynomial for e^r - 1 - r, the coefficients are 1 / n!.       */
+    const double q = r*r*(
+        5.0E-01 + r*(1.66666666666666666667E-01 +
+        r*(4.16666666666666666667E-02 + r*(8.33333333333333333333E-03 +
+        r*(1.38888888888888888889E-03 + r*(1.98412698412698412698E-04 +
+        r*(2.48015873015873015873E-05 + r*(2.75573192239858906526E-06 +
+        r*(2.75573192239858906526E-07 + r*(2.50521083854417187751E-08 +
+        r*(2.08767569878680989792E-09 + r*1.60590438368216145994E-10)))))))))));
+
+    /*  e^(r + c) = e^r (1 + c) to double precision. The 1 is added last.     */
+    const double p = 1.0 + (r + (q + (c + c*r)));
+
+    /*  2^k in two factors, each inside the range of pow2.                    */
+    const double k_half = cvp::math::round_to_int(0.5 * k);
+    return p * cvp::math::pow2(k_half) * cvp::math::pow2(k - k_half);
+}
+/*  End of cvp::math::exp.                                                    */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::math::log                                                        *
+ *  Purpose:                                                                  *
+ *      Computes the natural log of a real number.                            *
+ *  Arguments:                                                                *
+ *      x (double):                                                           *
+ *          A real number.                                                    *
+ *  Outputs:                                                                  *
+ *      log_x (double):                                                       *
+ *          The value log(x).                                                 *
+ *  Method:                                                                   *
+ *      Write x = 2^e m with sqrt(2) / 2 <= m < sqrt(2), reading e and m off  *
+ *      the bits of x. Subnormal x are first scaled by 2^54. Then             *
+ *      log(x) = e log(2) + log(m). With f = m - 1 and s = f / (2 + f),       *
+ *      log(m) = 2 atanh(s) = 2 (s + s^3 / 3 + s^5 / 5 + ...). |s| < 0.172,   *
+ *      so the series to s^19 has error below 1e-17 relative to s. It is      *
+ *      rearranged as in fdlibm so that f, which is exact, is added last,     *
+ *      and the rounding of s only affects the small terms. log(2) is split   *
+ *      into two parts as for exp.                                            *
+ ******************************************************************************/
+CVP_MATH_INLINE double cvp::math::log(double x)
+{
+    /*  The smallest normal double, and 2^54 for scaling subnormals.          */
+    const double min_normal = 2.2250738585072014E-308;
+    const double two_54 = 18014398509481984.0;
+
+    /*  log(2) in two parts, and sqrt(2).                                     */
+    const double ln2_hi = 6.93147180369123816490E-01;
+    const double ln2_lo = 1.90821492927058770002E-10;
+    const double sqrt_2 = 1.41421356237309504880E+00;
+
+    /*  Bit patterns for the exponent field and the mantissa.                 */
+    const unsigned long long mantissa_mask = 0x000FFFFFFFFFFFFFULL;
+    const unsigned long long one_bits = 0x3FF0000000000000ULL;
+    const unsigned long long int_bits = 0x4330000000000000ULL;
+
+    const bool subnormal = (x < min_normal);
+    const double xs = x * (subnormal ? two_54 : 1.0);
+
+    unsigned long long bits, ebits;
+    double m, e;
+
+    std::memcpy(&bits, &xs, sizeof(bits));
+
+    /*  The biased exponent, made a double by placing it in the mantissa of   *
+     *  2^52 and subtracting 2^52.                                            */
+    ebits = int_bits | ((bits >> 52) & 0x7FFULL);
+    std::memcpy(&e, &ebits, sizeof(e));
+    e = e - (4503599627370496.0 + 1023.0) - (subnormal ? 54.0 : 0.0);
+
+    /*  The mantissa, in [1, 2), moved to [sqrt(2) / 2, sqrt(2)).             */
+    bits = (bits & mantissa_mask) | one_bits;
+    std::memcpy(&m, &bits, sizeof(m));
+
+    const bool big = (m > sqrt_2);
+    m = m * (big ? 0.5 : 1.0);
+    e = e + (big ? 1.0 : 0.0);
+
+    /*  log(m) = log(1 + f) = f - f^2 / 2 + s (f^2 / 2 + R), where R is the   *
+     *  series 2 atanh(s) / s - 2, the coefficients are 2 / (2n + 1).         */
+    const double f = m - 1.0;
+    const double s = f / (2.0 + f);
+    const double s2 = s*s;
+    const double r =
+        s2*(6.66666666666666666667E-01 + s2*(4.00000000000000000000E-01 +
+        s2*(2.85714285714285714286E-01 + s2*(2.22222222222222222222E-01 +
+        s2*(1.81818181818181818182E-01 + s2*(1.53846153846153846154E-01 +
+        s2*(1.33333333333333333333E-01 + s2*(1.17647058823529411765E-01 +
+        s2*1.05263157894736842105E-01))))))));
+
+    /*  The small terms are summed first, and f and e log(2)_hi last.         */
+    const double half_f2 = 0.5*f*f;
+    const double out =
+        e*ln2_hi - ((half_f2 - (s*(half_f2 + r) + e*ln2_lo)) - f);
+
+    /*  Zero, negative, infinite, and NaN inputs. Positive infinity is its    *
+     *  own log, and the rest are NaN. The & avoids a branch.                 */
+    const bool in_range = (x > 0.0) & (x < HUGE_VAL);
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double edge = (x == 0.0 ? -HUGE_VAL : (x > 0.0 ? x : nan));
+    return (in_range ? out : edge);
+}
+/*  End of cvp::math::log.                                                    */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::math::rem_pio2_large                                             *
+ *  Purpose:                                                                  *
+ *      Reduces a large real number by pi / 2.                                *
+ *  Arguments:                                                                *
+ *      x (double):                                                           *
+ *          A finite real number with |x| >= 2^19.                            *
+ *      r (double *):                                                         *
+ *          The remainder x - k pi / 2, rounded to double, is stored here.    *
+ *      lo (double *):                                                        *
+ *          The rounding error of r is stored here.                           *
+ *  Outputs:                                                                  *
+ *      q (unsigned long long):                                               *
+ *          The integer k nearest to 2x / pi, mod 4.                          *
+ *  Method:                                                                   *
+ *      Payne-Hanek reduction with integers. Write |x| = m 2^(e - 52) with m  *
+ *      an integer of 53 bits. The bits of 2 / pi worth 2^-(e - 54) or more   *
+ *      add multiples of 4 to 2|x| / pi, so they are skipped, and the next    *
+ *      192 bits are taken from the table with a shift. Their product with m  *
+ *      mod 2^192, in 32-bit limbs, is 2|x| / pi mod 4 to about 2^-137. The   *
+ *      top two bits, rounded, are k mod 4, and the next 128 bits are the     *
+ *      signed fraction t. r + lo is t pi / 2 in double-double. The nearest   *
+ *      a double comes to a multiple of pi / 2 is about 2^-61, so at least 60 *
+ *      bits of t are correct past its leading one. The loops have fixed      *
+ *      lengths, and the table is read at an index rather than branched on,   *
+ *      so loops over this function are vectorized.                           *
+ ******************************************************************************/
+CVP_MATH_INLINE unsigned long long
+cvp::math::rem_pio2_large(double x, double *r, double *lo)
+{
+    /*  pi / 2 as the sum of two doubles.                                     */
+    const double pio2_hi = 1.57079632679489655800E+00;
+    const double pio2_lo = 6.12323399573676603587E-17;
+
+    /*  2^-32, for the weights of the limbs.                                  */
+    const double two_m32 = 2.32830643653869628906E-10;
+
+    /*  The bits of x, with its exponent e and integer mantissa m.            */
+    unsigned long long bits, m, m_lo, m_hi, w, shift;
+    long long e;
+
+    /*  The 192 bits of 2 / pi used, and the product mod 2^192, as limbs      *
+     *  of 32 bits with the most significant first.                           */
+    unsigned long long window[6], prod[6], carry, t_hi, t_lo;
+    unsigned int n;
+
+    /*  The fraction t as a double-double, built from four exact parts.       */
+    double a, b, c, d, ab, cd, ab_err, cd_err, t, t_err, sum_err;
+    double out, out_err;
+    unsigned long long q;
+
+    std::memcpy(&bits, &x, sizeof(bits));
+    m = (bits & 0x000FFFFFFFFFFFFFULL) | 0x0010000000000000ULL;
+    m_lo = m & 0xFFFFFFFFULL;
+    m_hi = m >> 32;
+
+    /*  Clamped so the table is read in bounds for any input. Values outside  *
+     *  the range are not used by sincos.                                     */
+    e = static_cast<long long>((bits >> 52) & 0x7FFULL) - 1023LL;
+    e = (e < 19LL ? 19LL : e);
+    e = (e > 1023LL ? 1023LL : e);
+
+    /*  The first bit used is bit e - 53 of 2 / pi, which is bit e + 10 of    *
+     *  the table after its 64 zero bits. Four words of the table hold the    *
+     *  192 bits. The second shift is split in two so it is never by 64.      */
+    w = static_cast<unsigned long long>(e + 10LL) >> 6;
+    shift = static_cast<unsigned long long>(e + 10LL) & 63ULL;
+
+    for (n = 0U; n < 3U; ++n)
+    {
+        const unsigned long long word =
+            (two_by_pi_bits[w + n] << shift) |
+            ((two_by_pi_bits[w + n + 1U] >> 1) >> (63ULL - shift));
+
+        window[2U*n] = word >> 32;
+        window[2U*n + 1U] = word & 0xFFFFFFFFULL;
+    }
+
+    /*  m times the window, keeping the low 192 bits. First the low half of   *
+     *  m, then the high half, which is below 2^21, one limb up.              */
+    carry = 0ULL;
+
+    for (n = 0U; n < 6U; ++n)
+    {
+        const unsigned long long p = m_lo*window[5U - n] + carry;
+        prod[5U - n] = p & 0xFFFFFFFFULL;
+        carry = p >> 32;
+    }
+
+    carry = 0ULL;
+
+    for (n = 0U; n < 5U; ++n)
+    {
+        const unsigned long long p =
+            m_hi*window[5U - n] + prod[4U - n] + carry;
+        prod[4U - n] = p & 0xFFFFFFFFULL;
+        carry = p >> 32;
+    }
+
+    /*  The top two bits are the integer part of 2|x| / pi mod 4, and the     *
+     *  next bit rounds it. The 128 bits after them are t in two's            *
+     *  complement, in [-1/2, 1/2).                                           */
+    q = ((prod[0] >> 30) + ((prod[0] >> 29) & 1ULL)) & 3ULL;
+    t_hi = (prod[0] << 34) | (prod[1] << 2) | (prod[2] >> 30);
+    t_lo = ((prod[2] & 0x3FFFFFFFULL) << 34) | (prod[3] << 2) | (prod[4] >> 30);
+
+    /*  Each part has 32 bits and is exact. Only the first carries the sign.  */
+    a = (static_cast<double>(t_hi >> 32) -
+         4294967296.0*static_cast<double>(t_hi >> 63)) * two_m32;
+    b = static_cast<double>(t_hi & 0xFFFFFFFFULL) * (two_m32*two_m32);
+    c = static_cast<double>(t_lo >> 32) * (two_m32*two_m32*two_m32);
+    d = static_cast<double>(t_lo & 0xFFFFFFFFULL) *
+        (two_m32*two_m32*two_m32*two_m32);
+
+    /*  Summed so nothing is lost when the leading parts are zero.            */
+    ab = cvp::eft::two_sum(a, b, ab_err);
+    cd = cvp::eft::two_sum(c, d, cd_err);
+    t = cvp::eft::two_sum(ab, cd, sum_err);
+    t = cvp::eft::quick_two_sum(t, (ab_err + cd_err) + sum_err, t_err);
+
+    /*  t pi / 2, the product of two double-doubles to double-double.         */
+    out = cvp::eft::two_prod(pio2_hi, t, out_err);
+    out_err += pio2_hi*t_err + pio2_lo*t;
+    out = cvp::eft::quick_two_sum(out, out_err, out_err);
+
+    /*  sin(-x) = -sin(x) and cos(-x) = cos(x), so k and t change sign.       */
+    *r = (x < 0.0 ? -out : out);
+    *lo = (x < 0.0 ? -out_err : out_err);
+    return (x < 0.0 ? (4ULL - q) & 3ULL : q);
+}
+/*  End of cvp::math::rem_pio2_large.                                         */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::math::sincos                                                     *
+ *  Purpose:                                                                  *
+ *      Computes the sine and cosine of a real number.                        *
+ *  Arguments:                                                                *
+ *      x (double):                                                           *
+ *          A real number.                                                    *
+ *      s (double *):                                                         *
+ *          The sine of x is stored here.                                     *
+ *      c (double *):                                                         *
+ *          The cosine of x is stored here.                                   *
+ *      large (bool):                                                         *
+ *          Whether x may be 2^19 or more in size. True by default.           *
+ *  Method:                                                                   *
+ *      Write x = k pi / 2 + r with |r| <= pi / 4. For |x| < 2^19, pi / 2 is  *
+ *      split into three parts (Cody-Waite reduction), the first two with 33  *
+ *      significant bits so that their products with k are exact for          *
+ *      |k| < 2^20, and the rounding error of r is kept. Larger x are reduced *
+ *      by rem_pio2_large. If large is true both are computed and one is      *
+ *      selected, with no branch per value. If it is false the long           *
+ *      reduction is skipped, and the test on large is folded away. sin(r)    *
+ *      and cos(r) are Taylor polynomials to r^15 and r^16, with errors below *
+ *      1e-17 on |r| <= pi / 4. k mod 4 then picks the signs and which of the *
+ *      two is the sine.                                                      *
+ ******************************************************************************/
+CVP_MATH_INLINE void
+cvp::math::sincos(double x, double *s, double *c, bool large)
+{
+    /*  2 / pi, and pi / 2 split into three parts.                            */
+    const double two_by_pi = 6.36619772367581382433E-01;
+    const double pio2_1 = 1.57079632673412561417E+00;
+    const double pio2_2 = 6.07710050630396597660E-11;
+    const double pio2_3 = 2.02226624879595063154E-21;
+
+    /*  x - k pi / 2 as r + lo. The products with the first two parts are     *
+     *  exact, and lo is the rounding error of r plus the third part.         */
+    const double k = cvp::math::round_to_int(x * two_by_pi);
+    double lo;
+    double r = cvp::eft::quick_two_sum(x - k*pio2_1, -k*pio2_2, lo);
+    unsigned long long q = cvp::math::quadrant(k);
+    lo = lo - k*pio2_3;
+
+    /*  The same for large x, selected. Infinity is large, and x - x makes it *
+     *  NaN. NaN is not large, and is NaN after the short reduction too.      */
+    if (large)
+    {
+        double r_large, lo_large;
+        const unsigned long long q_large =
+            cvp::math::rem_pio2_large(x, &r_large, &lo_large);
+
+        const bool is_large = ((x < 0.0 ? -x : x) >= 5.24288E+05);
+        r = (is_large ? r_large + (x - x) : r);
+        lo = (is_large ? lo_large : lo);
+        q = (is_large ? q_large : q);
+    }
+
+    const double r2 = r*r;
+    const double half_r2 = 0.5*r2;
+    const double w = 1.0 - half_r2;
+
+    /*  Taylor polynomials, the coefficients are +/- 1 / n!. sin(r + lo) and  *
+     *  cos(r + lo) are sin(r) + lo cos(r) and cos(r) - lo sin(r) to double   *
+     *  precision, and 1 - r^2 / 2 is corrected for its rounding error.       */
+    const double sin_p = r*r2*(
+        -1.66666666666666666667E-01 + r2*(8.33333333333333333333E-03 +
+        r2*(-1.98412698412698412698E-04 + r2*(2.75573192239858906526E-06 +
+        r2*(-2.50521083854417187751E-08 + r2*(1.60590438368216145994E-10 +
+        r2*-7.64716373181981647590E-13))))));
+
+    const double cos_p = r2*r2*(
+        4.16666666666666666667E-02 + r2*(-1.38888888888888888889E-03 +
+        r2*(2.48015873015873015873E-05 + r2*(-2.75573192239858906526E-07 +
+        r2*(2.08767569878680989792E-09 + r2*(-1.14707455977297247139E-11 +
+        r2*4.77947733238738529744E-14))))));
+
+    const double sin_r = r + (sin_p + lo*w);
+    const double cos_r = w + ((((1.0 - w) - half_r2) + cos_p) - r*lo);
+
+    /*  The quadrant, k mod 4. Odd quadrants swap sine and cosine.            */
+    const double sin_q = ((q & 1ULL) ? cos_r : sin_r);
+    const double cos_q = ((q & 1ULL) ? sin_r : cos_r);
+
+    *s = ((q & 2ULL) ? -sin_q : sin_q);
+    *c = (((q + 1ULL) & 2ULL) ? -cos_q : cos_q);
+}
+/*  End of cvp::math::sincos.                                                 */
+
+/*  The largest |x[k]| is found with no branches, so the loop is vectorized.  *
+ *  NaN fails the comparison and is skipped, sincos needs no help with it.    */
+CVP_MATH_INLINE bool cvp::math::any_large(const double *x, unsigned int n)
+{
+    double largest = 0.0;
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+    {
+        const double ax = (x[k] < 0.0 ? -x[k] : x[k]);
+        largest = (ax > largest ? ax : largest);
+    }
+
+    return (largest >= 5.24288E+05);
+}
+
+/*  For |x| < 1 the Taylor series is used, which avoids the cancellation in   *
+ *  e^x - e^-x. Otherwise both come from e^|x| and its reciprocal.            */
+CVP_MATH_INLINE void cvp::math::sinhcosh(double x, double *sh, double *ch)
+{
+    const double ax = (x < 0.0 ? -x : x);
+    const double ex = cvp::math::exp(ax);
+    const double ex_inv = 1.0 / ex;
+    const double x2 = x*x;
+
+    /*  Taylor polynomial for sinh, the coefficients are 1 / n! for odd n.    */
+    const double series = x + x*x2*(
+        1.66666666666666666667E-01 + x2*(8.33333333333333333333E-03 +
+        x2*(1.98412698412698412698E-04 + x2*(2.75573192239858906526E-06 +
+        x2*(2.50521083854417187751E-08 + x2*(1.60590438368216145994E-10 +
+        x2*(7.64716373181981647590E-13 + x2*2.81145725434552076320E-15)))))));
+
+    const double big = 0.5 * (ex - ex_inv);
+
+    *sh = (ax < 1.0 ? series : (x < 0.0 ? -big : big));
+    *ch = 0.5 * (ex + ex_inv);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::math::atan2                                                      *
+ *  Purpose:                                                                  *
+ *      Computes the angle of the point (x, y) with the positive x axis.      *
+ *  Arguments:                                                                *
+ *      y (double):                                                           *
+ *          The y coordinate of the point.                                    *
+ *      x (double):                                                           *
+ *          The x coordinate of the point.                                    *
+ *  Outputs:                                                                  *
+ *      theta (double):                                                       *
+ *          The angle, between -pi and pi.                                    *
+ *  Method:                                                                   *
+ *      With t = min(|x|, |y|) / max(|x|, |y|) in [0, 1], pick the nearest of *
+ *      tan(0), tan(pi / 8), and tan(pi / 4), call it c = tan(j pi / 8), and  *
+ *      use atan(t) = j pi / 8 + atan(u) with u = (t - c) / (1 + t c). Then   *
+ *      |u| <= tan(pi / 16) < 0.2, and the Taylor series of atan(u) to u^23   *
+ *      has error below 1e-17. The octant is restored from the signs of x and *
+ *      y and which of them is larger, giving n pi / 8 +/- atan(u) for an     *
+ *      integer n, and pi / 8 is split into two parts so that only the final  *
+ *      sum is rounded.                                                       *
+ *  Notes:                                                                    *
+ *      x and y both infinite give NaN. atan2(+/-0, x) is 0 or pi, without    *
+ *      the sign of zero.                                                     *
+ ******************************************************************************/
+CVP_MATH_INLINE double cvp::math::atan2(double y, double x)
+{
+    /*  pi / 8 in two parts, the first with 45 significant bits so that its   *
+     *  products with 0, 1, ..., 8 are exact, and tan(pi / 8).                */
+    const double pi_by_8_hi = 3.92699081698722807232E-01;
+    const double pi_by_8_lo = 1.34757571453952974203E-15;
+    const double tan_pi_by_8 = 4.14213562373095048802E-01;
+
+    /*  The boundaries between the three centers, tan(pi/16) and tan(3pi/16). */
+    const double tan_pi_by_16 = 1.98912367379658006912E-01;
+    const double tan_3pi_by_16 = 6.68178637919298919998E-01;
+
+    const double ax = (x < 0.0 ? -x : x);
+    const double ay = (y < 0.0 ? -y : y);
+    const bool swap = (ay > ax);
+    const double num = (swap ? ax : ay);
+    const double den = (swap ? ay : ax);
+
+    /*  t in [0, 1]. The origin gives t = 0 instead of 0 / 0.                 */
+    const double t = num / (den > 0.0 ? den : 1.0);
+
+    /*  The nearest center c = tan(j pi / 8), j = 0, 1, or 2.                 */
+    const bool past_high = (t > tan_3pi_by_16);
+    const bool past_low = (t > tan_pi_by_16);
+    const double j = (past_high ? 2.0 : (past_low ? 1.0 : 0.0));
+    const double c = (past_high ? 1.0 : (past_low ? tan_pi_by_8 : 0.0));
+    const double u = (t - c) / (1.0 + t*c);
+    const double u2 = u*u;
+
+    /*  Taylor series for atan(u), the coefficients are (-1)^n / (2n + 1).    */
+    const double atan_u = u + u*u2*(
+        -3.33333333333333333333E-01 + u2*(2.00000000000000000000E-01 +
+        u2*(-1.42857142857142857143E-01 + u2*(1.11111111111111111111E-01 +
+        u2*(-9.09090909090909090909E-02 + u2*(7.69230769230769230769E-02 +
+        u2*(-6.66666666666666666667E-02 + u2*(5.88235294117647058824E-02 +
+        u2*(-5.26315789473684210526E-02 + u2*(4.76190476190476190476E-02 +
+        u2*-4.34782608695652173913E-02))))))))));
+
+    /*  The angle is n pi / 8 + sign * atan(u) for an integer n. Restore the  *
+     *  octant, then the half plane, then add the parts keeping the error of  *
+     *  the sum, so that only the final sum is rounded.                       */
+    const double n_oct = (swap ? 4.0 - j : j);
+    const double n = (x < 0.0 ? 8.0 - n_oct : n_oct);
+    const double sgn_u = ((swap != (x < 0.0)) ? -atan_u : atan_u);
+    double err;
+    const double sum = cvp::eft::two_sum(n*pi_by_8_hi, sgn_u, err);
+    const double theta = sum + (err + n*pi_by_8_lo);
+    return (y < 0.0 ? -theta : theta);
+}
+/*  End of cvp::math::atan2.                                                  */
+
+/******************************************************************************
+ *                             Complex Functions                              *
+ ******************************************************************************/
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::exp                                                              *
+ *  Purpose:                                                                  *
+ *      Computes the complex exponential.                                     *
+ *  Arguments:                                                                *
+ *      z (const cvp::complex &):                                             *
+ *          A complex number x + iy.                                          *
+ *      large (bool):                                                         *
+ *          Whether |y| may be 2^19 or more, passed to sincos.                *
+ *  Outputs:                                                                  *
+ *      exp_z (cvp::complex):                                                 *
+ *          The value e^x (cos(y) + i sin(y)).                                *
+ *  Notes:                                                                    *
+ *      Each part is a product of two values with errors below 1.5 ulp, so    *
+ *      the error is below 2.5 ulp of |exp(z)| for all finite z.              *
+ *      If e^x overflows, a part whose trig factor is zero is still zero, so  *
+ *      exp(800) is (inf, 0) and not (inf, NaN).                              *
+ ******************************************************************************/
+CVP_MATH_INLINE cvp::complex cvp::exp(const cvp::complex &z, bool large)
+{
+    double s, c;
+    const double r = cvp::math::exp(z.real);
+    cvp::math::sincos(z.imag, &s, &c, large);
+
+    /*  inf * 0 is NaN. Select zero instead.                                  */
+    return cvp::complex((c == 0.0 ? 0.0 : r*c), (s == 0.0 ? 0.0 : r*s));
+}
+/*  End of cvp::exp.                                                          */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::log                                                              *
+ *  Purpose:                                                                  *
+ *      Computes the principal branch of the complex log.                     *
+ *  Arguments:                                                                *
+ *      z (const cvp::complex &):                                             *
+ *          A complex number x + iy.                                          *
+ *  Outputs:                                                                  *
+ *      log_z (cvp::complex):                                                 *
+ *          The value log|z| + i arg(z), with -pi < arg(z) <= pi.             *
+ *  Method:                                                                   *
+ *      log|z| = log(x^2 + y^2) / 2. Points with |z| above 2^500 or below     *
+ *      2^-500 are scaled by 2^-600 or 2^600 first, which is exact, so the    *
+ *      sum of squares neither overflows nor underflows.                      *
+ *  Notes:                                                                    *
+ *      The error is below 2 ulp of |log(z)| outside of 1/2 < |z| < 2. Inside *
+ *      it log|z| may be close to zero, and the error is below 3e-16 in       *
+ *      absolute terms instead.                                               *
+ *      log(0) is -infinity.                                                  *
+ ******************************************************************************/
+CVP_MATH_INLINE cvp::complex cvp::log(const cvp::complex &z)
+{
+    /*  2^500, 2^-500, 2^600, 2^-600, and 600 log(2).                         */
+    const double two_500 = 3.27339060789614187001E+150;
+    const double two_m500 = 3.05493636349960468205E-151;
+    const double two_600 = 4.14951556888099295851E+180;
+    const double two_m600 = 2.40991986510288411774E-181;
+    const double log_two_600 = 4.15888308335967185650E+02;
+
+    const double ax = (z.real < 0.0 ? -z.real : z.real);
+    const double ay = (z.imag < 0.0 ? -z.imag : z.imag);
+    const double big = (ax > ay ? ax : ay);
+
+    /*  Scale very large and very small points toward 1. The choice is made   *
+     *  with arithmetic on 0 and 1, since GCC turns nested selects on the     *
+     *  same value back into branches, which stops the vectorizer.            */
+    const double huge = (big > two_500 ? 1.0 : 0.0);
+    const double tiny = (big < two_m500 ? 1.0 : 0.0);
+    const double scale = (1.0 - huge - tiny) + huge*two_m600 + tiny*two_600;
+    const double shift = (huge - tiny) * log_two_600;
+
+    const double x = z.real * scale;
+    const double y = z.imag * scale;
+    const double log_abs = 0.5 * cvp::math::log(x*x + y*y) + shift;
+
+    return cvp::complex(log_abs, cvp::math::atan2(z.imag, z.real));
+}
+/*  End of cvp::log.                                                          */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::sqrt                                                             *
+ *  Purpose:                                                                  *
+ *      Computes the principal square root of a complex number.               *
+ *  Arguments:                                                                *
+ *      z (const cvp::complex &):                                             *
+ *          A complex number x + iy.                                          *
+ *  Outputs:                                                                  *
+ *      sqrt_z (cvp::complex):                                                *
+ *          The square root with non-negative real part.                      *
+ *  Method:                                                                   *
+ *      With t = sqrt((|x| + |z|) / 2), the root is t + iy / (2t) for x >= 0, *
+ *      and |y| / (2t) + i sign(y) t for x < 0, where sign(-0) is -1. This    *
+ *      avoids the cancellation of |z| - |x|. The real square root is a       *
+ *      single instruction. As in log, points with |z| above 2^500 or below   *
+ *      2^-500 are scaled by 2^-600 or 2^600 first, and the root by 2^300 or  *
+ *      2^-300 after, which is exact, so |z| neither overflows nor            *
+ *      underflows.                                                           *
+ *  Notes:                                                                    *
+ *      The error is below 3 ulp of |sqrt(z)|. The root of conj(z) is the     *
+ *      conjugate of the root of z, for signed zeros too, and a NaN in either *
+ *      part gives NaN in both.                                               *
+ ******************************************************************************/
+CVP_MATH_INLINE cvp::complex cvp::sqrt(const cvp::complex &z)
+{
+    /*  2^500, 2^-500, 2^600, 2^-600, 2^300, and 2^-300.                      */
+    const double two_500 = 3.27339060789614187001E+150;
+    const double two_m500 = 3.05493636349960468205E-151;
+    const double two_600 = 4.14951556888099295851E+180;
+    const double two_m600 = 2.40991986510288411774E-181;
+    const double two_300 = 2.03703597633448608627E+90;
+    const double two_m300 = 4.90909346529772655310E-91;
+
+    const double ax = (z.real < 0.0 ? -z.real : z.real);
+    const double ay = (z.imag < 0.0 ? -z.imag : z.imag);
+    const double big = (ax > ay ? ax : ay);
+
+    /*  Scale toward 1 with arithmetic on 0 and 1, as log does.               */
+    const double huge = (big > two_500 ? 1.0 : 0.0);
+    const double tiny = (big < two_m500 ? 1.0 : 0.0);
+    const double scale = (1.0 - huge - tiny) + huge*two_m600 + tiny*two_600;
+    const double unscale = (1.0 - huge - tiny) + huge*two_300 + tiny*two_m300;
+
+    const double x = z.real * scale;
+    const double y = z.imag * scale;
+    const double abs_z = std::sqrt(x*x + y*y);
+    const double t = std::sqrt(0.5 * (ax * scale + abs_z));
+
+    /*  The origin has t = 0, and its root is zero. A NaN t is kept, so NaN   *
+     *  goes to both parts.                                                   */
+    const double v = 0.5 * y / (t == 0.0 ? 1.0 : t);
+    const double av = std::fabs(v);
+
+    if (z.real >= 0.0)
+        return cvp::complex(t * unscale, v * unscale);
+
+    /*  copysign tells -0 from 0, so the roots of x - 0i and x + 0i are       *
+     *  conjugates. Unlike signbit, it is vectorized.                         */
+    return cvp::complex(av * unscale, std::copysign(t, y) * unscale);
+}
+/*  End of cvp::sqrt.                                                         */
+
+/*  Real powers, exp(p log(z)). 0^p is 0 for p > 0. large is passed to exp,   *
+ *  here and for complex powers.                                              */
+CVP_MATH_INLINE cvp::complex
+cvp::pow(const cvp::complex &z, double p, bool large)
+{
+    const cvp::complex w = cvp::log(z);
+    return cvp::exp(cvp::complex(p * w.real, p * w.imag), large);
+}
+
+/*  Complex powers, exp(w log(z)). 0^w is taken to be 0. The error grows with *
+ *  |w log(z)|, since the exponent is only known to a few ulp.                */
+CVP_MATH_INLINE cvp::complex
+cvp::pow(const cvp::complex &z, const cvp::complex &w, bool large)
+{
+    const bool zero = (z.real == 0.0 && z.imag == 0.0);
+    const cvp::complex out = cvp::exp(w * cvp::log(z), large);
+    return (zero ? cvp::complex(0.0, 0.0) : out);
+}
+
+/*  sin(x + iy) = sin(x) cosh(y) + i cos(x) sinh(y). If cosh(y) overflows,    *
+ *  a zero trig factor still gives a zero part, as in exp. large tells        *
+ *  sincos whether |x| may be 2^19 or more, here and in cos.                  */
+CVP_MATH_INLINE cvp::complex cvp::sin(const cvp::complex &z, bool large)
+{
+    double s, c, sh, ch;
+    cvp::math::sincos(z.real, &s, &c, large);
+    cvp::math::sinhcosh(z.imag, &sh, &ch);
+    return cvp::complex((s == 0.0 ? 0.0 : s*ch), (c == 0.0 ? 0.0 : c*sh));
+}
+
+/*  cos(x + iy) = cos(x) cosh(y) - i sin(x) sinh(y), with zeros as in sin.    */
+CVP_MATH_INLINE cvp::complex cvp::cos(const cvp::complex &z, bool large)
+{
+    double s, c, sh, ch;
+    cvp::math::sincos(z.real, &s, &c, large);
+    cvp::math::sinhcosh(z.imag, &sh, &ch);
+    return cvp::complex((c == 0.0 ? 0.0 : c*ch), (s == 0.0 ? 0.0 : -s*sh));
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::tanh                                                             *
+ *  Purpose:                                                                  *
+ *      Computes the hyperbolic tangent of a complex number.                  *
+ *  Arguments:                                                                *
+ *      z (const cvp::complex &):                                             *
+ *          A complex number x + iy.                                          *
+ *      large (bool):                                                         *
+ *          Whether |y| may be 2^19 or more, passed to sincos.                *
+ *  Outputs:                                                                  *
+ *      tanh_z (cvp::complex):                                                *
+ *          The value tanh(z).                                                *
+ *  Method:                                                                   *
+ *      tanh(x + iy) = (sinh(2x) + i sin(2y)) / (cosh(2x) + cos(2y)), and     *
+ *      with the double angle formulas this is                                *
+ *                                                                            *
+ *          sinh(x) cosh(x) + i sin(y) cos(y)                                 *
+ *          ---------------------------------                                 *
+ *                sinh(x)^2 + cos(y)^2                                        *
+ *                                                                            *
+ *      The denominator is a sum of squares and does not cancel. For          *
+ *      |x| > 20, where sinh(x)^2 would overflow first, this is sign(x) +     *
+ *      2 i sin(2y) e^(-2|x|) to double precision.                            *
+ *  Notes:                                                                    *
+ *      The error is below 6 ulp of |tanh(z)|. The poles at x = 0 and         *
+ *      y = pi / 2 + k pi give infinite parts.                                *
+ ******************************************************************************/
+CVP_MATH_INLINE cvp::complex cvp::tanh(const cvp::complex &z, bool large)
+{
+    double s, c, sh, ch;
+    const double ax = (z.real < 0.0 ? -z.real : z.real);
+
+    cvp::math::sincos(z.imag, &s, &c, large);
+    cvp::math::sinhcosh(z.real, &sh, &ch);
+
+    /*  The denominator is a sum of squares, with a single division.          */
+    const double rcpr = 1.0 / (sh*sh + c*c);
+    const double far_imag = 4.0 * s * c * cvp::math::exp(-2.0 * ax);
+
+    if (ax > 20.0)
+        return cvp::complex((z.real < 0.0 ? -1.0 : 1.0), far_imag);
+
+    return cvp::complex(sh * ch * rcpr, s * c * rcpr);
+}
+/*  End of cvp::tanh.                                                         */
+
+/*  The batch functions apply the complex ones to every lane. These are       *
+ *  inlined and have no branches, so the loops are vectorized. Functions      *
+ *  using sincos check once whether any lane needs the long reduction, and    *
+ *  run a loop without it if not. For pow, |arg(z)| <= pi and |log|z|| < 745  *
+ *  bound the argument of the sine from the exponent alone.                   */
+
+/*  Complex exponential of every lane.                                        */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::exp(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    if (cvp::math::any_large(z.imag, N))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::exp(z.get(k)));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::exp(z.get(k), false));
+    }
+
+    return out;
+}
+
+/*  Complex log of every lane.                                                */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::log(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::log(z.get(k)));
+
+    return out;
+}
+
+/*  Complex square root of every lane.                                        */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::sqrt(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+        out.set(k, cvp::sqrt(z.get(k)));
+
+    return out;
+}
+
+/*  Real power of every lane.                                                 */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::pow(const cvp::complex_batch<N> &z, double p)
+{
+    cvp::complex_batch<N> out;
+    const double bound = 3.1416 * (p < 0.0 ? -p : p);
+    unsigned int k;
+
+    if (cvp::math::any_large(&bound, 1U))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::pow(z.get(k), p));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::pow(z.get(k), p, false));
+    }
+
+    return out;
+}
+
+/*  Complex power of every lane.                                              */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::pow(const cvp::complex_batch<N> &z, const cvp::complex_batch<N> &w)
+{
+    cvp::complex_batch<N> out;
+    double bound[N];
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double a = (w.real[k] < 0.0 ? -w.real[k] : w.real[k]);
+        const double b = (w.imag[k] < 0.0 ? -w.imag[k] : w.imag[k]);
+        bound[k] = 3.1416*a + 745.0*b;
+    }
+
+    if (cvp::math::any_large(bound, N))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::pow(z.get(k), w.get(k)));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::pow(z.get(k), w.get(k), false));
+    }
+
+    return out;
+}
+
+/*  Complex sine of every lane.                                               */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::sin(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    if (cvp::math::any_large(z.real, N))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::sin(z.get(k)));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::sin(z.get(k), false));
+    }
+
+    return out;
+}
+
+/*  Complex cosine of every lane.                                             */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::cos(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    if (cvp::math::any_large(z.real, N))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::cos(z.get(k)));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::cos(z.get(k), false));
+    }
+
+    return out;
+}
+
+/*  Complex hyperbolic tangent of every lane.                                 */
+template <unsigned int N>
+inline cvp::complex_batch<N> cvp::tanh(const cvp::complex_batch<N> &z)
+{
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    if (cvp::math::any_large(z.imag, N))
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::tanh(z.get(k)));
+    }
+    else
+    {
+        for (k = 0U; k < N; ++k)
+            out.set(k, cvp::tanh(z.get(k), false));
+    }
+
+    return out;
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides cache-line aligned memory allocation.                        *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_MEMORY_HPP
+#define CVP_MEMORY_HPP
+
+/*  malloc, free, and size_t are given here.                                  */
+#include <cstdlib>
+
+/*  Namespace for the mini-project. "Complex Visual Plots."                   */
+namespace cvp {
+
+    /*  Another namespace to avoid name conflicts with the standard library.  */
+    namespace memory {
+
+        /*  The size of a cache line, in bytes. 64 on all common hardware.    */
+        const std::size_t cache_line = 64U;
+
+        /*  Rounds a size up to the nearest multiple of the cache line.       */
+        inline std::size_t round_up(std::size_t size);
+
+        /*  Allocates memory whose address is a multiple of the cache line.   */
+        inline void *aligned_malloc(std::size_t size);
+
+        /*  Frees memory allocated with aligned_malloc.                       */
+        inline void aligned_free(void *ptr);
+    }
+    /*  End of namespace "memory".                                            */
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Rounds a size up to the nearest multiple of the cache line.               */
+inline std::size_t cvp::memory::round_up(std::size_t size)
+{
+    return (size + cache_line - 1U) & ~(cache_line - 1U);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::memory::aligned_malloc                                           *
+ *  Purpose:                                                                  *
+ *      Allocates memory aligned to a cache line.                             *
+ *  Arguments:                                                                *
+ *      size (std::size_t):                                                   *
+ *          The number of bytes requested.                                    *
+ *  Outputs:                                                                  *
+ *      ptr (void *):                                                         *
+ *          A pointer to the aligned memory, or NULL if malloc failed.        *
+ *  Method:                                                                   *
+ *      Over-allocate with malloc, round the address up to the cache line,    *
+ *      and store the original pointer directly in front of the aligned one   *
+ *      so that aligned_free can find it again. This avoids depending on      *
+ *      posix_memalign or C++17's aligned new.                                *
+ ******************************************************************************/
+inline void *cvp::memory::aligned_malloc(std::size_t size)
+{
+    /*  Room for the data, the padding, and the stashed original pointer.     */
+    const std::size_t total = size + cache_line + sizeof(void *);
+
+    /*  The unaligned block returned by malloc.                               */
+    void * const base = std::malloc(total);
+
+    /*  Address of the block after reserving space for the original pointer.  */
+    std::size_t addr;
+
+    /*  Check if malloc failed. The caller should check for NULL as well.     */
+    if (!base)
+        return NULL;
+
+    /*  Round the address up to the next cache line.                          */
+    addr = reinterpret_cast<std::size_t>(base) + sizeof(void *);
+    addr = (addr + cache_line - 1U) & ~(cache_line - 1U);
+
+    /*  Store the original pointer right before the aligned block.            */
+    reinterpret_cast<void **>(addr)[-1] = base;
+    return reinterpret_cast<void *>(addr);
+}
+/*  End of cvp::memory::aligned_malloc.                                       */
+
+/*  Frees memory allocated with aligned_malloc.                               */
+inline void cvp::memory::aligned_free(void *ptr)
+{
+    /*  Freeing NULL is a no-op, just as it is for free.                      */
+    if (!ptr)
+        return;
+
+    /*  The original pointer is stored right before the aligned block.        */
+    std::free(static_cast<void **>(ptr)[-1]);
+}
+
+#endif
+/*  End of include guard.                                                     */
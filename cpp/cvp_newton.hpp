@@ -0,0 +1,106 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides the Newton map z - f(z) / f'(z) of a function f, with the    *
+ *      derivative computed by dual numbers instead of by hand.               *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_NEWTON_HPP
+#define CVP_NEWTON_HPP
+
+/*  std::enable_if found here.                                                */
+#include <type_traits>
+
+/*  Dual numbers, used to differentiate the function.                         */
+#include "cvp_dual.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The Newton map of f. f must be a template, like the classes in the    *
+     *  examples, so that it can be called on cvp::dual.                      */
+    template <typename Tfunc>
+    class newton_map {
+        public:
+            /*  The function whose roots are being found.                     */
+            Tfunc cfunc;
+
+            /*  Constructor from the function.                                */
+            newton_map(Tfunc f);
+
+            /*  Computes z - f(z) / f'(z). This only exists for the types T   *
+             *  that f can be called on as a dual, so batches are only used   *
+             *  if f can take a cvp::dual<cvp::complex_batch>.                *
+             *  T is cvp::basic_complex or cvp::complex_batch.                */
+            template <typename T>
+            inline typename std::enable_if<
+                cvp::is_dual_callable<Tfunc, T>::value, T
+            >::type operator () (const T &z) const;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the function.                                            */
+template <typename Tfunc>
+cvp::newton_map<Tfunc>::newton_map(Tfunc f) : cfunc(f)
+{
+    return;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::newton_map::operator ()                                          *
+ *  Purpose:                                                                  *
+ *      Computes one step of Newton's method for f.                           *
+ *  Arguments:                                                                *
+ *      z (const T &):                                                        *
+ *          A complex number, or a batch of them.                             *
+ *  Outputs:                                                                  *
+ *      w (T):                                                                *
+ *          The value z - f(z) / f'(z).                                       *
+ *  Method:                                                                   *
+ *      f is called once on the dual z + eps, which gives f(z) + f'(z) eps.   *
+ *      Every operation in f carries the derivative along with the value      *
+ *      (forward differentiation), so f' is exact up to rounding and no       *
+ *      finite differences are needed.                                        *
+ *  Notes:                                                                    *
+ *      The product rule makes each multiplication in f cost three complex    *
+ *      products instead of one. Writing polynomials in Horner form keeps     *
+ *      the number of multiplications down.                                   *
+ ******************************************************************************/
+template <typename Tfunc>
+template <typename T>
+inline typename std::enable_if<
+    cvp::is_dual_callable<Tfunc, T>::value, T
+>::type cvp::newton_map<Tfunc>::operator () (const T &z) const
+{
+    /*  The value and the derivative of f at z, in one pass.                  */
+    const cvp::dual<T> w = cfunc(cvp::dual_variable(z));
+
+    return z - w.value / w.deriv;
+}
+/*  End of cvp::newton_map::operator ().                                      */
+
+#endif
+/*  End of include guard.                                                     */
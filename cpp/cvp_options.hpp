@@ -0,0 +1,112 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides options for controlling how images are rendered.             *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_OPTIONS_HPP
+#define CVP_OPTIONS_HPP
+
+/*  Default tile sizes found here.                                            */
+#include "cvp_tiles.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The strategies for scheduling the work of rendering an image.         */
+    enum render_mode {
+
+        /*  Compute the entire image in tiles, then write it out.             */
+        tiled_mode,
+
+        /*  Compute bands of rows out of order and stream them to the file.   */
+        pipelined_mode,
+
+        /*  Memory-map the output and compute tiles directly into the file.   */
+        mapped_mode,
+
+        /*  Compute the borders of rectangles, filling in uniform ones.       */
+        subdivide_mode
+    };
+
+    /*  Class for the options of the plotting routines.                       */
+    class render_options {
+        public:
+            /*  How the work is scheduled. Defaults to tiled_mode.            */
+            cvp::render_mode mode;
+
+            /*  Number of rows in a band for the pipelined mode.              */
+            unsigned int band_height;
+
+            /*  The maximum number of bands held in memory at once by the     *
+             *  pipelined mode. Zero means twice the number of threads.       */
+            unsigned int max_bands;
+
+            /*  Size of the square blocks the subdivide mode starts from.     */
+            unsigned int block_size;
+
+            /*  If set, the subdivide mode also computes every pixel and      *
+             *  reports how many pixels were filled in incorrectly.           */
+            bool validate;
+
+            /*  How hard to compress PNG and TIFF files, from 0 to 9 as in    *
+             *  zlib. 0 stores the pixels as they are, 1 only codes runs, and *
+             *  is the fastest level that compresses. Defaults to 6.          */
+            unsigned int compression_level;
+
+            /*  Rows in each strip of a QOI file. The strips are encoded on   *
+             *  their own, in parallel. 0, the default, encodes the image as  *
+             *  one stream while the rows arrive.                             */
+            unsigned int strip_rows;
+
+            /*  Constructor with the default values.                          */
+            render_options(void);
+
+            /*  Constructor from the rendering mode.                          */
+            render_options(cvp::render_mode m);
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor with the default values.                                      */
+cvp::render_options::render_options(void)
+{
+    mode = cvp::tiled_mode;
+    band_height = cvp::tiles::height;
+    max_bands = 0U;
+    block_size = 128U;
+    validate = false;
+    compression_level = 6U;
+    strip_rows = 0U;
+}
+
+/*  Constructor from the rendering mode, the rest are the defaults.           */
+cvp::render_options::render_options(cvp::render_mode m)
+{
+    *this = cvp::render_options();
+    mode = m;
+}
+
+#endif
+/*  End of include guard.                                                     */
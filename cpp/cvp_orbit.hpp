@@ -0,0 +1,127 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides classes for the result of iterating a point, used by the     *
+ *      escape-time and convergence plots and their coloring functions.       *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_ORBIT_HPP
+#define CVP_ORBIT_HPP
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Class for the end of the orbit of a point under iteration.            */
+    class orbit {
+        public:
+            /*  The last value of the orbit. For escaped points this is the   *
+             *  first value outside of the bailout radius.                    */
+            cvp::complex z;
+
+            /*  The number of iterations performed, and the maximum allowed.  */
+            unsigned int iters, max_iters;
+
+            /*  Whether or not the orbit left the bailout radius.             */
+            bool escaped;
+
+            /*  Empty constructor.                                            */
+            orbit(void);
+
+            /*  Constructor from the last value, iterations, and status.      */
+            orbit(const cvp::complex &w, unsigned int n,
+                  unsigned int max, bool status);
+    };
+
+    /*  Class for the end of the orbit of a point under an iteration that     *
+     *  converges, like Newton's method.                                      */
+    class convergence {
+        public:
+            /*  The last value of the orbit. For converged points this is     *
+             *  within the tolerance of the previous value.                   */
+            cvp::complex z;
+
+            /*  The number of iterations performed, and the maximum allowed.  */
+            unsigned int iters, max_iters;
+
+            /*  Whether or not consecutive values came within the tolerance.  */
+            bool converged;
+
+            /*  The index of the attractor the orbit converged to, or -1 if   *
+             *  it did not converge or matched none of the known attractors.  */
+            int attractor;
+
+            /*  The square of the last step that was larger than the          *
+             *  tolerance, and the square of the tolerance. The final step is *
+             *  usually down at the rounding error, so this one is kept for   *
+             *  smooth shading instead. Zero if there was no such step.       */
+            double step_sq, tolerance_sq;
+
+            /*  Empty constructor.                                            */
+            convergence(void);
+
+            /*  Constructor from the last value, iterations, status, index of *
+             *  the attractor, and the squares of the step and tolerance.     */
+            convergence(const cvp::complex &w, unsigned int n,
+                        unsigned int max, bool status, int index,
+                        double dz_sq, double tol_sq);
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, simply return.                                         */
+cvp::orbit::orbit(void)
+{
+    return;
+}
+
+/*  Constructor from the last value, iterations, and status.                  */
+cvp::orbit::orbit(const cvp::complex &w, unsigned int n,
+                  unsigned int max, bool status)
+    : z(w), iters(n), max_iters(max), escaped(status)
+{
+    return;
+}
+
+/*  Empty constructor, simply return.                                         */
+cvp::convergence::convergence(void)
+{
+    return;
+}
+
+/*  Constructor from the last value, iterations, status, attractor, and the   *
+ *  squares of the last step and the tolerance.                               */
+cvp::convergence::convergence(const cvp::complex &w, unsigned int n,
+                              unsigned int max, bool status, int index,
+                              double dz_sq, double tol_sq)
+    : z(w), iters(n), max_iters(max), converged(status), attractor(index),
+      step_sq(dz_sq), tolerance_sq(tol_sq)
+{
+    return;
+}
+
+#endif
+/*  End of include guard.                                                     */
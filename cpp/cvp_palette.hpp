@@ -0,0 +1,498 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides palettes, color gradients stored as lookup tables. Coloring  *
+ *      a point is then two table lookups instead of a chain of branches.     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_PALETTE_HPP
+#define CVP_PALETTE_HPP
+
+/*  atan2 and sqrt functions provided here.                                   */
+#include <cmath>
+
+/*  fopen, fgets, sscanf, and puts found here.                                */
+#include <cstdio>
+
+/*  Complex class defined here.                                               */
+#include "cvp_complex.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Branch-free atan2 for the argument, and the CVP_MATH_INLINE macro.        */
+#include "cvp_math.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  A cyclic gradient of colors, precomputed into a table.                */
+    class palette {
+        public:
+            /*  The number of colors in the table. Six segments of 256.       */
+            static const unsigned int size = 1536U;
+
+            /*  The number of steps in the table of intensities.              */
+            static const unsigned int shades = 4096U;
+
+            /*  The gradient, sampled at every integer from 0 to size - 1.    */
+            cvp::color colors[size];
+
+            /*  Empty constructor, the rainbow color wheel.                   */
+            palette(void);
+
+            /*  Constructor from n evenly spaced stops, wrapping around.      */
+            palette(const cvp::color *stops, unsigned int n);
+
+            /*  Constructor from n evenly spaced stops. If cyclic is false    *
+             *  the table ends on the last stop instead of wrapping around.   */
+            palette(const cvp::color *stops, unsigned int n, bool cyclic);
+
+            /*  Constructor from a text file of stops, one "r g b" per line.  */
+            explicit palette(const char *filename);
+
+            /*  The color at val, for 0 <= val < size. Values outside this    *
+             *  range, and NaN, are clamped to the ends of the table.         */
+            inline cvp::color at(double val) const;
+
+            /*  Colors a complex number, hue from the argument and intensity  *
+             *  from the modulus.                                             */
+            inline cvp::color operator () (cvp::complex z) const;
+
+            /*  Colors the n points re[k] + i im[k], writing packed RGB to    *
+             *  out. Gives the same colors as operator (), and is vectorized. */
+            inline void row(const double *re, const double *im,
+                            unsigned int n, cvp::color *out) const;
+
+        private:
+            /*  Fills the table by linear interpolation between the stops.    */
+            inline void
+            interpolate(const cvp::color *stops, unsigned int n, bool cyclic);
+
+            /*  The indices into the table of colors and the table of         *
+             *  intensities for the point x + iy.                             */
+            static CVP_MATH_INLINE void
+            locate(double x, double y, int *hue, int *shade);
+
+            /*  Scales a color by a 16-bit fixed-point intensity.             */
+            static inline cvp::color scale(const cvp::color &c, unsigned int q);
+
+            /*  The intensity atan(5r) / (pi / 2) as a 16-bit fixed-point     *
+             *  number, sampled evenly in u = 5r / (1 + 5r).                  */
+            static inline const unsigned int *intensities(void);
+    };
+
+    /*  Palettes that are worth having.                                       */
+    namespace palettes {
+        inline const cvp::palette &wheel(void);
+        inline const cvp::palette &rainbow(void);
+    }
+    /*  End of namespace "palettes".                                          */
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  The rainbow wheel: blue, cyan, green, yellow, red, magenta, and back.     */
+cvp::palette::palette(void)
+{
+    const cvp::color stops[6] = {
+        cvp::color(0x00U, 0x00U, 0xFFU),
+        cvp::color(0x00U, 0xFFU, 0xFFU),
+        cvp::color(0x00U, 0xFFU, 0x00U),
+        cvp::color(0xFFU, 0xFFU, 0x00U),
+        cvp::color(0xFFU, 0x00U, 0x00U),
+        cvp::color(0xFFU, 0x00U, 0xFFU)
+    };
+
+    interpolate(stops, 6U, true);
+    return;
+}
+
+/*  Constructor from an array of stops. An empty array gives the wheel.       */
+cvp::palette::palette(const cvp::color *stops, unsigned int n)
+{
+    if (n == 0U)
+    {
+        std::puts("ERROR: cvp::palette needs at least one stop.");
+        *this = cvp::palette();
+        return;
+    }
+
+    interpolate(stops, n, true);
+    return;
+}
+
+/*  Constructor from an array of stops, which may or may not wrap around.     */
+cvp::palette::palette(const cvp::color *stops, unsigned int n, bool cyclic)
+{
+    if (n == 0U)
+    {
+        std::puts("ERROR: cvp::palette needs at least one stop.");
+        *this = cvp::palette();
+        return;
+    }
+
+    interpolate(stops, n, cyclic);
+    return;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      palette                                                               *
+ *  Purpose:                                                                  *
+ *      Creates a palette from a text file of color stops.                    *
+ *  Arguments:                                                                *
+ *      filename (const char *):                                              *
+ *          The path to the file.                                             *
+ *  Method:                                                                   *
+ *      Each line holds the red, green, and blue values of one stop, integers *
+ *      from 0 to 255 separated by spaces. Blank lines, and anything after a  *
+ *      '#', are skipped. The stops are evenly spaced around the palette and  *
+ *      the last one wraps around to the first.                               *
+ *  Notes:                                                                    *
+ *      If the file cannot be read, or a line is not a valid stop, an error   *
+ *      is printed and the palette is the rainbow wheel.                      *
+ ******************************************************************************/
+cvp::palette::palette(const char *filename)
+{
+    /*  Buffers for the stops and for the current line of the file.           */
+    cvp::color stops[size];
+    char line[256];
+
+    /*  The number of stops read so far, and whether every line was valid.    */
+    unsigned int n = 0U;
+    bool valid = true;
+
+    /*  Open the file for reading, falling back to the wheel on failure.      */
+    std::FILE *fp = std::fopen(filename, "r");
+
+    if (!fp)
+    {
+        std::puts("ERROR: cvp::palette could not open the palette file.");
+        *this = cvp::palette();
+        return;
+    }
+
+    while (std::fgets(line, static_cast<int>(sizeof(line)), fp))
+    {
+        int r, g, b;
+        char *c;
+
+        /*  Cut comments from the line, and skip it if nothing is left.       */
+        for (c = line; *c != '\0' && *c != '#'; ++c)
+            continue;
+
+        *c = '\0';
+
+        for (c = line; *c == ' ' || *c == '\t' || *c == '\r' || *c == '\n'; ++c)
+            continue;
+
+        if (*c == '\0')
+            continue;
+
+        if (std::sscanf(line, "%d %d %d", &r, &g, &b) != 3 ||
+            r < 0 || r > 255 || g < 0 || g > 255 || b < 0 || b > 255)
+        {
+            std::puts("ERROR: cvp::palette found an invalid line.");
+            valid = false;
+            break;
+        }
+
+        if (n == size)
+        {
+            std::puts("ERROR: cvp::palette file has too many stops.");
+            valid = false;
+            break;
+        }
+
+        stops[n] = cvp::color(static_cast<unsigned char>(r),
+                              static_cast<unsigned char>(g),
+                              static_cast<unsigned char>(b));
+        ++n;
+    }
+
+    std::fclose(fp);
+
+    if (valid && n == 0U)
+    {
+        std::puts("ERROR: cvp::palette file has no stops.");
+        valid = false;
+    }
+
+    if (!valid)
+    {
+        *this = cvp::palette();
+        return;
+    }
+
+    interpolate(stops, n, true);
+    return;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      interpolate                                                           *
+ *  Purpose:                                                                  *
+ *      Fills the table with a piecewise linear gradient between stops.       *
+ *  Arguments:                                                                *
+ *      stops (const cvp::color *):                                           *
+ *          The colors to interpolate between.                                *
+ *      n (unsigned int):                                                     *
+ *          The number of stops, between 1 and size.                          *
+ *      cyclic (bool):                                                        *
+ *          Whether the last stop is joined back to the first.                *
+ *  Method:                                                                   *
+ *      There are m = n segments if cyclic, and m = n - 1 if not. Segment k   *
+ *      of the table runs from k*size/m up to (k+1)*size/m, and goes from     *
+ *      stop k at its first entry to stop k+1 at its last, with stop n being  *
+ *      stop 0. Each channel is rounded to nearest. A single stop that does   *
+ *      not wrap around fills the table with one color.                       *
+ *  Notes:                                                                    *
+ *      With six stops every segment has 256 entries and each channel steps   *
+ *      by exactly 1, so the rainbow wheel matches the original gradient at   *
+ *      every val that is not an integer.                                     *
+ ******************************************************************************/
+inline void
+cvp::palette::interpolate(const cvp::color *stops, unsigned int n, bool cyclic)
+{
+    /*  A single stop is a single segment from the stop to itself.            */
+    const unsigned int segments = (cyclic || n == 1U ? n : n - 1U);
+    unsigned int k, j;
+
+    for (k = 0U; k < segments; ++k)
+    {
+        /*  The ends of this segment, and the two stops it joins.             */
+        const unsigned int start = k * size / segments;
+        const unsigned int end = (k + 1U) * size / segments;
+        const cvp::color &a = stops[k];
+        const cvp::color &b = stops[(k + 1U == n ? 0U : k + 1U)];
+
+        /*  The last entry of the segment lands exactly on the next stop.     */
+        const double steps = (end - start > 1U ? end - start - 1U : 1U);
+
+        for (j = start; j < end; ++j)
+        {
+            const double t = static_cast<double>(j - start) / steps;
+            const double s = 1.0 - t;
+
+            colors[j].red = static_cast<unsigned char>(
+                s*a.red + t*b.red + 0.5
+            );
+
+            colors[j].green = static_cast<unsigned char>(
+                s*a.green + t*b.green + 0.5
+            );
+
+            colors[j].blue = static_cast<unsigned char>(
+                s*a.blue + t*b.blue + 0.5
+            );
+        }
+    }
+}
+/*  End of interpolate.                                                       */
+
+/*  Table lookup, truncating val. The comparisons compile to min and max      *
+ *  instructions, and the first one is false for NaN, so this is branch free. */
+inline cvp::color cvp::palette::at(double val) const
+{
+    const double top = static_cast<double>(size - 1U);
+    const double low = (val >= 0.0 ? val : 0.0);
+    const double clamped = (low < top ? low : top);
+    return colors[static_cast<unsigned int>(clamped)];
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      intensities                                                           *
+ *  Purpose:                                                                  *
+ *      Returns the table of intensities, built the first time it is used.    *
+ *  Outputs:                                                                  *
+ *      table (const unsigned int *):                                         *
+ *          shades + 1 entries, the intensity at u = k / shades times 2^16.   *
+ *  Method:                                                                   *
+ *      With u = 5r / (1 + 5r) we have 5r = u / (1 - u), so the intensity     *
+ *      atan(5r) / (pi / 2) is atan2(u, 1 - u) / (pi / 2). The derivative of  *
+ *      this in u is at most 4 / pi, so rounding u to the nearest entry moves *
+ *      a channel by under 255 / (2 * 4096) * 4 / pi, or about 0.04.          *
+ *  Notes:                                                                    *
+ *      The table is a function-local static, which C++11 initializes once in *
+ *      a thread-safe way, so palettes may be used from OpenMP loops.         *
+ ******************************************************************************/
+inline const unsigned int *cvp::palette::intensities(void)
+{
+    /*  Wrapped in a struct so the table is filled by a constructor.          */
+    struct table {
+        unsigned int data[shades + 1U];
+
+        table(void)
+        {
+            const double scale = 65536.0 / (0.5 * M_PI);
+            unsigned int k;
+
+            for (k = 0U; k <= shades; ++k)
+            {
+                const double u = static_cast<double>(k) / shades;
+                const double t = std::atan2(u, 1.0 - u) * scale;
+                data[k] = static_cast<unsigned int>(t + 0.5);
+            }
+        }
+    };
+
+    static const table intensity_table;
+    return intensity_table.data;
+}
+/*  End of intensities.                                                       */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      locate                                                                *
+ *  Purpose:                                                                  *
+ *      Computes where a complex number falls in the tables of the palette.   *
+ *  Arguments:                                                                *
+ *      x (double):                                                           *
+ *          The real part of the number.                                      *
+ *      y (double):                                                           *
+ *          The imaginary part of the number.                                 *
+ *      hue (int *):                                                          *
+ *          The index into the colors is stored here.                         *
+ *      shade (int *):                                                        *
+ *          The index into the table of intensities is stored here.           *
+ *  Method:                                                                   *
+ *      The argument is scaled from [-pi, pi] to [0, size - 1] and truncated, *
+ *      as in color_wheel_from_complex. The modulus is mapped to              *
+ *      u = 1 - 1 / (1 + 5|z|) in [0, 1] and rounded to the nearest of the    *
+ *      intensities. Both indices are clamped with selects, and the argument  *
+ *      is found with cvp::math::atan2, so loops over this are vectorized.    *
+ *  Notes:                                                                    *
+ *      Infinite moduli give u = 1, and NaN is clamped to the first entry.    *
+ ******************************************************************************/
+CVP_MATH_INLINE void
+cvp::palette::locate(double x, double y, int *hue, int *shade)
+{
+    /*  Factors for the hue and for the intensity indices.                    */
+    const double gradient_factor = (size - 1U) / (2.0 * M_PI);
+    const double hue_top = static_cast<double>(size - 1U);
+    const double shade_top = static_cast<double>(shades);
+
+    /*  The unclamped indices. u is rounded to nearest by adding 1/2.         */
+    const double val = (cvp::math::atan2(y, x) + M_PI) * gradient_factor;
+    const double abs_z = std::sqrt(x*x + y*y);
+    const double u = (1.0 - 1.0 / (1.0 + 5.0*abs_z)) * shade_top + 0.5;
+
+    /*  The comparisons are false for NaN, which is sent to zero.             */
+    const double val_low = (val >= 0.0 ? val : 0.0);
+    const double u_low = (u >= 0.0 ? u : 0.0);
+
+    *hue = static_cast<int>(val_low < hue_top ? val_low : hue_top);
+    *shade = static_cast<int>(u_low < shade_top ? u_low : shade_top);
+}
+/*  End of locate.                                                            */
+
+/*  Scales by the intensity, which is at most 2^16, with integer arithmetic.  */
+inline cvp::color cvp::palette::scale(const cvp::color &c, unsigned int q)
+{
+    return cvp::color(static_cast<unsigned char>((c.red * q) >> 16),
+                      static_cast<unsigned char>((c.green * q) >> 16),
+                      static_cast<unsigned char>((c.blue * q) >> 16));
+}
+
+/*  Colors a complex number with two lookups. This agrees with the exact      *
+ *  formula t * c, with t = atan(5|z|) / (pi / 2), to within one level in     *
+ *  each channel, the difference coming from rounding the intensity.          */
+inline cvp::color cvp::palette::operator () (cvp::complex z) const
+{
+    int hue, shade;
+    locate(z.real, z.imag, &hue, &shade);
+    return scale(colors[hue], intensities()[shade]);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      row                                                                   *
+ *  Purpose:                                                                  *
+ *      Colors a row of complex numbers stored as arrays of their real and    *
+ *      imaginary parts.                                                      *
+ *  Arguments:                                                                *
+ *      re (const double *):                                                  *
+ *          The real parts of the numbers.                                    *
+ *      im (const double *):                                                  *
+ *          The imaginary parts of the numbers.                               *
+ *      n (unsigned int):                                                     *
+ *          The number of points.                                             *
+ *      out (cvp::color *):                                                   *
+ *          The colors are written here, packed RGB bytes.                    *
+ *  Method:                                                                   *
+ *      The row is done in blocks. For each block the indices of every point  *
+ *      are found first, in a loop that is vectorized, and the colors are     *
+ *      then gathered from the tables and scaled.                             *
+ *  Notes:                                                                    *
+ *      The colors are the same as those from operator ().                    *
+ ******************************************************************************/
+inline void cvp::palette::row(const double *re, const double *im,
+                              unsigned int n, cvp::color *out) const
+{
+    /*  The indices of a block are kept on the stack.                         */
+    const unsigned int block = 256U;
+    const unsigned int *levels = intensities();
+    int hue[block], shade[block];
+    unsigned int start, k;
+
+    for (start = 0U; start < n; start += block)
+    {
+        const unsigned int m = (n - start < block ? n - start : block);
+
+        for (k = 0U; k < m; ++k)
+            locate(re[start + k], im[start + k], hue + k, shade + k);
+
+        for (k = 0U; k < m; ++k)
+            out[start + k] = scale(colors[hue[k]], levels[shade[k]]);
+    }
+}
+/*  End of row.                                                               */
+
+/*  The rainbow wheel, built once the first time it is used.                  */
+inline const cvp::palette &cvp::palettes::wheel(void)
+{
+    static const cvp::palette wheel_palette;
+    return wheel_palette;
+}
+
+/*  The rainbow from blue to red, used by color_from_complex. It does not     *
+ *  wrap around, so the two ends of the argument, -pi and pi, have different  *
+ *  colors.                                                                   */
+inline const cvp::palette &cvp::palettes::rainbow(void)
+{
+    static const cvp::color stops[5] = {
+        cvp::color(0x00U, 0x00U, 0xFFU),
+        cvp::color(0x00U, 0xFFU, 0xFFU),
+        cvp::color(0x00U, 0xFFU, 0x00U),
+        cvp::color(0xFFU, 0xFFU, 0x00U),
+        cvp::color(0xFFU, 0x00U, 0x00U)
+    };
+
+    static const cvp::palette rainbow_palette(stops, 5U, false);
+    return rainbow_palette;
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,283 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a pipelined renderer that streams bands of rows to a file    *
+ *      while holding a bounded number of them in memory.                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_PIPELINE_HPP
+#define CVP_PIPELINE_HPP
+
+/*  size_t found here.                                                        */
+#include <cstddef>
+
+/*  Placement new found here.                                                 */
+#include <new>
+
+/*  Lock-free atomic integers for the band states.                            */
+#include <atomic>
+
+/*  std::this_thread::yield, used while waiting on other threads.             */
+#include <thread>
+
+/*  omp_get_thread_num and friends, if OpenMP is enabled.                     */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Class for creating and writing to PPM files.                              */
+#include "cvp_ppm.hpp"
+
+/*  Options for the rendering routines.                                       */
+#include "cvp_options.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  A slot of the reorder buffer. Padded to avoid false sharing.          */
+    class band_slot {
+        public:
+            /*  Slot s holds bands s, s + K, s + 2K, ..., where K is the      *
+             *  number of slots. state = 2r means the slot is free for band   *
+             *  s + rK, and state = 2r + 1 means that band is ready to write. */
+            std::atomic<unsigned int> state;
+
+            /*  Padding so neighboring slots live on separate cache lines.    */
+            char padding[cvp::memory::cache_line - sizeof(state)];
+
+            /*  Constructor, the slot starts free for band s.                 */
+            band_slot(void);
+
+            /*  Spins until the slot reaches the requested state.             */
+            inline void wait(unsigned int value) const;
+    };
+
+    /*  Renders an image by streaming bands of rows to a file.                */
+    template <typename Tkernel, typename Timage>
+    inline void
+    render_pipelined(const Tkernel &kernel, unsigned int xsize,
+                     unsigned int ysize, Timage &image,
+                     const cvp::render_options &opts);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor, the slot starts free for its first band.                     */
+cvp::band_slot::band_slot(void)
+{
+    state.store(0U);
+}
+
+/*  Spins until the slot reaches the requested state.                         */
+inline void cvp::band_slot::wait(unsigned int value) const
+{
+    while (state.load(std::memory_order_acquire) != value)
+        std::this_thread::yield();
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_pipelined                                                 *
+ *  Purpose:                                                                  *
+ *      Renders an image by streaming bands of rows to a file.                *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      xsize (unsigned int):                                                 *
+ *          The number of pixels in the x axis.                               *
+ *      ysize (unsigned int):                                                 *
+ *          The number of pixels in the y axis.                               *
+ *      image (Timage &):                                                     *
+ *          An initialized image file of any format, like a cvp::ppm.         *
+ *      opts (const cvp::render_options &):                                   *
+ *          The band height and the maximum number of bands in flight.        *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The image is split into bands of rows. Worker threads claim bands in  *
+ *      increasing order from an atomic counter and compute them into a       *
+ *      ring of K slots, band b going to slot b mod K. A single writer        *
+ *      thread releases the bands to the file in order, freeing each slot     *
+ *      for band b + K once written. A worker whose slot is still occupied    *
+ *      waits, so at most K bands are ever held in memory. Workers may run    *
+ *      ahead of the writer by up to K bands, so slow bands (say, those       *
+ *      through the Mandelbrot set) do not stall the threads behind them.     *
+ *  Notes:                                                                    *
+ *      With a single thread, or without OpenMP, each band is computed and    *
+ *      then written immediately.                                             *
+ ******************************************************************************/
+template <typename Tkernel, typename Timage>
+inline void
+cvp::render_pipelined(const Tkernel &kernel, unsigned int xsize,
+                      unsigned int ysize, Timage &image,
+                      const cvp::render_options &opts)
+{
+    /*  Number of rows per band, and the total number of bands.               */
+    const unsigned int height = (opts.band_height ? opts.band_height : 1U);
+    const unsigned int bands = (ysize + height - 1U) / height;
+
+    /*  Number of colors in a band, padded so each starts on a cache line.    */
+    const std::size_t band_bytes = sizeof(cvp::color) * xsize * height;
+    const std::size_t stride = cvp::memory::round_up(band_bytes);
+
+#ifdef _OPENMP
+    const unsigned int threads =
+        static_cast<unsigned int>(omp_get_max_threads());
+#else
+    const unsigned int threads = 1U;
+#endif
+
+    /*  The number of slots in the ring. Zero means twice the thread count.   */
+    unsigned int slots = (opts.max_bands ? opts.max_bands : 2U * threads);
+
+    /*  Next band to be claimed by a worker.                                  */
+    std::atomic<unsigned int> next;
+
+    /*  The ring buffer of bands and their states.                            */
+    unsigned char *data;
+    cvp::band_slot *ring;
+
+    /*  Variables for indexing over the bands and the pixels.                 */
+    unsigned int n;
+
+    /*  Never hold more slots than there are bands.                           */
+    if (slots > bands)
+        slots = bands;
+
+    if (slots == 0U)
+        return;
+
+    data = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(stride * slots)
+    );
+
+    ring = static_cast<cvp::band_slot *>(
+        cvp::memory::aligned_malloc(sizeof(*ring) * slots)
+    );
+
+    /*  Check if malloc failed.                                               */
+    if (!data || !ring)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        cvp::memory::aligned_free(data);
+        cvp::memory::aligned_free(ring);
+        return;
+    }
+
+    for (n = 0U; n < slots; ++n)
+        new (ring + n) cvp::band_slot();
+
+    next.store(0U);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads)
+#endif
+    {
+#ifdef _OPENMP
+        const unsigned int id = static_cast<unsigned int>(omp_get_thread_num());
+        const unsigned int team =
+            static_cast<unsigned int>(omp_get_num_threads());
+#else
+        const unsigned int id = 0U;
+        const unsigned int team = 1U;
+#endif
+
+        /*  Indices for the bands and the rows.                               */
+        unsigned int band, row;
+
+        /*  Thread 0 is the writer. It computes bands too if it's alone.      */
+        if (id == 0U)
+        {
+            for (band = 0U; band < bands; ++band)
+            {
+                const unsigned int slot = band % slots;
+                const unsigned int round = band / slots;
+                const unsigned int y = band * height;
+                const unsigned int left = ysize - y;
+                const unsigned int rows = (left < height ? left : height);
+
+                /*  The colors of this band in the ring buffer.               */
+                cvp::color * const out =
+                    reinterpret_cast<cvp::color *>(data + stride*slot);
+
+                /*  No workers, compute the band here.                        */
+                if (team == 1U)
+                {
+                    for (row = 0U; row < rows; ++row)
+                        kernel(0U, y + row, xsize, out + row*xsize);
+                }
+
+                /*  Otherwise wait for the worker to finish this band.        */
+                else
+                    ring[slot].wait(2U*round + 1U);
+
+                /*  Release the band to the file, in order.                   */
+                image.write_rows(out, xsize, rows);
+
+                /*  Free the slot for band + slots.                           */
+                ring[slot].state.store(2U*round + 2U,
+                                       std::memory_order_release);
+            }
+        }
+
+        /*  Workers claim bands until they run out.                           */
+        else
+        {
+            while ((band = next.fetch_add(1U)) < bands)
+            {
+                const unsigned int slot = band % slots;
+                const unsigned int round = band / slots;
+                const unsigned int y = band * height;
+                const unsigned int left = ysize - y;
+                const unsigned int rows = (left < height ? left : height);
+
+                cvp::color * const out =
+                    reinterpret_cast<cvp::color *>(data + stride*slot);
+
+                /*  Wait for the writer to release band - slots.              */
+                ring[slot].wait(2U*round);
+
+                for (row = 0U; row < rows; ++row)
+                    kernel(0U, y + row, xsize, out + row*xsize);
+
+                /*  Hand the finished band to the writer.                     */
+                ring[slot].state.store(2U*round + 1U,
+                                       std::memory_order_release);
+            }
+        }
+    }
+
+    cvp::memory::aligned_free(ring);
+    cvp::memory::aligned_free(data);
+}
+/*  End of cvp::render_pipelined.                                             */
+
+#endif
+/*  End of include guard.                                                     */
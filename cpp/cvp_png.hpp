@@ -0,0 +1,852 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a class for writing PNG files. Rows are streamed in like a   *
+ *      PPM, and are filtered and compressed in chunks by the tile engine.    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_PNG_HPP
+#define CVP_PNG_HPP
+
+/*  FILE data type found here.                                                */
+#include <cstdio>
+
+/*  size_t, memcpy, and memmove found here.                                   */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, for the checksums.                               */
+#include <cstdint>
+
+/*  omp_get_max_threads, if OpenMP is enabled.                                */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Low-level block writes found here.                                        */
+#include "cvp_io.hpp"
+
+/*  Basic constants for the setup of the experiments given here.              */
+#include "cvp_setup.hpp"
+
+/*  Tile engine, which compresses the chunks in parallel.                     */
+#include "cvp_tiles.hpp"
+
+/*  The deflate compressor and the Adler-32 checksum.                         */
+#include "cvp_deflate.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The number of bytes of filtered rows compressed as one chunk, the     *
+     *  same as the blocks of pigz. Chunks hold whole rows, so a chunk may be *
+     *  a little smaller, or larger if a single row is.                       */
+    static const std::size_t png_chunk_bytes = 131072U;
+
+    /*  Class for writing PNG files. The file is an 8-bit RGB image. Rows go  *
+     *  through a PNG filter and then deflate, one chunk of rows at a time.   *
+     *  Each chunk is primed with the 32 kB of the stream before it and ends  *
+     *  on a byte, so the chunks of a batch are compressed in parallel and    *
+     *  written in order, each as its own IDAT chunk of the file.             */
+    class png {
+        public:
+            /*  The file, NULL if it could not be opened.                     */
+            FILE *fp;
+
+            /*  The number of pixels in the x and y axes, set by init.        */
+            unsigned int width, height;
+
+            /*  The deflate level, 0 to 9.                                    */
+            unsigned int level;
+
+            /*  The bytes in a row of pixels, the rows in a chunk, and the    *
+             *  rows and chunks in a batch.                                   */
+            std::size_t row_bytes;
+            unsigned int chunk_rows, batch_rows, batch_chunks;
+
+            /*  The pixels of the batch, after the last row of the batch      *
+             *  before (zeros at first), and the number of bytes received.    */
+            unsigned char *raw;
+            std::size_t size;
+
+            /*  The filtered rows of the batch, after window_size bytes of    *
+             *  which the last history are the stream that came before.       */
+            unsigned char *stream;
+            std::size_t history;
+
+            /*  Rows compressed so far, and the Adler-32 of the stream.       */
+            unsigned int rows_done;
+            std::uint32_t adler;
+
+            /*  For each chunk of a batch, the whole IDAT chunk of the file,  *
+             *  the bytes of it so far, and the checksums of the stream and   *
+             *  of the IDAT chunk so far.                                     */
+            unsigned char **chunk_data;
+            std::size_t *chunk_size;
+            std::uint32_t *chunk_adler, *chunk_crc;
+
+            /*  Set when malloc fails, after which nothing more is written.   */
+            bool failed;
+
+            /*  Constructor from a name, compressing with the default level.  */
+            png(const char *name);
+
+            /*  Constructor from a name and the deflate level.                */
+            png(const char *name, unsigned int compression_level);
+
+            /*  Method for initializing the PNG with the size of the image.   */
+            inline void init(unsigned int x, unsigned int y);
+
+            /*  Method for initializing the PNG using the values in "setup".  */
+            inline void init(void);
+
+            /*  Method for initializing the PNG using the size of a viewport. */
+            template <typename Tview>
+            inline void init(const Tview &view);
+
+            /*  Appends a block of packed RGB bytes to the image.             */
+            inline void write(const void *data, std::size_t bytes);
+
+            /*  Appends an entire row (or several rows) of packed RGB pixels. */
+            inline void write_row(const void *rgb, unsigned int width);
+            inline void write_rows(const void *rgb, unsigned int width,
+                                   unsigned int rows);
+
+            /*  A PNG is compressed, so it cannot be mapped. Returns false.   */
+            inline bool map(void);
+
+            /*  There are no mapped pixels, returns NULL.                     */
+            inline unsigned char *pixel(unsigned int x, unsigned int y) const;
+
+            /*  Writes the end of the file and closes it.                     */
+            inline void close(void);
+
+            /*  Filters the rows of the n^th chunk of the batch.              */
+            inline void filter_chunk(unsigned int n);
+
+            /*  Compresses the n^th chunk of the batch into an IDAT chunk.    */
+            inline void compress_chunk(unsigned int n);
+
+            /*  Updates a CRC-32 with n more bytes. Start from 0.             */
+            static inline std::uint32_t
+            crc32(std::uint32_t crc, const unsigned char *data, std::size_t n);
+
+            /*  Stores a 32-bit integer in big endian order, as PNG wants.    */
+            static inline void put32(unsigned char *out, std::uint32_t x);
+
+            /*  Filters a row against the row above it. Level 0 does not      *
+             *  filter, the others pick a filter for each row.                */
+            static inline void
+            filter_row(const unsigned char *above, const unsigned char *row,
+                       std::size_t n, unsigned int level, unsigned char *out);
+
+        private:
+            /*  Filters, compresses, and writes the rows received so far.     */
+            inline void write_batch(void);
+
+            /*  Writes a small chunk of the file, like IHDR or IEND.          */
+            inline void write_chunk(const char *type,
+                                    const unsigned char *data,
+                                    std::uint32_t n);
+    };
+
+    /*  Job for the tile engine, filters a chunk of a batch of a PNG.         */
+    class png_filter_job {
+        public:
+            cvp::png &PNG;
+
+            /*  Constructor from the PNG.                                     */
+            png_filter_job(cvp::png &P);
+
+            /*  Filters the rows of the n^th chunk.                           */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Job for the tile engine, compresses a chunk of a batch of a PNG.      */
+    class png_compress_job {
+        public:
+            cvp::png &PNG;
+
+            /*  Constructor from the PNG.                                     */
+            png_compress_job(cvp::png &P);
+
+            /*  Compresses the n^th chunk.                                    */
+            inline void operator () (unsigned int n);
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from a name, using the default level.                         */
+cvp::png::png(const char *name) : png(name, cvp::deflate::default_level)
+{
+    return;
+}
+
+/*  Constructor from a name and a level. The buffers are made by init, once   *
+ *  the size of the image is known.                                           */
+cvp::png::png(const char *name, unsigned int compression_level)
+{
+    fp = std::fopen(name, "wb");
+    width = height = 0U;
+    level = (compression_level < cvp::deflate::max_level ?
+             compression_level : cvp::deflate::max_level);
+
+    row_bytes = 0U;
+    chunk_rows = batch_rows = batch_chunks = 0U;
+    raw = stream = NULL;
+    size = history = 0U;
+    rows_done = 0U;
+    adler = 1U;
+    chunk_data = NULL;
+    chunk_size = NULL;
+    chunk_adler = chunk_crc = NULL;
+    failed = false;
+
+    /*  Warn the caller if fopen failed.                                      */
+    if (!fp)
+        std::puts("ERROR: fopen failed and returned NULL.");
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::png::init                                                        *
+ *  Purpose:                                                                  *
+ *      Writes the start of a PNG file and makes room for a batch of rows.    *
+ *  Arguments:                                                                *
+ *      x (unsigned int):                                                     *
+ *          The number of pixels in the x axis.                               *
+ *      y (unsigned int):                                                     *
+ *          The number of pixels in the y axis.                               *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      A batch is two chunks for every thread, so that the tile engine can   *
+ *      balance the chunks that compress slowly. At most one batch of rows,   *
+ *      filtered and not, and its compressed chunks are held in memory.       *
+ ******************************************************************************/
+inline void cvp::png::init(unsigned int x, unsigned int y)
+{
+    /*  The PNG signature, and the header with the size, 8 bits per channel,  *
+     *  the RGB color type, and no interlacing.                               */
+    const unsigned char signature[8] = {
+        0x89U, 'P', 'N', 'G', '\r', '\n', 0x1AU, '\n'
+    };
+
+    unsigned char header[13];
+
+    /*  Bytes needed for a compressed chunk, and an index for the chunks.     */
+    std::size_t bound;
+    unsigned int n;
+
+#ifdef _OPENMP
+    const unsigned int threads =
+        static_cast<unsigned int>(omp_get_max_threads());
+#else
+    const unsigned int threads = 1U;
+#endif
+
+    width = x;
+    height = y;
+
+    if (!fp)
+        return;
+
+    row_bytes = 3U * static_cast<std::size_t>(width);
+    chunk_rows = static_cast<unsigned int>(
+        cvp::png_chunk_bytes / (row_bytes + 1U)
+    );
+
+    if (chunk_rows == 0U)
+        chunk_rows = 1U;
+
+    batch_chunks = (threads > 1U ? 2U * threads : 1U);
+    batch_rows = batch_chunks * chunk_rows;
+
+    /*  Small images need fewer chunks.                                       */
+    if (batch_rows > height)
+    {
+        batch_chunks = (height + chunk_rows - 1U) / chunk_rows;
+        batch_rows = batch_chunks * chunk_rows;
+    }
+
+    if (batch_chunks == 0U)
+        batch_chunks = 1U;
+
+    bound = 8U + 2U + cvp::deflate::bound(chunk_rows * (row_bytes + 1U)) + 8U;
+
+    raw = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(row_bytes * (batch_rows + 1U) + 1U)
+    );
+
+    stream = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(
+            cvp::deflate::window_size + (row_bytes + 1U) * batch_rows
+        )
+    );
+
+    chunk_data = static_cast<unsigned char **>(
+        cvp::memory::aligned_malloc(sizeof(*chunk_data) * batch_chunks)
+    );
+
+    chunk_size = static_cast<std::size_t *>(
+        cvp::memory::aligned_malloc(sizeof(*chunk_size) * batch_chunks)
+    );
+
+    chunk_adler = static_cast<std::uint32_t *>(
+        cvp::memory::aligned_malloc(sizeof(*chunk_adler) * batch_chunks)
+    );
+
+    chunk_crc = static_cast<std::uint32_t *>(
+        cvp::memory::aligned_malloc(sizeof(*chunk_crc) * batch_chunks)
+    );
+
+    if (!raw || !stream || !chunk_data || !chunk_size ||
+        !chunk_adler || !chunk_crc)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        failed = true;
+        return;
+    }
+
+    for (n = 0U; n < batch_chunks; ++n)
+        chunk_data[n] = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(bound)
+        );
+
+    for (n = 0U; n < batch_chunks; ++n)
+    {
+        if (!chunk_data[n])
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            failed = true;
+            return;
+        }
+    }
+
+    /*  The row above the first row is taken to be zero.                      */
+    std::memset(raw, 0, row_bytes);
+
+    cvp::png::put32(header, width);
+    cvp::png::put32(header + 4U, height);
+    header[8] = 8U;
+    header[9] = 2U;
+    header[10] = header[11] = header[12] = 0U;
+
+    if (!cvp::io::write_all(fp, signature, sizeof(signature)))
+        std::puts("ERROR: write failed.");
+
+    write_chunk("IHDR", header, sizeof(header));
+}
+/*  End of cvp::png::init.                                                    */
+
+/*  Initialize using the values in "setup".                                   */
+inline void cvp::png::init(void)
+{
+    init(cvp::setup::xsize, cvp::setup::ysize);
+}
+
+/*  Initialize using the resolution of a viewport.                            */
+template <typename Tview>
+inline void cvp::png::init(const Tview &view)
+{
+    init(view.xsize, view.ysize);
+}
+
+/*  Copies the bytes into the batch, writing it out each time it fills up.    *
+ *  The last batch of the image is cut short at the last row.                 */
+inline void cvp::png::write(const void *data, std::size_t bytes)
+{
+    const unsigned char *in = static_cast<const unsigned char *>(data);
+
+    while (bytes > 0U && !failed)
+    {
+        const unsigned int left = height - rows_done;
+        const std::size_t rows = (left < batch_rows ? left : batch_rows);
+        const std::size_t room = rows * row_bytes - size;
+        const std::size_t piece = (bytes < room ? bytes : room);
+
+        if (room == 0U)
+        {
+            std::puts("ERROR: More pixels than fit in the PNG.");
+            failed = true;
+            return;
+        }
+
+        std::memcpy(raw + row_bytes + size, in, piece);
+        size += piece;
+        in += piece;
+        bytes -= piece;
+
+        if (size == rows * row_bytes)
+            write_batch();
+    }
+}
+
+/*  Appends a row of packed RGB pixels.                                       */
+inline void cvp::png::write_row(const void *rgb, unsigned int width)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width));
+}
+
+/*  Appends several consecutive rows of packed RGB pixels.                    */
+inline void cvp::png::write_rows(const void *rgb, unsigned int width,
+                                 unsigned int rows)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width) * rows);
+}
+
+/*  The pixels of a PNG are compressed, there is nothing to map.              */
+inline bool cvp::png::map(void)
+{
+    return false;
+}
+
+/*  Never called, since map always fails.                                     */
+inline unsigned char *cvp::png::pixel(unsigned int x, unsigned int y) const
+{
+    (void)x;
+    (void)y;
+    return NULL;
+}
+
+/*  Writes the end of the file, frees the buffers, and closes the file.       */
+inline void cvp::png::close(void)
+{
+    unsigned int n;
+
+    if (!fp)
+        return;
+
+    if (!failed && rows_done != height)
+        std::puts("ERROR: The PNG is missing rows.");
+
+    write_chunk("IEND", NULL, 0U);
+
+    if (chunk_data)
+    {
+        for (n = 0U; n < batch_chunks; ++n)
+            cvp::memory::aligned_free(chunk_data[n]);
+    }
+
+    cvp::memory::aligned_free(raw);
+    cvp::memory::aligned_free(stream);
+    cvp::memory::aligned_free(chunk_data);
+    cvp::memory::aligned_free(chunk_size);
+    cvp::memory::aligned_free(chunk_adler);
+    cvp::memory::aligned_free(chunk_crc);
+    raw = stream = NULL;
+    chunk_data = NULL;
+    chunk_size = NULL;
+    chunk_adler = chunk_crc = NULL;
+
+    std::fclose(fp);
+    fp = NULL;
+}
+
+/*  The Paeth predictor of the PNG specification.                             */
+static inline unsigned int
+cvp_png_paeth(unsigned int a, unsigned int b, unsigned int c)
+{
+    const int p = static_cast<int>(a + b) - static_cast<int>(c);
+    const int pa = (p > static_cast<int>(a) ? p - static_cast<int>(a) :
+                                              static_cast<int>(a) - p);
+    const int pb = (p > static_cast<int>(b) ? p - static_cast<int>(b) :
+                                              static_cast<int>(b) - p);
+    const int pc = (p > static_cast<int>(c) ? p - static_cast<int>(c) :
+                                              static_cast<int>(c) - p);
+
+    if (pa <= pb && pa <= pc)
+        return a;
+
+    return (pb <= pc ? b : c);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::png::filter_row                                                  *
+ *  Purpose:                                                                  *
+ *      Filters a row of a PNG so that it compresses better.                  *
+ *  Arguments:                                                                *
+ *      above (const unsigned char *):                                        *
+ *          The row above, zeros for the first row.                           *
+ *      row (const unsigned char *):                                          *
+ *          The row to filter.                                                *
+ *      n (std::size_t):                                                      *
+ *          The number of bytes in a row.                                     *
+ *      level (unsigned int):                                                 *
+ *          The deflate level. Level 0 leaves the row as it is.               *
+ *      out (unsigned char *):                                                *
+ *          n + 1 bytes for the filter type and the filtered row.             *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Each byte is predicted from the byte to the left (a), above (b), and  *
+ *      above and to the left (c), in five ways: not at all, a, b, the mean   *
+ *      of a and b, and the Paeth predictor. Use the one whose differences,   *
+ *      as signed bytes, have the smallest sum of absolute values. This is    *
+ *      the heuristic the PNG specification suggests, and libpng uses.        *
+ ******************************************************************************/
+inline void
+cvp::png::filter_row(const unsigned char *above, const unsigned char *row,
+                     std::size_t n, unsigned int level, unsigned char *out)
+{
+    /*  The sum of absolute differences for each filter.                      */
+    unsigned long sums[5] = {0UL, 0UL, 0UL, 0UL, 0UL};
+    unsigned int best = 0U, filter;
+    std::size_t k;
+
+    if (level == cvp::deflate::stored_level)
+    {
+        out[0] = 0U;
+        std::memcpy(out + 1U, row, n);
+        return;
+    }
+
+    for (k = 0U; k < n; ++k)
+    {
+        const unsigned int x = row[k];
+        const unsigned int a = (k >= 3U ? row[k - 3U] : 0U);
+        const unsigned int b = above[k];
+        const unsigned int c = (k >= 3U ? above[k - 3U] : 0U);
+
+        const unsigned char d[5] = {
+            static_cast<unsigned char>(x),
+            static_cast<unsigned char>(x - a),
+            static_cast<unsigned char>(x - b),
+            static_cast<unsigned char>(x - ((a + b) >> 1)),
+            static_cast<unsigned char>(x - cvp_png_paeth(a, b, c))
+        };
+
+        for (filter = 0U; filter < 5U; ++filter)
+            sums[filter] += (d[filter] < 128U ? d[filter] : 256U - d[filter]);
+    }
+
+    for (filter = 1U; filter < 5U; ++filter)
+    {
+        if (sums[filter] < sums[best])
+            best = filter;
+    }
+
+    out[0] = static_cast<unsigned char>(best);
+    ++out;
+
+    for (k = 0U; k < n; ++k)
+    {
+        const unsigned int x = row[k];
+        const unsigned int a = (k >= 3U ? row[k - 3U] : 0U);
+        const unsigned int b = above[k];
+        const unsigned int c = (k >= 3U ? above[k - 3U] : 0U);
+        unsigned int prediction;
+
+        if (best == 0U)
+            prediction = 0U;
+        else if (best == 1U)
+            prediction = a;
+        else if (best == 2U)
+            prediction = b;
+        else if (best == 3U)
+            prediction = (a + b) >> 1;
+        else
+            prediction = cvp_png_paeth(a, b, c);
+
+        out[k] = static_cast<unsigned char>(x - prediction);
+    }
+}
+/*  End of cvp::png::filter_row.                                              */
+
+/*  Filters each row of the chunk against the one above it, which is in the   *
+ *  batch or is the saved last row of the batch before, and sums the result.  */
+inline void cvp::png::filter_chunk(unsigned int n)
+{
+    const unsigned int rows = static_cast<unsigned int>(size / row_bytes);
+    const unsigned int first = n * chunk_rows;
+    const unsigned int last = (first + chunk_rows < rows ?
+                               first + chunk_rows : rows);
+
+    unsigned char * const start = stream + cvp::deflate::window_size +
+                                  first * (row_bytes + 1U);
+    unsigned int row;
+
+    for (row = first; row < last; ++row)
+        cvp::png::filter_row(
+            raw + row * row_bytes, raw + (row + 1U) * row_bytes, row_bytes,
+            level, start + (row - first) * (row_bytes + 1U)
+        );
+
+    chunk_adler[n] = cvp::deflate::adler32(
+        1U, start, (last - first) * (row_bytes + 1U)
+    );
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::png::compress_chunk                                              *
+ *  Purpose:                                                                  *
+ *      Compresses a chunk of filtered rows into an IDAT chunk of the file.   *
+ *  Arguments:                                                                *
+ *      n (unsigned int):                                                     *
+ *          The index of the chunk in the batch.                              *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The chunk is compressed with the filtered bytes before it, up to 32   *
+ *      kB of them, as history. The first chunk of the file starts with the   *
+ *      zlib header. The last one ends with a final block. The Adler-32 of    *
+ *      the whole stream, which follows it, is added by write_batch. Leave    *
+ *      room for the length, and compute the CRC of everything but the        *
+ *      length and that checksum.                                             *
+ ******************************************************************************/
+inline void cvp::png::compress_chunk(unsigned int n)
+{
+    const unsigned int rows = static_cast<unsigned int>(size / row_bytes);
+    const unsigned int first = n * chunk_rows;
+    const unsigned int last = (first + chunk_rows < rows ?
+                               first + chunk_rows : rows);
+
+    /*  Where the chunk starts in the stream buffer, and the bytes of it.     */
+    const std::size_t offset = first * (row_bytes + 1U);
+    const std::size_t bytes = (last - first) * (row_bytes + 1U);
+
+    /*  The history before the chunk, at most a window of it.                 */
+    const std::size_t before = history + offset;
+    const std::size_t window = (before < cvp::deflate::window_size ?
+                                before : cvp::deflate::window_size);
+
+    const unsigned char *in =
+        stream + cvp::deflate::window_size + offset - window;
+
+    const bool first_chunk = (rows_done == 0U && n == 0U);
+    const bool last_chunk = (rows_done + last == height);
+
+    unsigned char * const out = chunk_data[n];
+    std::size_t used = 8U, written;
+
+    std::memcpy(out + 4U, "IDAT", 4U);
+
+    if (first_chunk)
+    {
+        out[8] = 0x78U;
+        out[9] = cvp::deflate::zlib_flags(level);
+        used += 2U;
+    }
+
+    written = cvp::deflate::compress(
+        in, window, window + bytes, level, last_chunk, out + used
+    );
+
+    chunk_size[n] = (written == 0U ? 0U : used + written);
+    chunk_crc[n] = cvp::png::crc32(0U, out + 4U, used + written - 4U);
+}
+/*  End of cvp::png::compress_chunk.                                          */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::png::write_batch                                                 *
+ *  Purpose:                                                                  *
+ *      Filters, compresses, and writes the rows received since the last      *
+ *      batch.                                                                *
+ *  Arguments:                                                                *
+ *      None.                                                                 *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Filter every chunk on the tile engine, then compress every chunk,     *
+ *      since a chunk is primed with the filtered chunks before it. Write     *
+ *      the chunks in order, combining their Adler-32 checksums, and keep     *
+ *      the last row and the last 32 kB of the stream for the next batch.     *
+ *  Notes:                                                                    *
+ *      When called from the pipelined renderer, which already runs on all    *
+ *      threads, the tile engine gets a single thread and the chunks are      *
+ *      compressed in turn.                                                   *
+ ******************************************************************************/
+inline void cvp::png::write_batch(void)
+{
+    const unsigned int rows = static_cast<unsigned int>(size / row_bytes);
+    const unsigned int chunks = (rows + chunk_rows - 1U) / chunk_rows;
+    const std::size_t bytes = rows * (row_bytes + 1U);
+
+    /*  The history kept for the next batch, and an index for the chunks.     */
+    const std::size_t total = history + bytes;
+    const std::size_t keep = (total < cvp::deflate::window_size ?
+                              total : cvp::deflate::window_size);
+    unsigned int n;
+
+    {
+        cvp::png_filter_job filter = cvp::png_filter_job(*this);
+        cvp::run_tiles(chunks, filter);
+    }
+
+    {
+        cvp::png_compress_job compress = cvp::png_compress_job(*this);
+        cvp::run_tiles(chunks, compress);
+    }
+
+    for (n = 0U; n < chunks; ++n)
+    {
+        const unsigned int first = n * chunk_rows;
+        const unsigned int last = (first + chunk_rows < rows ?
+                                   first + chunk_rows : rows);
+
+        unsigned char * const out = chunk_data[n];
+        std::size_t used = chunk_size[n];
+
+        if (used == 0U)
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            failed = true;
+            return;
+        }
+
+        adler = cvp::deflate::adler32_combine(
+            adler, chunk_adler[n], (last - first) * (row_bytes + 1U)
+        );
+
+        /*  The zlib stream ends with the checksum of everything in it.       */
+        if (rows_done + last == height)
+        {
+            cvp::png::put32(out + used, adler);
+            chunk_crc[n] = cvp::png::crc32(chunk_crc[n], out + used, 4U);
+            used += 4U;
+        }
+
+        cvp::png::put32(out, static_cast<std::uint32_t>(used - 8U));
+        cvp::png::put32(out + used, chunk_crc[n]);
+
+        if (!cvp::io::write_all(fp, out, used + 4U))
+            std::puts("ERROR: write failed.");
+    }
+
+    /*  The next batch is filtered against the last row of this one.          */
+    std::memcpy(raw, raw + rows * row_bytes, row_bytes);
+
+    std::memmove(
+        stream + cvp::deflate::window_size - keep,
+        stream + cvp::deflate::window_size + bytes - keep, keep
+    );
+
+    history = keep;
+    rows_done += rows;
+    size = 0U;
+}
+/*  End of cvp::png::write_batch.                                             */
+
+/*  A chunk is its length, its type, its data, and the CRC of the type and    *
+ *  the data.                                                                 */
+inline void cvp::png::write_chunk(const char *type, const unsigned char *data,
+                                  std::uint32_t n)
+{
+    unsigned char header[8], trailer[4];
+    std::uint32_t crc;
+
+    cvp::png::put32(header, n);
+    std::memcpy(header + 4U, type, 4U);
+
+    crc = cvp::png::crc32(0U, header + 4U, 4U);
+
+    if (n != 0U)
+        crc = cvp::png::crc32(crc, data, n);
+
+    cvp::png::put32(trailer, crc);
+
+    if (!cvp::io::write_all(fp, header, sizeof(header)) ||
+        (n != 0U && !cvp::io::write_all(fp, data, n)) ||
+        !cvp::io::write_all(fp, trailer, sizeof(trailer)))
+        std::puts("ERROR: write failed.");
+}
+
+/*  The CRC-32 of PNG and zlib, a byte at a time from a table. The table is   *
+ *  a function-local static, which C++11 initializes once in a thread-safe    *
+ *  way, so chunks may be checked from OpenMP loops.                          */
+inline std::uint32_t
+cvp::png::crc32(std::uint32_t crc, const unsigned char *data, std::size_t n)
+{
+    /*  Wrapped in a struct so the table is filled by a constructor.          */
+    struct table {
+        std::uint32_t data[256];
+
+        table(void)
+        {
+            unsigned int k, bit;
+
+            for (k = 0U; k < 256U; ++k)
+            {
+                std::uint32_t c = k;
+
+                for (bit = 0U; bit < 8U; ++bit)
+                    c = (c & 1U ? 0xEDB88320U ^ (c >> 1) : c >> 1);
+
+                data[k] = c;
+            }
+        }
+    };
+
+    static const table crc_table;
+    std::size_t k;
+
+    crc ^= 0xFFFFFFFFU;
+
+    for (k = 0U; k < n; ++k)
+        crc = crc_table.data[(crc ^ data[k]) & 0xFFU] ^ (crc >> 8);
+
+    return crc ^ 0xFFFFFFFFU;
+}
+
+/*  Most significant byte first.                                              */
+inline void cvp::png::put32(unsigned char *out, std::uint32_t x)
+{
+    out[0] = static_cast<unsigned char>(x >> 24);
+    out[1] = static_cast<unsigned char>(x >> 16);
+    out[2] = static_cast<unsigned char>(x >> 8);
+    out[3] = static_cast<unsigned char>(x);
+}
+
+/*  Constructor from the PNG.                                                 */
+cvp::png_filter_job::png_filter_job(cvp::png &P) : PNG(P)
+{
+    return;
+}
+
+/*  Filters the rows of the n^th chunk.                                       */
+inline void cvp::png_filter_job::operator () (unsigned int n)
+{
+    PNG.filter_chunk(n);
+}
+
+/*  Constructor from the PNG.                                                 */
+cvp::png_compress_job::png_compress_job(cvp::png &P) : PNG(P)
+{
+    return;
+}
+
+/*  Compresses the n^th chunk.                                                */
+inline void cvp::png_compress_job::operator () (unsigned int n)
+{
+    PNG.compress_chunk(n);
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,533 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides polynomials and rational functions whose coefficients are    *
+ *      fixed at compile time, and integer powers by repeated squaring.       *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_POLYNOMIAL_HPP
+#define CVP_POLYNOMIAL_HPP
+
+/*  std::true_type found here.                                                */
+#include <type_traits>
+
+/*  fma found here, and the FP_FAST_FMA macro.                                */
+#include <cmath>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, which the polynomials may also be called on.  */
+#include "cvp_batch.hpp"
+
+/*  The multibrot map of degree 2 gets the interior shortcuts of z^2.         */
+#include "cvp_quadratic.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The number of bits needed to write n in binary.                       */
+    constexpr unsigned int bit_width(unsigned int n)
+    {
+        return (n == 0U ? 0U : 1U + cvp::bit_width(n / 2U));
+    }
+
+    /*  The squares z, z^2, z^4, ..., z^(2^(K-1)). Any power of z up to       *
+     *  2^K - 1 is a product of these, one factor for each binary digit of    *
+     *  the exponent. A numerator and denominator share one chain.            */
+    template <typename T, unsigned int K>
+    class power_chain {
+        public:
+            /*  The k^th entry is z^(2^k).                                    */
+            T squares[K];
+
+            /*  Computes the squares of z by repeated squaring.               */
+            explicit power_chain(const T &z);
+
+            /*  Computes z^N from the squares, with N between 1 and 2^K - 1.  */
+            template <unsigned int N>
+            inline T power(void) const;
+    };
+
+    /*  The product of the squares selected by the binary digits of N,        *
+     *  starting from squares[J]. B is the lowest digit of N.                 */
+    template <unsigned int N, unsigned int J, unsigned int B = N % 2U>
+    class chain_product;
+
+    /*  The lowest digit is zero, move on to the next square.                 */
+    template <unsigned int N, unsigned int J>
+    class chain_product<N, J, 0U> {
+        public:
+            template <typename T>
+            static inline T eval(const T *squares)
+            {
+                return cvp::chain_product<N / 2U, J + 1U>::eval(squares);
+            }
+    };
+
+    /*  The lowest digit is one, this square is a factor.                     */
+    template <unsigned int N, unsigned int J>
+    class chain_product<N, J, 1U> {
+        public:
+            template <typename T>
+            static inline T eval(const T *squares)
+            {
+                return squares[J] *
+                       cvp::chain_product<N / 2U, J + 1U>::eval(squares);
+            }
+    };
+
+    /*  The last digit, this square is the final factor.                      */
+    template <unsigned int J>
+    class chain_product<1U, J, 1U> {
+        public:
+            template <typename T>
+            static inline T eval(const T *squares)
+            {
+                return squares[J];
+            }
+    };
+
+    /*  Computes z^N by repeated squaring. N must be at least one.            */
+    template <unsigned int N, typename T>
+    inline T ipow(const T &z);
+
+    /*  Computes p w + c, with a fused multiply-add when the hardware has     *
+     *  one. This is one step of Horner's method.                             */
+    template <typename T>
+    inline T horner_step(const T &p, const T &w, double c);
+
+    inline cvp::complex
+    horner_step(const cvp::complex &p, const cvp::complex &w, double c);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    horner_step(const cvp::complex_batch<N> &p,
+                const cvp::complex_batch<N> &w, double c);
+
+    /*  Computes a w + c for real a and c, with a fused multiply-add when the *
+     *  hardware has one. This is the first step of Horner's method.          */
+    template <typename T>
+    inline T horner_lead_step(const T &w, double a, double c);
+
+    inline cvp::complex
+    horner_lead_step(const cvp::complex &w, double a, double c);
+
+    template <unsigned int N>
+    inline cvp::complex_batch<N>
+    horner_lead_step(const cvp::complex_batch<N> &w, double a, double c);
+
+    /*  Horner's method after the leading coefficient. p is the value so far, *
+     *  G is the number of coefficients read since the last non-zero one, and *
+     *  C are the coefficients not read yet. Runs of zero coefficients become *
+     *  a single multiplication by a power of z.                              */
+    template <unsigned int G, int... C>
+    class horner_tail;
+
+    /*  All coefficients are read, multiply by the remaining power of z.      */
+    template <unsigned int G>
+    class horner_tail<G> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const T &p, const cvp::power_chain<T, K> &z)
+            {
+                return p * z.template power<G>();
+            }
+    };
+
+    /*  All coefficients are read and the last was non-zero.                  */
+    template <>
+    class horner_tail<0U> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const T &p, const cvp::power_chain<T, K> &)
+            {
+                return p;
+            }
+    };
+
+    /*  A zero coefficient adds nothing, only a power of z.                   */
+    template <unsigned int G, int... C>
+    class horner_tail<G, 0, C...> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const T &p, const cvp::power_chain<T, K> &z)
+            {
+                return cvp::horner_tail<G + 1U, C...>::eval(p, z);
+            }
+    };
+
+    /*  A non-zero coefficient is one step of Horner's method.                */
+    template <unsigned int G, int C0, int... C>
+    class horner_tail<G, C0, C...> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const T &p, const cvp::power_chain<T, K> &z)
+            {
+                const T w = z.template power<G + 1U>();
+                const T q = cvp::horner_step(p, w, static_cast<double>(C0));
+                return cvp::horner_tail<0U, C...>::eval(q, z);
+            }
+    };
+
+    /*  Horner's method up to the second non-zero coefficient. A is the       *
+     *  leading coefficient, which is real, so the first step scales a power  *
+     *  of z instead of multiplying two complex numbers.                      */
+    template <int A, unsigned int G, int... C>
+    class horner_lead;
+
+    /*  The polynomial is A z^G.                                              */
+    template <int A, unsigned int G>
+    class horner_lead<A, G> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const cvp::power_chain<T, K> &z)
+            {
+                const T w = z.template power<G>();
+                return (A == 1 ? w : w * static_cast<double>(A));
+            }
+    };
+
+    /*  The polynomial is the constant A.                                     */
+    template <int A>
+    class horner_lead<A, 0U> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const cvp::power_chain<T, K> &)
+            {
+                return T(cvp::complex(static_cast<double>(A), 0.0));
+            }
+    };
+
+    /*  A zero coefficient after the leading one, only a power of z.          */
+    template <int A, unsigned int G, int... C>
+    class horner_lead<A, G, 0, C...> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const cvp::power_chain<T, K> &z)
+            {
+                return cvp::horner_lead<A, G + 1U, C...>::eval(z);
+            }
+    };
+
+    /*  The second non-zero coefficient, A z^(G+1) + C0.                      */
+    template <int A, unsigned int G, int C0, int... C>
+    class horner_lead<A, G, C0, C...> {
+        public:
+            template <typename T, unsigned int K>
+            static inline T eval(const cvp::power_chain<T, K> &z)
+            {
+                const T w = z.template power<G + 1U>();
+                const double a = static_cast<double>(A);
+                const double c = static_cast<double>(C0);
+                const T p = (A == 1 ? w + c : cvp::horner_lead_step(w, a, c));
+                return cvp::horner_tail<0U, C...>::eval(p, z);
+            }
+    };
+
+    /*  Skips the leading zeros of a coefficient list.                        */
+    template <int... C>
+    class horner;
+
+    template <int... C>
+    class horner<0, C...> : public cvp::horner<C...> {};
+
+    template <int A, int... C>
+    class horner<A, C...> : public cvp::horner_lead<A, 0U, C...> {};
+
+    /*  The zero polynomial.                                                  */
+    template <>
+    class horner<0> : public cvp::horner_lead<0, 0U> {};
+
+    /*  Class for the polynomial with integer coefficients C, listed from the *
+     *  highest degree down to the constant. polynomial<1, 0, 0, -1> is       *
+     *  z^3 - 1. Rational coefficients may be had by scaling a numerator and  *
+     *  denominator of a cvp::rational by the same integer.                   */
+    template <int... C>
+    class polynomial {
+        public:
+            /*  The degree of the polynomial, counting leading zeros.         */
+            static const unsigned int degree = sizeof...(C) - 1U;
+
+            /*  The number of squares of z needed for the powers. A constant  *
+             *  still keeps z itself, so the chain is never empty.            */
+            static const unsigned int chain_length =
+                cvp::bit_width(degree | 1U);
+
+            /*  Evaluates the polynomial. T is cvp::basic_complex,            *
+             *  cvp::complex_batch, or cvp::dual, so the polynomial may be    *
+             *  passed to every plotting routine, and to cvp::newton_plot.    */
+            template <typename T>
+            inline T operator () (const T &z) const;
+
+            /*  Evaluates the polynomial from the squares of z, which may be  *
+             *  shared with another polynomial. K is at least chain_length.   */
+            template <typename T, unsigned int K>
+            static inline T eval(const cvp::power_chain<T, K> &z);
+    };
+
+    /*  Class for the rational function P / Q, where P and Q are              *
+     *  cvp::polynomial types. The Newton map of z^3 - 1 is                   *
+     *  rational<polynomial<2, 0, 0, 1>, polynomial<3, 0, 0>>.                */
+    template <typename P, typename Q>
+    class rational {
+        public:
+            /*  The number of squares of z needed by both polynomials.        */
+            static const unsigned int chain_length =
+                (P::chain_length > Q::chain_length ?
+                 P::chain_length : Q::chain_length);
+
+            /*  Evaluates P(z) / Q(z), with the powers of z computed once.    */
+            template <typename T>
+            inline T operator () (const T &z) const;
+    };
+
+    /*  The map z^N. Escape-time plots of it are plots of the multibrot set   *
+     *  of degree N, with c added by the plotting routine.                    */
+    template <unsigned int N>
+    class multibrot {
+        public:
+            /*  Computes z^N by repeated squaring.                            */
+            template <typename T>
+            inline T operator () (const T &z) const;
+    };
+
+    /*  z^2 is the quadratic map, and gets the same interior shortcuts.       */
+    template <>
+    class is_quadratic<cvp::multibrot<2U>> : public std::true_type {};
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  The first entry is z, and every other is the square of the one before.    */
+template <typename T, unsigned int K>
+cvp::power_chain<T, K>::power_chain(const T &z)
+{
+    unsigned int k;
+
+    squares[0] = z;
+
+    for (k = 1U; k < K; ++k)
+        squares[k] = squares[k - 1U] * squares[k - 1U];
+
+    return;
+}
+
+/*  The binary digits of N select the squares that multiply to z^N.           */
+template <typename T, unsigned int K>
+template <unsigned int N>
+inline T cvp::power_chain<T, K>::power(void) const
+{
+    static_assert(N > 0U && cvp::bit_width(N) <= K,
+                  "cvp::power_chain: exponent out of range.");
+
+    return cvp::chain_product<N, 0U>::eval(squares);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::ipow                                                             *
+ *  Purpose:                                                                  *
+ *      Computes an integer power of a complex number.                        *
+ *  Arguments:                                                                *
+ *      z (const T &):                                                        *
+ *          A complex number, or a batch of them.                             *
+ *  Outputs:                                                                  *
+ *      w (T):                                                                *
+ *          The power z^N.                                                    *
+ *  Method:                                                                   *
+ *      z is squared repeatedly, giving z^(2^k), and the squares selected by  *
+ *      the binary digits of N are multiplied together. This takes at most    *
+ *      2 log2(N) products instead of N - 1. The digits are known at compile  *
+ *      time, so there are no branches.                                       *
+ ******************************************************************************/
+template <unsigned int N, typename T>
+inline T cvp::ipow(const T &z)
+{
+    const cvp::power_chain<T, cvp::bit_width(N)> chain(z);
+    return chain.template power<N>();
+}
+/*  End of cvp::ipow.                                                         */
+
+/*  Horner step for any complex type, using its operators.                    */
+template <typename T>
+inline T cvp::horner_step(const T &p, const T &w, double c)
+{
+    return p * w + c;
+}
+
+/*  Horner step for complex doubles. The constant is folded into the real     *
+ *  part and each part of the product is a pair of fused multiply-adds.       */
+inline cvp::complex
+cvp::horner_step(const cvp::complex &p, const cvp::complex &w, double c)
+{
+#ifdef FP_FAST_FMA
+    const double re = std::fma(p.real, w.real, std::fma(-p.imag, w.imag, c));
+    const double im = std::fma(p.real, w.imag, p.imag * w.real);
+    return cvp::complex(re, im);
+#else
+    return p * w + c;
+#endif
+}
+
+/*  Horner step for batches, with the same formula as complex doubles.        */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::horner_step(const cvp::complex_batch<N> &p,
+                 const cvp::complex_batch<N> &w, double c)
+{
+#ifdef FP_FAST_FMA
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        const double pr = p.real[k], pi = p.imag[k];
+        out.real[k] = std::fma(pr, w.real[k], std::fma(-pi, w.imag[k], c));
+        out.imag[k] = std::fma(pr, w.imag[k], pi * w.real[k]);
+    }
+
+    return out;
+#else
+    return p * w + c;
+#endif
+}
+
+/*  First Horner step for any complex type, using its operators.              */
+template <typename T>
+inline T cvp::horner_lead_step(const T &w, double a, double c)
+{
+    return w * a + c;
+}
+
+/*  First Horner step for complex doubles, one fused multiply-add.            */
+inline cvp::complex
+cvp::horner_lead_step(const cvp::complex &w, double a, double c)
+{
+#ifdef FP_FAST_FMA
+    return cvp::complex(std::fma(w.real, a, c), w.imag * a);
+#else
+    return w * a + c;
+#endif
+}
+
+/*  First Horner step for batches, with the same formula as complex doubles.  */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::horner_lead_step(const cvp::complex_batch<N> &w, double a, double c)
+{
+#ifdef FP_FAST_FMA
+    cvp::complex_batch<N> out;
+    unsigned int k;
+
+    for (k = 0U; k < N; ++k)
+    {
+        out.real[k] = std::fma(w.real[k], a, c);
+        out.imag[k] = w.imag[k] * a;
+    }
+
+    return out;
+#else
+    return w * a + c;
+#endif
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::polynomial::operator ()                                          *
+ *  Purpose:                                                                  *
+ *      Evaluates a polynomial with integer coefficients.                     *
+ *  Arguments:                                                                *
+ *      z (const T &):                                                        *
+ *          A complex number, or a batch of them.                             *
+ *  Outputs:                                                                  *
+ *      p (T):                                                                *
+ *          The value of the polynomial at z.                                 *
+ *  Method:                                                                   *
+ *      Horner's method, p = (...(a_n z + a_{n-1}) z + ...) z + a_0, unrolled *
+ *      at compile time. Zero coefficients are skipped: a run of them becomes *
+ *      one multiplication by a power of z, computed from the repeated        *
+ *      squares of z. The leading coefficient is real, so the first step      *
+ *      scales instead of multiplying, and is dropped if it is one. Each      *
+ *      remaining step is a complex product plus a real constant, done with   *
+ *      fused multiply-adds when the hardware has them.                       *
+ *  Notes:                                                                    *
+ *      z^3 - 1 is z (z z) - 1, which is the same two products as z*z*z - 1.  *
+ *      z^8 + 1 is three squarings instead of seven products. Dense           *
+ *      polynomials take one product per coefficient, which is the fewest.    *
+ ******************************************************************************/
+template <int... C>
+template <typename T>
+inline T cvp::polynomial<C...>::operator () (const T &z) const
+{
+    const cvp::power_chain<T, chain_length> chain(z);
+    return eval(chain);
+}
+/*  End of cvp::polynomial::operator ().                                      */
+
+/*  Evaluates the polynomial from the squares of z.                           */
+template <int... C>
+template <typename T, unsigned int K>
+inline T cvp::polynomial<C...>::eval(const cvp::power_chain<T, K> &z)
+{
+    static_assert(sizeof...(C) > 0U, "cvp::polynomial: no coefficients.");
+    return cvp::horner<C...>::eval(z);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::rational::operator ()                                            *
+ *  Purpose:                                                                  *
+ *      Evaluates a rational function P / Q.                                  *
+ *  Arguments:                                                                *
+ *      z (const T &):                                                        *
+ *          A complex number, or a batch of them.                             *
+ *  Outputs:                                                                  *
+ *      w (T):                                                                *
+ *          The value P(z) / Q(z).                                            *
+ *  Method:                                                                   *
+ *      The squares z, z^2, z^4, ... are computed once for both polynomials,  *
+ *      and P and Q are then evaluated by Horner's method from them. For      *
+ *      (2z^3 + 1) / (3z^2) the square z^2 is computed once, where            *
+ *      (2.0*z*z*z + 1.0) / (3.0*z*z) computes it twice unless the compiler   *
+ *      notices. The division is the usual complex division.                  *
+ ******************************************************************************/
+template <typename P, typename Q>
+template <typename T>
+inline T cvp::rational<P, Q>::operator () (const T &z) const
+{
+    const cvp::power_chain<T, chain_length> chain(z);
+    return P::eval(chain) / Q::eval(chain);
+}
+/*  End of cvp::rational::operator ().                                        */
+
+/*  Computes z^N by repeated squaring.                                        */
+template <unsigned int N>
+template <typename T>
+inline T cvp::multibrot<N>::operator () (const T &z) const
+{
+    return cvp::ipow<N>(z);
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -31,18 +31,47 @@
 /*  FILE data type found here.                                                */
 #include <cstdio>
 
+/*  size_t and memcpy found here.                                             */
+#include <cstddef>
+#include <cstring>
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Low-level block writes found here.                                        */
+#include "cvp_io.hpp"
+
 /*  Basic constants for the setup of the experiments given here.              */
 #include "cvp_setup.hpp"
 
 /*  Namespace for the mini-project. "Complex Visual Plots."                   */
 namespace cvp {
 
+    /*  Size of the output buffer of a PPM, in bytes. A whole number of       *
+     *  pixels so that put never has to split a pixel across two flushes.     */
+    const std::size_t ppm_buffer_size = 3U * 16384U;
+
     /*  Struct for working with PPM files.                                    */
     class ppm {
         public:
             /*  The "data" of the PPM is just a FILE pointer.                 */
             FILE *fp;
 
+            /*  Cache-aligned buffer of packed RGB bytes waiting to be        *
+             *  written, and the number of bytes currently in it.             */
+            unsigned char *buffer;
+            std::size_t size;
+
+            /*  The number of pixels in the x and y axes, set by init.        */
+            unsigned int width, height;
+
+            /*  The memory-mapped file, NULL unless map has been called.      */
+            unsigned char *mapping;
+            std::size_t mapped_size;
+
+            /*  Pointer to the first pixel in the mapped file.                */
+            unsigned char *pixels;
+
             /*  Constructor from a name, the name of the file.                */
             ppm(const char *name);
 
@@ -52,6 +81,31 @@ namespace cvp {
             /*  Method for initializing the PPM using the values in "setup".  */
             inline void init(void);
 
+            /*  Method for initializing the PPM using the size of a viewport. */
+            template <typename Tview>
+            inline void init(const Tview &view);
+
+            /*  Appends a single pixel to the buffer.                         */
+            inline void put(unsigned char r, unsigned char g, unsigned char b);
+
+            /*  Appends a block of packed RGB bytes to the file.              */
+            inline void write(const void *data, std::size_t bytes);
+
+            /*  Appends an entire row (or several rows) of packed RGB pixels. */
+            inline void write_row(const void *rgb, unsigned int width);
+            inline void write_rows(const void *rgb, unsigned int width,
+                                   unsigned int rows);
+
+            /*  Writes the contents of the buffer to the file.                */
+            inline void flush(void);
+
+            /*  Maps the whole file into memory so pixels can be written      *
+             *  directly and in any order.                                    */
+            inline bool map(void);
+
+            /*  Pointer to the pixel (x, y) in the mapped file.               */
+            inline unsigned char *pixel(unsigned int x, unsigned int y) const;
+
             /*  Method for closing the file pointer for the PPM.              */
             inline void close(void);
     };
@@ -59,11 +113,32 @@ namespace cvp {
     /*  Constructor from a name.                                              */
     ppm::ppm(const char *name)
     {
-        fp = std::fopen(name, "w");
+        /*  Open for reading as well so that the file can be mapped later.    */
+        fp = std::fopen(name, "w+");
+        size = 0U;
+        width = height = 0U;
+        mapping = pixels = NULL;
+        mapped_size = 0U;
 
         /*  Warn the caller is fopen failed.                                  */
         if (!fp)
+        {
             std::puts("ERROR: fopen failed and returned NULL.");
+            buffer = NULL;
+            return;
+        }
+
+        buffer = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(cvp::ppm_buffer_size)
+        );
+
+        /*  Without a buffer the PPM is unusable, treat it as a failed fopen. */
+        if (!buffer)
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            std::fclose(fp);
+            fp = NULL;
+        }
     }
 
     /*  Print the preamble to the PPM file. A PPM file wants Pn followed by   *
@@ -72,9 +147,13 @@ namespace cvp {
      *  The last number is the size of our color spectrum, which is 255.      */
     inline void ppm::init(unsigned int x, unsigned int y, int type)
     {
+        /*  Remember the size of the image for map and pixel.                 */
+        width = x;
+        height = y;
+
         /*  For values 1 to 5, print normally.                                */
         if (0 < type && type < 6)
-            std::fprintf(fp, "P%d\n%u %u\n255\n", x, y, type);
+            std::fprintf(fp, "P%d\n%u %u\n255\n", type, x, y);
 
         /*  The only other legal value is 6. All illegal values default to 6. */
         else
@@ -87,6 +166,123 @@ namespace cvp {
         init(cvp::setup::xsize, cvp::setup::ysize, 6);
     }
 
+    /*  Initialize using the resolution of a viewport.                        */
+    template <typename Tview>
+    inline void ppm::init(const Tview &view)
+    {
+        init(view.xsize, view.ysize, 6);
+    }
+
+    /*  Appends a single pixel. This is the hot path for per-pixel writes.    */
+    inline void ppm::put(unsigned char r, unsigned char g, unsigned char b)
+    {
+        /*  The buffer holds a whole number of pixels, so it is either full   *
+         *  or has room for at least one more.                                */
+        if (size == cvp::ppm_buffer_size)
+            flush();
+
+        buffer[size] = r;
+        buffer[size + 1U] = g;
+        buffer[size + 2U] = b;
+        size += 3U;
+    }
+
+    /*  Appends a block of bytes, writing large blocks straight to the file.  */
+    inline void ppm::write(const void *data, std::size_t bytes)
+    {
+        /*  Small blocks are copied into the buffer.                          */
+        if (size + bytes <= cvp::ppm_buffer_size)
+        {
+            std::memcpy(buffer + size, data, bytes);
+            size += bytes;
+            return;
+        }
+
+        /*  Otherwise empty the buffer and write the block directly, which    *
+         *  saves a copy for anything larger than the buffer itself.          */
+        flush();
+
+        if (bytes >= cvp::ppm_buffer_size)
+        {
+            if (!cvp::io::write_all(fp, data, bytes))
+                std::puts("ERROR: write failed.");
+        }
+        else
+        {
+            std::memcpy(buffer, data, bytes);
+            size = bytes;
+        }
+    }
+
+    /*  Appends a row of packed RGB pixels.                                   */
+    inline void ppm::write_row(const void *rgb, unsigned int width)
+    {
+        write(rgb, 3U * static_cast<std::size_t>(width));
+    }
+
+    /*  Appends several consecutive rows of packed RGB pixels.                */
+    inline void ppm::write_rows(const void *rgb, unsigned int width,
+                                unsigned int rows)
+    {
+        write(rgb, 3U * static_cast<std::size_t>(width) * rows);
+    }
+
+    /*  Writes the contents of the buffer to the file in one call.            */
+    inline void ppm::flush(void)
+    {
+        if (size == 0U)
+            return;
+
+        if (!cvp::io::write_all(fp, buffer, size))
+            std::puts("ERROR: write failed.");
+
+        size = 0U;
+    }
+
+    /*  Maps the PPM into memory so pixels can be placed directly, in any     *
+     *  order, by any thread. The header written by init determines where the *
+     *  pixels start. The file is sized up front to the header plus 3 bytes   *
+     *  per pixel and then mapped. Returns false if mmap is unavailable or    *
+     *  fails, in which case the PPM can still be written sequentially. Once  *
+     *  mapped, pixels must be written through pixel(x, y), not put.          */
+    inline bool ppm::map(void)
+    {
+        /*  The header is the only thing written so far. Its size is the      *
+         *  current position in the file, once stdio has flushed it.          */
+        long header;
+
+        flush();
+
+        if (std::fflush(fp) != 0)
+            return false;
+
+        header = std::ftell(fp);
+
+        if (header < 0L)
+            return false;
+
+        mapped_size = static_cast<std::size_t>(header) +
+                      3U * static_cast<std::size_t>(width) * height;
+
+        mapping = cvp::io::map_file(fp, mapped_size);
+
+        if (!mapping)
+        {
+            mapped_size = 0U;
+            return false;
+        }
+
+        pixels = mapping + header;
+        return true;
+    }
+
+    /*  Pointer to the pixel (x, y). Rows are stored top to bottom.           */
+    inline unsigned char *ppm::pixel(unsigned int x, unsigned int y) const
+    {
+        const std::size_t n = static_cast<std::size_t>(y) * width + x;
+        return pixels + 3U * n;
+    }
+
     /*  Method for closing the file pointer for the PPM.                      */
     inline void ppm::close(void)
     {
@@ -94,7 +290,21 @@ namespace cvp {
         if (!fp)
             return;
 
+        /*  The pixels of a mapped file are already in place.                 */
+        if (mapping)
+        {
+            cvp::io::unmap_file(mapping, mapped_size);
+            mapping = pixels = NULL;
+            mapped_size = 0U;
+        }
+
+        /*  Write whatever is left in the buffer before closing.              */
+        flush();
+        cvp::memory::aligned_free(buffer);
+        buffer = NULL;
+
         std::fclose(fp);
+        fp = NULL;
     }
 }
 /*  End of namespace cvp.                                                     */
@@ -0,0 +1,468 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides quad-double numbers, the unevaluated sum of four doubles,    *
+ *      with about 212 bits of precision.                                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_QD_REAL_HPP
+#define CVP_QD_REAL_HPP
+
+/*  puts found here.                                                          */
+#include <cstdio>
+
+/*  sqrt and atan2 found here.                                                */
+#include <cmath>
+
+/*  The error-free transformations are shared with cvp::dd_real.              */
+#include "cvp_dd_real.hpp"
+
+/*  Decimal strings are read with a cvp::bigfloat.                            */
+#include "cvp_bigfloat.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    namespace eft {
+
+        /*  Sums a, b, and c into a, carrying the error into b and c.         */
+        inline void three_sum(double &a, double &b, double &c);
+
+        /*  Sums a, b, and c into a, with the error in b. c is overwritten.   */
+        inline void three_sum2(double &a, double &b, double &c);
+
+        /*  Turns five overlapping doubles into four non-overlapping ones,    *
+         *  stored in c0, ..., c3, largest first.                             */
+        inline void renormalize(double &c0, double &c1, double &c2,
+                                double &c3, double c4);
+    }
+
+    /*  A quad-double number, the unevaluated sum x[0] + x[1] + x[2] + x[3]   *
+     *  of four non-overlapping doubles, largest first.                       */
+    class qd_real {
+        public:
+            double x[4];
+
+            /*  Empty constructor.                                            */
+            qd_real(void);
+
+            /*  Constructor from a double. Not explicit, so doubles may be    *
+             *  used wherever a qd_real is expected.                          */
+            qd_real(double a);
+
+            /*  Constructor from the four parts. They must not overlap.       */
+            qd_real(double a0, double a1, double a2, double a3);
+
+            /*  Constructor from a decimal string like "-0.743643887037151".  */
+            explicit qd_real(const char *str);
+
+            /*  Rounds to a double.                                           */
+            explicit operator double(void) const;
+    };
+
+    /*  Square root, accurate to the full precision.                          */
+    inline cvp::qd_real sqrt(const cvp::qd_real &a);
+
+    /*  The angle of (x, y). Only computed in double precision, as it is only *
+     *  ever used for colors.                                                 */
+    inline cvp::qd_real atan2(const cvp::qd_real &y, const cvp::qd_real &x);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Two two_sums: a + b first, then c plus the result.                        */
+inline void cvp::eft::three_sum(double &a, double &b, double &c)
+{
+    double t1, t2, t3;
+
+    t1 = cvp::eft::two_sum(a, b, t2);
+    a = cvp::eft::two_sum(c, t1, t3);
+    b = cvp::eft::two_sum(t2, t3, c);
+}
+
+/*  Same as three_sum, but the smallest error term is rounded into b.         */
+inline void cvp::eft::three_sum2(double &a, double &b, double &c)
+{
+    double t1, t2, t3;
+
+    t1 = cvp::eft::two_sum(a, b, t2);
+    a = cvp::eft::two_sum(c, t1, t3);
+    b = t2 + t3;
+}
+
+/*  Renormalization from Hida, Li, and Bailey's quad-double library. The      *
+ *  terms are first summed from the smallest up, then the non-zero parts are  *
+ *  collected from the largest down, skipping any that vanish.                */
+inline void cvp::eft::renormalize(double &c0, double &c1, double &c2,
+                                  double &c3, double c4)
+{
+    double s0, s1, s2 = 0.0, s3 = 0.0;
+
+    s0 = cvp::eft::quick_two_sum(c3, c4, c4);
+    s0 = cvp::eft::quick_two_sum(c2, s0, c3);
+    s0 = cvp::eft::quick_two_sum(c1, s0, c2);
+    c0 = cvp::eft::quick_two_sum(c0, s0, c1);
+
+    s0 = c0;
+    s1 = c1;
+
+    if (s1 != 0.0)
+    {
+        s1 = cvp::eft::quick_two_sum(s1, c2, s2);
+
+        if (s2 != 0.0)
+        {
+            s2 = cvp::eft::quick_two_sum(s2, c3, s3);
+
+            if (s3 != 0.0)
+                s3 += c4;
+            else
+                s2 += c4;
+        }
+        else
+        {
+            s1 = cvp::eft::quick_two_sum(s1, c3, s2);
+
+            if (s2 != 0.0)
+                s2 = cvp::eft::quick_two_sum(s2, c4, s3);
+            else
+                s1 = cvp::eft::quick_two_sum(s1, c4, s2);
+        }
+    }
+    else
+    {
+        s0 = cvp::eft::quick_two_sum(s0, c2, s1);
+
+        if (s1 != 0.0)
+        {
+            s1 = cvp::eft::quick_two_sum(s1, c3, s2);
+
+            if (s2 != 0.0)
+                s2 = cvp::eft::quick_two_sum(s2, c4, s3);
+            else
+                s1 = cvp::eft::quick_two_sum(s1, c4, s2);
+        }
+        else
+        {
+            s0 = cvp::eft::quick_two_sum(s0, c3, s1);
+
+            if (s1 != 0.0)
+                s1 = cvp::eft::quick_two_sum(s1, c4, s2);
+            else
+                s0 = cvp::eft::quick_two_sum(s0, c4, s1);
+        }
+    }
+
+    c0 = s0;
+    c1 = s1;
+    c2 = s2;
+    c3 = s3;
+}
+
+/*  Empty constructor, simply return.                                         */
+cvp::qd_real::qd_real(void)
+{
+    return;
+}
+
+/*  Constructor from a double, which is exact.                                */
+cvp::qd_real::qd_real(double a)
+{
+    x[0] = a;
+    x[1] = x[2] = x[3] = 0.0;
+}
+
+/*  Constructor from the four parts.                                          */
+cvp::qd_real::qd_real(double a0, double a1, double a2, double a3)
+{
+    x[0] = a0;
+    x[1] = a1;
+    x[2] = a2;
+    x[3] = a3;
+}
+
+/*  Reads the string with more bits than a qd_real holds, then peels off the  *
+ *  four parts, subtracting each from the exact value.                        */
+cvp::qd_real::qd_real(const char *str)
+{
+    const unsigned int limbs = 12U;
+    cvp::bigfloat a;
+    double rest = 0.0;
+    unsigned int k;
+
+    x[0] = x[1] = x[2] = x[3] = 0.0;
+
+    if (!a.parse(str, limbs))
+    {
+        std::puts("ERROR: qd_real could not parse the string.");
+        return;
+    }
+
+    for (k = 0U; k < 4U; ++k)
+    {
+        x[k] = a.to_double();
+        a = a - cvp::bigfloat(x[k], limbs);
+    }
+
+    rest = a.to_double();
+    cvp::eft::renormalize(x[0], x[1], x[2], x[3], rest);
+}
+
+/*  The first part is the value rounded to a double.                          */
+cvp::qd_real::operator double(void) const
+{
+    return x[0];
+}
+
+/*  Negation is exact.                                                        */
+inline cvp::qd_real operator - (const cvp::qd_real &a)
+{
+    return cvp::qd_real(-a.x[0], -a.x[1], -a.x[2], -a.x[3]);
+}
+
+/*  Addition of quad-doubles. Matching parts are summed with two_sum, and the *
+ *  errors are carried down into the smaller parts. This is the "sloppy"      *
+ *  addition of the quad-double library: the error is relative to |a| + |b|   *
+ *  rather than |a + b|, which is all that iterating a polynomial needs.      */
+inline cvp::qd_real operator + (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    double s0, s1, s2, s3;
+    double t0, t1, t2, t3;
+
+    s0 = cvp::eft::two_sum(a.x[0], b.x[0], t0);
+    s1 = cvp::eft::two_sum(a.x[1], b.x[1], t1);
+    s2 = cvp::eft::two_sum(a.x[2], b.x[2], t2);
+    s3 = cvp::eft::two_sum(a.x[3], b.x[3], t3);
+
+    s1 = cvp::eft::two_sum(s1, t0, t0);
+    cvp::eft::three_sum(s2, t0, t1);
+    cvp::eft::three_sum2(s3, t0, t2);
+    t0 = t0 + t1 + t3;
+
+    cvp::eft::renormalize(s0, s1, s2, s3, t0);
+    return cvp::qd_real(s0, s1, s2, s3);
+}
+
+/*  Addition of a quad-double and a double. The error ripples down the parts. */
+inline cvp::qd_real operator + (const cvp::qd_real &a, double b)
+{
+    double c0, c1, c2, c3, err;
+
+    c0 = cvp::eft::two_sum(a.x[0], b, err);
+    c1 = cvp::eft::two_sum(a.x[1], err, err);
+    c2 = cvp::eft::two_sum(a.x[2], err, err);
+    c3 = cvp::eft::two_sum(a.x[3], err, err);
+
+    cvp::eft::renormalize(c0, c1, c2, c3, err);
+    return cvp::qd_real(c0, c1, c2, c3);
+}
+
+/*  Addition of a double and a quad-double.                                   */
+inline cvp::qd_real operator + (double a, const cvp::qd_real &b)
+{
+    return b + a;
+}
+
+/*  Subtraction is addition of the negative.                                  */
+inline cvp::qd_real operator - (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return a + (-b);
+}
+
+/*  Subtraction of a double from a quad-double.                               */
+inline cvp::qd_real operator - (const cvp::qd_real &a, double b)
+{
+    return a + (-b);
+}
+
+/*  Subtraction of a quad-double from a double.                               */
+inline cvp::qd_real operator - (double a, const cvp::qd_real &b)
+{
+    return (-b) + a;
+}
+
+/*  Multiplication of quad-doubles. The products of order 1, eps, and eps^2   *
+ *  are computed exactly with two_prod, the products of order eps^3 only in   *
+ *  double precision, and smaller ones are dropped.                           */
+inline cvp::qd_real operator * (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    double p0, p1, p2, p3, p4, p5;
+    double q0, q1, q2, q3, q4, q5;
+    double s0, s1, s2, t0, t1;
+
+    p0 = cvp::eft::two_prod(a.x[0], b.x[0], q0);
+    p1 = cvp::eft::two_prod(a.x[0], b.x[1], q1);
+    p2 = cvp::eft::two_prod(a.x[1], b.x[0], q2);
+    p3 = cvp::eft::two_prod(a.x[0], b.x[2], q3);
+    p4 = cvp::eft::two_prod(a.x[1], b.x[1], q4);
+    p5 = cvp::eft::two_prod(a.x[2], b.x[0], q5);
+
+    /*  The terms of order eps.                                               */
+    cvp::eft::three_sum(p1, p2, q0);
+
+    /*  The six terms of order eps^2, summed into three.                      */
+    cvp::eft::three_sum(p2, q1, q2);
+    cvp::eft::three_sum(p3, p4, p5);
+
+    s0 = cvp::eft::two_sum(p2, p3, t0);
+    s1 = cvp::eft::two_sum(q1, p4, t1);
+    s2 = q2 + p5;
+    s1 = cvp::eft::two_sum(s1, t0, t0);
+    s2 += (t0 + t1);
+
+    /*  The terms of order eps^3.                                             */
+    s1 += a.x[0]*b.x[3] + a.x[1]*b.x[2] + a.x[2]*b.x[1] + a.x[3]*b.x[0] +
+          q0 + q3 + q4 + q5;
+
+    cvp::eft::renormalize(p0, p1, s0, s1, s2);
+    return cvp::qd_real(p0, p1, s0, s1);
+}
+
+/*  Multiplication of a quad-double and a double.                             */
+inline cvp::qd_real operator * (const cvp::qd_real &a, double b)
+{
+    double p0, p1, p2, p3, q0, q1, q2, s0, s1, s2, s3, s4;
+
+    p0 = cvp::eft::two_prod(a.x[0], b, q0);
+    p1 = cvp::eft::two_prod(a.x[1], b, q1);
+    p2 = cvp::eft::two_prod(a.x[2], b, q2);
+    p3 = a.x[3] * b;
+
+    s0 = p0;
+    s1 = cvp::eft::two_sum(q0, p1, s2);
+    cvp::eft::three_sum(s2, q1, p2);
+    cvp::eft::three_sum2(q1, q2, p3);
+    s3 = q1;
+    s4 = q2 + p2;
+
+    cvp::eft::renormalize(s0, s1, s2, s3, s4);
+    return cvp::qd_real(s0, s1, s2, s3);
+}
+
+/*  Multiplication of a double and a quad-double.                             */
+inline cvp::qd_real operator * (double a, const cvp::qd_real &b)
+{
+    return b * a;
+}
+
+/*  Long division, one double of the quotient at a time.                      */
+inline cvp::qd_real operator / (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    double q0, q1, q2, q3;
+    cvp::qd_real r;
+
+    q0 = a.x[0] / b.x[0];
+    r = a - b*q0;
+
+    q1 = r.x[0] / b.x[0];
+    r = r - b*q1;
+
+    q2 = r.x[0] / b.x[0];
+    r = r - b*q2;
+
+    q3 = r.x[0] / b.x[0];
+
+    cvp::eft::renormalize(q0, q1, q2, q3, 0.0);
+    return cvp::qd_real(q0, q1, q2, q3);
+}
+
+/*  Division of a quad-double by a double.                                    */
+inline cvp::qd_real operator / (const cvp::qd_real &a, double b)
+{
+    return a / cvp::qd_real(b);
+}
+
+/*  Division of a double by a quad-double.                                    */
+inline cvp::qd_real operator / (double a, const cvp::qd_real &b)
+{
+    return cvp::qd_real(a) / b;
+}
+
+/*  Comparisons. The parts are normalized, so compare them largest first.     */
+inline bool operator < (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    unsigned int k;
+
+    for (k = 0U; k < 3U; ++k)
+    {
+        if (a.x[k] != b.x[k])
+            return a.x[k] < b.x[k];
+    }
+
+    return a.x[3] < b.x[3];
+}
+
+inline bool operator > (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return b < a;
+}
+
+inline bool operator <= (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return !(b < a);
+}
+
+inline bool operator >= (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return !(a < b);
+}
+
+inline bool operator == (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return a.x[0] == b.x[0] && a.x[1] == b.x[1] &&
+           a.x[2] == b.x[2] && a.x[3] == b.x[3];
+}
+
+inline bool operator != (const cvp::qd_real &a, const cvp::qd_real &b)
+{
+    return !(a == b);
+}
+
+/*  Newton's method for 1/sqrt(a), starting from the double precision value.  *
+ *  Each step doubles the number of correct bits, so three steps take the 53  *
+ *  bits of the double to the full precision. Then sqrt(a) = a / sqrt(a).     */
+inline cvp::qd_real cvp::sqrt(const cvp::qd_real &a)
+{
+    unsigned int k;
+    cvp::qd_real r;
+    const cvp::qd_real half_a = a * 0.5;
+
+    if (a.x[0] <= 0.0)
+        return cvp::qd_real(0.0);
+
+    r = cvp::qd_real(1.0 / std::sqrt(a.x[0]));
+
+    for (k = 0U; k < 3U; ++k)
+        r = r + r * (0.5 - half_a * (r * r));
+
+    return a * r;
+}
+
+/*  The angle is only needed for coloring, so double precision suffices.      */
+inline cvp::qd_real cvp::atan2(const cvp::qd_real &y, const cvp::qd_real &x)
+{
+    return cvp::qd_real(std::atan2(y.x[0], x.x[0]));
+}
+
+#endif
+/*  End of include guard.                                                     */
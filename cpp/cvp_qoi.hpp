@@ -0,0 +1,662 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a class for writing QOI files, the "Quite OK Image" format.  *
+ *      Rows are streamed in like a PPM and encoded as they arrive, or in     *
+ *      independent strips on every thread.                                   *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_QOI_HPP
+#define CVP_QOI_HPP
+
+/*  FILE data type found here.                                                */
+#include <cstdio>
+
+/*  size_t, memcpy, and memset found here.                                    */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, for the index of seen colors.                    */
+#include <cstdint>
+
+/*  omp_get_max_threads, if OpenMP is enabled.                                */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Low-level block writes found here.                                        */
+#include "cvp_io.hpp"
+
+/*  Basic constants for the setup of the experiments given here.              */
+#include "cvp_setup.hpp"
+
+/*  Tile engine, which encodes the strips in parallel.                        */
+#include "cvp_tiles.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The number of bytes of pixels held before they are encoded, when the  *
+     *  image is encoded as a single stream.                                  */
+    static const std::size_t qoi_batch_bytes = 131072U;
+
+    /*  The state of a QOI encoder: the colors seen so far, hashed into 64    *
+     *  slots, the previous color, and the length of the current run.         */
+    class qoi_state {
+        public:
+            /*  Colors stored as r | g << 8 | b << 16 | a << 24. The pixels   *
+             *  are opaque, so an empty slot, with alpha 0, never matches.    */
+            std::uint32_t index[64];
+
+            /*  The previous color, in the same form.                         */
+            std::uint32_t previous;
+
+            /*  False at the start of a strip, where the decoder's previous   *
+             *  color is not known. The first pixel is then stored in full.   */
+            bool known;
+
+            /*  The number of pixels repeating the previous one, not yet      *
+             *  written out.                                                  */
+            unsigned int run;
+
+            /*  Constructor, the state at the start of a file.                */
+            qoi_state(void);
+
+            /*  Resets the state for a strip encoded on its own.              */
+            inline void reset(void);
+
+            /*  Encodes n packed RGB pixels. Returns the bytes written.       */
+            inline std::size_t
+            encode(const unsigned char *rgb, std::size_t n, unsigned char *out);
+
+            /*  Ends the current run. Returns the bytes written.              */
+            inline std::size_t finish(unsigned char *out);
+    };
+
+    /*  Class for writing QOI files. The file is an RGB image. With strip     *
+     *  rows of zero the image is one stream, encoded as the rows arrive and  *
+     *  identical to the file of the reference encoder. Otherwise the image   *
+     *  is cut into strips of that many rows, which are encoded on their own  *
+     *  by the tile engine and written one after the other.                   */
+    class qoi {
+        public:
+            /*  The file, NULL if it could not be opened.                     */
+            FILE *fp;
+
+            /*  The number of pixels in the x and y axes, set by init.        */
+            unsigned int width, height;
+
+            /*  Rows in a strip, 0 for a single stream.                       */
+            unsigned int strip_rows;
+
+            /*  The bytes in a row of pixels, the rows in a batch, and the    *
+             *  strips in a batch.                                            */
+            std::size_t row_bytes;
+            unsigned int batch_rows, batch_strips;
+
+            /*  The pixels of the batch, and the number of bytes received.    */
+            unsigned char *raw;
+            std::size_t size;
+
+            /*  Rows encoded so far.                                          */
+            unsigned int rows_done;
+
+            /*  The encoder, for a single stream.                             */
+            cvp::qoi_state state;
+
+            /*  For each strip of a batch, the encoded bytes and their count. */
+            unsigned char **strip_data;
+            std::size_t *strip_size;
+
+            /*  Set when malloc fails, after which nothing more is written.   */
+            bool failed;
+
+            /*  Constructor from a name, encoding a single stream.            */
+            qoi(const char *name);
+
+            /*  Constructor from a name and the rows in a strip.              */
+            qoi(const char *name, unsigned int rows);
+
+            /*  Method for initializing the QOI with the size of the image.   */
+            inline void init(unsigned int x, unsigned int y);
+
+            /*  Method for initializing the QOI using the values in "setup".  */
+            inline void init(void);
+
+            /*  Method for initializing the QOI using the size of a viewport. */
+            template <typename Tview>
+            inline void init(const Tview &view);
+
+            /*  Appends a block of packed RGB bytes to the image.             */
+            inline void write(const void *data, std::size_t bytes);
+
+            /*  Appends an entire row (or several rows) of packed RGB pixels. */
+            inline void write_row(const void *rgb, unsigned int width);
+            inline void write_rows(const void *rgb, unsigned int width,
+                                   unsigned int rows);
+
+            /*  A QOI is compressed, so it cannot be mapped. Returns false.   */
+            inline bool map(void);
+
+            /*  There are no mapped pixels, returns NULL.                     */
+            inline unsigned char *pixel(unsigned int x, unsigned int y) const;
+
+            /*  Writes the end of the file and closes it.                     */
+            inline void close(void);
+
+            /*  Encodes the n^th strip of the batch.                          */
+            inline void encode_strip(unsigned int n);
+
+        private:
+            /*  Encodes and writes the rows received so far.                  */
+            inline void write_batch(void);
+    };
+
+    /*  Job for the tile engine, encodes a strip of a batch of a QOI.         */
+    class qoi_strip_job {
+        public:
+            cvp::qoi &QOI;
+
+            /*  Constructor from the QOI.                                     */
+            qoi_strip_job(cvp::qoi &Q);
+
+            /*  Encodes the n^th strip.                                       */
+            inline void operator () (unsigned int n);
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  At the start of a file the decoder's previous color is opaque black.      */
+cvp::qoi_state::qoi_state(void)
+{
+    reset();
+    previous = 0xFF000000U;
+    known = true;
+}
+
+/*  Forget every color, the decoder may have seen other ones.                 */
+inline void cvp::qoi_state::reset(void)
+{
+    std::memset(index, 0, sizeof(index));
+    previous = 0U;
+    known = false;
+    run = 0U;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::qoi_state::encode                                                *
+ *  Purpose:                                                                  *
+ *      Encodes opaque RGB pixels as QOI operations.                          *
+ *  Arguments:                                                                *
+ *      rgb (const unsigned char *):                                          *
+ *          The pixels, three bytes each.                                     *
+ *      n (std::size_t):                                                      *
+ *          The number of pixels.                                             *
+ *      out (unsigned char *):                                                *
+ *          Room for 4 n bytes, the most n pixels can take.                   *
+ *  Outputs:                                                                  *
+ *      written (std::size_t):                                                *
+ *          The number of bytes written to out.                               *
+ *  Method:                                                                   *
+ *      Each pixel is, in order of preference, part of a run of the previous  *
+ *      color, a color in the index, a small difference from the previous     *
+ *      color, a larger difference with green as the reference, or written    *
+ *      out in full. A run still going at the end is kept for the next call.  *
+ *  Notes:                                                                    *
+ *      A strip is decodable after any other strip because its first pixel    *
+ *      is written in full, and the only colors of the index it uses are the  *
+ *      ones it put there itself.                                             *
+ ******************************************************************************/
+inline std::size_t
+cvp::qoi_state::encode(const unsigned char *rgb, std::size_t n,
+                       unsigned char *out)
+{
+    /*  Variables for indexing over the pixels and the output.                */
+    std::size_t k, written = 0U;
+
+    for (k = 0U; k < n; ++k, rgb += 3)
+    {
+        const unsigned int r = rgb[0], g = rgb[1], b = rgb[2];
+        const std::uint32_t color = r | (g << 8) | (b << 16) | 0xFF000000U;
+        const unsigned int slot = (r * 3U + g * 5U + b * 7U + 255U * 11U) & 63U;
+
+        if (known && color == previous)
+        {
+            /*  A run holds at most 62 pixels.                                */
+            if (++run == 62U)
+            {
+                out[written++] = 0xC0U | 61U;
+                run = 0U;
+            }
+
+            continue;
+        }
+
+        if (run > 0U)
+        {
+            out[written++] = static_cast<unsigned char>(0xC0U | (run - 1U));
+            run = 0U;
+        }
+
+        if (index[slot] == color)
+            out[written++] = static_cast<unsigned char>(slot);
+
+        else
+        {
+            /*  The differences from the previous color, modulo 256.          */
+            const unsigned int pr = previous & 0xFFU;
+            const unsigned int pg = (previous >> 8) & 0xFFU;
+            const unsigned int pb = (previous >> 16) & 0xFFU;
+            const int dr = static_cast<signed char>(r - pr);
+            const int dg = static_cast<signed char>(g - pg);
+            const int db = static_cast<signed char>(b - pb);
+            const int dr_dg = dr - dg;
+            const int db_dg = db - dg;
+
+            index[slot] = color;
+
+            if (known && dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 &&
+                db >= -2 && db <= 1)
+                out[written++] = static_cast<unsigned char>(
+                    0x40 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2)
+                );
+
+            else if (known && dg >= -32 && dg <= 31 && dr_dg >= -8 &&
+                     dr_dg <= 7 && db_dg >= -8 && db_dg <= 7)
+            {
+                out[written++] = static_cast<unsigned char>(0x80 | (dg + 32));
+                out[written++] = static_cast<unsigned char>(
+                    ((dr_dg + 8) << 4) | (db_dg + 8)
+                );
+            }
+
+            else
+            {
+                out[written++] = 0xFEU;
+                out[written++] = static_cast<unsigned char>(r);
+                out[written++] = static_cast<unsigned char>(g);
+                out[written++] = static_cast<unsigned char>(b);
+            }
+        }
+
+        previous = color;
+        known = true;
+    }
+
+    return written;
+}
+/*  End of cvp::qoi_state::encode.                                            */
+
+/*  Writes out the run in progress, if there is one.                          */
+inline std::size_t cvp::qoi_state::finish(unsigned char *out)
+{
+    if (run == 0U)
+        return 0U;
+
+    out[0] = static_cast<unsigned char>(0xC0U | (run - 1U));
+    run = 0U;
+    return 1U;
+}
+
+/*  Constructor from a name, the image is a single stream.                    */
+cvp::qoi::qoi(const char *name) : qoi(name, 0U)
+{
+    return;
+}
+
+/*  Constructor from a name and the rows in a strip. The buffers are made by  *
+ *  init, once the size of the image is known.                                */
+cvp::qoi::qoi(const char *name, unsigned int rows)
+{
+    fp = std::fopen(name, "wb");
+    width = height = 0U;
+    strip_rows = rows;
+    row_bytes = 0U;
+    batch_rows = batch_strips = 0U;
+    raw = NULL;
+    size = 0U;
+    rows_done = 0U;
+    strip_data = NULL;
+    strip_size = NULL;
+    failed = false;
+
+    /*  Warn the caller if fopen failed.                                      */
+    if (!fp)
+        std::puts("ERROR: fopen failed and returned NULL.");
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::qoi::init                                                        *
+ *  Purpose:                                                                  *
+ *      Writes the header of a QOI file and makes room for a batch of rows.   *
+ *  Arguments:                                                                *
+ *      x (unsigned int):                                                     *
+ *          The number of pixels in the x axis.                               *
+ *      y (unsigned int):                                                     *
+ *          The number of pixels in the y axis.                               *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      A single stream is encoded about 128 kB of pixels at a time. With     *
+ *      strips, a batch is two strips for every thread, so that the tile      *
+ *      engine can balance the strips that encode slowly.                     *
+ ******************************************************************************/
+inline void cvp::qoi::init(unsigned int x, unsigned int y)
+{
+    /*  The magic bytes, the size in big endian order, three channels, and    *
+     *  the sRGB color space.                                                 */
+    unsigned char header[14] = {'q', 'o', 'i', 'f'};
+
+    /*  Bytes needed for an encoded strip, and an index for the strips.       */
+    std::size_t bound;
+    unsigned int n;
+
+#ifdef _OPENMP
+    const unsigned int threads =
+        static_cast<unsigned int>(omp_get_max_threads());
+#else
+    const unsigned int threads = 1U;
+#endif
+
+    width = x;
+    height = y;
+
+    if (!fp)
+        return;
+
+    row_bytes = 3U * static_cast<std::size_t>(width);
+
+    if (strip_rows == 0U)
+    {
+        batch_strips = 1U;
+        batch_rows = static_cast<unsigned int>(
+            cvp::qoi_batch_bytes / row_bytes
+        );
+
+        if (batch_rows == 0U)
+            batch_rows = 1U;
+    }
+    else
+    {
+        batch_strips = (threads > 1U ? 2U * threads : 1U);
+        batch_rows = batch_strips * strip_rows;
+    }
+
+    if (batch_rows > height)
+        batch_rows = height;
+
+    if (batch_rows == 0U)
+        batch_rows = 1U;
+
+    /*  Four bytes for each pixel, and one to end the last run.               */
+    bound = 4U * static_cast<std::size_t>(width) *
+            (strip_rows == 0U ? batch_rows : strip_rows) + 1U;
+
+    raw = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(row_bytes * batch_rows + 1U)
+    );
+
+    strip_data = static_cast<unsigned char **>(
+        cvp::memory::aligned_malloc(sizeof(*strip_data) * batch_strips)
+    );
+
+    strip_size = static_cast<std::size_t *>(
+        cvp::memory::aligned_malloc(sizeof(*strip_size) * batch_strips)
+    );
+
+    if (!raw || !strip_data || !strip_size)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        failed = true;
+        return;
+    }
+
+    for (n = 0U; n < batch_strips; ++n)
+        strip_data[n] = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(bound)
+        );
+
+    for (n = 0U; n < batch_strips; ++n)
+    {
+        if (!strip_data[n])
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            failed = true;
+            return;
+        }
+    }
+
+    for (n = 0U; n < 4U; ++n)
+    {
+        header[4U + n] = static_cast<unsigned char>(width >> (24U - 8U * n));
+        header[8U + n] = static_cast<unsigned char>(height >> (24U - 8U * n));
+    }
+
+    header[12] = 3U;
+    header[13] = 0U;
+
+    if (!cvp::io::write_all(fp, header, sizeof(header)))
+        std::puts("ERROR: write failed.");
+}
+/*  End of cvp::qoi::init.                                                    */
+
+/*  Initialize using the values in "setup".                                   */
+inline void cvp::qoi::init(void)
+{
+    init(cvp::setup::xsize, cvp::setup::ysize);
+}
+
+/*  Initialize using the resolution of a viewport.                            */
+template <typename Tview>
+inline void cvp::qoi::init(const Tview &view)
+{
+    init(view.xsize, view.ysize);
+}
+
+/*  Copies the bytes into the batch, writing it out each time it fills up.    *
+ *  The last batch of the image is cut short at the last row.                 */
+inline void cvp::qoi::write(const void *data, std::size_t bytes)
+{
+    const unsigned char *in = static_cast<const unsigned char *>(data);
+
+    while (bytes > 0U && !failed)
+    {
+        const unsigned int left = height - rows_done;
+        const std::size_t rows = (left < batch_rows ? left : batch_rows);
+        const std::size_t room = rows * row_bytes - size;
+        const std::size_t piece = (bytes < room ? bytes : room);
+
+        if (room == 0U)
+        {
+            std::puts("ERROR: More pixels than fit in the QOI.");
+            failed = true;
+            return;
+        }
+
+        std::memcpy(raw + size, in, piece);
+        size += piece;
+        in += piece;
+        bytes -= piece;
+
+        if (size == rows * row_bytes)
+            write_batch();
+    }
+}
+
+/*  Appends a row of packed RGB pixels.                                       */
+inline void cvp::qoi::write_row(const void *rgb, unsigned int width)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width));
+}
+
+/*  Appends several consecutive rows of packed RGB pixels.                    */
+inline void cvp::qoi::write_rows(const void *rgb, unsigned int width,
+                                 unsigned int rows)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width) * rows);
+}
+
+/*  The pixels of a QOI are compressed, there is nothing to map.              */
+inline bool cvp::qoi::map(void)
+{
+    return false;
+}
+
+/*  Never called, since map always fails.                                     */
+inline unsigned char *cvp::qoi::pixel(unsigned int x, unsigned int y) const
+{
+    (void)x;
+    (void)y;
+    return NULL;
+}
+
+/*  Writes the end marker, frees the buffers, and closes the file.            */
+inline void cvp::qoi::close(void)
+{
+    /*  A QOI ends with seven zeros and a one.                                */
+    const unsigned char end[8] = {0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U};
+    unsigned int n;
+
+    if (!fp)
+        return;
+
+    if (!failed && rows_done != height)
+        std::puts("ERROR: The QOI is missing rows.");
+
+    if (!cvp::io::write_all(fp, end, sizeof(end)))
+        std::puts("ERROR: write failed.");
+
+    if (strip_data)
+    {
+        for (n = 0U; n < batch_strips; ++n)
+            cvp::memory::aligned_free(strip_data[n]);
+    }
+
+    cvp::memory::aligned_free(raw);
+    cvp::memory::aligned_free(strip_data);
+    cvp::memory::aligned_free(strip_size);
+    raw = NULL;
+    strip_data = NULL;
+    strip_size = NULL;
+
+    std::fclose(fp);
+    fp = NULL;
+}
+
+/*  Encodes the rows of the n^th strip, starting from a fresh state.          */
+inline void cvp::qoi::encode_strip(unsigned int n)
+{
+    const unsigned int rows = static_cast<unsigned int>(size / row_bytes);
+    const unsigned int first = n * strip_rows;
+    const unsigned int last = (first + strip_rows < rows ?
+                               first + strip_rows : rows);
+
+    /*  The first strip of the file may start from the state of the file.     */
+    cvp::qoi_state strip = cvp::qoi_state();
+    std::size_t written;
+
+    if (rows_done + first != 0U)
+        strip.reset();
+
+    written = strip.encode(
+        raw + first * row_bytes,
+        static_cast<std::size_t>(last - first) * width, strip_data[n]
+    );
+
+    strip_size[n] = written + strip.finish(strip_data[n] + written);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::qoi::write_batch                                                 *
+ *  Purpose:                                                                  *
+ *      Encodes and writes the rows received since the last batch.            *
+ *  Arguments:                                                                *
+ *      None.                                                                 *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      A single stream carries its state from batch to batch, and only ends  *
+ *      its last run at the end of the image. Strips are encoded by the tile  *
+ *      engine and written in order.                                          *
+ *  Notes:                                                                    *
+ *      When called from the pipelined renderer, which already runs on all    *
+ *      threads, the tile engine gets a single thread and the strips are      *
+ *      encoded in turn.                                                      *
+ ******************************************************************************/
+inline void cvp::qoi::write_batch(void)
+{
+    const unsigned int rows = static_cast<unsigned int>(size / row_bytes);
+    unsigned int n;
+
+    if (strip_rows == 0U)
+    {
+        std::size_t written = state.encode(
+            raw, static_cast<std::size_t>(rows) * width, strip_data[0]
+        );
+
+        if (rows_done + rows == height)
+            written += state.finish(strip_data[0] + written);
+
+        if (!cvp::io::write_all(fp, strip_data[0], written))
+            std::puts("ERROR: write failed.");
+    }
+    else
+    {
+        const unsigned int strips = (rows + strip_rows - 1U) / strip_rows;
+        cvp::qoi_strip_job job = cvp::qoi_strip_job(*this);
+
+        cvp::run_tiles(strips, job);
+
+        for (n = 0U; n < strips; ++n)
+        {
+            if (!cvp::io::write_all(fp, strip_data[n], strip_size[n]))
+                std::puts("ERROR: write failed.");
+        }
+    }
+
+    rows_done += rows;
+    size = 0U;
+}
+/*  End of cvp::qoi::write_batch.                                             */
+
+/*  Constructor from the QOI.                                                 */
+cvp::qoi_strip_job::qoi_strip_job(cvp::qoi &Q) : QOI(Q)
+{
+    return;
+}
+
+/*  Encodes the n^th strip.                                                   */
+inline void cvp::qoi_strip_job::operator () (unsigned int n)
+{
+    QOI.encode_strip(n);
+}
+
+#endif
+/*  End of include guard.                                                     */
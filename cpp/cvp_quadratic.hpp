@@ -0,0 +1,110 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides the quadratic map z^2, for which escape-time plots can skip  *
+ *      most of the interior of the Mandelbrot set.                           *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_QUADRATIC_HPP
+#define CVP_QUADRATIC_HPP
+
+/*  std::true_type and std::false_type found here.                            */
+#include <type_traits>
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The function z^2. Escape-time plots of this function are plots of the *
+     *  Mandelbrot set, and use its known geometry to skip interior points.   */
+    class quadratic {
+        public:
+            /*  Computes z^2. Works for cvp::complex and cvp::complex_batch.  */
+            template <typename T>
+            inline T operator () (const T &z) const;
+
+            /*  Whether (x, y) is in the main cardioid or the period-2 bulb.  *
+             *  T is double, or an extended precision type.                   */
+            template <typename T>
+            static inline bool in_cardioid_or_bulb(const T &x, const T &y);
+    };
+
+    /*  Tells whether a function is the quadratic map. Escape-time plots of   *
+     *  such functions use the interior shortcuts.                            */
+    template <typename Tfunc>
+    class is_quadratic : public std::false_type {};
+
+    template <>
+    class is_quadratic<cvp::quadratic> : public std::true_type {};
+
+    /*  Orbits coming within this squared distance of an earlier value are    *
+     *  treated as periodic by the escape-time plots.                         */
+    static const double periodicity_tolerance = 1.0E-24;
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Computes the square of the input.                                         */
+template <typename T>
+inline T cvp::quadratic::operator () (const T &z) const
+{
+    return z*z;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::quadratic::in_cardioid_or_bulb                                   *
+ *  Purpose:                                                                  *
+ *      Determines if a point lies in the main cardioid or the period-2 bulb  *
+ *      of the Mandelbrot set.                                                *
+ *  Arguments:                                                                *
+ *      x (const T &):                                                        *
+ *          The real part of the point.                                       *
+ *      y (const T &):                                                        *
+ *          The imaginary part of the point.                                  *
+ *  Outputs:                                                                  *
+ *      inside (bool):                                                        *
+ *          True if the point is in either region, and hence in the set.      *
+ *  Method:                                                                   *
+ *      With q = (x - 1/4)^2 + y^2, the main cardioid is the region where     *
+ *      q (q + x - 1/4) <= y^2 / 4. The period-2 bulb is the disk of radius   *
+ *      1/4 about -1. Together they are most of the area of the set.          *
+ ******************************************************************************/
+template <typename T>
+inline bool cvp::quadratic::in_cardioid_or_bulb(const T &x, const T &y)
+{
+    /*  Shifted x coordinate and the square of y, used by both tests.         */
+    const T xs = x - 0.25;
+    const T ysq = y*y;
+    const T q = xs*xs + ysq;
+
+    /*  Test for the main cardioid.                                           */
+    if (q*(q + xs) <= 0.25*ysq)
+        return true;
+
+    /*  Test for the disk about -1.                                           */
+    return (x + 1.0)*(x + 1.0) + ysq <= 0.0625;
+}
+/*  End of cvp::quadratic::in_cardioid_or_bulb.                               */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,471 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides the driver that runs a pixel kernel over an entire image.    *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_RENDER_HPP
+#define CVP_RENDER_HPP
+
+/*  strrchr and tolower, for telling the format from the name of a file.      */
+#include <cstring>
+#include <cctype>
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Classes for creating and writing to PPM, PNG, QOI, and TIFF files.        */
+#include "cvp_ppm.hpp"
+#include "cvp_png.hpp"
+#include "cvp_qoi.hpp"
+#include "cvp_tiff.hpp"
+
+/*  Viewports for mapping pixels to points in the plane.                      */
+#include "cvp_viewport.hpp"
+
+/*  Tile engine found here.                                                   */
+#include "cvp_tiles.hpp"
+
+/*  Options for the rendering routines.                                       */
+#include "cvp_options.hpp"
+
+/*  Pipelined renderer for streaming bands of rows.                           */
+#include "cvp_pipeline.hpp"
+
+/*  Renderer using Mariani-Silver subdivision of rectangles.                  */
+#include "cvp_subdivide.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Job for the tile engine, runs a kernel over a tile of a framebuffer.  */
+    template <typename Tkernel>
+    class tile_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::framebuffer &frame;
+
+            /*  Constructor from the kernel and the output framebuffer.       */
+            tile_job(const Tkernel &k, const cvp::framebuffer &f);
+
+            /*  Computes every pixel of the n^th tile.                        */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Job for the tile engine, runs a kernel over a tile of a mapped file.  */
+    template <typename Tkernel, typename Timage>
+    class mapped_tile_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::tile_grid &grid;
+            const Timage &image;
+
+            /*  Constructor from the kernel, the tiling, and the mapped file. */
+            mapped_tile_job(const Tkernel &k, const cvp::tile_grid &g,
+                            const Timage &im);
+
+            /*  Computes every pixel of the n^th tile, in place.              */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Renders an image in tiles and then writes it to a file.               */
+    template <typename Tkernel, typename Timage>
+    inline void
+    render_tiled(const Tkernel &kernel, unsigned int xsize,
+                 unsigned int ysize, Timage &image);
+
+    /*  Renders an image in tiles directly into a memory-mapped file.         */
+    template <typename Tkernel, typename Timage>
+    inline void
+    render_mapped(const Tkernel &kernel, unsigned int xsize,
+                  unsigned int ysize, Timage &image);
+
+    /*  The file formats images can be written in.                            */
+    enum image_format {
+
+        /*  Uncompressed binary PPM (P6).                                     */
+        ppm_format,
+
+        /*  PNG, compressed with deflate.                                     */
+        png_format,
+
+        /*  QOI, the "Quite OK Image" format, fast to compress.               */
+        qoi_format,
+
+        /*  Tiled BigTIFF, written a tile at a time in any order.             */
+        tiff_format
+    };
+
+    /*  Compares the extension of a file name with ext, ignoring case.        */
+    inline bool has_extension(const char *name, const char *ext);
+
+    /*  The format for a file name. Names ending in .png are PNG files, names *
+     *  ending in .qoi are QOI files, .tif or .tiff are TIFF files, and       *
+     *  everything else is a PPM file.                                        */
+    inline cvp::image_format format_of(const char *name);
+
+    /*  Renders an image into an opened file, of any format, with the         *
+     *  scheduling strategy given by the options, and closes the file.        */
+    template <typename Tkernel, typename Tview, typename Timage>
+    inline void render_image(const Tkernel &kernel, const Tview &view,
+                             Timage &image, const cvp::render_options &opts);
+
+    /*  Renders an image from a pixel kernel and writes it to a file.         */
+    template <typename Tkernel>
+    inline void render(const Tkernel &kernel, const char *name);
+
+    /*  Same as render, but with options for how to schedule the work.        */
+    template <typename Tkernel>
+    inline void render(const Tkernel &kernel, const char *name,
+                       const cvp::render_options &opts);
+
+    /*  Same as render, but for the resolution of the given viewport.         */
+    template <typename Tkernel, typename Tview>
+    inline void render(const Tkernel &kernel, const Tview &view,
+                       const char *name, const cvp::render_options &opts);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the kernel and the output framebuffer.                   */
+template <typename Tkernel>
+cvp::tile_job<Tkernel>::tile_job(const Tkernel &k, const cvp::framebuffer &f)
+    : kernel(k), frame(f)
+{
+    return;
+}
+
+/*  Computes every pixel of the n^th tile, one row of the tile at a time.     */
+template <typename Tkernel>
+inline void cvp::tile_job<Tkernel>::operator () (unsigned int n)
+{
+    /*  Index for the rows of the tile.                                       */
+    unsigned int row;
+
+    /*  The location of the tile in the image, and its private buffer.        */
+    const cvp::tile t = frame.grid.get(n);
+    cvp::color * const out = frame.tile_data(n);
+
+    for (row = 0U; row < t.height; ++row)
+        kernel(t.x, t.y + row, t.width, out + row*t.width);
+}
+
+/*  Constructor from the kernel, the tiling, and the mapped file.             */
+template <typename Tkernel, typename Timage>
+cvp::mapped_tile_job<Tkernel, Timage>::mapped_tile_job(const Tkernel &k,
+                                                       const cvp::tile_grid &g,
+                                                       const Timage &im)
+    : kernel(k), grid(g), image(im)
+{
+    return;
+}
+
+/*  Computes the n^th tile, writing each row straight into the mapped file.   */
+template <typename Tkernel, typename Timage>
+inline void
+cvp::mapped_tile_job<Tkernel, Timage>::operator () (unsigned int n)
+{
+    /*  Index for the rows of the tile.                                       */
+    unsigned int row;
+
+    /*  The location of the tile in the image.                                */
+    const cvp::tile t = grid.get(n);
+
+    for (row = 0U; row < t.height; ++row)
+    {
+        /*  The row of the tile lives in the file at pixel (t.x, t.y + row).  */
+        cvp::color * const out =
+            reinterpret_cast<cvp::color *>(image.pixel(t.x, t.y + row));
+
+        kernel(t.x, t.y + row, t.width, out);
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_tiled                                                     *
+ *  Purpose:                                                                  *
+ *      Renders an image in tiles and then writes it to a file.               *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      xsize (unsigned int):                                                 *
+ *          The number of pixels in the x axis.                               *
+ *      ysize (unsigned int):                                                 *
+ *          The number of pixels in the y axis.                               *
+ *      image (Timage &):                                                     *
+ *          An initialized image file of any format, like a cvp::ppm.         *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Split the image into tiles and compute them with the work-stealing    *
+ *      tile engine, then write the tiles out in scanline order.              *
+ ******************************************************************************/
+template <typename Tkernel, typename Timage>
+inline void
+cvp::render_tiled(const Tkernel &kernel, unsigned int xsize,
+                  unsigned int ysize, Timage &image)
+{
+    /*  Split the image into cache-sized tiles.                               */
+    const cvp::tile_grid grid = cvp::tile_grid(
+        xsize, ysize, cvp::tiles::width, cvp::tiles::height
+    );
+
+    /*  Storage for the computed tiles.                                       */
+    cvp::framebuffer frame = cvp::framebuffer(grid);
+
+    /*  Job for the tile engine, fills the framebuffer.                       */
+    cvp::tile_job<Tkernel> job = cvp::tile_job<Tkernel>(kernel, frame);
+
+    /*  Check if malloc failed.                                               */
+    if (!frame.data)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        return;
+    }
+
+    /*  Compute every tile in parallel and write the result.                  */
+    cvp::run_tiles(grid.count, job);
+    frame.write(image);
+    frame.destroy();
+}
+/*  End of cvp::render_tiled.                                                 */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_mapped                                                    *
+ *  Purpose:                                                                  *
+ *      Renders an image in tiles directly into a memory-mapped file.         *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      xsize (unsigned int):                                                 *
+ *          The number of pixels in the x axis.                               *
+ *      ysize (unsigned int):                                                 *
+ *          The number of pixels in the y axis.                               *
+ *      image (Timage &):                                                     *
+ *          An initialized image file of any format, like a cvp::ppm.         *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Map the file and let the tile engine write every tile straight into   *
+ *      its final place. There is no intermediate framebuffer and no serial   *
+ *      write-out loop, the kernel's stores are the output. If the file       *
+ *      cannot be mapped, fall back to render_tiled. Only PPM files can be    *
+ *      mapped, render sends the other formats elsewhere.                     *
+ ******************************************************************************/
+template <typename Tkernel, typename Timage>
+inline void
+cvp::render_mapped(const Tkernel &kernel, unsigned int xsize,
+                   unsigned int ysize, Timage &image)
+{
+    /*  Split the image into cache-sized tiles.                               */
+    const cvp::tile_grid grid = cvp::tile_grid(
+        xsize, ysize, cvp::tiles::width, cvp::tiles::height
+    );
+
+    /*  Job for the tile engine, fills the mapped file.                       */
+    cvp::mapped_tile_job<Tkernel, Timage> job =
+        cvp::mapped_tile_job<Tkernel, Timage>(kernel, grid, image);
+
+    /*  mmap is not available everywhere. Stream the image instead.           */
+    if (!image.map())
+    {
+        std::puts("WARNING: mmap failed, using the tiled renderer instead.");
+        cvp::render_tiled(kernel, xsize, ysize, image);
+        return;
+    }
+
+    cvp::run_tiles(grid.count, job);
+}
+/*  End of cvp::render_mapped.                                                */
+
+/*  Renders an image from a pixel kernel using the default options.           */
+template <typename Tkernel>
+inline void cvp::render(const Tkernel &kernel, const char *name)
+{
+    cvp::render(kernel, cvp::default_viewport(), name, cvp::render_options());
+}
+
+/*  Renders an image at the default resolution with the given options.        */
+template <typename Tkernel>
+inline void cvp::render(const Tkernel &kernel, const char *name,
+                        const cvp::render_options &opts)
+{
+    cvp::render(kernel, cvp::default_viewport(), name, opts);
+}
+
+/*  Compares the extension with ext, which is lower case, ignoring case. The  *
+ *  comparison stops at the first character that differs, so it never reads   *
+ *  past the name.                                                            */
+inline bool cvp::has_extension(const char *name, const char *ext)
+{
+    const char *extension = std::strrchr(name, '.');
+    unsigned int n;
+
+    if (!extension)
+        return false;
+
+    for (n = 0U; ext[n] != '\0'; ++n)
+    {
+        const unsigned char c = static_cast<unsigned char>(extension[n + 1U]);
+
+        if (std::tolower(c) != ext[n])
+            return false;
+    }
+
+    return (extension[n + 1U] == '\0');
+}
+
+/*  Picks the format from the extension of the name.                          */
+inline cvp::image_format cvp::format_of(const char *name)
+{
+    if (cvp::has_extension(name, "png"))
+        return cvp::png_format;
+
+    if (cvp::has_extension(name, "qoi"))
+        return cvp::qoi_format;
+
+    if (cvp::has_extension(name, "tif") || cvp::has_extension(name, "tiff"))
+        return cvp::tiff_format;
+
+    return cvp::ppm_format;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_image                                                     *
+ *  Purpose:                                                                  *
+ *      Renders an image into an opened file and closes it.                   *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      view (const Tview &):                                                 *
+ *          The viewport, only its resolution xsize and ysize is used here.   *
+ *      image (Timage &):                                                     *
+ *          An image file of any format, like a cvp::ppm, that was just       *
+ *          opened.                                                           *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how the work is scheduled.                            *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Notes:                                                                    *
+ *      Every renderer writes through the same few methods of the file, so    *
+ *      any strategy works with any format.                                   *
+ ******************************************************************************/
+template <typename Tkernel, typename Tview, typename Timage>
+inline void cvp::render_image(const Tkernel &kernel, const Tview &view,
+                              Timage &image, const cvp::render_options &opts)
+{
+    /*  Check if the constructor failed.                                      */
+    if (!image.fp)
+        return;
+
+    /*  Initialize the file to the size of the viewport.                      */
+    image.init(view);
+
+    /*  Compute the image using the requested strategy.                       */
+    if (opts.mode == cvp::pipelined_mode)
+        cvp::render_pipelined(kernel, view.xsize, view.ysize, image, opts);
+
+    else if (opts.mode == cvp::mapped_mode)
+        cvp::render_mapped(kernel, view.xsize, view.ysize, image);
+
+    else if (opts.mode == cvp::subdivide_mode)
+        cvp::render_subdivided(kernel, view.xsize, view.ysize, image, opts);
+
+    else
+        cvp::render_tiled(kernel, view.xsize, view.ysize, image);
+
+    /*  Close the file.                                                       */
+    image.close();
+}
+/*  End of cvp::render_image.                                                 */
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render                                                           *
+ *  Purpose:                                                                  *
+ *      Renders an image from a pixel kernel and writes it to a file.         *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      view (const Tview &):                                                 *
+ *          The viewport, only its resolution xsize and ysize is used here.   *
+ *      name (const char *):                                                  *
+ *          The name of the output file. A PNG file if it ends in .png, a QOI *
+ *          file if it ends in .qoi, a TIFF file if it ends in .tif or .tiff, *
+ *          and a PPM file otherwise.                                         *
+ *      opts (const cvp::render_options &):                                   *
+ *          Options for how the work is scheduled, and how hard to compress.  *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ ******************************************************************************/
+template <typename Tkernel, typename Tview>
+inline void cvp::render(const Tkernel &kernel, const Tview &view,
+                        const char *name, const cvp::render_options &opts)
+{
+    const cvp::image_format format = cvp::format_of(name);
+
+    /*  Compressed files cannot be mapped, stream them with the tiled         *
+     *  renderer instead.                                                     */
+    cvp::render_options stream_opts = opts;
+
+    if (stream_opts.mode == cvp::mapped_mode)
+        stream_opts.mode = cvp::tiled_mode;
+
+    if (format == cvp::png_format)
+    {
+        cvp::png PNG = cvp::png(name, opts.compression_level);
+        cvp::render_image(kernel, view, PNG, stream_opts);
+    }
+    else if (format == cvp::qoi_format)
+    {
+        cvp::qoi QOI = cvp::qoi(name, opts.strip_rows);
+        cvp::render_image(kernel, view, QOI, stream_opts);
+    }
+    else if (format == cvp::tiff_format)
+    {
+        cvp::tiff TIFF = cvp::tiff(name, opts.compression_level);
+
+        /*  The tiled modes write each tile of the file as it is finished.    *
+         *  The others make rows, and the file cuts them into tiles.          */
+        if (stream_opts.mode == cvp::tiled_mode)
+            cvp::render_tiff(kernel, view, TIFF);
+        else
+            cvp::render_image(kernel, view, TIFF, stream_opts);
+    }
+    else
+    {
+        cvp::ppm PPM = cvp::ppm(name);
+        cvp::render_image(kernel, view, PPM, opts);
+    }
+}
+/*  End of cvp::render.                                                       */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,388 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides monic polynomials given by their roots, and Newton's method  *
+ *      for them using the logarithmic derivative p'/p = sum 1 / (z - r_k).   *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_ROOT_POLYNOMIAL_HPP
+#define CVP_ROOT_POLYNOMIAL_HPP
+
+/*  HUGE_VAL found here.                                                      */
+#include <cmath>
+
+/*  Complex class provided here.                                              */
+#include "cvp_complex.hpp"
+
+/*  Batches of complex numbers, for evaluating several pixels at once.        */
+#include "cvp_batch.hpp"
+
+/*  Lists of attractors, used to label the basins of the roots.               */
+#include "cvp_attractors.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The monic polynomial (z - r_0)(z - r_1)...(z - r_{n-1}). The roots    *
+     *  are stored inline, so kernels can copy it without allocating.         */
+    class root_polynomial {
+        public:
+            /*  The largest degree that can be stored.                        */
+            static const unsigned int max_degree = cvp::attractors::max_count;
+
+            /*  The number of roots summed as one fraction by newton_step.    */
+            static const unsigned int group_size = 8U;
+
+            /*  The roots and the number of them.                             */
+            cvp::complex roots[max_degree];
+            unsigned int degree;
+
+            /*  Empty constructor, the constant polynomial 1.                 */
+            root_polynomial(void);
+
+            /*  Constructor from an array of n roots.                         */
+            root_polynomial(const cvp::complex *r, unsigned int n);
+
+            /*  Adds a root, multiplying by z - r. Ignored if full.           */
+            inline void add(const cvp::complex &r);
+
+            /*  Evaluates the product. T is cvp::complex, cvp::complex_batch, *
+             *  or a cvp::dual of these. The degree must be at least one.     */
+            template <typename T>
+            inline T operator () (const T &z) const;
+
+            /*  Computes z - p(z) / p'(z) in the precision of z.              */
+            template <typename T>
+            inline cvp::basic_complex<T>
+            newton_step(const cvp::basic_complex<T> &z) const;
+
+            /*  Computes z - p(z) / p'(z) for every lane of a batch.          */
+            template <unsigned int N>
+            inline cvp::complex_batch<N>
+            newton_step(const cvp::complex_batch<N> &z) const;
+
+            /*  The roots as attractors. Every converged point is labeled by  *
+             *  the nearest root, however far away it is.                     */
+            inline cvp::attractors basins(void) const;
+    };
+
+    /*  Newton's method for a polynomial given by its roots, z - p(z) / p'(z) *
+     *  computed as z - 1 / (p'(z) / p(z)).                                   */
+    class root_newton {
+        public:
+            /*  The polynomial whose roots are being found.                   */
+            cvp::root_polynomial poly;
+
+            /*  Constructor from the polynomial.                              */
+            root_newton(const cvp::root_polynomial &p);
+
+            /*  Computes one Newton step. Works for every precision of        *
+             *  cvp::basic_complex, and for cvp::complex_batch.               */
+            template <typename T>
+            inline T operator () (const T &z) const;
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Empty constructor, no roots.                                              */
+cvp::root_polynomial::root_polynomial(void) : degree(0U)
+{
+    return;
+}
+
+/*  Constructor from an array of roots, keeping at most max_degree of them.   */
+cvp::root_polynomial::root_polynomial(const cvp::complex *r, unsigned int n)
+    : degree(0U)
+{
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+        add(r[k]);
+}
+
+/*  Adds a root to the end of the list.                                       */
+inline void cvp::root_polynomial::add(const cvp::complex &r)
+{
+    if (degree == max_degree)
+        return;
+
+    roots[degree] = r;
+    ++degree;
+}
+
+/*  Evaluates the product of z - r_k over the roots.                          */
+template <typename T>
+inline T cvp::root_polynomial::operator () (const T &z) const
+{
+    unsigned int k;
+    T out = z - roots[0];
+
+    for (k = 1U; k < degree; ++k)
+        out = out * (z - roots[k]);
+
+    return out;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::root_polynomial::newton_step                                     *
+ *  Purpose:                                                                  *
+ *      Computes one step of Newton's method, z - p(z) / p'(z).               *
+ *  Arguments:                                                                *
+ *      z (const cvp::basic_complex<T> &):                                    *
+ *          A complex number.                                                 *
+ *  Outputs:                                                                  *
+ *      w (cvp::basic_complex<T>):                                            *
+ *          The value z - p(z) / p'(z).                                       *
+ *  Method:                                                                   *
+ *      Taking the log of the product and differentiating gives the           *
+ *      logarithmic derivative p'/p = sum 1 / (z - r_k), and the step is      *
+ *      z - 1 / (p'/p). Unlike evaluating p and p' and dividing, this never   *
+ *      forms the whole product, which overflows or loses precision for high  *
+ *      degrees, and the sum is dominated by the nearest root.                *
+ *                                                                            *
+ *      Divisions are slow, especially as vectors, so the terms are not       *
+ *      divided out one at a time. Instead the roots are taken in groups of   *
+ *      group_size, and the sum over a group is kept as a fraction n / q.     *
+ *      The roots of a group are added in pairs. With d_0 and d_1 the         *
+ *      differences for the pair, 1 / d_0 + 1 / d_1 = (d_0 + d_1) / (d_0 d_1) *
+ *      and adding a / b to n / q gives (n b + a q) / (q b). That is two      *
+ *      complex products per root, and one real division per group. Doing     *
+ *      pairs keeps the chain of dependent products short. The groups are     *
+ *      small so that q cannot overflow or underflow for any reasonable z.    *
+ *  Notes:                                                                    *
+ *      Newton's method often lands exactly on a root. Then the product of    *
+ *      its group is zero and the sum is not a number. Such points are fixed, *
+ *      and are returned as they are.                                         *
+ ******************************************************************************/
+template <typename T>
+inline cvp::basic_complex<T>
+cvp::root_polynomial::newton_step(const cvp::basic_complex<T> &z) const
+{
+    unsigned int k, end;
+
+    /*  The sum of 1 / (z - r_k) over all of the roots.                       */
+    cvp::basic_complex<T> s = cvp::basic_complex<T>(T(0.0), T(0.0));
+
+    /*  Whether z is exactly one of the roots.                                */
+    bool at_root = false;
+
+    for (k = 0U; k < degree; k = end)
+    {
+        /*  The sum over the group is num / den, starting from 0 / 1.         */
+        cvp::basic_complex<T> num = cvp::basic_complex<T>(T(0.0), T(0.0));
+        cvp::basic_complex<T> den = cvp::basic_complex<T>(T(1.0), T(0.0));
+        T den_sq, scale;
+
+        end = (degree - k < group_size ? degree : k + group_size);
+
+        for (; k + 1U < end; k += 2U)
+        {
+            const cvp::basic_complex<T> d0 =
+                z - cvp::basic_complex<T>(roots[k]);
+            const cvp::basic_complex<T> d1 =
+                z - cvp::basic_complex<T>(roots[k + 1U]);
+            const cvp::basic_complex<T> pair_den = d0*d1;
+
+            num = num*pair_den + (d0 + d1)*den;
+            den = den*pair_den;
+        }
+
+        /*  A group with an odd number of roots has one left over.            */
+        if (k < end)
+        {
+            const cvp::basic_complex<T> d =
+                z - cvp::basic_complex<T>(roots[k]);
+
+            num = num*d + den;
+            den = den*d;
+            ++k;
+        }
+
+        /*  num / den = num conj(den) / |den|^2. The product is zero if z is  *
+         *  one of the roots of the group.                                    */
+        den_sq = den.real*den.real + den.imag*den.imag;
+        scale = 1.0 / den_sq;
+        at_root = at_root || (den_sq == 0.0);
+        s.real = s.real + (num.real*den.real + num.imag*den.imag)*scale;
+        s.imag = s.imag + (num.imag*den.real - num.real*den.imag)*scale;
+    }
+
+    if (at_root)
+        return z;
+
+    return z - s.rcpr();
+}
+/*  End of cvp::root_polynomial::newton_step.                                 */
+
+/*  Same as above for each lane of a batch. The roots are the outer loops and *
+ *  the lanes the inner ones, which are vectorized. The arithmetic is the     *
+ *  same as for cvp::complex, so the results are identical.                   */
+template <unsigned int N>
+inline cvp::complex_batch<N>
+cvp::root_polynomial::newton_step(const cvp::complex_batch<N> &z) const
+{
+    unsigned int k, end, lane;
+
+    /*  The sum of 1 / (z - r_k), and the fraction for the current group.     */
+    cvp::complex_batch<N> s = cvp::complex_batch<N>(cvp::complex(0.0, 0.0));
+    cvp::complex_batch<N> num, den, out;
+
+    /*  Nonzero for the lanes that are exactly one of the roots. 64 bits wide *
+     *  so that the selects vectorize, as in the kernels.                     */
+    long long at_root[N];
+
+    for (lane = 0U; lane < N; ++lane)
+        at_root[lane] = 0;
+
+    for (k = 0U; k < degree; k = end)
+    {
+        end = (degree - k < group_size ? degree : k + group_size);
+
+        for (lane = 0U; lane < N; ++lane)
+        {
+            num.real[lane] = 0.0;
+            num.imag[lane] = 0.0;
+            den.real[lane] = 1.0;
+            den.imag[lane] = 0.0;
+        }
+
+        for (; k + 1U < end; k += 2U)
+        {
+            const double r0_re = roots[k].real;
+            const double r0_im = roots[k].imag;
+            const double r1_re = roots[k + 1U].real;
+            const double r1_im = roots[k + 1U].imag;
+
+#if CVP_SIMD_MASKS
+#pragma omp simd
+#endif
+            for (lane = 0U; lane < N; ++lane)
+            {
+                const double d0_re = z.real[lane] - r0_re;
+                const double d0_im = z.imag[lane] - r0_im;
+                const double d1_re = z.real[lane] - r1_re;
+                const double d1_im = z.imag[lane] - r1_im;
+                const double p_re = d0_re*d1_re - d0_im*d1_im;
+                const double p_im = d0_re*d1_im + d0_im*d1_re;
+                const double a_re = d0_re + d1_re;
+                const double a_im = d0_im + d1_im;
+                const double n_re = num.real[lane];
+                const double n_im = num.imag[lane];
+                const double q_re = den.real[lane];
+                const double q_im = den.imag[lane];
+
+                /*  num p + (d0 + d1) den and den p, with p = d0 d1.          */
+                num.real[lane] = (n_re*p_re - n_im*p_im) +
+                                 (a_re*q_re - a_im*q_im);
+                num.imag[lane] = (n_re*p_im + n_im*p_re) +
+                                 (a_re*q_im + a_im*q_re);
+                den.real[lane] = q_re*p_re - q_im*p_im;
+                den.imag[lane] = q_re*p_im + q_im*p_re;
+            }
+        }
+
+        /*  A group with an odd number of roots has one left over.            */
+        if (k < end)
+        {
+            const double r_re = roots[k].real;
+            const double r_im = roots[k].imag;
+
+#if CVP_SIMD_MASKS
+#pragma omp simd
+#endif
+            for (lane = 0U; lane < N; ++lane)
+            {
+                const double d_re = z.real[lane] - r_re;
+                const double d_im = z.imag[lane] - r_im;
+                const double n_re = num.real[lane];
+                const double n_im = num.imag[lane];
+                const double q_re = den.real[lane];
+                const double q_im = den.imag[lane];
+
+                /*  num d + den and den d.                                    */
+                num.real[lane] = (n_re*d_re - n_im*d_im) + q_re;
+                num.imag[lane] = (n_re*d_im + n_im*d_re) + q_im;
+                den.real[lane] = q_re*d_re - q_im*d_im;
+                den.imag[lane] = q_re*d_im + q_im*d_re;
+            }
+
+            ++k;
+        }
+
+#if CVP_SIMD_MASKS
+#pragma omp simd
+#endif
+        for (lane = 0U; lane < N; ++lane)
+        {
+            const double re = num.real[lane]*den.real[lane] +
+                              num.imag[lane]*den.imag[lane];
+            const double im = num.imag[lane]*den.real[lane] -
+                              num.real[lane]*den.imag[lane];
+            const double den_sq = den.real[lane]*den.real[lane] +
+                                  den.imag[lane]*den.imag[lane];
+            const double scale = 1.0 / den_sq;
+
+            at_root[lane] |= static_cast<long long>(den_sq == 0.0);
+            s.real[lane] = s.real[lane] + re*scale;
+            s.imag[lane] = s.imag[lane] + im*scale;
+        }
+    }
+
+    out = z - s.rcpr();
+
+#if CVP_SIMD_MASKS
+#pragma omp simd
+#endif
+    for (lane = 0U; lane < N; ++lane)
+    {
+        out.real[lane] = (at_root[lane] ? z.real[lane] : out.real[lane]);
+        out.imag[lane] = (at_root[lane] ? z.imag[lane] : out.imag[lane]);
+    }
+
+    return out;
+}
+
+/*  The roots as attractors with an infinite radius, so that the label of a   *
+ *  converged point is the index of the closest root.                         */
+inline cvp::attractors cvp::root_polynomial::basins(void) const
+{
+    return cvp::attractors(roots, degree, HUGE_VAL);
+}
+
+/*  Constructor from the polynomial.                                          */
+cvp::root_newton::root_newton(const cvp::root_polynomial &p) : poly(p)
+{
+    return;
+}
+
+/*  One Newton step, z - 1 / (p'(z) / p(z)).                                  */
+template <typename T>
+inline T cvp::root_newton::operator () (const T &z) const
+{
+    return poly.newton_step(z);
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,235 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides row colorers, which color a row of complex numbers stored as *
+ *      arrays of real and imaginary parts and write packed RGB bytes. Every  *
+ *      colorer of a complex number can be used as one.                       *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_ROW_COLORERS_HPP
+#define CVP_ROW_COLORERS_HPP
+
+/*  std::true_type, std::false_type, and std::declval found here.             */
+#include <type_traits>
+#include <utility>
+
+/*  Complex class defined here.                                               */
+#include "cvp_complex.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  The built-in colorers, and the palettes they use.                         */
+#include "cvp_colorers.hpp"
+#include "cvp_palette.hpp"
+
+/*  The fast color wheel and its row version.                                 */
+#include "cvp_fast_color.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The number of pixels the kernels color at a time, when they have to   *
+     *  collect the points into a row first.                                  */
+    static const unsigned int row_block = 256U;
+
+    /*  Colorers that are plain functions of a complex number.                */
+    typedef cvp::color (*complex_colorer)(cvp::complex);
+
+    /*  Row colorers that are plain functions.                                */
+    typedef void (*row_colorer)(const double *re, const double *im,
+                                unsigned int n, cvp::color *out);
+
+    /*  Tells whether a colorer has a row method,                             *
+     *      color.row(re, im, n, out).                                        *
+     *  Derives from std::true_type if so, and std::false_type otherwise.     */
+    template <typename Tcolor>
+    class has_row {
+        private:
+            template <typename T>
+            static std::true_type test(
+                decltype(std::declval<const T &>().row(
+                    std::declval<const double *>(),
+                    std::declval<const double *>(),
+                    0U, std::declval<cvp::color *>()
+                )) *
+            );
+
+            template <typename T>
+            static std::false_type test(...);
+
+        public:
+            typedef decltype(test<Tcolor>(0)) type;
+            static const bool value = type::value;
+    };
+
+    /*  Row versions of the built-in colorers.                                */
+    inline void color_from_complex_row(const double *re, const double *im,
+                                       unsigned int n, cvp::color *out);
+
+    inline void
+    color_wheel_from_complex_row(const double *re, const double *im,
+                                 unsigned int n, cvp::color *out);
+
+    /*  Returns the row version of a built-in colorer, or a null pointer if   *
+     *  there is none.                                                        */
+    inline cvp::row_colorer find_row_colorer(cvp::complex_colorer color);
+
+    /*  Colors the n points re[k] + i im[k] with any colorer of complex       *
+     *  numbers, writing packed RGB to out. Colorers with a row method and    *
+     *  built-in colorers use their row versions, which are vectorized.       *
+     *  Anything else is called one point at a time. Colorers without a row   *
+     *  method may return something other than a cvp::color, which is then    *
+     *  stored in an array of type Tout.                                      */
+    template <typename Tcolor, typename Tout>
+    inline void color_row(const Tcolor &color, const double *re,
+                          const double *im, unsigned int n, Tout *out);
+
+    inline void color_row(cvp::complex_colorer color, const double *re,
+                          const double *im, unsigned int n, cvp::color *out);
+
+    /*  The two cases of color_row for classes, with and without a row.       */
+    template <typename Tcolor, typename Tout>
+    inline void color_row(const Tcolor &color, const double *re,
+                          const double *im, unsigned int n, Tout *out,
+                          std::true_type);
+
+    template <typename Tcolor, typename Tout>
+    inline void color_row(const Tcolor &color, const double *re,
+                          const double *im, unsigned int n, Tout *out,
+                          std::false_type);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Row version of color_from_complex, a lookup in the rainbow palette.       */
+inline void cvp::color_from_complex_row(const double *re, const double *im,
+                                        unsigned int n, cvp::color *out)
+{
+    cvp::palettes::rainbow().row(re, im, n, out);
+}
+
+/*  Row version of color_wheel_from_complex, a lookup in the wheel palette.   */
+inline void
+cvp::color_wheel_from_complex_row(const double *re, const double *im,
+                                  unsigned int n, cvp::color *out)
+{
+    cvp::palettes::wheel().row(re, im, n, out);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      find_row_colorer                                                      *
+ *  Purpose:                                                                  *
+ *      Finds the row version of a colorer passed as a function pointer.      *
+ *  Arguments:                                                                *
+ *      color (cvp::complex_colorer):                                         *
+ *          A pointer to a colorer of complex numbers.                        *
+ *  Outputs:                                                                  *
+ *      row (cvp::row_colorer):                                               *
+ *          The row version of color, or a null pointer if it has none.       *
+ *  Method:                                                                   *
+ *      The built-in colorers are passed to the plotting routines as function *
+ *      pointers, so which one it is can only be told at run time. Compare    *
+ *      the pointer with each of them.                                        *
+ ******************************************************************************/
+inline cvp::row_colorer cvp::find_row_colorer(cvp::complex_colorer color)
+{
+    if (color == &cvp::color_wheel_from_complex)
+        return &cvp::color_wheel_from_complex_row;
+
+    if (color == &cvp::color_from_complex)
+        return &cvp::color_from_complex_row;
+
+    if (color == &cvp::fast_color_wheel_from_complex)
+        return &cvp::fast_color_wheel_from_complex_row;
+
+    if (color == &cvp::fast::color_wheel_from_complex<3U>)
+        return &cvp::fast::color_wheel_row<3U>;
+
+    if (color == &cvp::fast::color_wheel_from_complex<4U>)
+        return &cvp::fast::color_wheel_row<4U>;
+
+    if (color == &cvp::fast::color_wheel_from_complex<5U>)
+        return &cvp::fast::color_wheel_row<5U>;
+
+    if (color == &cvp::fast::color_wheel_from_complex<6U>)
+        return &cvp::fast::color_wheel_row<6U>;
+
+    if (color == &cvp::fast::color_wheel_from_complex<7U>)
+        return &cvp::fast::color_wheel_row<7U>;
+
+    return 0;
+}
+/*  End of find_row_colorer.                                                  */
+
+/*  Classes use their row method if they have one.                            */
+template <typename Tcolor, typename Tout>
+inline void cvp::color_row(const Tcolor &color, const double *re,
+                           const double *im, unsigned int n, Tout *out)
+{
+    cvp::color_row(color, re, im, n, out,
+                   typename cvp::has_row<Tcolor>::type());
+}
+
+/*  Function pointers use the row version of a built-in colorer if there is   *
+ *  one, and are otherwise called on each point.                              */
+inline void cvp::color_row(cvp::complex_colorer color, const double *re,
+                           const double *im, unsigned int n, cvp::color *out)
+{
+    const cvp::row_colorer row = cvp::find_row_colorer(color);
+    unsigned int k;
+
+    if (row)
+    {
+        row(re, im, n, out);
+        return;
+    }
+
+    for (k = 0U; k < n; ++k)
+        out[k] = color(cvp::complex(re[k], im[k]));
+}
+
+/*  The colorer has a row method, call it.                                    */
+template <typename Tcolor, typename Tout>
+inline void cvp::color_row(const Tcolor &color, const double *re,
+                           const double *im, unsigned int n, Tout *out,
+                           std::true_type)
+{
+    color.row(re, im, n, out);
+}
+
+/*  The colorer has no row method, lift it by calling it on each point.       */
+template <typename Tcolor, typename Tout>
+inline void cvp::color_row(const Tcolor &color, const double *re,
+                           const double *im, unsigned int n, Tout *out,
+                           std::false_type)
+{
+    unsigned int k;
+
+    for (k = 0U; k < n; ++k)
+        out[k] = color(cvp::complex(re[k], im[k]));
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -35,18 +35,29 @@ namespace cvp {
     namespace setup {
 
         /*  The plotting parameters for functions.                            */
-        const double xmin = -2.0;
-        const double xmax = +2.0;
-        const double ymin = -2.0;
-        const double ymax = +2.0;
+        constexpr double xmin = -2.0;
+        constexpr double xmax = +2.0;
+        constexpr double ymin = -2.0;
+        constexpr double ymax = +2.0;
 
         /*  The number of pixels in the x and y axes.                         */
-        const unsigned int xsize = 1024U;
-        const unsigned int ysize = 1024U;
+        constexpr unsigned int xsize = 1024U;
+        constexpr unsigned int ysize = 1024U;
 
         /*  Factors for converting from pixels to points in the plane.        */
-        const double pxfactor = (xmax - xmin) / static_cast<double>(xsize);
-        const double pyfactor = (ymax - ymin) / static_cast<double>(ysize);
+        constexpr double pxfactor = (xmax - xmin) / static_cast<double>(xsize);
+        constexpr double pyfactor = (ymax - ymin) / static_cast<double>(ysize);
+
+        /*  The parameters above as a type, for cvp::static_viewport.         */
+        class params {
+            public:
+                static constexpr double xmin = cvp::setup::xmin;
+                static constexpr double xmax = cvp::setup::xmax;
+                static constexpr double ymin = cvp::setup::ymin;
+                static constexpr double ymax = cvp::setup::ymax;
+                static constexpr unsigned int xsize = cvp::setup::xsize;
+                static constexpr unsigned int ysize = cvp::setup::ysize;
+        };
     }
     /*  End of namespace "setup".                                             */
 }
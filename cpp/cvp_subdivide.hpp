@@ -0,0 +1,449 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a renderer using Mariani-Silver subdivision. Only the border *
+ *      of a rectangle is computed, and the rectangle is filled in at once if *
+ *      the border is a single color.                                         *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_SUBDIVIDE_HPP
+#define CVP_SUBDIVIDE_HPP
+
+/*  size_t found here.                                                        */
+#include <cstddef>
+
+/*  memset found here.                                                        */
+#include <cstring>
+
+/*  printf and puts found here.                                               */
+#include <cstdio>
+
+/*  Lock-free atomic integers for counting mismatched pixels.                 */
+#include <atomic>
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Class for creating and writing to PPM files.                              */
+#include "cvp_ppm.hpp"
+
+/*  Tile engine found here.                                                   */
+#include "cvp_tiles.hpp"
+
+/*  Options for the rendering routines.                                       */
+#include "cvp_options.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  Another namespace to avoid name conflicts with other constants.       */
+    namespace subdivide {
+
+        /*  Rectangles narrower or shorter than this are computed directly.   *
+         *  Their borders are most of their pixels anyways.                   */
+        const unsigned int min_size = 4U;
+
+        /*  Number of pixels the validation computes per call to the kernel.  */
+        const unsigned int chunk = 64U;
+    }
+    /*  End of namespace "subdivide".                                         */
+
+    /*  Job for the tile engine, renders a tile by rectangle subdivision.     */
+    template <typename Tkernel>
+    class subdivide_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::framebuffer &frame;
+
+            /*  One byte per pixel of every tile, set once it is known.       */
+            unsigned char * const known;
+
+            /*  Constructor from the kernel, the framebuffer, and the mask.   */
+            subdivide_job(const Tkernel &k, const cvp::framebuffer &f,
+                          unsigned char *mask);
+
+            /*  Computes the n^th tile by subdivision.                        */
+            inline void operator () (unsigned int n);
+
+            /*  Computes the unknown pixels of a run in a row of a tile.      */
+            inline void
+            compute_run(const cvp::tile &t, cvp::color *out,
+                        unsigned char *mask, unsigned int x,
+                        unsigned int y, unsigned int length) const;
+
+            /*  Computes a rectangle of a tile, recursing if need be.         */
+            inline void
+            compute_rectangle(const cvp::tile &t, cvp::color *out,
+                              unsigned char *mask, unsigned int x,
+                              unsigned int y, unsigned int width,
+                              unsigned int height) const;
+    };
+
+    /*  Job for the tile engine, compares a tile with the brute-force result. */
+    template <typename Tkernel>
+    class validate_job {
+        public:
+            const Tkernel &kernel;
+            const cvp::framebuffer &frame;
+
+            /*  The total number of pixels that differ, over every tile.      */
+            std::atomic<unsigned long> mismatches;
+
+            /*  Constructor from the kernel and the subdivided image.         */
+            validate_job(const Tkernel &k, const cvp::framebuffer &f);
+
+            /*  Computes every pixel of the n^th tile and compares.           */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Renders an image by rectangle subdivision and writes it to a file.    */
+    template <typename Tkernel, typename Timage>
+    inline void
+    render_subdivided(const Tkernel &kernel, unsigned int xsize,
+                      unsigned int ysize, Timage &image,
+                      const cvp::render_options &opts);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the kernel, the framebuffer, and the mask.               */
+template <typename Tkernel>
+cvp::subdivide_job<Tkernel>::subdivide_job(const Tkernel &k,
+                                           const cvp::framebuffer &f,
+                                           unsigned char *mask)
+    : kernel(k), frame(f), known(mask)
+{
+    return;
+}
+
+/*  Computes the unknown pixels of a run in a row of a tile. Maximal runs of  *
+ *  unknown pixels are passed to the kernel in a single call.                 */
+template <typename Tkernel>
+inline void
+cvp::subdivide_job<Tkernel>::compute_run(const cvp::tile &t, cvp::color *out,
+                                         unsigned char *mask, unsigned int x,
+                                         unsigned int y,
+                                         unsigned int length) const
+{
+    /*  Offset of the start of the run in the tile.                           */
+    const std::size_t row = static_cast<std::size_t>(y) * t.width;
+
+    /*  Indices for the start and end of the runs of unknown pixels.          */
+    unsigned int start = x, end;
+
+    while (start < x + length)
+    {
+        /*  Skip pixels that have already been computed.                      */
+        if (mask[row + start])
+        {
+            ++start;
+            continue;
+        }
+
+        /*  Find the end of this run of unknown pixels.                       */
+        end = start + 1U;
+
+        while (end < x + length && !mask[row + end])
+            ++end;
+
+        kernel(t.x + start, t.y + y, end - start, out + row + start);
+        std::memset(mask + row + start, 1, end - start);
+        start = end;
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::subdivide_job::compute_rectangle                                 *
+ *  Purpose:                                                                  *
+ *      Computes a rectangle of a tile using Mariani-Silver subdivision.      *
+ *  Arguments:                                                                *
+ *      t (const cvp::tile &):                                                *
+ *          The tile the rectangle is in.                                     *
+ *      out (cvp::color *):                                                   *
+ *          The pixels of the tile.                                           *
+ *      mask (unsigned char *):                                               *
+ *          Flags for the pixels of the tile that have been computed.         *
+ *      x, y (unsigned int):                                                  *
+ *          The top-left corner of the rectangle, relative to the tile.       *
+ *      width, height (unsigned int):                                         *
+ *          The size of the rectangle.                                        *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Compute the border of the rectangle. If every pixel of the border is  *
+ *      the same color, fill the inside with that color. Otherwise split the  *
+ *      rectangle into four quadrants, which share their middle row and       *
+ *      column, and repeat on each of them. Shared pixels are only computed   *
+ *      once since the mask remembers them. Small rectangles are computed     *
+ *      directly.                                                             *
+ *  Notes:                                                                    *
+ *      This assumes the regions of a single color are simply connected, so   *
+ *      a border of one color cannot enclose anything else. This is true for  *
+ *      the escape-time level sets of the Mandelbrot set, and is a good       *
+ *      approximation for most escape-time plots. Features smaller than a     *
+ *      rectangle that lie entirely inside of it can be missed. Use the       *
+ *      validate option to measure this for a given plot.                     *
+ ******************************************************************************/
+template <typename Tkernel>
+inline void
+cvp::subdivide_job<Tkernel>::compute_rectangle(const cvp::tile &t,
+                                               cvp::color *out,
+                                               unsigned char *mask,
+                                               unsigned int x,
+                                               unsigned int y,
+                                               unsigned int width,
+                                               unsigned int height) const
+{
+    /*  Indices for the rows and columns of the rectangle.                    */
+    unsigned int row, col;
+
+    /*  Half of the size of the rectangle, used for splitting it.             */
+    unsigned int half_width, half_height;
+
+    /*  The color of the top-left corner, compared with the rest of the edge. */
+    cvp::color c;
+
+    /*  Whether or not the entire border has the same color.                  */
+    bool uniform = true;
+
+    /*  Small rectangles are computed directly.                               */
+    if (width < cvp::subdivide::min_size || height < cvp::subdivide::min_size)
+    {
+        for (row = 0U; row < height; ++row)
+            compute_run(t, out, mask, x, y + row, width);
+
+        return;
+    }
+
+    /*  Compute the top and bottom rows, and the left and right columns.      */
+    compute_run(t, out, mask, x, y, width);
+    compute_run(t, out, mask, x, y + height - 1U, width);
+
+    for (row = 1U; row < height - 1U; ++row)
+    {
+        compute_run(t, out, mask, x, y + row, 1U);
+        compute_run(t, out, mask, x + width - 1U, y + row, 1U);
+    }
+
+    /*  Check if the border is a single color.                                */
+    c = out[y*t.width + x];
+
+    for (col = 0U; col < width && uniform; ++col)
+        uniform = (out[y*t.width + x + col] == c) &&
+                  (out[(y + height - 1U)*t.width + x + col] == c);
+
+    for (row = 1U; row < height - 1U && uniform; ++row)
+        uniform = (out[(y + row)*t.width + x] == c) &&
+                  (out[(y + row)*t.width + x + width - 1U] == c);
+
+    /*  If so, fill the inside of the rectangle with this color.              */
+    if (uniform)
+    {
+        for (row = 1U; row < height - 1U; ++row)
+        {
+            const std::size_t offset = (y + row)*t.width;
+
+            for (col = 1U; col < width - 1U; ++col)
+            {
+                if (!mask[offset + x + col])
+                {
+                    out[offset + x + col] = c;
+                    mask[offset + x + col] = 1U;
+                }
+            }
+        }
+
+        return;
+    }
+
+    /*  Otherwise split into quadrants sharing the middle row and column.     */
+    half_width = width / 2U;
+    half_height = height / 2U;
+
+    compute_rectangle(t, out, mask, x, y, half_width + 1U, half_height + 1U);
+
+    compute_rectangle(
+        t, out, mask, x + half_width, y, width - half_width, half_height + 1U
+    );
+
+    compute_rectangle(
+        t, out, mask, x, y + half_height, half_width + 1U, height - half_height
+    );
+
+    compute_rectangle(
+        t, out, mask, x + half_width, y + half_height,
+        width - half_width, height - half_height
+    );
+}
+/*  End of cvp::subdivide_job::compute_rectangle.                             */
+
+/*  Computes the n^th tile, starting from the entire tile as one rectangle.   */
+template <typename Tkernel>
+inline void cvp::subdivide_job<Tkernel>::operator () (unsigned int n)
+{
+    /*  The location of the tile in the image, its pixels, and its mask.      */
+    const cvp::tile t = frame.grid.get(n);
+    cvp::color * const out = frame.tile_data(n);
+    unsigned char * const mask = known + frame.stride * n;
+
+    compute_rectangle(t, out, mask, 0U, 0U, t.width, t.height);
+}
+
+/*  Constructor from the kernel and the subdivided image.                     */
+template <typename Tkernel>
+cvp::validate_job<Tkernel>::validate_job(const Tkernel &k,
+                                         const cvp::framebuffer &f)
+    : kernel(k), frame(f)
+{
+    mismatches.store(0UL);
+}
+
+/*  Computes every pixel of the n^th tile and counts the ones that differ.    */
+template <typename Tkernel>
+inline void cvp::validate_job<Tkernel>::operator () (unsigned int n)
+{
+    /*  Indices for the rows of the tile, and the runs in a row.              */
+    unsigned int row, start, k;
+
+    /*  The brute-force colors of a run of pixels.                            */
+    cvp::color exact[cvp::subdivide::chunk];
+
+    /*  The number of pixels in this tile that differ.                        */
+    unsigned long count = 0UL;
+
+    /*  The location of the tile in the image, and the subdivided result.     */
+    const cvp::tile t = frame.grid.get(n);
+    const cvp::color * const out = frame.tile_data(n);
+
+    for (row = 0U; row < t.height; ++row)
+    {
+        for (start = 0U; start < t.width; start += cvp::subdivide::chunk)
+        {
+            const unsigned int left = t.width - start;
+            const unsigned int length =
+                (left < cvp::subdivide::chunk ? left : cvp::subdivide::chunk);
+
+            kernel(t.x + start, t.y + row, length, exact);
+
+            for (k = 0U; k < length; ++k)
+                count += !(exact[k] == out[row*t.width + start + k]);
+        }
+    }
+
+    mismatches.fetch_add(count);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_subdivided                                                *
+ *  Purpose:                                                                  *
+ *      Renders an image by rectangle subdivision and writes it to a file.    *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      xsize (unsigned int):                                                 *
+ *          The number of pixels in the x axis.                               *
+ *      ysize (unsigned int):                                                 *
+ *          The number of pixels in the y axis.                               *
+ *      image (Timage &):                                                     *
+ *          An initialized image file of any format, like a cvp::ppm.         *
+ *      opts (const cvp::render_options &):                                   *
+ *          The block size, and whether or not to validate the result.        *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Split the image into square blocks and give them to the tile engine.  *
+ *      Each block is computed by Mariani-Silver subdivision, so the blocks   *
+ *      run in parallel and the threads steal blocks from each other as the   *
+ *      cost of the blocks varies. With validation on, every pixel is then    *
+ *      computed again by brute force, and the number that differ is printed. *
+ ******************************************************************************/
+template <typename Tkernel, typename Timage>
+inline void
+cvp::render_subdivided(const Tkernel &kernel, unsigned int xsize,
+                       unsigned int ysize, Timage &image,
+                       const cvp::render_options &opts)
+{
+    /*  The size of the blocks the subdivision starts from.                   */
+    const unsigned int size = (opts.block_size ? opts.block_size : 1U);
+
+    /*  Split the image into square blocks.                                   */
+    const cvp::tile_grid grid = cvp::tile_grid(xsize, ysize, size, size);
+
+    /*  Storage for the computed blocks.                                      */
+    cvp::framebuffer frame = cvp::framebuffer(grid);
+
+    /*  One flag per pixel, laid out like the pixels of the framebuffer.      */
+    const std::size_t mask_size = frame.stride * grid.count;
+    unsigned char * const known =
+        static_cast<unsigned char *>(cvp::memory::aligned_malloc(mask_size));
+
+    /*  Check if malloc failed.                                               */
+    if (!frame.data || !known)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        frame.destroy();
+        cvp::memory::aligned_free(known);
+        return;
+    }
+
+    /*  No pixels are known to begin with.                                    */
+    std::memset(known, 0, mask_size);
+
+    /*  Compute every block in parallel.                                      */
+    {
+        cvp::subdivide_job<Tkernel> job =
+            cvp::subdivide_job<Tkernel>(kernel, frame, known);
+
+        cvp::run_tiles(grid.count, job);
+    }
+
+    /*  Compare with the brute-force image, if requested.                     */
+    if (opts.validate)
+    {
+        cvp::validate_job<Tkernel> check(kernel, frame);
+        const unsigned long total =
+            static_cast<unsigned long>(xsize) * ysize;
+
+        cvp::run_tiles(grid.count, check);
+
+        std::printf(
+            "Subdivision: %lu of %lu pixels differ from brute force.\n",
+            check.mismatches.load(), total
+        );
+    }
+
+    /*  Write the image and free everything.                                  */
+    frame.write(image);
+    frame.destroy();
+    cvp::memory::aligned_free(known);
+}
+/*  End of cvp::render_subdivided.                                            */
+
+#endif
+/*  End of include guard.                                                     */
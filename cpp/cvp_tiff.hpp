@@ -0,0 +1,773 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a class for writing tiled BigTIFF files. Every tile of the   *
+ *      image is written on its own, in any order, from any thread, so the    *
+ *      image never has to fit in memory.                                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_TIFF_HPP
+#define CVP_TIFF_HPP
+
+/*  FILE data type found here.                                                */
+#include <cstdio>
+
+/*  size_t, memcpy, and memset found here.                                    */
+#include <cstddef>
+#include <cstring>
+
+/*  Integers of exact width, for offsets into files larger than 4 GB.         */
+#include <cstdint>
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Positional writes, safe to call from many threads, found here.            */
+#include "cvp_io.hpp"
+
+/*  Basic constants for the setup of the experiments given here.              */
+#include "cvp_setup.hpp"
+
+/*  Colors, which the kernels write, found here.                              */
+#include "cvp_color.hpp"
+
+/*  Tile engine, which renders and writes the tiles in parallel.              */
+#include "cvp_tiles.hpp"
+
+/*  The deflate compressor and the Adler-32 checksum.                         */
+#include "cvp_deflate.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  The width and height of the tiles of a TIFF, which must be multiples  *
+     *  of 16. 256 is what most viewers expect, 192 kB of pixels a tile.      */
+    static const unsigned int tiff_tile_size = 256U;
+
+    /*  Class for writing tiled BigTIFF files. The file is an 8-bit RGB       *
+     *  image, cut into square tiles that are either stored as they are, or   *
+     *  compressed on their own with deflate. A tile goes wherever the file   *
+     *  ends when it is done, and the table of where the tiles are is added   *
+     *  after the last one, so tiles may come in any order. BigTIFF uses      *
+     *  64-bit offsets, so the file may be larger than 4 GB.                  */
+    class tiff {
+        public:
+            /*  The file, NULL if it could not be opened.                     */
+            FILE *fp;
+
+            /*  The number of pixels in the x and y axes, set by init.        */
+            unsigned int width, height;
+
+            /*  The deflate level, 1 to 9, or 0 to store the tiles.           */
+            unsigned int level;
+
+            /*  The tiles across, the tiles down, and the number of tiles.    */
+            unsigned int columns, rows, count;
+
+            /*  Where each tile is in the file, and its size. Zero for tiles  *
+             *  that were never written.                                      */
+            std::uint64_t *offsets, *byte_counts;
+
+            /*  Where the next tile goes, and the tiles written so far.       *
+             *  Both are only changed with atomic updates.                    */
+            std::uint64_t end;
+            unsigned int tiles_done;
+
+            /*  Rows written in scanline order are kept until they fill a row *
+             *  of tiles. The rows, and the number of bytes received.         */
+            unsigned char *band;
+            std::size_t size;
+
+            /*  Rows received so far in scanline order.                       */
+            unsigned int rows_done;
+
+            /*  Set when malloc or a write fails.                             */
+            bool failed;
+
+            /*  Constructor from a name, compressing with the default level.  */
+            tiff(const char *name);
+
+            /*  Constructor from a name and the deflate level.                */
+            tiff(const char *name, unsigned int compression_level);
+
+            /*  Method for initializing the TIFF with the size of the image.  */
+            inline void init(unsigned int x, unsigned int y);
+
+            /*  Method for initializing the TIFF using the values in "setup". */
+            inline void init(void);
+
+            /*  Method for initializing the TIFF using a viewport's size.     */
+            template <typename Tview>
+            inline void init(const Tview &view);
+
+            /*  The n^th tile, clipped to the image, in the order of a TIFF.  */
+            inline cvp::tile get(unsigned int n) const;
+
+            /*  Compresses and writes the n^th tile. Safe to call from many   *
+             *  threads, each tile once. The pixels, a full tile of them, are *
+             *  overwritten.                                                  */
+            inline void write_tile(unsigned int n, unsigned char *pixels);
+
+            /*  Appends a block of packed RGB bytes to the image, in scanline *
+             *  order, like a PPM.                                            */
+            inline void write(const void *data, std::size_t bytes);
+
+            /*  Appends an entire row (or several rows) of packed RGB pixels. */
+            inline void write_row(const void *rgb, unsigned int width);
+            inline void write_rows(const void *rgb, unsigned int width,
+                                   unsigned int rows);
+
+            /*  Writes the n^th tile of the current band of rows.             */
+            inline void write_band_tile(unsigned int n);
+
+            /*  Tiles are written whole, so a TIFF is not mapped.             */
+            inline bool map(void);
+
+            /*  There are no mapped pixels, returns NULL.                     */
+            inline unsigned char *pixel(unsigned int x, unsigned int y) const;
+
+            /*  Writes the table of tiles, and the header, and closes.        */
+            inline void close(void);
+
+            /*  Store integers in little endian order, the order of the file. */
+            static inline void put16(unsigned char *out, std::uint16_t x);
+            static inline void put32(unsigned char *out, std::uint32_t x);
+            static inline void put64(unsigned char *out, std::uint64_t x);
+    };
+
+    /*  Job for the tile engine, writes a tile of the current band of rows.   */
+    class tiff_band_job {
+        public:
+            cvp::tiff &TIFF;
+
+            /*  Constructor from the TIFF.                                    */
+            tiff_band_job(cvp::tiff &T);
+
+            /*  Writes the n^th tile of the band.                             */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Job for the tile engine, runs a kernel over a tile of a TIFF, and     *
+     *  writes the tile.                                                      */
+    template <typename Tkernel>
+    class tiff_tile_job {
+        public:
+            const Tkernel &kernel;
+            cvp::tiff &TIFF;
+
+            /*  Constructor from the kernel and the TIFF.                     */
+            tiff_tile_job(const Tkernel &k, cvp::tiff &T);
+
+            /*  Computes every pixel of the n^th tile, and writes it.         */
+            inline void operator () (unsigned int n);
+    };
+
+    /*  Renders an image one TIFF tile at a time, writing each tile as soon   *
+     *  as it is done, and closes the file.                                   */
+    template <typename Tkernel, typename Tview>
+    inline void
+    render_tiff(const Tkernel &kernel, const Tview &view, cvp::tiff &TIFF);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from a name, using the default level.                         */
+cvp::tiff::tiff(const char *name) : tiff(name, cvp::deflate::default_level)
+{
+    return;
+}
+
+/*  Constructor from a name and a level. The tables are made by init, once    *
+ *  the size of the image is known.                                           */
+cvp::tiff::tiff(const char *name, unsigned int compression_level)
+{
+    fp = std::fopen(name, "wb");
+    width = height = 0U;
+    level = (compression_level < cvp::deflate::max_level ?
+             compression_level : cvp::deflate::max_level);
+
+    columns = rows = count = 0U;
+    offsets = byte_counts = NULL;
+
+    /*  The header, written by close, comes first.                            */
+    end = 16U;
+    tiles_done = 0U;
+    band = NULL;
+    size = 0U;
+    rows_done = 0U;
+    failed = false;
+
+    /*  Warn the caller if fopen failed.                                      */
+    if (!fp)
+        std::puts("ERROR: fopen failed and returned NULL.");
+}
+
+/*  Makes the table of tiles. Nothing is written until the first tile.        */
+inline void cvp::tiff::init(unsigned int x, unsigned int y)
+{
+    const unsigned int n = cvp::tiff_tile_size;
+    std::uint64_t tiles;
+
+    width = x;
+    height = y;
+
+    if (!fp)
+        return;
+
+    columns = (width + n - 1U) / n;
+    rows = (height + n - 1U) / n;
+    tiles = static_cast<std::uint64_t>(columns) * rows;
+
+    /*  The tile engine counts tiles with unsigned ints.                      */
+    if (tiles > 0xFFFFFFFFU)
+    {
+        std::puts("ERROR: Too many tiles for a TIFF.");
+        failed = true;
+        return;
+    }
+
+    count = static_cast<unsigned int>(tiles);
+
+    offsets = static_cast<std::uint64_t *>(
+        cvp::memory::aligned_malloc(sizeof(*offsets) * count + 1U)
+    );
+
+    byte_counts = static_cast<std::uint64_t *>(
+        cvp::memory::aligned_malloc(sizeof(*byte_counts) * count + 1U)
+    );
+
+    if (!offsets || !byte_counts)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        failed = true;
+        return;
+    }
+
+    std::memset(offsets, 0, sizeof(*offsets) * count);
+    std::memset(byte_counts, 0, sizeof(*byte_counts) * count);
+}
+
+/*  Initialize using the values in "setup".                                   */
+inline void cvp::tiff::init(void)
+{
+    init(cvp::setup::xsize, cvp::setup::ysize);
+}
+
+/*  Initialize using the resolution of a viewport.                            */
+template <typename Tview>
+inline void cvp::tiff::init(const Tview &view)
+{
+    init(view.xsize, view.ysize);
+}
+
+/*  Tiles go across and then down. Edge tiles are clipped to the image here,  *
+ *  but the file still holds the whole tile.                                  */
+inline cvp::tile cvp::tiff::get(unsigned int n) const
+{
+    const unsigned int size = cvp::tiff_tile_size;
+    cvp::tile t;
+
+    t.x = (n % columns) * size;
+    t.y = (n / columns) * size;
+    t.width = (width - t.x < size ? width - t.x : size);
+    t.height = (height - t.y < size ? height - t.y : size);
+    return t;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::tiff::write_tile                                                 *
+ *  Purpose:                                                                  *
+ *      Compresses a tile and writes it at the end of the file.               *
+ *  Arguments:                                                                *
+ *      n (unsigned int):                                                     *
+ *          The index of the tile, across and then down.                      *
+ *      pixels (unsigned char *):                                             *
+ *          The tile, tiff_tile_size rows of tiff_tile_size pixels. Parts     *
+ *          past the edge of the image may hold anything.                     *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Each byte is replaced by its difference from the same channel of the  *
+ *      pixel to the left, the horizontal predictor of TIFF, and the tile is  *
+ *      compressed as a zlib stream. Space for it is taken from the end of    *
+ *      the file with an atomic add, and it is written there with pwrite.     *
+ *      Stored tiles skip the predictor and compression.                      *
+ ******************************************************************************/
+inline void cvp::tiff::write_tile(unsigned int n, unsigned char *pixels)
+{
+    const std::size_t row_bytes = 3U * cvp::tiff_tile_size;
+    const std::size_t bytes = row_bytes * cvp::tiff_tile_size;
+
+    /*  The bytes for the file, and how many.                                 */
+    unsigned char *out = pixels;
+    std::size_t out_size = bytes;
+
+    /*  Where the tile goes, and indices for the rows and bytes.              */
+    std::uint64_t offset;
+    std::size_t row, k;
+
+    if (failed)
+        return;
+
+    if (level != cvp::deflate::stored_level)
+    {
+        /*  The checksum is of the bytes before compressing.                  */
+        std::uint32_t adler;
+        std::size_t written;
+
+        for (row = 0U; row < cvp::tiff_tile_size; ++row)
+        {
+            unsigned char * const p = pixels + row * row_bytes;
+
+            for (k = row_bytes - 1U; k >= 3U; --k)
+                p[k] = static_cast<unsigned char>(p[k] - p[k - 3U]);
+        }
+
+        out = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(cvp::deflate::bound(bytes) + 6U)
+        );
+
+        if (!out)
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            failed = true;
+            return;
+        }
+
+        written = cvp::deflate::compress(pixels, 0U, bytes, level, true,
+                                         out + 2U);
+
+        if (written == 0U)
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            cvp::memory::aligned_free(out);
+            failed = true;
+            return;
+        }
+
+        /*  A zlib stream is a header, the deflate stream, and its Adler-32   *
+         *  in big endian order.                                              */
+        adler = cvp::deflate::adler32(1U, pixels, bytes);
+        out[0] = 0x78U;
+        out[1] = cvp::deflate::zlib_flags(level);
+        out_size = written + 2U;
+
+        for (k = 0U; k < 4U; ++k)
+            out[out_size++] = static_cast<unsigned char>(adler >> (24U - 8U*k));
+    }
+
+    /*  Take the space for the tile from the end of the file.                 */
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    {
+        offset = end;
+        end += out_size;
+    }
+
+    if (!cvp::io::write_at(fp, offset, out, out_size))
+    {
+        std::puts("ERROR: write failed.");
+        failed = true;
+    }
+
+    offsets[n] = offset;
+    byte_counts[n] = out_size;
+
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+    ++tiles_done;
+
+    if (out != pixels)
+        cvp::memory::aligned_free(out);
+}
+/*  End of cvp::tiff::write_tile.                                             */
+
+/*  Copies the bytes into the band, writing the tiles of the band each time   *
+ *  it fills up. The last band is cut short at the last row.                  */
+inline void cvp::tiff::write(const void *data, std::size_t bytes)
+{
+    const std::size_t row_bytes = 3U * static_cast<std::size_t>(width);
+    const unsigned char *in = static_cast<const unsigned char *>(data);
+
+    if (!band && !failed)
+    {
+        band = static_cast<unsigned char *>(
+            cvp::memory::aligned_malloc(row_bytes * cvp::tiff_tile_size + 1U)
+        );
+
+        if (!band)
+        {
+            std::puts("ERROR: malloc failed and returned NULL.");
+            failed = true;
+        }
+    }
+
+    while (bytes > 0U && !failed)
+    {
+        const unsigned int left = height - rows_done;
+        const std::size_t band_rows =
+            (left < cvp::tiff_tile_size ? left : cvp::tiff_tile_size);
+        const std::size_t room = band_rows * row_bytes - size;
+        const std::size_t piece = (bytes < room ? bytes : room);
+
+        if (room == 0U)
+        {
+            std::puts("ERROR: More pixels than fit in the TIFF.");
+            failed = true;
+            return;
+        }
+
+        std::memcpy(band + size, in, piece);
+        size += piece;
+        in += piece;
+        bytes -= piece;
+
+        if (size == band_rows * row_bytes)
+        {
+            cvp::tiff_band_job job = cvp::tiff_band_job(*this);
+            cvp::run_tiles(columns, job);
+            rows_done += static_cast<unsigned int>(band_rows);
+            size = 0U;
+        }
+    }
+}
+
+/*  Appends a row of packed RGB pixels.                                       */
+inline void cvp::tiff::write_row(const void *rgb, unsigned int width)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width));
+}
+
+/*  Appends several consecutive rows of packed RGB pixels.                    */
+inline void cvp::tiff::write_rows(const void *rgb, unsigned int width,
+                                  unsigned int rows)
+{
+    write(rgb, 3U * static_cast<std::size_t>(width) * rows);
+}
+
+/*  Copies the n^th tile out of the band, padded with zeros, and writes it.   */
+inline void cvp::tiff::write_band_tile(unsigned int n)
+{
+    const std::size_t row_bytes = 3U * static_cast<std::size_t>(width);
+    const std::size_t tile_bytes = 3U * cvp::tiff_tile_size;
+    const cvp::tile t = get(rows_done / cvp::tiff_tile_size * columns + n);
+
+    unsigned char * const pixels = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(tile_bytes * cvp::tiff_tile_size)
+    );
+
+    unsigned int row;
+
+    if (!pixels)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        failed = true;
+        return;
+    }
+
+    std::memset(pixels, 0, tile_bytes * cvp::tiff_tile_size);
+
+    for (row = 0U; row < t.height; ++row)
+        std::memcpy(pixels + row * tile_bytes,
+                    band + row * row_bytes + 3U * t.x, 3U * t.width);
+
+    write_tile(t.y / cvp::tiff_tile_size * columns + n, pixels);
+    cvp::memory::aligned_free(pixels);
+}
+
+/*  Tiles are compressed, and are not in scanline order, so there is nothing  *
+ *  to map.                                                                   */
+inline bool cvp::tiff::map(void)
+{
+    return false;
+}
+
+/*  Never called, since map always fails.                                     */
+inline unsigned char *cvp::tiff::pixel(unsigned int x, unsigned int y) const
+{
+    (void)x;
+    (void)y;
+    return NULL;
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::tiff::close                                                      *
+ *  Purpose:                                                                  *
+ *      Writes the directory of the image and the header, and closes.         *
+ *  Arguments:                                                                *
+ *      None.                                                                 *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The directory, with the size of the image, how it is stored, and the  *
+ *      offsets and sizes of the tiles, goes after the last tile. The header  *
+ *      at the start of the file points to it. Tags are in increasing order,  *
+ *      and values of up to 8 bytes are stored in the tag itself.             *
+ ******************************************************************************/
+inline void cvp::tiff::close(void)
+{
+    /*  The tags, each a tag number, a type, a count, and a value. The types  *
+     *  are 3 for 16-bit, 4 for 32-bit, and 16 for 64-bit integers.           */
+    const std::uint16_t tags[12][2] = {
+        {256U, 4U},     /*  ImageWidth.                                       */
+        {257U, 4U},     /*  ImageLength.                                      */
+        {258U, 3U},     /*  BitsPerSample, 8 for each channel.                */
+        {259U, 3U},     /*  Compression, 1 for none, 8 for deflate.           */
+        {262U, 3U},     /*  PhotometricInterpretation, 2 for RGB.             */
+        {277U, 3U},     /*  SamplesPerPixel.                                  */
+        {284U, 3U},     /*  PlanarConfiguration, 1 for interleaved channels.  */
+        {317U, 3U},     /*  Predictor, 1 for none, 2 for horizontal.          */
+        {322U, 4U},     /*  TileWidth.                                        */
+        {323U, 4U},     /*  TileLength.                                       */
+        {324U, 16U},    /*  TileOffsets.                                      */
+        {325U, 16U}     /*  TileByteCounts.                                   */
+    };
+
+    const std::uint64_t counts[12] = {
+        1U, 1U, 3U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, count, count
+    };
+
+    const bool compressed = (level != cvp::deflate::stored_level);
+
+    const std::uint64_t values[10] = {
+        width, height, 0U, (compressed ? 8U : 1U), 2U, 3U, 1U,
+        (compressed ? 2U : 1U), cvp::tiff_tile_size, cvp::tiff_tile_size
+    };
+
+    /*  The directory is its tag count, the tags, and the offset of the next  *
+     *  directory, 0 for none, followed by the tables if they do not fit.     */
+    const std::size_t tag_bytes = 8U + 12U * 20U + 8U;
+    const std::size_t table_bytes = (count > 1U ? 16U * count : 0U);
+
+    /*  The header, the directory, and indices for the tags and tiles.        */
+    unsigned char header[16] = {'I', 'I', 43U, 0U, 8U, 0U, 0U, 0U};
+    unsigned char *directory;
+    std::uint64_t start;
+    unsigned int n;
+
+    if (!fp)
+        return;
+
+    if (!failed && tiles_done != count)
+        std::puts("ERROR: The TIFF is missing tiles.");
+
+    /*  The directory must start on an even offset. Use 8 to be tidy.         */
+    start = (end + 7U) & ~static_cast<std::uint64_t>(7U);
+
+    directory = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(tag_bytes + table_bytes)
+    );
+
+    if (!directory || !offsets || !byte_counts)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        failed = true;
+    }
+    else
+    {
+        std::memset(directory, 0, tag_bytes + table_bytes);
+        cvp::tiff::put64(directory, 12U);
+
+        for (n = 0U; n < 12U; ++n)
+        {
+            unsigned char * const tag = directory + 8U + 20U * n;
+            unsigned char * const value = tag + 12U;
+
+            cvp::tiff::put16(tag, tags[n][0]);
+            cvp::tiff::put16(tag + 2U, tags[n][1]);
+            cvp::tiff::put64(tag + 4U, counts[n]);
+
+            if (n == 2U)
+            {
+                cvp::tiff::put16(value, 8U);
+                cvp::tiff::put16(value + 2U, 8U);
+                cvp::tiff::put16(value + 4U, 8U);
+            }
+
+            /*  A single tile has its offset and size in the tags.            */
+            else if (n >= 10U && count == 1U)
+                cvp::tiff::put64(value, n == 10U ? offsets[0] : byte_counts[0]);
+
+            else if (n >= 10U)
+                cvp::tiff::put64(
+                    value, start + tag_bytes + (n == 10U ? 0U : 8U * count)
+                );
+
+            else if (tags[n][1] == 3U)
+                cvp::tiff::put16(value, static_cast<std::uint16_t>(values[n]));
+
+            else
+                cvp::tiff::put32(value, static_cast<std::uint32_t>(values[n]));
+        }
+
+        for (n = 0U; n < count && count > 1U; ++n)
+        {
+            cvp::tiff::put64(directory + tag_bytes + 8U*n, offsets[n]);
+            cvp::tiff::put64(directory + tag_bytes + 8U*(count + n),
+                             byte_counts[n]);
+        }
+
+        cvp::tiff::put64(header + 8U, start);
+
+        if (!cvp::io::write_at(fp, start, directory, tag_bytes + table_bytes) ||
+            !cvp::io::write_at(fp, 0U, header, sizeof(header)))
+            std::puts("ERROR: write failed.");
+    }
+
+    cvp::memory::aligned_free(directory);
+    cvp::memory::aligned_free(offsets);
+    cvp::memory::aligned_free(byte_counts);
+    cvp::memory::aligned_free(band);
+    offsets = byte_counts = NULL;
+    band = NULL;
+
+    std::fclose(fp);
+    fp = NULL;
+}
+/*  End of cvp::tiff::close.                                                  */
+
+/*  Least significant byte first.                                             */
+inline void cvp::tiff::put16(unsigned char *out, std::uint16_t x)
+{
+    out[0] = static_cast<unsigned char>(x);
+    out[1] = static_cast<unsigned char>(x >> 8);
+}
+
+/*  Least significant byte first.                                             */
+inline void cvp::tiff::put32(unsigned char *out, std::uint32_t x)
+{
+    cvp::tiff::put16(out, static_cast<std::uint16_t>(x));
+    cvp::tiff::put16(out + 2U, static_cast<std::uint16_t>(x >> 16));
+}
+
+/*  Least significant byte first.                                             */
+inline void cvp::tiff::put64(unsigned char *out, std::uint64_t x)
+{
+    cvp::tiff::put32(out, static_cast<std::uint32_t>(x));
+    cvp::tiff::put32(out + 4U, static_cast<std::uint32_t>(x >> 32));
+}
+
+/*  Constructor from the TIFF.                                                */
+cvp::tiff_band_job::tiff_band_job(cvp::tiff &T) : TIFF(T)
+{
+    return;
+}
+
+/*  Writes the n^th tile of the band.                                         */
+inline void cvp::tiff_band_job::operator () (unsigned int n)
+{
+    TIFF.write_band_tile(n);
+}
+
+/*  Constructor from the kernel and the TIFF.                                 */
+template <typename Tkernel>
+cvp::tiff_tile_job<Tkernel>::tiff_tile_job(const Tkernel &k, cvp::tiff &T)
+    : kernel(k), TIFF(T)
+{
+    return;
+}
+
+/*  Computes the n^th tile into a buffer of its own, and writes it. The part  *
+ *  of an edge tile past the image is zero.                                   */
+template <typename Tkernel>
+inline void cvp::tiff_tile_job<Tkernel>::operator () (unsigned int n)
+{
+    const unsigned int size = cvp::tiff_tile_size;
+    const cvp::tile t = TIFF.get(n);
+
+    const std::size_t bytes = sizeof(cvp::color) * size * size;
+
+    unsigned char * const pixels = static_cast<unsigned char *>(
+        cvp::memory::aligned_malloc(bytes)
+    );
+
+    /*  The same bytes, as the colors the kernel writes.                      */
+    cvp::color * const out = reinterpret_cast<cvp::color *>(pixels);
+    unsigned int row;
+
+    if (!pixels)
+    {
+        std::puts("ERROR: malloc failed and returned NULL.");
+        TIFF.failed = true;
+        return;
+    }
+
+    if (t.width != size || t.height != size)
+        std::memset(pixels, 0, bytes);
+
+    for (row = 0U; row < t.height; ++row)
+        kernel(t.x, t.y + row, t.width, out + row * size);
+
+    TIFF.write_tile(n, pixels);
+    cvp::memory::aligned_free(pixels);
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::render_tiff                                                      *
+ *  Purpose:                                                                  *
+ *      Renders an image straight into the tiles of a TIFF file.              *
+ *  Arguments:                                                                *
+ *      kernel (const Tkernel &):                                             *
+ *          Callable with kernel(x, y, n, out) computing the colors of the    *
+ *          n pixels (x, y), ..., (x + n - 1, y) and storing them in out.     *
+ *      view (const Tview &):                                                 *
+ *          The viewport, only its resolution xsize and ysize is used here.   *
+ *      TIFF (cvp::tiff &):                                                   *
+ *          A TIFF file that was just opened.                                 *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      The tiles of the file are the jobs of the tile engine. Each thread    *
+ *      computes a tile, compresses it, and writes it with no lock, in        *
+ *      whatever order the tiles finish. Only the tiles being worked on are   *
+ *      in memory, so the image may be far larger than the memory.            *
+ ******************************************************************************/
+template <typename Tkernel, typename Tview>
+inline void
+cvp::render_tiff(const Tkernel &kernel, const Tview &view, cvp::tiff &TIFF)
+{
+    /*  Check if the constructor failed.                                      */
+    if (!TIFF.fp)
+        return;
+
+    TIFF.init(view);
+
+    if (!TIFF.failed)
+    {
+        cvp::tiff_tile_job<Tkernel> job =
+            cvp::tiff_tile_job<Tkernel>(kernel, TIFF);
+
+        cvp::run_tiles(TIFF.count, job);
+    }
+
+    TIFF.close();
+}
+/*  End of cvp::render_tiff.                                                  */
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,387 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides a tile-based work-stealing engine for rendering images.      *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_TILES_HPP
+#define CVP_TILES_HPP
+
+/*  size_t found here.                                                        */
+#include <cstddef>
+
+/*  Placement new found here.                                                 */
+#include <new>
+
+/*  Lock-free atomic integers for the work queues.                            */
+#include <atomic>
+
+/*  omp_get_thread_num and friends, if OpenMP is enabled.                     */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/*  Aligned memory allocation provided here.                                  */
+#include "cvp_memory.hpp"
+
+/*  Class for working with colors in RGB format.                              */
+#include "cvp_color.hpp"
+
+/*  Class for creating and writing to PPM files.                              */
+#include "cvp_ppm.hpp"
+
+/*  Namespace for the mini-project. "Complex Visual Plots."                   */
+namespace cvp {
+
+    /*  Another namespace to avoid name conflicts with other constants.       */
+    namespace tiles {
+
+        /*  Default size of a tile. 64 x 16 pixels is 3 kB of colors, which   *
+         *  fits comfortably in L1 alongside the working set of the kernel.   */
+        const unsigned int width = 64U;
+        const unsigned int height = 16U;
+    }
+    /*  End of namespace "tiles".                                             */
+
+    /*  A rectangular block of pixels, given by its top-left corner and size. */
+    class tile {
+        public:
+            unsigned int x, y, width, height;
+    };
+
+    /*  Class for splitting an image into tiles.                              */
+    class tile_grid {
+        public:
+            /*  Size of the image and the size of a (non-edge) tile.          */
+            unsigned int xsize, ysize, tile_width, tile_height;
+
+            /*  Number of tiles per row, per column, and in total.            */
+            unsigned int columns, rows, count;
+
+            /*  Constructor from the image size and the tile size.            */
+            tile_grid(unsigned int x, unsigned int y,
+                      unsigned int tw, unsigned int th);
+
+            /*  Returns the n^th tile, counting left-to-right, top-to-bottom. */
+            inline cvp::tile get(unsigned int n) const;
+    };
+
+    /*  Work queue of tile indices. Owners pop from the front, thieves steal  *
+     *  from the back. Padded to a full cache line to avoid false sharing.    */
+    class work_queue {
+        public:
+            /*  The range [begin, end) packed as (begin << 32) | end.         */
+            std::atomic<unsigned long long> range;
+
+            /*  Padding so neighboring queues live on separate cache lines.   */
+            char padding[cvp::memory::cache_line - sizeof(range)];
+
+            /*  Constructor from the range of indices owned by the queue.     */
+            work_queue(unsigned int begin, unsigned int end);
+
+            /*  Takes the next index from the front of the queue.             */
+            inline bool pop(unsigned int &n);
+
+            /*  Takes the last index from the back of the queue.              */
+            inline bool steal(unsigned int &n);
+    };
+
+    /*  Runs job(n) for 0 <= n < count on every available thread.             */
+    template <typename Tjob>
+    inline void run_tiles(unsigned int count, Tjob &job);
+
+    /*  Image stored as one cache-aligned buffer per tile.                    */
+    class framebuffer {
+        public:
+            /*  The tiles the image is split into.                            */
+            cvp::tile_grid grid;
+
+            /*  Number of colors reserved per tile. Rounded so that every     *
+             *  tile starts on its own cache line.                            */
+            std::size_t stride;
+
+            /*  The pixel data, NULL if the allocation failed.                */
+            cvp::color *data;
+
+            /*  Constructor from the tiling of the image.                     */
+            framebuffer(const cvp::tile_grid &g);
+
+            /*  Returns the pixel buffer for the n^th tile.                   */
+            inline cvp::color *tile_data(unsigned int n) const;
+
+            /*  Writes the image to a file in scanline order.                 */
+            template <typename Timage>
+            inline void write(Timage &image) const;
+
+            /*  Frees the pixel data.                                         */
+            inline void destroy(void);
+    };
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the image size and the tile size.                        */
+cvp::tile_grid::tile_grid(unsigned int x, unsigned int y,
+                          unsigned int tw, unsigned int th)
+{
+    xsize = x;
+    ysize = y;
+    tile_width = tw;
+    tile_height = th;
+
+    /*  Edge tiles may be smaller than the others. Round up.                  */
+    columns = (xsize + tile_width - 1U) / tile_width;
+    rows = (ysize + tile_height - 1U) / tile_height;
+    count = columns * rows;
+}
+
+/*  Returns the n^th tile, clipping tiles on the right and bottom edges.      */
+inline cvp::tile cvp::tile_grid::get(unsigned int n) const
+{
+    cvp::tile t;
+    t.x = (n % columns) * tile_width;
+    t.y = (n / columns) * tile_height;
+    t.width = (xsize - t.x < tile_width ? xsize - t.x : tile_width);
+    t.height = (ysize - t.y < tile_height ? ysize - t.y : tile_height);
+    return t;
+}
+
+/*  Constructor from the range of indices owned by the queue.                 */
+cvp::work_queue::work_queue(unsigned int begin, unsigned int end)
+{
+    range.store((static_cast<unsigned long long>(begin) << 32) | end);
+}
+
+/*  Takes the next index from the front of the queue.                         */
+inline bool cvp::work_queue::pop(unsigned int &n)
+{
+    unsigned long long r = range.load();
+
+    /*  Retry until we either empty the queue or win the compare-exchange.    */
+    while (true)
+    {
+        const unsigned int begin = static_cast<unsigned int>(r >> 32);
+        const unsigned int end = static_cast<unsigned int>(r & 0xFFFFFFFFULL);
+
+        /*  Nothing left to take.                                             */
+        if (begin >= end)
+            return false;
+
+        /*  On failure r is reloaded with the current range and we retry.     */
+        if (range.compare_exchange_weak(r, r + (1ULL << 32)))
+        {
+            n = begin;
+            return true;
+        }
+    }
+}
+
+/*  Takes the last index from the back of the queue.                          */
+inline bool cvp::work_queue::steal(unsigned int &n)
+{
+    unsigned long long r = range.load();
+
+    /*  Same as pop, but shrink the range from the other end.                 */
+    while (true)
+    {
+        const unsigned int begin = static_cast<unsigned int>(r >> 32);
+        const unsigned int end = static_cast<unsigned int>(r & 0xFFFFFFFFULL);
+
+        if (begin >= end)
+            return false;
+
+        if (range.compare_exchange_weak(r, r - 1ULL))
+        {
+            n = end - 1U;
+            return true;
+        }
+    }
+}
+
+/******************************************************************************
+ *  Function:                                                                 *
+ *      cvp::run_tiles                                                        *
+ *  Purpose:                                                                  *
+ *      Runs a job on every tile using a work-stealing pool of threads.       *
+ *  Arguments:                                                                *
+ *      count (unsigned int):                                                 *
+ *          The number of tiles.                                              *
+ *      job (Tjob &):                                                         *
+ *          Callable with job(n) processing tile n. Must be thread-safe.      *
+ *  Outputs:                                                                  *
+ *      None.                                                                 *
+ *  Method:                                                                   *
+ *      Each thread owns a contiguous range of tiles, so neighboring tiles    *
+ *      (and their cache lines) stay on one core. A thread that runs out of   *
+ *      work steals single tiles from the back of the other queues. Tiles     *
+ *      are never added once the pool starts, so a thread may exit as soon    *
+ *      as a full sweep over every queue comes up empty.                      *
+ *  Notes:                                                                    *
+ *      Without OpenMP this simply loops over the tiles in order.             *
+ ******************************************************************************/
+template <typename Tjob>
+inline void cvp::run_tiles(unsigned int count, Tjob &job)
+{
+    /*  Index for looping over the tiles and the queues.                      */
+    unsigned int n;
+
+#ifdef _OPENMP
+    /*  One queue per thread we may be given.                                 */
+    const int max_threads = omp_get_max_threads();
+    const unsigned int threads = static_cast<unsigned int>(max_threads);
+
+    /*  Storage for the queues, aligned so each sits on its own cache line.   */
+    cvp::work_queue *queues;
+
+    /*  With a single thread or a single tile there is nothing to balance.    */
+    if (threads < 2U || count < 2U)
+    {
+        for (n = 0U; n < count; ++n)
+            job(n);
+
+        return;
+    }
+
+    queues = static_cast<cvp::work_queue *>(
+        cvp::memory::aligned_malloc(sizeof(*queues) * threads)
+    );
+
+    /*  If malloc failed, fall back to the serial loop.                       */
+    if (!queues)
+    {
+        for (n = 0U; n < count; ++n)
+            job(n);
+
+        return;
+    }
+
+    /*  Give each thread an equal, contiguous share of the tiles.             */
+    for (n = 0U; n < threads; ++n)
+    {
+        const unsigned long long begin = (1ULL * count * n) / threads;
+        const unsigned long long end = (1ULL * count * (n + 1U)) / threads;
+
+        new (queues + n) cvp::work_queue(
+            static_cast<unsigned int>(begin), static_cast<unsigned int>(end)
+        );
+    }
+
+#pragma omp parallel num_threads(threads)
+    {
+        /*  OpenMP may give us fewer threads than asked for. The orphaned     *
+         *  queues are still drained by the stealing loop below.              */
+        const unsigned int id = static_cast<unsigned int>(omp_get_thread_num());
+
+        /*  The tile currently being processed and the victim index.          */
+        unsigned int tile = 0U;
+        unsigned int victim, k;
+
+        while (true)
+        {
+            /*  Work through our own queue first.                             */
+            if (queues[id].pop(tile))
+            {
+                job(tile);
+                continue;
+            }
+
+            /*  Ours is empty. Look for a victim, starting with our neighbor. */
+            for (k = 1U; k < threads; ++k)
+            {
+                victim = (id + k) % threads;
+
+                if (queues[victim].steal(tile))
+                    break;
+            }
+
+            /*  Every queue is empty, we're done.                             */
+            if (k == threads)
+                break;
+
+            job(tile);
+        }
+    }
+
+    /*  The queues are trivially destructible, just free the memory.          */
+    cvp::memory::aligned_free(queues);
+#else
+    /*  No threads, process the tiles in order.                               */
+    for (n = 0U; n < count; ++n)
+        job(n);
+#endif
+}
+/*  End of cvp::run_tiles.                                                    */
+
+/*  Constructor from the tiling of the image.                                 */
+cvp::framebuffer::framebuffer(const cvp::tile_grid &g) : grid(g)
+{
+    /*  Bytes needed for a full tile, rounded up to a cache line.             */
+    const std::size_t bytes = sizeof(cvp::color) * g.tile_width * g.tile_height;
+    stride = cvp::memory::round_up(bytes) / sizeof(cvp::color);
+
+    data = static_cast<cvp::color *>(
+        cvp::memory::aligned_malloc(sizeof(cvp::color) * stride * g.count)
+    );
+}
+
+/*  Returns the pixel buffer for the n^th tile.                               */
+inline cvp::color *cvp::framebuffer::tile_data(unsigned int n) const
+{
+    return data + stride * n;
+}
+
+/*  Writes the image to a file, like a cvp::ppm, in scanline order.           */
+template <typename Timage>
+inline void cvp::framebuffer::write(Timage &image) const
+{
+    /*  Variables for indexing over the image.                                */
+    unsigned int y, column;
+
+    for (y = 0U; y < grid.ysize; ++y)
+    {
+        /*  The row of tiles containing this scanline, and the row within.    */
+        const unsigned int tile_row = y / grid.tile_height;
+        const unsigned int offset = y - tile_row * grid.tile_height;
+
+        /*  Walk across the scanline one tile at a time.                      */
+        for (column = 0U; column < grid.columns; ++column)
+        {
+            const unsigned int n = tile_row * grid.columns + column;
+            const cvp::tile t = grid.get(n);
+            const cvp::color *row = tile_data(n) + offset * t.width;
+
+            /*  Commit this tile's part of the scanline in one call.          */
+            image.write_row(row, t.width);
+        }
+    }
+}
+
+/*  Frees the pixel data.                                                     */
+inline void cvp::framebuffer::destroy(void)
+{
+    cvp::memory::aligned_free(data);
+    data = NULL;
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,219 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Provides viewports, the region of the plane being plotted together    *
+ *      with the resolution of the image.                                     *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Include guard to prevent including this file twice.                       */
+#ifndef CVP_VIEWPORT_HPP
+#define CVP_VIEWPORT_HPP
+
+/*  Default parameters for plots given here.                                  */
+#include "cvp_setup.hpp"
+
+/*  Complex class, for the centers of viewports, provided here.               */
+#include "cvp_complex.hpp"
+
+/*  Namespace for this mini-project. "Complex Visual Plots."                  */
+namespace cvp {
+
+    /*  A viewport chosen at run time. T is the type of the coordinates, and  *
+     *  the kernels compute in this precision. For T = double this is a       *
+     *  literal type, so a constexpr viewport is also possible for views that *
+     *  are known in advance.                                                 */
+    template <typename T>
+    class basic_viewport {
+        public:
+            /*  The type of the coordinates of the points in the plane.       */
+            typedef T real_type;
+
+            /*  The region of the plane, [xmin, xmax] x [ymin, ymax].         */
+            T xmin, xmax, ymin, ymax;
+
+            /*  The number of pixels in the x and y axes.                     */
+            unsigned int xsize, ysize;
+
+            /*  Factors for converting from pixels to points in the plane.    */
+            T pxfactor, pyfactor;
+
+            /*  Constructor from the region of the plane and the resolution.  */
+            constexpr basic_viewport(const T &x0, const T &x1,
+                                     const T &y0, const T &y1,
+                                     unsigned int width, unsigned int height);
+
+            /*  The real part of the points in column x of the image.         */
+            constexpr T real(unsigned int x) const;
+
+            /*  The imaginary part of the points in row y of the image.       */
+            constexpr T imag(unsigned int y) const;
+    };
+
+    /*  Viewports in double precision, used by most plots.                    */
+    typedef basic_viewport<double> viewport;
+
+    /*  A viewport fixed at compile time. Tparams is a class with static      *
+     *  constexpr members xmin, xmax, ymin, ymax, xsize, and ysize. Nothing   *
+     *  is stored, so the mapping from pixels to the plane is always folded   *
+     *  into constants, even inside the threads of the renderers.             */
+    template <typename Tparams>
+    class static_viewport {
+        public:
+            typedef double real_type;
+
+            static constexpr double xmin = Tparams::xmin;
+            static constexpr double xmax = Tparams::xmax;
+            static constexpr double ymin = Tparams::ymin;
+            static constexpr double ymax = Tparams::ymax;
+            static constexpr unsigned int xsize = Tparams::xsize;
+            static constexpr unsigned int ysize = Tparams::ysize;
+
+            static constexpr double pxfactor =
+                (xmax - xmin) / static_cast<double>(xsize);
+
+            static constexpr double pyfactor =
+                (ymax - ymin) / static_cast<double>(ysize);
+
+            /*  The real part of the points in column x of the image.         */
+            static constexpr double real(unsigned int x);
+
+            /*  The imaginary part of the points in row y of the image.       */
+            static constexpr double imag(unsigned int y);
+    };
+
+    /*  The default viewport, given by the constants in cvp::setup.           */
+    typedef cvp::static_viewport<cvp::setup::params> default_viewport;
+
+    /*  Creates a viewport centered on a point with a given width. The height *
+     *  is chosen so that pixels are square.                                  */
+    constexpr cvp::viewport
+    centered_viewport(double x, double y, double width,
+                      unsigned int xsize, unsigned int ysize);
+
+    /*  Same as centered_viewport, in the precision of the center. This is    *
+     *  how extended precision plots are selected, for example with a center  *
+     *  of type cvp::basic_complex<cvp::dd_real>.                             */
+    template <typename T>
+    inline cvp::basic_viewport<T>
+    centered_viewport(const cvp::basic_complex<T> &center, double width,
+                      unsigned int xsize, unsigned int ysize);
+}
+/*  End of namespace "cvp".                                                   */
+
+/*  Constructor from the region of the plane and the resolution.              */
+template <typename T>
+constexpr cvp::basic_viewport<T>::basic_viewport(const T &x0, const T &x1,
+                                                 const T &y0, const T &y1,
+                                                 unsigned int width,
+                                                 unsigned int height)
+    : xmin(x0), xmax(x1), ymin(y0), ymax(y1),
+      xsize(width), ysize(height),
+      pxfactor((x1 - x0) / static_cast<double>(width)),
+      pyfactor((y1 - y0) / static_cast<double>(height))
+{
+}
+
+/*  Pixels are mapped left-to-right starting at xmin.                         */
+template <typename T>
+constexpr T cvp::basic_viewport<T>::real(unsigned int x) const
+{
+    return xmin + pxfactor*static_cast<double>(x);
+}
+
+/*  Pixels are mapped top-to-bottom starting at ymax.                         */
+template <typename T>
+constexpr T cvp::basic_viewport<T>::imag(unsigned int y) const
+{
+    return ymax - pyfactor*static_cast<double>(y);
+}
+
+/*  Static data members need a definition if they are ever odr-used.          */
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::xmin;
+
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::xmax;
+
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::ymin;
+
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::ymax;
+
+template <typename Tparams>
+constexpr unsigned int cvp::static_viewport<Tparams>::xsize;
+
+template <typename Tparams>
+constexpr unsigned int cvp::static_viewport<Tparams>::ysize;
+
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::pxfactor;
+
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::pyfactor;
+
+/*  Pixels are mapped left-to-right starting at xmin.                         */
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::real(unsigned int x)
+{
+    return xmin + pxfactor*x;
+}
+
+/*  Pixels are mapped top-to-bottom starting at ymax.                         */
+template <typename Tparams>
+constexpr double cvp::static_viewport<Tparams>::imag(unsigned int y)
+{
+    return ymax - pyfactor*y;
+}
+
+/*  Creates a viewport centered on (x, y) with square pixels.                 */
+constexpr cvp::viewport
+cvp::centered_viewport(double x, double y, double width,
+                       unsigned int xsize, unsigned int ysize)
+{
+    return cvp::viewport(
+        x - 0.5*width, x + 0.5*width,
+        y - 0.5*width*ysize/xsize, y + 0.5*width*ysize/xsize,
+        xsize, ysize
+    );
+}
+
+/*  Creates a viewport centered on a point of any precision, square pixels.   */
+template <typename T>
+inline cvp::basic_viewport<T>
+cvp::centered_viewport(const cvp::basic_complex<T> &center, double width,
+                       unsigned int xsize, unsigned int ysize)
+{
+    /*  Half the width and the height. These are small, so a double is fine.  */
+    const double half_width = 0.5*width;
+    const double half_height = 0.5*width*ysize/xsize;
+
+    return cvp::basic_viewport<T>(
+        center.real - half_width, center.real + half_width,
+        center.imag - half_height, center.imag + half_height,
+        xsize, ysize
+    );
+}
+
+#endif
+/*  End of include guard.                                                     */
@@ -0,0 +1,53 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Deep zoom into the Mandelbrot set around the point i.                 *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  Routine for plotting a deep zoom of the Mandelbrot set.                   */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "deep_zoom.ppm";
+
+    /*  The maximum number of iterations to perform.                          */
+    const unsigned int iters = 5000U;
+
+    /*  Orbits leaving this radius have escaped.                              */
+    const double bailout = 256.0;
+
+    /*  The point i is on the boundary of the set, and its neighborhood is    *
+     *  full of spirals at every scale. This zooms in by a factor of 10^50,   *
+     *  far past what doubles can resolve.                                    */
+    const cvp::deep_viewport view = cvp::deep_viewport(
+        "0.0", "1.0", 1.0E-50, cvp::setup::xsize, cvp::setup::ysize
+    );
+
+    /*  Create the plots.                                                     */
+    cvp::deep_zoom_plot(iters, bailout, cvp::escape_time_color, view, name);
+    return 0;
+}
+/*  End of main.                                                              */
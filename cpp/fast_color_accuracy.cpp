@@ -0,0 +1,143 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Checks the fast coloring mode against the C library. For each number  *
+ *      of terms, the index into the color wheel and the intensity of each    *
+ *      channel are compared with those from std::atan2 and std::atan, in     *
+ *      units of one 8-bit step. The program fails if any error reaches half  *
+ *      a step, and also reports how many colors differ from the exact ones.  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines and the fast colorers given here.                       */
+#include "cvp.hpp"
+
+/*  printf found here.                                                        */
+#include <cstdio>
+
+/*  Compares cvp::fast with the C library at the point z, updating the        *
+ *  largest errors found and the count of colors that differ.                 */
+template <unsigned int terms>
+static void check_point(const cvp::complex &z, double *hue_err,
+                        double *shade_err, unsigned long *mismatches)
+{
+    const double gradient_factor = 1535.0 / (2.0 * M_PI);
+    const double intensity_factor = 255.0 / (0.5 * M_PI);
+    const double abs_z = std::sqrt(z.real*z.real + z.imag*z.imag);
+
+    /*  The index into the wheel, exact and approximate.                      */
+    const double val = (std::atan2(z.imag, z.real) + M_PI) * gradient_factor;
+    const double fast_val =
+        (cvp::fast::atan2<terms>(z.imag, z.real) + M_PI) * gradient_factor;
+
+    /*  The intensity, times 255. This is the largest change in a channel.    */
+    const double shade = std::atan(5.0*abs_z) * intensity_factor;
+    const double fast_shade =
+        cvp::fast::atan<terms>(5.0*abs_z) * intensity_factor;
+
+    /*  The colors themselves.                                                */
+    const cvp::color exact = cvp::palettes::wheel().at(val) * (shade / 255.0);
+    const cvp::color fast = cvp::fast::color_wheel_from_complex<terms>(z);
+
+    /*  The wheel wraps around, an index near 0 may be compared with one near *
+     *  1535. Both ends of the wheel are blue.                                */
+    double dval = std::fabs(fast_val - val);
+    dval = (dval > 767.5 ? 1535.0 - dval : dval);
+
+    if (dval > *hue_err)
+        *hue_err = dval;
+
+    if (std::fabs(fast_shade - shade) > *shade_err)
+        *shade_err = std::fabs(fast_shade - shade);
+
+    if (!(exact == fast))
+        ++(*mismatches);
+}
+
+/*  Runs the checks for one number of terms. Returns true if they pass.       */
+template <unsigned int terms>
+static bool check(void)
+{
+    /*  The points are a grid over [-4, 4]^2 and circles whose radii range    *
+     *  over many orders of magnitude.                                        */
+    const unsigned int grid_size = 2048U;
+    const unsigned int circles = 256U;
+    const unsigned int angles = 8192U;
+
+    double hue_err = 0.0;
+    double shade_err = 0.0;
+    unsigned long mismatches = 0UL;
+    unsigned long points = 0UL;
+    unsigned int m, n;
+
+    for (m = 0U; m < grid_size; ++m)
+    {
+        const double y = 4.0 - 8.0 * m / (grid_size - 1U);
+
+        for (n = 0U; n < grid_size; ++n)
+        {
+            const double x = -4.0 + 8.0 * n / (grid_size - 1U);
+            check_point<terms>(cvp::complex(x, y), &hue_err, &shade_err,
+                               &mismatches);
+            ++points;
+        }
+    }
+
+    for (m = 0U; m < circles; ++m)
+    {
+        const double r = std::pow(10.0, -8.0 + 16.0 * m / (circles - 1U));
+
+        for (n = 0U; n < angles; ++n)
+        {
+            const double theta = -M_PI + 2.0 * M_PI * (n + 0.5) / angles;
+            const cvp::complex z(r * std::cos(theta), r * std::sin(theta));
+            check_point<terms>(z, &hue_err, &shade_err, &mismatches);
+            ++points;
+        }
+    }
+
+    std::printf("terms = %u: hue %.4f steps, intensity %.4f steps, "
+                "%lu of %lu colors differ\n", terms, hue_err, shade_err,
+                mismatches, points);
+
+    return hue_err < 0.5 && shade_err < 0.5;
+}
+
+/*  Checks every accuracy supported by cvp::fast.                             */
+int main(void)
+{
+    bool passed = check<3U>();
+    passed = check<4U>() && passed;
+    passed = check<5U>() && passed;
+    passed = check<6U>() && passed;
+    passed = check<7U>() && passed;
+
+    if (!passed)
+    {
+        std::puts("ERROR: cvp::fast is off by half a step or more.");
+        return 1;
+    }
+
+    std::puts("PASSED");
+    return 0;
+}
+/*  End of main.                                                              */
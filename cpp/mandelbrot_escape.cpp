@@ -0,0 +1,56 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Escape-time plot of the Mandelbrot set.                               *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  The Mandelbrot set comes from the quadratic map z^2. cvp::quadratic lets  *
+ *  the escape-time plot skip most of the interior of the set.                */
+static const cvp::quadratic f = cvp::quadratic();
+
+/*  Routine for plotting the Mandelbrot set with escape times.                */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "mandelbrot_escape.ppm";
+
+    /*  The maximum number of iterations to perform.                          */
+    const unsigned int iters = 1000U;
+
+    /*  Orbits leaving this radius have escaped. A large radius makes the     *
+     *  smoothed iteration count used by escape_time_color more accurate.     */
+    const double bailout = 256.0;
+
+    /*  The region containing the entire set.                                 */
+    const cvp::viewport view = cvp::viewport(
+        -2.0, 1.0, -1.5, 1.5, cvp::setup::xsize, cvp::setup::ysize
+    );
+
+    /*  Create the plots.                                                     */
+    cvp::escape_plot(f, iters, bailout, cvp::escape_time_color, view, name);
+    return 0;
+}
+/*  End of main.                                                              */
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Saves the escape-time orbits of the Mandelbrot set to a field file    *
+ *      once, and then colors it several ways without iterating again.        *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  fmod found here.                                                          */
+#include <cmath>
+
+/*  The Mandelbrot set comes from the quadratic map z^2.                      */
+static const cvp::quadratic f = cvp::quadratic();
+
+/*  Escape colorer with bands of the color wheel, one every 20 iterations.    */
+class bands {
+    public:
+        inline cvp::color operator () (const cvp::orbit &o) const
+        {
+            if (!o.escaped)
+                return cvp::color(0x00U, 0x00U, 0x00U);
+
+            /*  The fraction of the way around the wheel, as an index.        */
+            const double t = std::fmod(0.05 * o.iters, 1.0);
+            return cvp::palettes::wheel().at(t * cvp::palette::size);
+        }
+};
+
+/*  Routine for recoloring an escape-time field of the Mandelbrot set.        */
+int main(void)
+{
+    /*  Name of the field file, computed once.                                */
+    const char *field_name = "mandelbrot.field";
+
+    /*  The maximum number of iterations to perform.                          */
+    const unsigned int iters = 1000U;
+
+    /*  Orbits leaving this radius have escaped.                              */
+    const double bailout = 256.0;
+
+    /*  The region containing the entire set.                                 */
+    const cvp::viewport view = cvp::viewport(
+        -2.0, 1.0, -1.5, 1.5, cvp::setup::xsize, cvp::setup::ysize
+    );
+
+    /*  The expensive part, iterating every pixel. The field is compressed,   *
+     *  which is lossless and roughly halves the size of the file.            */
+    cvp::escape_field(f, iters, bailout, view, field_name,
+                      cvp::fpc_compression);
+
+    /*  Same image as mandelbrot_escape.cpp.                                  */
+    cvp::recolor(field_name, cvp::escape_time_color, "mandelbrot_recolor.ppm");
+
+    /*  A different escape colorer, and the last value of each orbit.         */
+    cvp::recolor(field_name, bands(), "mandelbrot_bands.ppm");
+    cvp::recolor(
+        field_name, cvp::color_wheel_from_complex, "mandelbrot_values.ppm"
+    );
+
+    return 0;
+}
+/*  End of main.                                                              */
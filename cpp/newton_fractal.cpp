@@ -0,0 +1,77 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Newton fractal for z^3 - 2z + 2, with the derivative found by duals.  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  The polynomial z^3 - 2z + 2, written in Horner form. Only the function    *
+ *  is needed, cvp::newton_plot finds its derivative with dual numbers.       */
+class cubic {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            return (z*z - 2.0)*z + 2.0;
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const cubic f = cubic();
+
+/*  Routine for plotting the basins of the roots of z^3 - 2z + 2.             */
+int main(void)
+{
+    /*  Names of the output PPM files.                                        */
+    const char *basins_name = "newton_fractal_basins.ppm";
+    const char *speed_name = "newton_fractal_speed.ppm";
+
+    /*  The maximum number of iterations, and the tolerance for convergence.  */
+    const unsigned int iters = 200U;
+    const double tolerance = 1.0E-10;
+
+    /*  The roots of z^3 - 2z + 2, one real and a complex conjugate pair.     */
+    const cvp::complex roots[3] = {
+        cvp::complex(-1.7692923542386314, 0.0),
+        cvp::complex(0.8846461771193157, 0.5897428050222056),
+        cvp::complex(0.8846461771193157, -0.5897428050222056)
+    };
+
+    /*  Converged points are labeled by the root they are near.               */
+    const cvp::attractors basins = cvp::attractors(roots, 3U, 1.0E-6);
+
+    /*  Create the plots. Starting points near 0 fall into the 2-cycle        *
+     *  0 -> 1 -> 0 and never converge, these are colored black.              */
+    cvp::newton_plot(
+        f, iters, tolerance, basins, cvp::convergence_color, basins_name
+    );
+
+    cvp::newton_plot(
+        f, iters, tolerance, basins, cvp::convergence_speed_color, speed_name
+    );
+
+    return 0;
+}
+/*  End of main.                                                              */
@@ -0,0 +1,71 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Basins of Newton's method for a degree 24 polynomial given by roots.  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  cos and sin found here.                                                   */
+#include <cmath>
+
+/*  Routine for plotting the basins of roots placed on a sunflower spiral.    */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "sunflower_basins.ppm";
+
+    /*  The maximum number of iterations, and the tolerance for convergence.  */
+    const unsigned int iters = 200U;
+    const double tolerance = 1.0E-10;
+
+    /*  The number of roots, and the golden angle between consecutive ones.   */
+    const unsigned int degree = 24U;
+    const double golden_angle = 2.39996322972865332;
+
+    /*  The polynomial, built one root at a time.                             */
+    cvp::root_polynomial poly;
+    unsigned int k;
+
+    /*  Root k is at radius sqrt(k / n) and angle k times the golden angle,   *
+     *  which spreads the roots evenly over the unit disk.                    */
+    for (k = 0U; k < degree; ++k)
+    {
+        const double t = static_cast<double>(k) + 0.5;
+        const double radius = std::sqrt(t / static_cast<double>(degree));
+        const double angle = t * golden_angle;
+
+        poly.add(
+            cvp::complex(radius * std::cos(angle), radius * std::sin(angle))
+        );
+    }
+
+    /*  Create the plots.                                                     */
+    cvp::root_newton_plot(
+        poly, iters, tolerance, cvp::convergence_color, name
+    );
+
+    return 0;
+}
+/*  End of main.                                                              */
@@ -0,0 +1,55 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Plots the function tanh(z).                                           *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  The function to be plotted. cvp::tanh takes a cvp::complex or a batch of  *
+ *  them, and the batch version is vectorized.                                */
+class hyperbolic_tangent {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            return cvp::tanh(z);
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const hyperbolic_tangent f = hyperbolic_tangent();
+
+/*  Routine for plotting the function f(z) = tanh(z).                         */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "tanh_z.ppm";
+
+    /*  Create the plots.                                                     */
+    cvp::complex_plot(f, cvp::color_wheel_from_complex, name);
+    return 0;
+}
+/*  End of main.                                                              */
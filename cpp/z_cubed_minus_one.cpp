@@ -27,11 +27,20 @@
 /*  Plotting routines given here.                                             */
 #include "cvp.hpp"
 
-/*  The function to be plotted.                                               */
-static inline cvp::complex f(cvp::complex z)
-{
-    return z*z*z - 1.0;
-}
+/*  The function to be plotted. It is a template so that it may be called on  *
+ *  a cvp::complex or on a cvp::complex_batch, the latter computing several   *
+ *  pixels at once.                                                           */
+class cubic {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            return z*z*z - 1.0;
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const cubic f = cubic();
 
 /*  Routine for plotting the function f(z) = z^3 - 1.                         */
 int main(void)
@@ -0,0 +1,73 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Basins of attraction of Newton's method for z^3 - 1.                  *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  The Newton iteration for z^3 - 1. It is a template so that it may be      *
+ *  called on a cvp::complex or on a cvp::complex_batch.                      */
+class newton {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            /*  z - (z^3 - 1) / (3z^2) simplifies to (2z^3 + 1) / (3z^2).     */
+            return (2.0*z*z*z + 1.0) / (3.0*z*z);
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const newton f = newton();
+
+/*  Routine for plotting the basins of the three cube roots of unity.         */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "z_cubed_minus_one_basins.ppm";
+
+    /*  The maximum number of iterations, and the tolerance for convergence.  */
+    const unsigned int iters = 200U;
+    const double tolerance = 1.0E-10;
+
+    /*  The roots of z^3 - 1 are the cube roots of unity.                     */
+    const double half_sqrt_three = 0.86602540378443864676;
+    const cvp::complex roots[3] = {
+        cvp::complex(1.0, 0.0),
+        cvp::complex(-0.5, half_sqrt_three),
+        cvp::complex(-0.5, -half_sqrt_three)
+    };
+
+    /*  Converged points are labeled by the root they are near.               */
+    const cvp::attractors basins = cvp::attractors(roots, 3U, 1.0E-6);
+
+    /*  Create the plots.                                                     */
+    cvp::convergence_plot(
+        f, iters, tolerance, basins, cvp::convergence_color, name
+    );
+
+    return 0;
+}
+/*  End of main.                                                              */
@@ -19,24 +19,34 @@
  ******************************************************************************/
 #include "cvp.hpp"
 
-static inline cvp::complex g(cvp::complex z)
-{
-    // return (z*z*z - 1.0) / (2.0*z*z*z);
-    // return (z*z*z - 1.0) / (3.0*z*z*z);
-    // return (z*z*z - 1.0) / (2.0*z*z);
-    return (z*z*z - 1.0) / (3.0*z*z);
-}
+/*  (z^3 - 1) / (3 z^2). Other choices of the denominator:                    *
+ *      cvp::polynomial<2, 0, 0, 0> for (z^3 - 1) / (2 z^3).                  *
+ *      cvp::polynomial<3, 0, 0, 0> for (z^3 - 1) / (3 z^3).                  *
+ *      cvp::polynomial<2, 0, 0> for (z^3 - 1) / (2 z^2).                     */
+typedef cvp::rational<
+    cvp::polynomial<1, 0, 0, -1>, cvp::polynomial<3, 0, 0>
+> rational_map;
 
-static inline cvp::complex f(cvp::complex z)
-{
-    for (int n = 0; n < 10; ++n)
-        z = g(z);
-    return z;
-}
+/*  Ten iterations of the rational map. As a template this may be called on   *
+ *  batches, computing several pixels at once.                                */
+class iterated_map {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            const rational_map g = rational_map();
+            T w = z;
+
+            for (int n = 0; n < 10; ++n)
+                w = g(w);
+
+            return w;
+        }
+};
 
 int main(void)
 {
     const char *name = "z_cubed_minus_one_by_two_z.ppm";
-    cvp::complex_plot(f, cvp::color_wheel_from_complex, name);
+    cvp::complex_plot(iterated_map(), cvp::color_wheel_from_complex, name);
     return 0;
 }
@@ -27,12 +27,20 @@
 /*  Plotting routines given here.                                             */
 #include "cvp.hpp"
 
-/*  The Newton iteration for z^3 - 1.                                         */
-static inline cvp::complex f(cvp::complex z)
-{
-    /*  z - (z^3 - 1) / (3z^2) simplifies to (2z^3 + 1) / (3z^3).             */
-    return (2.0*z*z*z + 1.0) / (3.0*z*z);
-}
+/*  The Newton iteration for z^3 - 1. It is a template so that it may be      *
+ *  called on a cvp::complex or on a cvp::complex_batch.                      */
+class newton {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            /*  z - (z^3 - 1) / (3z^2) simplifies to (2z^3 + 1) / (3z^3).     */
+            return (2.0*z*z*z + 1.0) / (3.0*z*z);
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const newton f = newton();
 
 /*  Routine for plotting the first three iterations of Newton's method.       */
 int main(void)
@@ -0,0 +1,59 @@
+/******************************************************************************
+ *                                  LICENSE                                   *
+ ******************************************************************************
+ *  This file is part of complex_visual_plots.                                *
+ *                                                                            *
+ *  complex_visual_plots is free software: you can redistribute it and/or     *
+ *  modify it under the terms of the GNU General Public License as published  *
+ *  by the Free Software Foundation, either version 3 of the License, or      *
+ *  (at your option) any later version.                                       *
+ *                                                                            *
+ *  complex_visual_plots is distributed in the hope that it will be useful    *
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of            *
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the             *
+ *  GNU General Public License for more details.                              *
+ *                                                                            *
+ *  You should have received a copy of the GNU General Public License         *
+ *  along with complex_visual_plots.  If not, see                             *
+ *  <https://www.gnu.org/licenses/>.                                          *
+ ******************************************************************************
+ *  Purpose:                                                                  *
+ *      Plots the function z^3 - 1 using a palette read from a file.          *
+ ******************************************************************************
+ *  Author: Ryan Maguire                                                      *
+ *  Date:   2026/10/16                                                        *
+ ******************************************************************************/
+
+/*  Plotting routines given here.                                             */
+#include "cvp.hpp"
+
+/*  The function to be plotted, for a cvp::complex or a cvp::complex_batch.   */
+class cubic {
+    public:
+        template <typename T>
+        inline T operator () (const T &z) const
+        {
+            return z*z*z - 1.0;
+        }
+};
+
+/*  The instance passed to the plotting routines.                             */
+static const cubic f = cubic();
+
+/*  Routine for plotting the function f(z) = z^3 - 1.                         */
+int main(void)
+{
+    /*  Name of the output PPM file.                                          */
+    const char *name = "z_cubed_minus_one_palette.ppm";
+
+    /*  The palette is read once and interpolated into a table. twilight is   *
+     *  cyclic, white through blue and purple, then red and orange back to    *
+     *  white, so the zeros of z^3 - 1 show no seam. If the file is missing,  *
+     *  an error is printed and the rainbow wheel is used.                    */
+    const cvp::palette colorer("palettes/twilight.txt");
+
+    /*  Create the plots.                                                     */
+    cvp::complex_plot(f, colorer, name);
+    return 0;
+}
+/*  End of main.                                                              */